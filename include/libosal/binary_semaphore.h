@@ -68,6 +68,12 @@
 //! Flag to make a process shared binary semaphore.
 #define OSAL_BINARY_SEMAPHORE_ATTR__PROCESS_SHARED         0x00000020u
 
+#define OSAL_BINARY_SEMAPHORE_ATTR__CLOCK__MASK            0x00000C00u  //!< \brief Timeout clock mask.
+#define OSAL_BINARY_SEMAPHORE_ATTR__CLOCK__SHIFT           10u          //!< \brief Timeout clock shift.
+#define OSAL_BINARY_SEMAPHORE_ATTR__CLOCK__DEFAULT         0x00000000u  //!< \brief Timeouts use the clock source configured at init.
+#define OSAL_BINARY_SEMAPHORE_ATTR__CLOCK__REALTIME        0x00000400u  //!< \brief Timeouts use LIBOSAL_CLOCK_REALTIME.
+#define OSAL_BINARY_SEMAPHORE_ATTR__CLOCK__MONOTONIC       0x00000800u  //!< \brief Timeouts use LIBOSAL_CLOCK_MONOTONIC.
+
 //! Binary semaphore attribute type.
 typedef osal_uint32_t osal_binary_semaphore_attr_t;
 
@@ -139,6 +145,28 @@ osal_retval_t osal_binary_semaphore_trywait(osal_binary_semaphore_t *sem);
  */
 osal_retval_t osal_binary_semaphore_timedwait(osal_binary_semaphore_t *sem, const osal_timer_t *to);
 
+//! \brief Wait for a binary_semaphore until a deadline in nanoseconds.
+/*!
+ * Like \ref osal_binary_semaphore_timedwait without \ref osal_timer_t conversions.
+ *
+ * \param[in]   sem         Pointer to osal binary_semaphore structure. Content is OS dependent.
+ * \param[in]   deadline_ns Absolute timeout in [ns] on the timeout clock of \p sem.
+ *
+ * \retval OK               on success.
+ * \retval OSAL_ERR_TIMEOUT if there was no \ref osal_binary_semaphore_post until the deadline.
+ */
+osal_retval_t osal_binary_semaphore_wait_until_ns(osal_binary_semaphore_t *sem, osal_uint64_t deadline_ns);
+
+//! \brief Wait for a binary_semaphore for a time in nanoseconds.
+/*!
+ * \param[in]   sem         Pointer to osal binary_semaphore structure. Content is OS dependent.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \retval OK               on success.
+ * \retval OSAL_ERR_TIMEOUT if there was no \ref osal_binary_semaphore_post in the specified time.
+ */
+osal_retval_t osal_binary_semaphore_wait_for_ns(osal_binary_semaphore_t *sem, osal_uint64_t rel_ns);
+
 //! \brief Destroys a binary_semaphore.
 /*!
  * This function destroys the binary semaphore and frees operating system resources.
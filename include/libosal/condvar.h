@@ -80,6 +80,12 @@
 #define OSAL_CONDVAR_ATTR__PROTOCOL__INHERIT      0x00000100u   //!< \brief Inherit protocol.
 #define OSAL_CONDVAR_ATTR__PROTOCOL__PROTECT      0x00000200u   //!< \brief Protect protocol.
 
+#define OSAL_CONDVAR_ATTR__CLOCK__MASK            0x00000C00u   //!< \brief Timeout clock mask.
+#define OSAL_CONDVAR_ATTR__CLOCK__SHIFT           10u           //!< \brief Timeout clock shift.
+#define OSAL_CONDVAR_ATTR__CLOCK__DEFAULT         0x00000000u   //!< \brief Timeouts use the clock source configured at init.
+#define OSAL_CONDVAR_ATTR__CLOCK__REALTIME        0x00000400u   //!< \brief Timeouts use LIBOSAL_CLOCK_REALTIME.
+#define OSAL_CONDVAR_ATTR__CLOCK__MONOTONIC       0x00000800u   //!< \brief Timeouts use LIBOSAL_CLOCK_MONOTONIC.
+
 #define OSAL_CONDVAR_ATTR__PRIOCEILING__MASK      0xFFFF0000u   //!< \brief Mask for priority ceiling protocol.
 #define OSAL_CONDVAR_ATTR__PRIOCEILING__SHIFT     16u           //!< \brief Priority ceiling value shift.
 
@@ -136,6 +142,34 @@ osal_retval_t osal_condvar_wait(osal_condvar_t *cv, osal_mutex_t *mtx);
  */
 osal_retval_t osal_condvar_timedwait(osal_condvar_t *cv, osal_mutex_t *mtx, const osal_timer_t *timeout);
 
+//! \brief timed wait on a condvar until a deadline in nanoseconds.
+/*!
+ * Like \ref osal_condvar_timedwait without \ref osal_timer_t conversions.
+ *
+ * \param[in]   cv          Pointer to osal condvar structure. Content is OS dependent.
+ * \param[in]   mtx         Pointer to osal mutex structure. Content is OS dependent.
+ * \param[in]   deadline_ns Absolute timeout in [ns] on the timeout clock of \p cv.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_TIMEOUT             Timeout expired waiting on condition.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Mutex was not owner by thread.
+ * \retval OSAL_ERR_INVALID_PARAM       Condvar is invalid/not initalized.
+ */
+osal_retval_t osal_condvar_wait_until_ns(osal_condvar_t *cv, osal_mutex_t *mtx, osal_uint64_t deadline_ns);
+
+//! \brief timed wait on a condvar for a time in nanoseconds.
+/*!
+ * \param[in]   cv          Pointer to osal condvar structure. Content is OS dependent.
+ * \param[in]   mtx         Pointer to osal mutex structure. Content is OS dependent.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_TIMEOUT             Timeout expired waiting on condition.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Mutex was not owner by thread.
+ * \retval OSAL_ERR_INVALID_PARAM       Condvar is invalid/not initalized.
+ */
+osal_retval_t osal_condvar_wait_for_ns(osal_condvar_t *cv, osal_mutex_t *mtx, osal_uint64_t rel_ns);
+
 //! \brief Signals one waiter on a condvar.
 /*!
  * This function signals one waiting task to resume it's work.
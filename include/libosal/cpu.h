@@ -0,0 +1,65 @@
+/**
+ * \file cpu.h
+ *
+ * \author agent <agent@local>
+ *
+ * \date 17 Oct 2026
+ *
+ * \brief OSAL cpu header.
+ *
+ * OSAL cpu helpers include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_CPU__H
+#define LIBOSAL_CPU__H
+
+#ifdef HAVE_CONFIG_H
+#include <libosal/config.h>
+#endif
+
+#include <libosal/types.h>
+
+/** \defgroup cpu_group CPU
+ * Small helpers around CPU instructions, usable in busy-wait loops.
+ *
+ * @{
+ */
+
+//! \brief Hint the CPU that the caller is spinning.
+/*!
+ * Executes PAUSE on x86 or YIELD on ARM. This lowers power consumption
+ * and frees resources for a sibling hyperthread while busy-waiting,
+ * without giving up the CPU to the scheduler.
+ */
+static inline void osal_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+/** @} */
+
+#endif /* LIBOSAL_CPU__H */
+
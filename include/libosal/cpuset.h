@@ -0,0 +1,164 @@
+/**
+ * \file cpuset.h
+ *
+ * \author agent <agent@local>
+ *
+ * \date 18 Oct 2026
+ *
+ * \brief OSAL cpuset header.
+ *
+ * OSAL CPU set include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_CPUSET__H
+#define LIBOSAL_CPUSET__H
+
+#ifdef HAVE_CONFIG_H
+#include <libosal/config.h>
+#endif
+
+#include <libosal/types.h>
+
+/** \defgroup cpuset_group CPU set
+ * Fixed size set of CPUs, e.g. for task affinity on machines with more
+ * than 32 CPUs.
+ *
+ * @{
+ */
+
+#define OSAL_CPUSET_SIZE    1024u                       //!< \brief Maximum number of CPUs in a set.
+#define OSAL_CPUSET_WORDS   (OSAL_CPUSET_SIZE / 64u)    //!< \brief Number of 64 bit words in a set.
+
+//! \brief CPU set.
+typedef struct osal_cpuset {
+    osal_uint64_t bits[OSAL_CPUSET_WORDS];              //!< \brief One bit per CPU.
+} osal_cpuset_t;                                        //!< \brief CPU set type.
+
+//! \brief Remove all CPUs from set.
+/*!
+ * \param[out]  set     Pointer to CPU set.
+ */
+static inline void osal_cpuset_zero(osal_cpuset_t *set) {
+    for (osal_uint32_t i = 0u; i < OSAL_CPUSET_WORDS; ++i) {
+        set->bits[i] = 0u;
+    }
+}
+
+//! \brief Add CPU to set.
+/*!
+ * \param[in,out]   set     Pointer to CPU set.
+ * \param[in]       cpu     CPU number, ignored if out of range.
+ */
+static inline void osal_cpuset_set(osal_cpuset_t *set, osal_uint32_t cpu) {
+    if (cpu < OSAL_CPUSET_SIZE) {
+        set->bits[cpu / 64u] |= (osal_uint64_t)1u << (cpu % 64u);
+    }
+}
+
+//! \brief Remove CPU from set.
+/*!
+ * \param[in,out]   set     Pointer to CPU set.
+ * \param[in]       cpu     CPU number, ignored if out of range.
+ */
+static inline void osal_cpuset_clear(osal_cpuset_t *set, osal_uint32_t cpu) {
+    if (cpu < OSAL_CPUSET_SIZE) {
+        set->bits[cpu / 64u] &= ~((osal_uint64_t)1u << (cpu % 64u));
+    }
+}
+
+//! \brief Check if CPU is in set.
+/*!
+ * \param[in]   set     Pointer to CPU set.
+ * \param[in]   cpu     CPU number.
+ *
+ * \return 1 if \p cpu is in \p set, 0 otherwise.
+ */
+static inline osal_bool_t osal_cpuset_isset(const osal_cpuset_t *set, osal_uint32_t cpu) {
+    return (cpu < OSAL_CPUSET_SIZE) && (((set->bits[cpu / 64u] >> (cpu % 64u)) & 1u) != 0u);
+}
+
+//! \brief Count CPUs in set.
+/*!
+ * \param[in]   set     Pointer to CPU set.
+ *
+ * \return Number of CPUs in \p set.
+ */
+static inline osal_uint32_t osal_cpuset_count(const osal_cpuset_t *set) {
+    osal_uint32_t cnt = 0u;
+
+    for (osal_uint32_t i = 0u; i < OSAL_CPUSET_WORDS; ++i) {
+        cnt += (osal_uint32_t)__builtin_popcountll(set->bits[i]);
+    }
+
+    return cnt;
+}
+
+//! \brief Iterate over CPUs in set.
+/*!
+ * \code
+ * for (osal_int32_t cpu = osal_cpuset_next(&set, -1); cpu >= 0; cpu = osal_cpuset_next(&set, cpu)) {
+ * \endcode
+ *
+ * \param[in]   set     Pointer to CPU set.
+ * \param[in]   prev    Previous CPU, -1 to start.
+ *
+ * \return Lowest CPU in \p set greater than \p prev, -1 if there is none.
+ */
+static inline osal_int32_t osal_cpuset_next(const osal_cpuset_t *set, osal_int32_t prev) {
+    osal_uint32_t cpu = (osal_uint32_t)(prev + 1);
+    osal_int32_t ret = -1;
+
+    while ((cpu < OSAL_CPUSET_SIZE) && (ret < 0)) {
+        osal_uint64_t word = set->bits[cpu / 64u] >> (cpu % 64u);
+
+        if (word != 0u) {
+            ret = (osal_int32_t)(cpu + (osal_uint32_t)__builtin_ctzll(word));
+        } else {
+            cpu = (cpu | 63u) + 1u;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Initialize set from 32 bit mask.
+/*!
+ * \param[out]  set     Pointer to CPU set.
+ * \param[in]   mask    Bit n set for CPU n.
+ */
+static inline void osal_cpuset_from_mask(osal_cpuset_t *set, osal_uint32_t mask) {
+    osal_cpuset_zero(set);
+    set->bits[0] = mask;
+}
+
+//! \brief Return CPUs 0 to 31 of set as 32 bit mask.
+/*!
+ * \param[in]   set     Pointer to CPU set.
+ *
+ * \return Bit n set for CPU n, higher CPUs are dropped.
+ */
+static inline osal_uint32_t osal_cpuset_to_mask(const osal_cpuset_t *set) {
+    return (osal_uint32_t)(set->bits[0] & 0xFFFFFFFFu);
+}
+
+/** @} */
+
+#endif /* LIBOSAL_CPUSET__H */
@@ -0,0 +1,213 @@
+/**
+ * \file executor.h
+ *
+ * \author agent <agent@local>
+ *
+ * \date 18 Oct 2026
+ *
+ * \brief OSAL executor header.
+ *
+ * OSAL work-stealing thread pool include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_EXECUTOR__H
+#define LIBOSAL_EXECUTOR__H
+
+#ifdef HAVE_CONFIG_H
+#include <libosal/config.h>
+#endif
+
+#include <libosal/types.h>
+#include <libosal/osal.h>
+
+/** \defgroup executor_group Executor
+ * This module runs many short jobs on a fixed pool of worker tasks.
+ *
+ * Every worker owns a Chase-Lev deque. Jobs submitted from a worker are
+ * pushed to its own deque and popped again in LIFO order, idle workers
+ * steal the oldest jobs from the other deques. Jobs submitted from other
+ * tasks go to a shared injection queue. Completion is tracked with wait
+ * groups. Jobs are owned by the caller, submitting needs no allocation.
+ *
+ * Not meant for realtime tasks, the injection queue and idle workers use
+ * a mutex.
+ *
+ * @{
+ */
+
+#define OSAL_EXECUTOR_DEQUE_SIZE_DEFAULT    1024u   //!< \brief Default jobs per worker deque.
+
+typedef void (*osal_executor_func_t)(osal_void_t *arg);    //!< \brief Job function.
+
+struct osal_executor_wg;
+
+//! \brief Executor job.
+/*!
+ * Must not be submitted again before its wait group reports it done.
+ * Do not access the members directly.
+ */
+typedef struct osal_executor_job {
+    struct osal_executor_job *next;     //!< \brief Injection queue linkage.
+    osal_executor_func_t func;          //!< \brief Job function.
+    osal_void_t *arg;                   //!< \brief Job function argument.
+    struct osal_executor_wg *wg;        //!< \brief Wait group, may be NULL.
+} osal_executor_job_t;                  //!< \brief Executor job type.
+
+//! \brief Wait group.
+typedef struct osal_executor_wg {
+    osal_uint32_t pending;              //!< \brief Submitted but not finished jobs.
+    osal_mutex_t lock;                  //!< \brief Protects the transition to 0.
+    osal_condvar_t cond;                //!< \brief Signalled when \p pending reaches 0.
+} osal_executor_wg_t;                   //!< \brief Wait group type.
+
+//! \brief Worker deque, single owner, many thieves.
+typedef struct osal_executor_deque {
+    osal_int64_t top;                   //!< \brief Next job to steal.
+    osal_uint8_t pad0[56];              //!< \brief Keep \p top and \p bottom on own cache lines.
+    osal_int64_t bottom;                //!< \brief Next free slot, written by owner only.
+    osal_uint8_t pad1[56];              //!< \brief Keep \p bottom and the next deque on own cache lines.
+    osal_int64_t mask;                  //!< \brief Number of slots - 1.
+    osal_executor_job_t **jobs;         //!< \brief Ring of job pointers.
+} osal_executor_deque_t;                //!< \brief Worker deque type.
+
+struct osal_executor;
+
+//! \brief Executor worker.
+typedef struct osal_executor_worker {
+    struct osal_executor *exec;         //!< \brief Owning executor.
+    osal_uint32_t index;                //!< \brief Worker index.
+    osal_uint32_t seed;                 //!< \brief Victim selection state.
+    osal_task_t task;                   //!< \brief Worker task.
+    osal_executor_deque_t deque;        //!< \brief Own jobs.
+} osal_executor_worker_t;               //!< \brief Executor worker type.
+
+//! \brief Executor attributes.
+typedef struct osal_executor_attr {
+    osal_uint32_t workers;              //!< \brief Number of workers, 0 for one per online CPU.
+    osal_uint32_t deque_size;           //!< \brief Jobs per worker deque, 0 for \ref OSAL_EXECUTOR_DEQUE_SIZE_DEFAULT.
+    osal_task_attr_t task_attr;         //!< \brief Attributes of all workers.
+    const osal_task_attr_t *worker_attr;//!< \brief Attributes per worker, \p workers entries overriding \p task_attr. Can be NULL.
+} osal_executor_attr_t;                 //!< \brief Executor attributes type.
+
+//! \brief Executor.
+typedef struct osal_executor {
+    osal_uint32_t worker_cnt;           //!< \brief Number of workers.
+    osal_uint32_t stop;                 //!< \brief Request workers to exit.
+    osal_uint32_t sleepers;             //!< \brief Workers waiting for jobs.
+
+    osal_mutex_t lock;                  //!< \brief Protects injection queue and sleeping.
+    osal_condvar_t cond;                //!< \brief Wakes sleeping workers.
+    osal_executor_job_t *inject_head;   //!< \brief Jobs submitted from outside.
+    osal_executor_job_t *inject_tail;   //!< \brief Last injected job.
+    osal_uint32_t inject_cnt;           //!< \brief Number of injected jobs.
+
+    osal_executor_worker_t *workers;    //!< \brief Workers.
+} osal_executor_t;                      //!< \brief Executor type.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! \brief Initialize executor.
+/*!
+ * Allocates the worker deques and starts the workers.
+ *
+ * \param[out]  exec    Pointer to executor.
+ * \param[in]   attr    Pointer to executor attributes. Can be NULL.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid attributes.
+ * \retval OSAL_ERR_OUT_OF_MEMORY       Deques could not be allocated.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Not allowed to create task with given attributes.
+ * \retval OSAL_ERR_OPERATION_FAILED    Task, mutex or condition could not be created.
+ */
+osal_retval_t osal_executor_init(osal_executor_t *exec, const osal_executor_attr_t *attr);
+
+//! \brief Destroy executor.
+/*!
+ * Waits for running jobs and joins the workers. Jobs not yet started are
+ * dropped, their wait groups never reach 0.
+ *
+ * \param[in]   exec    Pointer to executor.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_executor_destroy(osal_executor_t *exec);
+
+//! \brief Initialize job.
+/*!
+ * \param[out]  job     Pointer to job.
+ * \param[in]   func    Job function.
+ * \param[in]   arg     Job function argument.
+ */
+void osal_executor_job_init(osal_executor_job_t *job, osal_executor_func_t func, osal_void_t *arg);
+
+//! \brief Submit job.
+/*!
+ * From a worker of \p exec the job is pushed to the worker's own deque,
+ * otherwise to the injection queue. May be called from jobs. Only POSIX
+ * builds recognize workers, elsewhere all jobs go to the injection queue.
+ *
+ * \param[in]   exec    Pointer to executor.
+ * \param[in]   job     Pointer to initialized job.
+ * \param[in]   wg      Wait group to notify when the job has finished. Can be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_executor_submit(osal_executor_t *exec, osal_executor_job_t *job, osal_executor_wg_t *wg);
+
+//! \brief Initialize wait group.
+/*!
+ * \param[out]  wg      Pointer to wait group.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_executor_wg_init(osal_executor_wg_t *wg);
+
+//! \brief Destroy wait group.
+/*!
+ * \param[in]   wg      Pointer to wait group without pending jobs.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_executor_wg_destroy(osal_executor_wg_t *wg);
+
+//! \brief Wait until all jobs of a wait group have finished.
+/*!
+ * Called from a worker of \p exec, the worker runs other jobs while
+ * waiting, so jobs may wait for jobs they submitted. This needs thread
+ * local storage and is only done on POSIX builds, elsewhere the worker
+ * blocks and jobs must not wait for other jobs.
+ *
+ * \param[in]   exec    Pointer to executor.
+ * \param[in]   wg      Pointer to wait group.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_executor_wg_wait(osal_executor_t *exec, osal_executor_wg_t *wg);
+
+#ifdef __cplusplus
+};
+#endif
+
+/** @} */
+
+#endif /* LIBOSAL_EXECUTOR__H */
@@ -0,0 +1,272 @@
+/**
+ * \file fiber.h
+ *
+ * \author agent <agent@local>
+ *
+ * \date 18 Oct 2026
+ *
+ * \brief OSAL fiber header.
+ *
+ * OSAL fiber include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_FIBER__H
+#define LIBOSAL_FIBER__H
+
+#ifdef HAVE_CONFIG_H
+#include <libosal/config.h>
+#endif
+
+#include <libosal/types.h>
+#include <libosal/osal.h>
+
+/** \defgroup fiber_group Fiber
+ * Cooperatively scheduled user-space tasks with small stacks.
+ *
+ * A fiber scheduler runs its fibers on the thread calling
+ * \ref osal_fiber_sched_run until all of them have returned. Fibers switch
+ * only in \ref osal_fiber_yield and the fiber-aware wait functions, a
+ * switch costs a few nanoseconds and needs no kernel call. To use several
+ * CPUs create one scheduler per (pinned) task.
+ *
+ * A scheduler and its fibers must only be used from one thread at a time.
+ * Fibers can be created before the scheduler runs or from fibers of the
+ * same scheduler.
+ *
+ * Only available on POSIX systems with mmap.
+ *
+ * @{
+ */
+
+#define OSAL_FIBER_STACK_SIZE_DEFAULT       (64u * 1024u)   //!< \brief Default fiber stack size in [byte].
+#define OSAL_FIBER_MAX_DEFAULT              256u            //!< \brief Default number of fibers per scheduler.
+#define OSAL_FIBER_POLL_INTERVAL_DEFAULT    100000u         //!< \brief Default semaphore poll interval in [ns].
+
+#define OSAL_FIBER_STATE_READY              0u              //!< \brief Fiber waits to be run.
+#define OSAL_FIBER_STATE_RUNNING            1u              //!< \brief Fiber is running.
+#define OSAL_FIBER_STATE_WAITING            2u              //!< \brief Fiber waits for a semaphore or a deadline.
+#define OSAL_FIBER_STATE_DONE               3u              //!< \brief Fiber function has returned.
+
+//! \brief Fiber function.
+typedef osal_void_t (*osal_fiber_func_t)(osal_void_t *arg);
+
+//! \brief Condition a waiting fiber is polled for.
+typedef osal_retval_t (*osal_fiber_trywait_t)(osal_void_t *obj);
+
+//! \brief Fiber scheduler attributes.
+typedef struct osal_fiber_sched_attr {
+    osal_size_t stack_size;             //!< \brief Stack size of each fiber in [byte], 0 for \ref OSAL_FIBER_STACK_SIZE_DEFAULT.
+    osal_uint32_t max_fibers;           //!< \brief Stacks in the pool, 0 for \ref OSAL_FIBER_MAX_DEFAULT.
+    osal_uint64_t poll_interval;        //!< \brief Semaphore poll interval while idle in [ns], 0 for \ref OSAL_FIBER_POLL_INTERVAL_DEFAULT.
+} osal_fiber_sched_attr_t;              //!< \brief Fiber scheduler attributes type.
+
+struct osal_fiber_sched;
+
+//! \brief Fiber.
+/*!
+ * Lives in caller memory and has to stay valid until the fiber is done.
+ */
+typedef struct osal_fiber {
+    osal_void_t *ctx;                   //!< \brief Saved context while not running.
+    struct osal_fiber_sched *sched;     //!< \brief Scheduler the fiber belongs to.
+    struct osal_fiber *next;            //!< \brief Link in ready or wait list.
+    osal_fiber_func_t func;             //!< \brief Fiber function.
+    osal_void_t *arg;                   //!< \brief Argument passed to \ref func.
+    osal_uint32_t slot;                 //!< \brief Stack pool slot.
+    osal_uint32_t state;                //!< \brief OSAL_FIBER_STATE_* state.
+    osal_fiber_trywait_t wait_try;      //!< \brief Polled condition while waiting, NULL for none.
+    osal_void_t *wait_obj;              //!< \brief Argument to \ref wait_try.
+    osal_uint64_t wait_deadline;        //!< \brief Wait deadline in [ns], 0 for none.
+    osal_retval_t wait_result;          //!< \brief Result of the last wait.
+} osal_fiber_t;                         //!< \brief Fiber type.
+
+//! \brief Fiber scheduler.
+typedef struct osal_fiber_sched {
+    osal_fiber_sched_attr_t attr;       //!< \brief Attributes with defaults applied.
+    osal_void_t *ctx;                   //!< \brief Saved context of the scheduler while a fiber runs.
+    osal_uint8_t *stacks;               //!< \brief Stack pool mapping.
+    osal_size_t map_size;               //!< \brief Size of \ref stacks.
+    osal_size_t slot_size;              //!< \brief Stack size including guard page.
+    osal_uint32_t *free_slots;          //!< \brief Unused pool slots.
+    osal_uint32_t free_cnt;             //!< \brief Number of unused pool slots.
+    osal_uint32_t fiber_cnt;            //!< \brief Fibers not yet done.
+    osal_fiber_t *ready_head;           //!< \brief First fiber ready to run.
+    osal_fiber_t *ready_tail;           //!< \brief Last fiber ready to run.
+    osal_fiber_t *waiting;              //!< \brief Waiting fibers.
+    osal_fiber_t *current;              //!< \brief Running fiber, NULL in the scheduler.
+    osal_uint64_t switches;             //!< \brief Number of switches to fibers.
+} osal_fiber_sched_t;                   //!< \brief Fiber scheduler type.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! \brief Initialize a fiber scheduler.
+/*!
+ * Maps the stacks of all fibers with a guard page below each stack. Stack
+ * memory is only committed when used.
+ *
+ * \param[out]  sched   Pointer to fiber scheduler.
+ * \param[in]   attr    Attributes, NULL for defaults.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_OUT_OF_MEMORY   Stack pool could not be allocated.
+ */
+osal_retval_t osal_fiber_sched_init(osal_fiber_sched_t *sched, const osal_fiber_sched_attr_t *attr);
+
+//! \brief Destroy a fiber scheduler.
+/*!
+ * \param[in]   sched   Pointer to fiber scheduler.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_BUSY            Fibers are not done yet.
+ */
+osal_retval_t osal_fiber_sched_destroy(osal_fiber_sched_t *sched);
+
+//! \brief Run fibers on the calling thread.
+/*!
+ * Runs ready fibers round robin and returns once all fibers are done.
+ * While all fibers wait, the thread sleeps until the next deadline and
+ * polls semaphores every \ref osal_fiber_sched_attr_t::poll_interval.
+ *
+ * \param[in]   sched   Pointer to fiber scheduler.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_BUSY            Called from a fiber.
+ */
+osal_retval_t osal_fiber_sched_run(osal_fiber_sched_t *sched);
+
+//! \brief Create a fiber.
+/*!
+ * \param[in]   sched   Pointer to fiber scheduler.
+ * \param[out]  fiber   Pointer to fiber, valid until the fiber is done.
+ * \param[in]   func    Fiber function.
+ * \param[in]   arg     Argument to \p func.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_SYSTEM_LIMIT_REACHED    All stacks of the pool are used.
+ */
+osal_retval_t osal_fiber_create(osal_fiber_sched_t *sched, osal_fiber_t *fiber,
+        osal_fiber_func_t func, osal_void_t *arg);
+
+//! \brief Return the running fiber.
+/*!
+ * \return Running fiber, NULL if not called from a fiber.
+ */
+osal_fiber_t *osal_fiber_self(osal_void_t);
+
+//! \brief Let other ready fibers run.
+/*!
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   Not called from a fiber.
+ */
+osal_retval_t osal_fiber_yield(osal_void_t);
+
+//! \brief Wait for a condition.
+/*!
+ * Parks the running fiber until \p cond returns OSAL_OK or \p deadline has
+ * passed. The scheduler calls \p cond from its own context, so it must not
+ * block. Building block for the other fiber-aware wait functions.
+ *
+ * \param[in]   cond        Condition, NULL to wait for \p deadline only.
+ * \param[in]   obj         Argument to \p cond.
+ * \param[in]   deadline    Absolute time in [ns], \ref osal_timer_gettime_nsec, 0 for none.
+ *
+ * \retval OSAL_OK                  Condition met or deadline reached without condition.
+ * \retval OSAL_ERR_TIMEOUT         Deadline reached before condition was met.
+ * \retval OSAL_ERR_INVALID_PARAM   Not called from a fiber.
+ */
+osal_retval_t osal_fiber_wait(osal_fiber_trywait_t cond, osal_void_t *obj, osal_uint64_t deadline);
+
+//! \brief Sleep for a delay.
+/*!
+ * Other fibers run meanwhile. Falls back to \ref osal_sleep outside of fibers.
+ *
+ * \param[in]   nsec    Delay in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_sleep(osal_uint64_t nsec);
+
+//! \brief Sleep until an absolute time.
+/*!
+ * Other fibers run meanwhile. Falls back to \ref osal_sleep_until_nsec
+ * outside of fibers.
+ *
+ * \param[in]   nsec    Absolute time in [ns], \ref osal_timer_gettime_nsec.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_sleep_until_nsec(osal_uint64_t nsec);
+
+//! \brief Sleep until a timer expires.
+/*!
+ * Other fibers run meanwhile. Falls back to \ref osal_sleep_until outside
+ * of fibers.
+ *
+ * \param[in]   timer   Timer initialized with \ref osal_timer_init.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_sleep_until(osal_timer_t *timer);
+
+//! \brief Wait for a semaphore.
+/*!
+ * Other fibers run meanwhile. Falls back to \ref osal_semaphore_wait
+ * outside of fibers.
+ *
+ * \param[in]   sem     Pointer to osal semaphore structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_semaphore_wait(osal_semaphore_t *sem);
+
+//! \brief Wait for a semaphore with deadline.
+/*!
+ * Other fibers run meanwhile. Falls back to \ref osal_semaphore_wait_until_ns
+ * outside of fibers.
+ *
+ * \param[in]   sem         Pointer to osal semaphore structure.
+ * \param[in]   deadline_ns Absolute time in [ns], \ref osal_timer_gettime_nsec.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_TIMEOUT         Deadline reached.
+ */
+osal_retval_t osal_fiber_semaphore_wait_until_ns(osal_semaphore_t *sem, osal_uint64_t deadline_ns);
+
+//! \brief Wait for a binary semaphore.
+/*!
+ * Other fibers run meanwhile. Falls back to \ref osal_binary_semaphore_wait
+ * outside of fibers.
+ *
+ * \param[in]   sem     Pointer to osal binary semaphore structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_binary_semaphore_wait(osal_binary_semaphore_t *sem);
+
+#ifdef __cplusplus
+};
+#endif
+
+/** @} */
+
+#endif /* LIBOSAL_FIBER__H */
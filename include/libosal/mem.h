@@ -0,0 +1,130 @@
+/**
+ * \file mem.h
+ *
+ * \author agent <agent@local>
+ *
+ * \date 17 Oct 2026
+ *
+ * \brief OSAL mem header.
+ *
+ * OSAL realtime memory include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_MEM__H
+#define LIBOSAL_MEM__H
+
+#ifdef HAVE_CONFIG_H
+#include <libosal/config.h>
+#endif
+
+#include <libosal/types.h>
+#include <libosal/osal.h>
+
+/** \defgroup mem_group Memory
+ * This module provides memory which does not page-fault when it is first
+ * touched inside a realtime cycle.
+ *
+ * @{
+ */
+
+#define OSAL_MEM_ATTR__LOCK             0x00000001u     //!< \brief Lock pages in RAM.
+#define OSAL_MEM_ATTR__PREFAULT         0x00000002u     //!< \brief Write-touch all pages in advance.
+#define OSAL_MEM_ATTR__HUGEPAGE         0x00000004u     //!< \brief Use huge pages if available.
+
+typedef osal_uint32_t osal_mem_attr_t;                  //!< \brief Memory attribute type.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! \brief Allocate realtime memory.
+/*!
+ * Allocates zeroed, cache line aligned memory directly from the operating system.
+ * With \ref OSAL_MEM_ATTR__HUGEPAGE explicit huge pages are tried first,
+ * then transparent huge pages, then normal pages.
+ *
+ * \param[out]  ptr     Returns pointer to allocated memory.
+ * \param[in]   size    Size in bytes.
+ * \param[in]   attr    Pointer to memory attributes. Can be NULL.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       \p size is 0.
+ * \retval OSAL_ERR_OUT_OF_MEMORY       System out of memory or lock limit reached.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Not allowed to lock memory.
+ */
+osal_retval_t osal_mem_alloc(osal_void_t **ptr, osal_size_t size, const osal_mem_attr_t *attr);
+
+//! \brief Free realtime memory.
+/*!
+ * \param[in]   ptr     Pointer returned by \ref osal_mem_alloc.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_OPERATION_FAILED    Memory could not be released.
+ */
+osal_retval_t osal_mem_free(osal_void_t *ptr);
+
+//! \brief Prepare existing memory for realtime use.
+/*!
+ * Locks and/or prefaults the pages covering \p ptr to \p ptr + \p size, e.g.
+ * of statically allocated buffers. Locked pages stay locked until they are
+ * freed or the process exits.
+ *
+ * \param[in]   ptr     Start of memory region.
+ * \param[in]   size    Size in bytes.
+ * \param[in]   attr    Pointer to memory attributes. Can be NULL.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_OUT_OF_MEMORY       Lock limit reached.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Not allowed to lock memory.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED     Locking not supported on this platform.
+ */
+osal_retval_t osal_mem_prepare(osal_void_t *ptr, osal_size_t size, const osal_mem_attr_t *attr);
+
+//! \brief Lock all memory of the process.
+/*!
+ * Locks all current and future pages of the process in RAM, including the
+ * stacks of tasks created later. Also keeps the C library from returning
+ * freed heap memory to the system, so later allocations do not fault.
+ * Call once during startup before the realtime tasks are created.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_OUT_OF_MEMORY       Lock limit reached.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Not allowed to lock memory.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED     Locking not supported on this platform.
+ */
+osal_retval_t osal_mem_lock_all(void);
+
+//! \brief Unlock all memory of the process.
+/*!
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_OPERATION_FAILED    Memory could not be unlocked.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED     Locking not supported on this platform.
+ */
+osal_retval_t osal_mem_unlock_all(void);
+
+#ifdef __cplusplus
+};
+#endif
+
+/** @} */
+
+#endif /* LIBOSAL_MEM__H */
+
@@ -68,6 +68,12 @@
 #define OSAL_MQ_ATTR__OFLAG__CLOEXEC          0x00000010u   //!< \brief Message queue attribute flag close execute
 #define OSAL_MQ_ATTR__OFLAG__EXCL             0x00000020u   //!< \brief Message queue attribute flag exclusive
 
+#define OSAL_MQ_ATTR__CLOCK__MASK             0x00000C00u   //!< \brief Timeout clock mask, part of oflags.
+#define OSAL_MQ_ATTR__CLOCK__SHIFT            10u           //!< \brief Timeout clock shift.
+#define OSAL_MQ_ATTR__CLOCK__DEFAULT          0x00000000u   //!< \brief Timeouts use the clock source configured at open.
+#define OSAL_MQ_ATTR__CLOCK__REALTIME         0x00000400u   //!< \brief Timeouts use LIBOSAL_CLOCK_REALTIME.
+#define OSAL_MQ_ATTR__CLOCK__MONOTONIC        0x00000800u   //!< \brief Timeouts use LIBOSAL_CLOCK_MONOTONIC.
+
 typedef struct osal_mq_attr {
     osal_uint32_t   oflags;                 //!< \brief Message queue open flags.
     osal_mode_t     mode;                   //!< \brief Message queue mode.
@@ -121,6 +127,32 @@ osal_retval_t osal_mq_send(osal_mq_t *mq, const osal_char_t *msg, const osal_siz
 osal_retval_t osal_mq_timedsend(osal_mq_t *mq, const osal_char_t *msg, const osal_size_t msg_len, 
         const osal_uint32_t prio, const osal_timer_t *to);
 
+//! \brief Send a message through message queue until a deadline in nanoseconds.
+/*!
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   msg         Pointer to message buffer.
+ * \param[in]   msg_len     Lenght of message to send.
+ * \param[in]   prio        Send priority.
+ * \param[in]   deadline_ns Absolute timeout in [ns] on the timeout clock of \p mq.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_send_until_ns(osal_mq_t *mq, const osal_char_t *msg, const osal_size_t msg_len, 
+        const osal_uint32_t prio, osal_uint64_t deadline_ns);
+
+//! \brief Send a message through message queue waiting at most a time in nanoseconds.
+/*!
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   msg         Pointer to message buffer.
+ * \param[in]   msg_len     Lenght of message to send.
+ * \param[in]   prio        Send priority.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_send_for_ns(osal_mq_t *mq, const osal_char_t *msg, const osal_size_t msg_len, 
+        const osal_uint32_t prio, osal_uint64_t rel_ns);
+
 //! \brief Receive a message through message queue.
 /*!
  * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
@@ -145,6 +177,32 @@ osal_retval_t osal_mq_receive(osal_mq_t *mq, osal_char_t *msg, const osal_size_t
 osal_retval_t osal_mq_timedreceive(osal_mq_t *mq, osal_char_t *msg, const osal_size_t msg_len, 
         osal_uint32_t *prio, const osal_timer_t *to);
 
+//! \brief Receive a message through message queue until a deadline in nanoseconds.
+/*!
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[out]  msg         Pointer to message buffer.
+ * \param[in]   msg_len     Lenght of message to receive.
+ * \param[out]  prio        Receive priority.
+ * \param[in]   deadline_ns Absolute timeout in [ns] on the timeout clock of \p mq.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_receive_until_ns(osal_mq_t *mq, osal_char_t *msg, const osal_size_t msg_len, 
+        osal_uint32_t *prio, osal_uint64_t deadline_ns);
+
+//! \brief Receive a message through message queue waiting at most a time in nanoseconds.
+/*!
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[out]  msg         Pointer to message buffer.
+ * \param[in]   msg_len     Lenght of message to receive.
+ * \param[out]  prio        Receive priority.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_receive_for_ns(osal_mq_t *mq, osal_char_t *msg, const osal_size_t msg_len, 
+        osal_uint32_t *prio, osal_uint64_t rel_ns);
+
 //! \brief Closes an open mq.
 /*!
  * \param[in]   mq     Pointer to osal mq structure. Content is OS dependent.
@@ -48,6 +48,7 @@
 #define OSAL_ERR_NO_DATA                -14     //!< \brief Error no date.
 #define OSAL_ERR_INTERRUPTED            -15     //!< \brief Error function call was interrupted.
 #define OSAL_ERR_MUTEX_IS_LOCKED        -16     //!< \brief Error mutex is locked.
+#define OSAL_ERR_ADMISSION_DENIED       -17     //!< \brief Error scheduler admission control rejected request.
 
 #ifdef HAVE_CONFIG_H
 #include <libosal/config.h>
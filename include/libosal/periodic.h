@@ -0,0 +1,138 @@
+/**
+ * \file periodic.h
+ *
+ * \author agent <agent@local>
+ *
+ * \date 17 Oct 2026
+ *
+ * \brief OSAL periodic header.
+ *
+ * OSAL periodic execution include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_PERIODIC__H
+#define LIBOSAL_PERIODIC__H
+
+#ifdef HAVE_CONFIG_H
+#include <libosal/config.h>
+#endif
+
+#include <libosal/types.h>
+#include <libosal/osal.h>
+
+/** \defgroup periodic_group Periodic
+ * This module implements drift-free periodic execution. Releases lie on a
+ * fixed grid of absolute times, a job missing its deadline (the next
+ * release) is detected and handled according to the overrun policy.
+ *
+ * @{
+ */
+
+#define OSAL_PERIODIC_ATTR__OVERRUN__MASK       0x0000000Fu     //!< \brief Overrun policy mask.
+#define OSAL_PERIODIC_ATTR__OVERRUN__SKIP       0x00000000u     //!< \brief Skip missed releases, continue at next grid point (default).
+#define OSAL_PERIODIC_ATTR__OVERRUN__CATCH_UP   0x00000001u     //!< \brief Run missed releases back to back.
+
+typedef osal_uint32_t osal_periodic_attr_t;                     //!< \brief Periodic attributes type.
+
+//! \brief Periodic execution statistics.
+typedef struct osal_periodic_stats {
+    osal_uint64_t releases;             //!< \brief Released jobs.
+    osal_uint64_t cycles;               //!< \brief Completed jobs.
+    osal_uint64_t missed;               //!< \brief Jobs finished after their deadline.
+    osal_uint64_t skipped;              //!< \brief Releases skipped due to overruns.
+    osal_uint64_t exec_min;             //!< \brief Minimum execution time in [ns].
+    osal_uint64_t exec_max;             //!< \brief Maximum execution time in [ns].
+    osal_uint64_t exec_sum;             //!< \brief Sum of execution times in [ns].
+    osal_uint64_t lat_min;              //!< \brief Minimum wakeup latency in [ns].
+    osal_uint64_t lat_max;              //!< \brief Maximum wakeup latency in [ns].
+    osal_uint64_t lat_sum;              //!< \brief Sum of wakeup latencies in [ns].
+} osal_periodic_stats_t;                //!< \brief Periodic statistics type.
+
+//! \brief Periodic execution.
+typedef struct osal_periodic {
+    osal_periodic_attr_t attr;          //!< \brief Attributes.
+    osal_uint64_t period;               //!< \brief Period in [ns].
+    osal_uint64_t release;              //!< \brief Release time of current job in [ns].
+    osal_uint64_t wakeup;               //!< \brief Wakeup time of current job in [ns], 0 before first job.
+    osal_periodic_stats_t stats;        //!< \brief Statistics.
+} osal_periodic_t;                      //!< \brief Periodic type.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! \brief Initialize periodic execution.
+/*!
+ * The first job is released at \p start + \p phase, following jobs
+ * every \p period.
+ *
+ * \param[out]  per     Pointer to periodic struct.
+ * \param[in]   attr    Pointer to attributes. Can be NULL.
+ * \param[in]   period  Period in [ns].
+ * \param[in]   phase   Offset of first release from \p start in [ns].
+ * \param[in]   start   Absolute start time in [ns], 0 for now.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   \p period is 0 or invalid overrun policy.
+ */
+osal_retval_t osal_periodic_init(osal_periodic_t *per, const osal_periodic_attr_t *attr,
+        osal_uint64_t period, osal_uint64_t phase, osal_uint64_t start);
+
+//! \brief Finish current job and wait for next release.
+/*!
+ * Records the execution time of the current job and sleeps with an absolute
+ * timeout until the next release. If the current job finished after its
+ * deadline, the next release is chosen by the overrun policy: with
+ * \ref OSAL_PERIODIC_ATTR__OVERRUN__SKIP the next grid point in the future,
+ * with \ref OSAL_PERIODIC_ATTR__OVERRUN__CATCH_UP the next grid point, even
+ * if it is already in the past. The first call waits for the first release.
+ *
+ * \param[in]   per     Pointer to periodic struct.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_TIMEOUT             Current job missed its deadline, next job released.
+ * \retval OSAL_ERR_OPERATION_FAILED    Sleep failed.
+ */
+osal_retval_t osal_periodic_wait_next_period(osal_periodic_t *per);
+
+//! \brief Get statistics.
+/*!
+ * \param[in]   per     Pointer to periodic struct.
+ * \param[out]  stats   Returns statistics, min values are 0 if there is no sample.
+ */
+void osal_periodic_get_stats(osal_periodic_t *per, osal_periodic_stats_t *stats);
+
+//! \brief Reset statistics.
+/*!
+ * Must be called from the periodic task.
+ *
+ * \param[in]   per     Pointer to periodic struct.
+ */
+void osal_periodic_reset_stats(osal_periodic_t *per);
+
+#ifdef __cplusplus
+};
+#endif
+
+/** @} */
+
+#endif /* LIBOSAL_PERIODIC__H */
+
@@ -32,11 +32,13 @@
 #define LIBOSAL_POSIX_BINARY_SEMAPHORE__H
 
 #include <pthread.h>
+#include <time.h>
 
 typedef struct osal_binary_semaphore {
     pthread_mutex_t posix_mtx;
     pthread_cond_t posix_cond;
     int value;
+    clockid_t clock_id;
 } osal_binary_semaphore_t;
 
 #endif /* LIBOSAL_POSIX_BINARY_SEMAPHORE__H */
@@ -32,9 +32,11 @@
 #define LIBOSAL_POSIX_CONDVAR__H
 
 #include <pthread.h>
+#include <time.h>
 
 typedef struct osal_condvar {
     pthread_cond_t posix_cond;
+    clockid_t clock_id;
 } osal_condvar_t;
 
 #endif /* LIBOSAL_POSIX_CONDVAR__H */
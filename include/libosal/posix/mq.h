@@ -32,9 +32,11 @@
 #define LIBOSAL_POSIX_MQ__H
 
 #include <mqueue.h>
+#include <time.h>
 
 typedef struct osal_mq {
     mqd_t mq_desc;
+    clockid_t clock_id;
 } osal_mq_t;
 
 #endif /* LIBOSAL_POSIX_MQ__H */
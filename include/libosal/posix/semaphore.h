@@ -32,9 +32,11 @@
 #define LIBOSAL_POSIX_SEMAPHORE__H
 
 #include <semaphore.h>
+#include <time.h>
 
 typedef struct osal_semaphore {
     sem_t posix_sem;
+    clockid_t clock_id;
 } osal_semaphore_t;
 
 #endif /* LIBOSAL_POSIX_SEMAPHORE__H */
@@ -34,7 +34,10 @@
 #include <pthread.h>
 
 typedef struct osal_spinlock {
-    pthread_spinlock_t posix_sl;
+    pthread_spinlock_t posix_sl;        //!< \brief Lock of \ref OSAL_SPINLOCK_ATTR__ALGORITHM__DEFAULT.
+    osal_uint32_t algorithm;            //!< \brief OSAL_SPINLOCK_ATTR__ALGORITHM__* of the lock.
+    osal_uint32_t next;                 //!< \brief Ticket: next ticket, TTAS: lock word.
+    osal_uint32_t owner;                //!< \brief Ticket: ticket being served.
 } osal_spinlock_t;
 
 #endif /* LIBOSAL_POSIX_SPINLOCK__H */
@@ -32,9 +32,12 @@
 #define LIBOSAL_POSIX_TASK__H
 
 #include <pthread.h>
+#include <sys/types.h>
 
 typedef struct osal_task {
     pthread_t tid;
+    pid_t ktid;                     //!< Kernel thread id.
+    osal_retval_t sched_status;     //!< Result of applying the scheduling attributes at create.
 } osal_task_t;
 
 #endif /* LIBOSAL_POSIX_TASK__H */
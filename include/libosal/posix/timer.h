@@ -37,4 +37,39 @@
 
 extern int global_clock_id;
 
+#include <libosal/types.h>
+#include <time.h>
+
+//! \brief Convert nanoseconds to timespec (internal).
+static inline void osal_timer_posix_ns_to_timespec(osal_uint64_t ns, struct timespec *ts) {
+    ts->tv_sec = (time_t)(ns / 1000000000u);
+    ts->tv_nsec = (long)(ns % 1000000000u);
+}
+
+//! \brief Get time of a clock in nanoseconds (internal).
+static inline osal_uint64_t osal_timer_posix_gettime_ns(clockid_t clock_id) {
+    struct timespec ts;
+    (void)clock_gettime(clock_id, &ts);
+    return ((osal_uint64_t)ts.tv_sec * 1000000000u) + (osal_uint64_t)ts.tv_nsec;
+}
+
+//! \brief Get clock id from clock attribute (internal).
+/*!
+ * \param[in]   clock_attr  Clock attribute bits shifted down, 0 default, 1 realtime, 2 monotonic.
+ *
+ * \return Clock id, global_clock_id for default.
+ */
+clockid_t osal_timer_posix_clock(osal_uint32_t clock_attr);
+
+//! \brief Convert absolute timeout of a clock to CLOCK_REALTIME (internal).
+/*!
+ * For functions which only accept CLOCK_REALTIME timeouts. Timeouts in
+ * the past are converted to the current time.
+ *
+ * \param[in]   clock_id    Clock of \p deadline_ns.
+ * \param[in]   deadline_ns Absolute timeout in [ns].
+ * \param[out]  ts          Returns absolute CLOCK_REALTIME timeout.
+ */
+void osal_timer_posix_to_realtime(clockid_t clock_id, osal_uint64_t deadline_ns, struct timespec *ts);
+
 #endif /* LIBOSAL_POSIX_TIMER__H */
@@ -68,6 +68,12 @@
 
 #define OSAL_SEMAPHORE_ATTR__PROCESS_SHARED         0x00000020u     //!< \brief Create a process shared semaphore.
 
+#define OSAL_SEMAPHORE_ATTR__CLOCK__MASK            0x00000C00u     //!< \brief Timeout clock mask.
+#define OSAL_SEMAPHORE_ATTR__CLOCK__SHIFT           10u             //!< \brief Timeout clock shift.
+#define OSAL_SEMAPHORE_ATTR__CLOCK__DEFAULT         0x00000000u     //!< \brief Timeouts use the clock source configured at init.
+#define OSAL_SEMAPHORE_ATTR__CLOCK__REALTIME        0x00000400u     //!< \brief Timeouts use LIBOSAL_CLOCK_REALTIME.
+#define OSAL_SEMAPHORE_ATTR__CLOCK__MONOTONIC       0x00000800u     //!< \brief Timeouts use LIBOSAL_CLOCK_MONOTONIC.
+
 typedef osal_uint32_t osal_semaphore_attr_t;        //!< \brief Semaphore attribute type.
 
 #ifdef __cplusplus
@@ -148,6 +154,30 @@ osal_retval_t osal_semaphore_trywait(osal_semaphore_t *sem);
  */
 osal_retval_t osal_semaphore_timedwait(osal_semaphore_t *sem, const osal_timer_t *to);
 
+//! \brief Wait for a semaphore until a deadline in nanoseconds.
+/*!
+ * Like \ref osal_semaphore_timedwait without \ref osal_timer_t conversions.
+ *
+ * \param[in]   sem         Pointer to osal semaphore structure. Content is OS dependent.
+ * \param[in]   deadline_ns Absolute timeout in [ns] on the timeout clock of \p sem.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid input parameter.
+ * \retval OSAL_ERR_TIMEOUT             Timeout occured waiting for semaphore to become available.
+ */
+osal_retval_t osal_semaphore_wait_until_ns(osal_semaphore_t *sem, osal_uint64_t deadline_ns);
+
+//! \brief Wait for a semaphore for a time in nanoseconds.
+/*!
+ * \param[in]   sem         Pointer to osal semaphore structure. Content is OS dependent.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid input parameter.
+ * \retval OSAL_ERR_TIMEOUT             Timeout occured waiting for semaphore to become available.
+ */
+osal_retval_t osal_semaphore_wait_for_ns(osal_semaphore_t *sem, osal_uint64_t rel_ns);
+
 //! \brief Destroys a semaphore.
 /*!
  * \param[in]   sem     Pointer to osal semaphore structure. Content is OS dependent.
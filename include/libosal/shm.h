@@ -120,6 +120,27 @@ osal_retval_t osal_shm_map(osal_shm_t *shm, const osal_shm_map_attr_t *attr, osa
  */
 osal_retval_t osal_shm_close(osal_shm_t *shm);
 
+//! \brief Unmap a shm.
+/*!
+ * \param[in]   shm     Pointer to osal shm structure. Content is OS dependent.
+ * \param[in]   ptr     Pointer returned by \ref osal_shm_map.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_unmap(osal_shm_t *shm, osal_void_t *ptr);
+
+//! \brief Remove a shm name.
+/*!
+ * The shm is destroyed after all processes closed and unmapped it.
+ *
+ * \param[in]   name    Shared memory name.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_NOT_FOUND           No shm with that name.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Not allowed to remove shm.
+ */
+osal_retval_t osal_shm_unlink(const osal_char_t *name);
+
 #ifdef __cplusplus
 };
 #endif
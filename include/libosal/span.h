@@ -0,0 +1,130 @@
+/**
+ * \file span.h
+ *
+ * \author agent <agent@local>
+ *
+ * \date 17 Oct 2026
+ *
+ * \brief OSAL span header.
+ *
+ * OSAL span tracing include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_SPAN__H
+#define LIBOSAL_SPAN__H
+
+#ifdef HAVE_CONFIG_H
+#include <libosal/config.h>
+#endif
+
+#include <libosal/types.h>
+#include <libosal/osal.h>
+
+/** \defgroup span_group Span
+ * This module implements named, nested spans to break down realtime cycles
+ * into phases. Every thread records into its own preallocated buffer, the
+ * recorded spans can be exported to the Chrome trace-event JSON format
+ * which is understood by chrome://tracing and Perfetto.
+ *
+ * @{
+ */
+
+#define OSAL_SPAN_MAX_DEPTH             16u     //!< \brief Maximum nesting depth of recorded spans.
+#define OSAL_SPAN_THREAD_NAME_LEN       16u     //!< \brief Maximum thread name length including terminator.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! \brief Initialize span buffer of calling thread.
+/*!
+ * Allocates the span buffer of the calling thread. The buffer keeps the
+ * last \p size completed spans, older ones are overwritten. It stays
+ * registered for export after the thread has exited, until
+ * \ref osal_span_cleanup is called. Spans of threads without buffer
+ * are silently ignored.
+ *
+ * \param[in]   size            Number of spans to keep, rounded up to a power of two.
+ * \param[in]   thread_name     Thread name shown in the export. NULL to use the OS thread name.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   \p size is 0.
+ * \retval OSAL_ERR_BUSY            Calling thread already has a span buffer.
+ * \retval OSAL_ERR_OUT_OF_MEMORY   Allocation failed.
+ */
+osal_retval_t osal_span_thread_init(osal_uint32_t size, const char *thread_name);
+
+//! \brief Begin a span.
+/*!
+ * Opens a new span on the calling thread, nested into the currently open
+ * span if any. Does not allocate or lock.
+ *
+ * \param[in]   name    Span name, has to be a string with static lifetime.
+ */
+void osal_span_begin(const char *name);
+
+//! \brief End the innermost open span.
+/*!
+ * Closes the innermost open span of the calling thread and records it.
+ */
+void osal_span_end(void);
+
+//! \brief Get dropped spans of calling thread.
+/*!
+ * Spans are dropped if they are nested deeper than \ref OSAL_SPAN_MAX_DEPTH
+ * or \ref osal_span_end is called without open span.
+ *
+ * \return Number of dropped spans.
+ */
+osal_uint64_t osal_span_get_dropped(void);
+
+//! \brief Export recorded spans.
+/*!
+ * Writes the completed spans of all span buffers as Chrome trace-event
+ * JSON to \p filename. May be called while other threads are recording,
+ * spans overwritten during the export are skipped.
+ *
+ * \param[in]   filename    Output file name.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       \p filename is NULL.
+ * \retval OSAL_ERR_PERMISSION_DENIED   File cannot be created due to permissions.
+ * \retval OSAL_ERR_OUT_OF_MEMORY       Allocation failed.
+ * \retval OSAL_ERR_OPERATION_FAILED    File could not be written.
+ */
+osal_retval_t osal_span_export_chrome(const char *filename);
+
+//! \brief Free all span buffers.
+/*!
+ * Frees the span buffers of all threads. No thread may record spans
+ * concurrently. Afterwards spans are ignored until a thread calls
+ * \ref osal_span_thread_init again.
+ */
+void osal_span_cleanup(void);
+
+#ifdef __cplusplus
+};
+#endif
+
+/** @} */
+
+#endif /* LIBOSAL_SPAN__H */
+
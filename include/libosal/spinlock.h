@@ -65,6 +65,20 @@
  * waiting on a spinlock does an active/busy-wait and costs CPU-time, but does not have the 
  * side-effects of the OS-scheduler.
  *
+ * Besides the spinlock of the operating system, own implementations can
+ * be selected with the OSAL_SPINLOCK_ATTR__ALGORITHM__* attributes:
+ * - ticket: fair, waiters get the lock in arrival order.
+ * - TTAS: test-and-test-and-set with exponential backoff, unfair but
+ *   fastest with little contention.
+ *
+ * The MCS queue lock \ref osal_spinlock_mcs_t is fair too and lets every
+ * waiter spin on its own cache line, for heavy contention. It carries its
+ * queue nodes and is a type of its own, so the other spinlocks stay small.
+ *
+ * All of them contain no pointers and can be placed in shared memory.
+ * Waiters yield the CPU after spinning for a while, so they also make
+ * progress with more threads than CPUs.
+ *
  * @{
  */
 
@@ -76,6 +90,11 @@
 #define OSAL_SPINLOCK_ATTR__ROBUST                 0x00000010u      //!< \brief Robust spinlock (unlocks if owner died).
 #define OSAL_SPINLOCK_ATTR__PROCESS_SHARED         0x00000020u      //!< \brief Process shared spinlock.
 
+#define OSAL_SPINLOCK_ATTR__ALGORITHM__MASK        0x00003000u      //!< \brief Spinlock algorithm mask.
+#define OSAL_SPINLOCK_ATTR__ALGORITHM__DEFAULT     0x00000000u      //!< \brief Spinlock of the operating system.
+#define OSAL_SPINLOCK_ATTR__ALGORITHM__TICKET      0x00001000u      //!< \brief Fair ticket lock.
+#define OSAL_SPINLOCK_ATTR__ALGORITHM__TTAS        0x00002000u      //!< \brief Test-and-test-and-set lock with exponential backoff.
+
 #define OSAL_SPINLOCK_ATTR__PROTOCOL__MASK         0x00000300u      //!< \brief Spinlock protocol mask.
 #define OSAL_SPINLOCK_ATTR__PROTOCOL__NONE         0x00000000u      //!< \brief Spinlock protocol default.
 #define OSAL_SPINLOCK_ATTR__PROTOCOL__INHERIT      0x00000100u      //!< \brief Spinlock inherit protocol.
@@ -86,6 +105,28 @@
 
 typedef osal_uint32_t osal_spinlock_attr_t;         //!< \brief Spinlock attribute type.
 
+#define OSAL_SPINLOCK_MCS_NODES     64u     //!< \brief Queue nodes of an MCS lock, more waiters wait for a free node.
+
+//! \brief Queue node of an MCS lock, one cache line.
+typedef struct osal_spinlock_mcs_node {
+    osal_uint32_t used;                 //!< \brief Node is claimed by a waiter or the owner.
+    osal_uint32_t next;                 //!< \brief Index + 1 of the successor, 0 for none.
+    osal_uint32_t locked;               //!< \brief Set while the waiter has to spin.
+    osal_uint8_t pad[52];               //!< \brief Padding to 64 byte.
+} osal_spinlock_mcs_node_t;             //!< \brief MCS queue node type.
+
+//! \brief MCS queue lock.
+/*!
+ * Nodes are linked by index instead of pointer, so the lock can be placed
+ * in shared memory. Do not access the members directly.
+ */
+typedef struct osal_spinlock_mcs {
+    osal_uint32_t tail;                 //!< \brief Index + 1 of the last queued node, 0 if unlocked.
+    osal_uint32_t owner;                //!< \brief Node of the owner.
+    osal_uint32_t pad[14];              //!< \brief Keep the lock words on their own cache line.
+    osal_spinlock_mcs_node_t nodes[OSAL_SPINLOCK_MCS_NODES];   //!< \brief Queue nodes.
+} osal_spinlock_mcs_t;                  //!< \brief MCS queue lock type.
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -98,6 +139,8 @@ extern "C" {
  * \param[in]   mtx     Pointer to osal spinlock structure. Content is OS dependent.
  * \param[in]   attr    Pointer to initial spinlock attributes. Can be NULL then
  *                      the defaults of the underlying spinlock will be used.
+ *                      On POSIX only the algorithm and
+ *                      \ref OSAL_SPINLOCK_ATTR__PROCESS_SHARED are used.
  *
  * \retval OSAL_OK                          On success.
  * \retval OSAL_ERR_SYSTEM_LIMIT_REACHED    Not enough system resources.
@@ -148,6 +191,44 @@ osal_retval_t osal_spinlock_unlock(osal_spinlock_t *mtx);
  */
 osal_retval_t osal_spinlock_destroy(osal_spinlock_t *mtx);
 
+//! \brief Initialize an MCS queue lock.
+/*!
+ * Only available on POSIX systems.
+ *
+ * \param[in]   mtx     Pointer to osal MCS spinlock structure.
+ *
+ * \retval OSAL_OK                          On success.
+ */
+osal_retval_t osal_spinlock_mcs_init(osal_spinlock_mcs_t *mtx);
+
+//! \brief Locks an MCS queue lock.
+/*!
+ * Waiters get the lock in arrival order. With more than
+ * \ref OSAL_SPINLOCK_MCS_NODES waiters the excess ones wait for a free
+ * queue node first.
+ *
+ * \param[in]   mtx     Pointer to osal MCS spinlock structure.
+ *
+ * \retval OSAL_OK                          On success.
+ */
+osal_retval_t osal_spinlock_mcs_lock(osal_spinlock_mcs_t *mtx);
+
+//! \brief Unlocks an MCS queue lock.
+/*!
+ * \param[in]   mtx     Pointer to osal MCS spinlock structure.
+ *
+ * \retval OSAL_OK                          On success.
+ */
+osal_retval_t osal_spinlock_mcs_unlock(osal_spinlock_mcs_t *mtx);
+
+//! \brief Destroys an MCS queue lock.
+/*!
+ * \param[in]   mtx     Pointer to osal MCS spinlock structure.
+ *
+ * \retval OSAL_OK                          On success.
+ */
+osal_retval_t osal_spinlock_mcs_destroy(osal_spinlock_mcs_t *mtx);
+
 #ifdef __cplusplus
 };
 #endif
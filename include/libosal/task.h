@@ -37,6 +37,7 @@
 #endif
 
 #include <libosal/types.h>
+#include <libosal/cpuset.h>
 
 #ifdef LIBOSAL_BUILD_POSIX
 #include <libosal/posix/task.h>
@@ -68,6 +69,9 @@
 #define OSAL_SCHED_POLICY_FIFO          ((osal_uint32_t)0x00000001u)        //!< \brief Task scheduling policy FIFO.
 #define OSAL_SCHED_POLICY_ROUND_ROBIN   ((osal_uint32_t)0x00000002u)        //!< \brief Task scheduling policy round-robin.
 #define OSAL_SCHED_POLICY_OTHER         ((osal_uint32_t)0x00000003u)        //!< \brief Task scheduling policy other.
+#define OSAL_SCHED_POLICY_DEADLINE      ((osal_uint32_t)0x00000004u)        //!< \brief Task scheduling policy earliest deadline first.
+#define OSAL_SCHED_POLICY_BATCH         ((osal_uint32_t)0x00000005u)        //!< \brief Task scheduling policy batch, for CPU intensive background work.
+#define OSAL_SCHED_POLICY_IDLE          ((osal_uint32_t)0x00000006u)        //!< \brief Task scheduling policy idle, runs only if nothing else does.
 
 #define TASK_NAME_LEN   64u                             //!< \brief Task maximum name length.
 
@@ -79,7 +83,15 @@ typedef struct osal_task_attr {
     osal_char_t task_name[TASK_NAME_LEN];               //!< \brief Task name.
     osal_task_sched_policy_t   policy;                  //!< \brief Task policy.
     osal_task_sched_priority_t priority;                //!< \brief Task priority.
-    osal_task_sched_affinity_t affinity;                //!< \brief Task affinity.
+    osal_task_sched_affinity_t affinity;                //!< \brief Task affinity, CPUs 0 to 31. Overrides \p cpuset if not 0 and \p cpuset has no CPU from 32 on.
+    osal_uint64_t runtime;                              //!< \brief Deadline policy: runtime per period in [ns].
+    osal_uint64_t deadline;                             //!< \brief Deadline policy: relative deadline in [ns], 0 for period.
+    osal_uint64_t period;                               //!< \brief Deadline policy: period in [ns], 0 for deadline.
+    osal_cpuset_t cpuset;                               //!< \brief Task affinity, used if \p affinity is 0 and set is not empty.
+    osal_size_t stack_size;                             //!< \brief Stack size in [bytes], 0 for system default.
+    osal_size_t guard_size;                             //!< \brief Stack guard size in [bytes], 0 for system default.
+    osal_size_t stack_prefault;                         //!< \brief Stack in [bytes] touched before the handler runs, 0 for none. Clamped to the available stack, ignored where the stack cannot be determined (non-glibc).
+    osal_uint64_t timer_slack;                          //!< \brief Timer slack in [ns], 0 to keep the inherited one.
 } osal_task_attr_t;                                     //!< \brief Task attribute type.
 
 typedef void *(*osal_task_handler_t)(void *arg);        //!< \brief Task handler function template.
@@ -93,12 +105,36 @@ typedef osal_uint32_t osal_task_state_t;                //!< \brief Task state t
 #define OSAL_STATE_THREAD_INACTIVE      (2u)            //!< \brief The thread is in an inactive state
 #define OSAL_STATE_THREAD_BLOCKED       (3u)            //!< \brief The thread is in a blocked state
 
+//! \brief Task runtime statistics.
+/*!
+ * All counters are totals since the task was started.
+ */
+typedef struct osal_task_stats {
+    osal_uint64_t cpu_time;                             //!< \brief CPU time consumed in [ns].
+    osal_uint64_t voluntary_switches;                   //!< \brief Context switches because the task blocked.
+    osal_uint64_t involuntary_switches;                 //!< \brief Context switches because the task was preempted.
+    osal_uint64_t minor_faults;                         //!< \brief Page faults served without I/O.
+    osal_uint64_t major_faults;                         //!< \brief Page faults which needed I/O.
+    osal_int32_t  cpu;                                  //!< \brief CPU the task last ran on, -1 if unknown.
+} osal_task_stats_t;                                    //!< \brief Task runtime statistics type.
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 //! \brief Create a task.
 /*!
+ * The scheduling attributes are in effect before \p handler is called.
+ * Where possible they are set before the task is started, so it never runs
+ * on the wrong CPU or with the wrong priority. The task is started even if
+ * they cannot be applied, use \ref osal_task_get_sched_status to check the
+ * result. Returns as soon as the task has started.
+ *
+ * Stack and guard size are fixed at creation, an invalid size fails with
+ * \ref OSAL_ERR_INVALID_PARAM. Timer slack and stack prefaulting are done by
+ * the new task before \p handler is called, a failing timer slack is also
+ * reported with \ref osal_task_get_sched_status.
+ *
  * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
  * \param[in]   attr    Pointer to initial task attributes. Can be NULL then
  *                      the defaults of the underlying task will be used.
@@ -138,7 +174,9 @@ osal_retval_t osal_task_destroy(osal_task_t *hdl);
 
 //! \brief Get the handle of the calling thread.
 /*!
- * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
+ * The handle may be used with all functions except \ref osal_task_join.
+ *
+ * \param[out]  hdl     Pointer to osal task structure. Content is OS dependent.
  *
  * \retval OSAL_OK                          On success.
  * \retval OSAL_ERR_NOT_IMPLEMENTED         Not implemented.
@@ -160,6 +198,9 @@ osal_retval_t osal_task_set_task_attr(osal_task_t *hdl, osal_task_attr_t *attr);
 
 //! \brief Get the current task attributes of the specified task.
 /*!
+ * The affinity is returned in \p cpuset, \p affinity is set to 0 so the
+ * attributes can be passed to \ref osal_task_set_task_attr unchanged.
+ *
  * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
  * \param[out]  attr    The thread's current attributes.
  *
@@ -172,6 +213,8 @@ osal_retval_t osal_task_get_task_attr(osal_task_t *hdl, osal_task_attr_t *attr);
 
 //! \brief Change the policy of the specified thread.
 /*!
+ * \ref OSAL_SCHED_POLICY_DEADLINE needs a reservation, use \ref osal_task_set_deadline.
+ *
  * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
  *                      If \p hdl is NULL, set policy for calling thread.
  * \param[in]   policy  The thread prio as member of osal_task_sched_policy_t
@@ -198,6 +241,41 @@ osal_retval_t osal_task_set_policy(osal_task_t *hdl,
 osal_retval_t osal_task_get_policy(osal_task_t *hdl,
                                         osal_task_sched_policy_t *policy);
 
+//! \brief Set earliest deadline first scheduling for the specified thread.
+/*!
+ * The kernel reserves \p runtime nanoseconds of CPU time within every
+ * \p period and guarantees it before \p deadline, relative to the period 
+ * start. A reservation is only accepted if the total bandwidth of all
+ * deadline tasks stays within the limit of the system.
+ *
+ * \param[in]   hdl         Pointer to osal task structure. Content is OS dependent.
+ *                          If \p hdl is NULL, set policy for calling thread.
+ * \param[in]   runtime     Runtime per period in [ns].
+ * \param[in]   deadline    Relative deadline in [ns], 0 for \p period.
+ * \param[in]   period      Period in [ns], 0 for \p deadline.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_ADMISSION_DENIED        Reservation exceeds available bandwidth.
+ * \retval OSAL_ERR_PERMISSION_DENIED       Insufficient permission to set policy.
+ * \retval OSAL_ERR_INVALID_PARAM           Invalid input parameter, e.g. \p runtime > \p deadline.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED         Policy not supported.
+ * \retval OSAL_ERR_OPERATION_FAILED        Other errors.
+ */
+osal_retval_t osal_task_set_deadline(osal_task_t *hdl, osal_uint64_t runtime,
+                                        osal_uint64_t deadline, osal_uint64_t period);
+
+//! \brief Get the result of applying the scheduling attributes at task creation.
+/*!
+ * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
+ * \param[out]  status  Returns \ref OSAL_OK if all attributes were applied, otherwise
+ *                      the first error, e.g. \ref OSAL_ERR_ADMISSION_DENIED if a 
+ *                      deadline reservation was rejected.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED         Not implemented.
+ */
+osal_retval_t osal_task_get_sched_status(osal_task_t *hdl, osal_retval_t *status);
+
 //! \brief Change the priority of the specified thread.
 /*!
  * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
@@ -228,6 +306,8 @@ osal_retval_t osal_task_get_priority(osal_task_t *hdl,
 
 //! \brief Change the affinity of the specified thread.
 /*!
+ * Only CPUs 0 to 31, use \ref osal_task_set_cpuset for more CPUs.
+ *
  * \param[in]   hdl         Pointer to osal task structure. Content is OS dependent.
  *                          If \p hdl is NULL, set affinity for calling thread.
  * \param[in]   affinity    The thread affinity as member of osal_task_sched_priority_t
@@ -237,11 +317,13 @@ osal_retval_t osal_task_get_priority(osal_task_t *hdl,
 osal_retval_t osal_task_set_affinity(osal_task_t *hdl, 
                                         osal_task_sched_affinity_t affinity);
 
-//! \brief Change the affinity of the specified thread.
+//! \brief Get the affinity of the specified thread.
 /*!
+ * Only CPUs 0 to 31, use \ref osal_task_get_cpuset for more CPUs.
+ *
  * \param[in]   hdl         Pointer to osal task structure. Content is OS dependent.
- *                          If \p hdl is NULL, set affinity for calling thread.
- * \param[in]   affinity    The thread affinity as member of osal_task_sched_priority_t
+ *                          If \p hdl is NULL, get affinity of calling thread.
+ * \param[out]  affinity    The thread affinity as member of osal_task_sched_priority_t
  *
  * \retval OSAL_OK                          On success.
  * \retval OSAL_ERR_INVALID_PARAM           Invalid input parameter.
@@ -249,6 +331,30 @@ osal_retval_t osal_task_set_affinity(osal_task_t *hdl,
 osal_retval_t osal_task_get_affinity(osal_task_t *hdl, 
                                         osal_task_sched_affinity_t *affinity);
 
+//! \brief Change the affinity of the specified thread to a CPU set.
+/*!
+ * \param[in]   hdl         Pointer to osal task structure. Content is OS dependent.
+ *                          If \p hdl is NULL, set affinity for calling thread.
+ * \param[in]   cpuset      CPUs the thread may run on.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_INVALID_PARAM           Empty set or no CPU of the set available.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED         Not supported on this platform.
+ */
+osal_retval_t osal_task_set_cpuset(osal_task_t *hdl, const osal_cpuset_t *cpuset);
+
+//! \brief Get the affinity of the specified thread as CPU set.
+/*!
+ * \param[in]   hdl         Pointer to osal task structure. Content is OS dependent.
+ *                          If \p hdl is NULL, get affinity of calling thread.
+ * \param[out]  cpuset      CPUs the thread may run on.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_INVALID_PARAM           Invalid input parameter.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED         Not supported on this platform.
+ */
+osal_retval_t osal_task_get_cpuset(osal_task_t *hdl, osal_cpuset_t *cpuset);
+
 //! \brief Suspend a thread from running.
 /*!
  * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
@@ -279,15 +385,36 @@ osal_retval_t osal_task_delete(osal_void_t);
 
 //! \brief Get the current state of a created thread.
 /*!
+ * A running or runnable thread is \ref OSAL_STATE_THREAD_ACTIVE, a thread
+ * waiting for an event is \ref OSAL_STATE_THREAD_BLOCKED and a stopped
+ * thread is \ref OSAL_STATE_THREAD_INACTIVE.
+ *
  * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
  * \param[out]  state   A thread state according to osal_task_State_t
  *
  * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_INVALID_PARAM           Thread does not exist (any more),
+ *                                          \p state is \ref OSAL_STATE_THREAD_UNKNOWN_ID.
  * \retval OSAL_ERR_NOT_IMPLEMENTED         Not implemented.
  */
 osal_retval_t osal_task_get_state(osal_task_t *hdl,
                                      osal_task_state_t *state);
 
+//! \brief Get runtime statistics of a created thread.
+/*!
+ * Cheap enough to be sampled periodically by a supervisor task. Compare
+ * two samples to get rates, e.g. a growing \p involuntary_switches count of
+ * a realtime task means it is preempted by other tasks.
+ *
+ * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
+ * \param[out]  stats   Returns the statistics.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_INVALID_PARAM           Thread does not exist (any more).
+ * \retval OSAL_ERR_NOT_IMPLEMENTED         Not implemented.
+ */
+osal_retval_t osal_task_get_stats(osal_task_t *hdl, osal_task_stats_t *stats);
+
 #ifdef __cplusplus
 };
 #endif
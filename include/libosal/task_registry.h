@@ -0,0 +1,186 @@
+/**
+ * \file task_registry.h
+ *
+ * \author agent <agent@local>
+ *
+ * \date 18 Oct 2026
+ *
+ * \brief OSAL task registry header.
+ *
+ * OSAL task registry include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_TASK_REGISTRY__H
+#define LIBOSAL_TASK_REGISTRY__H
+
+#ifdef HAVE_CONFIG_H
+#include <libosal/config.h>
+#endif
+
+#include <libosal/types.h>
+#include <libosal/cpuset.h>
+#include <libosal/task.h>
+
+/** \defgroup task_registry_group Task registry
+ * Every task created with \ref osal_task_create is recorded together with
+ * the attributes it was created with and whether they could be applied.
+ * Once published, the registry is readable from other processes, e.g. by
+ * the osal-top tool, which compares it with what the kernel reports.
+ *
+ * Publishing can be enabled without code changes by setting the
+ * environment variable \ref OSAL_TASK_REGISTRY_ENV to 1, the registry is
+ * then published when the first task is created.
+ *
+ * Only available on POSIX systems.
+ *
+ * @{
+ */
+
+#define OSAL_TASK_REGISTRY_MAGIC        0x4B534154u             //!< \brief Registry magic ("TASK" on little endian).
+#define OSAL_TASK_REGISTRY_VERSION      1u                      //!< \brief Registry layout version.
+#define OSAL_TASK_REGISTRY_ENTRIES      64u                     //!< \brief Maximum number of registered tasks.
+#define OSAL_TASK_REGISTRY_SHM_PREFIX   "/osal-tasks."          //!< \brief Shared memory name prefix, followed by the process id.
+#define OSAL_TASK_REGISTRY_ENV          "LIBOSAL_TASK_REGISTRY" //!< \brief Environment variable to publish on first task creation.
+
+//! \brief Registered task.
+/*!
+ * Written with a sequence lock: \ref seq is odd while the entry is being
+ * changed. A reader copies the entry and has to retry if \ref seq was odd
+ * or changed during the copy.
+ */
+typedef struct osal_task_registry_entry {
+    osal_uint32_t seq;                          //!< \brief Sequence lock.
+    osal_int32_t ktid;                          //!< \brief Kernel thread id, 0 for an unused entry.
+    osal_char_t name[TASK_NAME_LEN];            //!< \brief Task name.
+    osal_task_sched_policy_t policy;            //!< \brief Requested policy, 0 if inherited.
+    osal_task_sched_priority_t priority;        //!< \brief Requested priority, 0 if inherited.
+    osal_cpuset_t cpuset;                       //!< \brief Requested CPUs, empty if inherited.
+    osal_retval_t sched_status;                 //!< \brief Result of applying the attributes, see \ref osal_task_get_sched_status.
+    osal_uint64_t created;                      //!< \brief Creation time in [ns], \ref osal_timer_gettime_nsec.
+} osal_task_registry_entry_t;                   //!< \brief Registered task type.
+
+//! \brief Task registry.
+/*!
+ * Layout of the shared memory segment named \ref OSAL_TASK_REGISTRY_SHM_PREFIX
+ * followed by the process id, all values in host byte order.
+ */
+typedef struct osal_task_registry {
+    osal_uint32_t magic;                        //!< \brief \ref OSAL_TASK_REGISTRY_MAGIC, set last when initialized.
+    osal_uint32_t version;                      //!< \brief \ref OSAL_TASK_REGISTRY_VERSION.
+    osal_int32_t pid;                           //!< \brief Process id of the owner.
+    osal_uint32_t entries;                      //!< \brief Number of entries.
+    osal_uint32_t dropped;                      //!< \brief Tasks not registered because all entries were used.
+    osal_uint32_t pad[11];                      //!< \brief Keep entries on own cache lines.
+    osal_task_registry_entry_t entry[OSAL_TASK_REGISTRY_ENTRIES];   //!< \brief Registered tasks.
+} osal_task_registry_t;                         //!< \brief Task registry type.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! \brief Publish the task registry of this process.
+/*!
+ * Moves the registry to a shared memory segment named
+ * \ref OSAL_TASK_REGISTRY_SHM_PREFIX followed by the process id. Already
+ * registered tasks are kept. The segment is removed at normal process exit
+ * or with \ref osal_task_registry_unpublish.
+ *
+ * \retval OSAL_OK                      On success or if already published.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Not allowed to create shared memory.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED     Not supported on this platform.
+ * \retval OSAL_ERR_OPERATION_FAILED    Other errors.
+ */
+osal_retval_t osal_task_registry_publish(osal_void_t);
+
+//! \brief Stop publishing the task registry of this process.
+/*!
+ * Moves the registry back to process memory and removes the segment.
+ *
+ * \retval OSAL_OK                      On success or if not published.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED     Not supported on this platform.
+ */
+osal_retval_t osal_task_registry_unpublish(osal_void_t);
+
+//! \brief Register a task.
+/*!
+ * Called by \ref osal_task_create from the new task, the entry is removed
+ * again when the task exits, whether it is joined or not. Can be used to
+ * register threads not created by osal, e.g. the main thread after
+ * \ref osal_task_get_hdl.
+ *
+ * \param[in]   hdl     Pointer to osal task structure.
+ * \param[in]   attr    Attributes the task was created with. Can be NULL.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_SYSTEM_LIMIT_REACHED    All entries are used.
+ */
+osal_retval_t osal_task_registry_add(const osal_task_t *hdl, const osal_task_attr_t *attr);
+
+//! \brief Remove a task from the registry.
+/*!
+ * Called when a task created by \ref osal_task_create exits.
+ *
+ * \param[in]   hdl     Pointer to osal task structure.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_NOT_FOUND               Task is not registered.
+ */
+osal_retval_t osal_task_registry_remove(const osal_task_t *hdl);
+
+//! \brief Attach to the published task registry of a process.
+/*!
+ * \param[in]   pid     Process id.
+ * \param[out]  reg     Returns read-only mapping of the registry.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_NOT_FOUND           Process does not publish a registry.
+ * \retval OSAL_ERR_INVALID_PARAM       Segment is no compatible registry.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED     Not supported on this platform.
+ */
+osal_retval_t osal_task_registry_attach(osal_int32_t pid, const osal_task_registry_t **reg);
+
+//! \brief Detach from a task registry.
+/*!
+ * \param[in]   reg     Registry returned by \ref osal_task_registry_attach.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_registry_detach(const osal_task_registry_t *reg);
+
+//! \brief Read one entry of a task registry consistently.
+/*!
+ * \param[in]   reg     Registry.
+ * \param[in]   idx     Entry index, less than \p reg->entries.
+ * \param[out]  entry   Returns a copy of the entry.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_NO_DATA             Entry is unused.
+ */
+osal_retval_t osal_task_registry_read(const osal_task_registry_t *reg, osal_uint32_t idx,
+        osal_task_registry_entry_t *entry);
+
+#ifdef __cplusplus
+};
+#endif
+
+/** @} */
+
+#endif /* LIBOSAL_TASK_REGISTRY__H */
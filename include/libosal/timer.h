@@ -141,6 +141,53 @@ osal_retval_t osal_sleep_until_nsec(osal_uint64_t nsec);
  */
 osal_retval_t osal_busy_wait_until_nsec(osal_uint64_t nsec);
 
+//! Initial slack of \ref osal_sleep_until_precise in [ns].
+#define OSAL_TIMER_PRECISE_SLACK_DEFAULT    50000u
+//! Minimum slack of \ref osal_sleep_until_precise in [ns].
+#define OSAL_TIMER_PRECISE_SLACK_MIN        2000u
+//! Maximum slack of \ref osal_sleep_until_precise in [ns].
+#define OSAL_TIMER_PRECISE_SLACK_MAX        5000000u
+
+//! \brief Calibration state of \ref osal_sleep_until_precise.
+typedef struct osal_timer_precise_stats {
+    osal_uint64_t slack;                //!< \brief Current slack in [ns].
+    osal_uint64_t cnt;                  //!< \brief Number of calls.
+    osal_uint64_t late;                 //!< \brief Number of wakeups after the deadline.
+} osal_timer_precise_stats_t;           //!< \brief Precise sleep statistics type.
+
+//! Sleep, then busy-wait until current time equals nsec value
+/*!
+ * This function sleeps until a slack margin before \p nsec and busy-waits
+ * the rest of the time with \ref osal_cpu_relax. The margin adapts per
+ * calling thread from a histogram of the observed sleep wakeup latencies,
+ * it covers their 99.9th percentile. Wakeups later than \p nsec are counted
+ * and raise the margin immediately. Only available on POSIX systems.
+ *
+ * \param[in]   nsec   Absolute time in [ns].
+ *
+ * \retval OSAL_OK                      On success, also if \p nsec is in the past.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid timer value.
+ * \retval OSAL_ERR_OPERATION_FAILED    Any other error.
+ */
+osal_retval_t osal_sleep_until_precise(osal_uint64_t nsec);
+
+//! Get calibration state of \ref osal_sleep_until_precise for calling thread.
+/*!
+ * Only available on POSIX systems.
+ *
+ * \param[out]  stats   Returns current slack and counters.
+ */
+void osal_timer_precise_get_stats(osal_timer_precise_stats_t *stats);
+
+//! Reset calibration of \ref osal_sleep_until_precise for calling thread.
+/*!
+ * Clears the histogram and counters of the calling thread. Only available
+ * on POSIX systems.
+ *
+ * \param[in]   slack   New start slack in [ns], 0 selects \ref OSAL_TIMER_PRECISE_SLACK_DEFAULT.
+ */
+void osal_timer_precise_reset(osal_uint64_t slack);
+
 //! Globally sets the internal clock source used by the timer functions.
 /*!
  *
@@ -156,6 +203,44 @@ void osal_timer_set_clock_source(int clock_id);
  */
 int osal_timer_get_clock_source(void);
 
+//! Default calibration period of \ref osal_timer_tsc_enable in [ns].
+#define OSAL_TIMER_TSC_CALIBRATION_DEFAULT  100000000u
+
+//! Enables the CPU timestamp counter as fast time source.
+/*!
+ * This function switches \ref osal_timer_gettime_nsec (and thereby
+ * \ref osal_trace_point) from clock_gettime to the CPU timestamp counter
+ * (rdtscp on x86-64, cntvct_el0 on aarch64). The counter rate is calibrated
+ * against CLOCK_MONOTONIC for \p calibration_time, the returned time
+ * keeps the time base of the configured clock source.
+ *
+ * On x86-64 the TSC is only used if it is invariant and the kernel also
+ * uses it as clocksource. Otherwise the timer functions stay on
+ * clock_gettime. Call this once during startup before realtime tasks
+ * are running. The realtime clock is not followed when it is stepped
+ * afterwards, prefer LIBOSAL_CLOCK_MONOTONIC as clock source.
+ *
+ * \param[in] calibration_time  Calibration period in [ns], 0 selects
+ *                              \ref OSAL_TIMER_TSC_CALIBRATION_DEFAULT.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_UNAVAILABLE     Timestamp counter is not invariant or calibration failed.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED Not supported on this architecture or platform.
+ */
+osal_retval_t osal_timer_tsc_enable(osal_uint64_t calibration_time);
+
+//! Disables the CPU timestamp counter as time source.
+/*!
+ * Falls back to clock_gettime for \ref osal_timer_gettime_nsec.
+ */
+void osal_timer_tsc_disable(void);
+
+//! Returns the calibrated timestamp counter frequency.
+/*!
+ * \return Counter frequency in [Hz] or 0 if the timestamp counter is not in use.
+ */
+osal_uint64_t osal_timer_tsc_get_frequency(void);
+
 //! Gets filled timer struct with current time.
 /*!
  * This function fills given \p timer structure with current time.
@@ -170,7 +255,8 @@ osal_retval_t osal_timer_gettime(osal_timer_t *timer);
 
 //! Gets time in nanoseconds.
 /*!
- * This function returns current system time in nanoseconds.
+ * This function returns current system time in nanoseconds. If enabled by
+ * \ref osal_timer_tsc_enable the time is derived from the CPU timestamp counter.
  *
  * \return              Current timer in nanosecond.
  */
@@ -0,0 +1,174 @@
+/**
+ * \file timer_service.h
+ *
+ * \author agent <agent@local>
+ *
+ * \date 17 Oct 2026
+ *
+ * \brief OSAL timer service header.
+ *
+ * OSAL software timer service include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_TIMER_SERVICE__H
+#define LIBOSAL_TIMER_SERVICE__H
+
+#ifdef HAVE_CONFIG_H
+#include <libosal/config.h>
+#endif
+
+#include <libosal/types.h>
+#include <libosal/osal.h>
+#include <libosal/queue.h>
+
+/** \defgroup timer_service_group Timer service
+ * This module implements software timers on a hierarchical timing wheel.
+ * Arming and cancelling a timer is O(1), the work per tick is constant
+ * regardless of the number of armed timers. All callbacks of a service
+ * are dispatched on one task, timers expiring in the same tick are
+ * dispatched as one batch.
+ *
+ * @{
+ */
+
+#define OSAL_TIMER_SERVICE_WHEEL_BITS   8u                                      //!< \brief log2 of slots per wheel level.
+#define OSAL_TIMER_SERVICE_WHEEL_SIZE   (1u << OSAL_TIMER_SERVICE_WHEEL_BITS)   //!< \brief Slots per wheel level.
+#define OSAL_TIMER_SERVICE_LEVELS       4u                                      //!< \brief Wheel levels.
+#define OSAL_TIMER_SERVICE_TICK_DEFAULT 1000000u                                //!< \brief Default tick period in [ns].
+
+typedef void (*osal_timer_service_cb_t)(osal_void_t *arg);  //!< \brief Timer callback.
+
+//! \brief Software timer.
+/*!
+ * Owned by the caller and linked into the wheel while armed, arming needs
+ * no allocation. Do not access the members directly.
+ */
+typedef struct osal_timer_service_timer {
+    LIST_ENTRY(osal_timer_service_timer) entry; //!< \brief Wheel slot linkage.
+    osal_uint64_t expire;                       //!< \brief Expiry tick.
+    osal_uint64_t period;                       //!< \brief Period in ticks, 0 for one-shot.
+    osal_uint32_t armed;                        //!< \brief Linked into the service.
+    osal_uint32_t gen;                          //!< \brief Incremented by arm and cancel.
+    osal_timer_service_cb_t cb;                 //!< \brief Callback.
+    osal_void_t *arg;                           //!< \brief Callback argument.
+} osal_timer_service_timer_t;                   //!< \brief Software timer type.
+
+LIST_HEAD(osal_timer_service_slot, osal_timer_service_timer);   //!< \brief Wheel slot.
+
+//! \brief Timer service attributes.
+typedef struct osal_timer_service_attr {
+    osal_uint64_t tick;                 //!< \brief Tick period in [ns], 0 for \ref OSAL_TIMER_SERVICE_TICK_DEFAULT.
+    osal_task_attr_t task_attr;         //!< \brief Attributes of the dispatching task.
+} osal_timer_service_attr_t;            //!< \brief Timer service attributes type.
+
+//! \brief Timer service.
+typedef struct osal_timer_service {
+    osal_uint64_t tick;                 //!< \brief Tick period in [ns].
+    osal_uint64_t start;                //!< \brief Time of tick 0 in [ns].
+    osal_uint64_t now;                  //!< \brief Next tick to process.
+    osal_uint32_t stop;                 //!< \brief Request dispatching task to exit.
+    osal_uint32_t armed_cnt;            //!< \brief Number of armed timers.
+
+    osal_mutex_t lock;                  //!< \brief Protects wheel and timers.
+    osal_task_t task;                   //!< \brief Dispatching task.
+
+    struct osal_timer_service_slot wheel[OSAL_TIMER_SERVICE_LEVELS][OSAL_TIMER_SERVICE_WHEEL_SIZE];
+} osal_timer_service_t;                 //!< \brief Timer service type.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! \brief Initialize timer service.
+/*!
+ * Initializes the timing wheel and starts the dispatching task.
+ *
+ * \param[out]  svc     Pointer to timer service.
+ * \param[in]   attr    Pointer to service attributes. Can be NULL.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid attributes.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Not allowed to create task with given attributes.
+ * \retval OSAL_ERR_OPERATION_FAILED    Task or mutex could not be created.
+ */
+osal_retval_t osal_timer_service_init(osal_timer_service_t *svc, const osal_timer_service_attr_t *attr);
+
+//! \brief Destroy timer service.
+/*!
+ * Stops and joins the dispatching task, this may take up to one tick.
+ * Timers still armed are dropped without callback.
+ *
+ * \param[in]   svc     Pointer to timer service.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_timer_service_destroy(osal_timer_service_t *svc);
+
+//! \brief Initialize software timer.
+/*!
+ * The callback of a one-shot timer may free or reuse its timer. A periodic
+ * timer must not be freed from its own callback, even after cancelling it,
+ * because the service checks it again when the callback returns.
+ *
+ * \param[out]  tmr     Pointer to timer.
+ * \param[in]   cb      Callback called on the dispatching task on expiry.
+ * \param[in]   arg     Callback argument.
+ */
+void osal_timer_service_timer_init(osal_timer_service_timer_t *tmr, osal_timer_service_cb_t cb, osal_void_t *arg);
+
+//! \brief Arm software timer.
+/*!
+ * Arms \p tmr to expire after \p timeout, re-arms it if it is already armed.
+ * The timer never expires early, it expires at the first tick at or after
+ * the timeout. Periodic timers are re-armed before the tick their next expiry
+ * falls into. May be called from timer callbacks.
+ *
+ * \param[in]   svc         Pointer to timer service.
+ * \param[in]   tmr         Pointer to timer.
+ * \param[in]   timeout     Relative timeout in [ns].
+ * \param[in]   period      Period in [ns] rounded up to ticks, 0 for one-shot.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_timer_service_arm(osal_timer_service_t *svc, osal_timer_service_timer_t *tmr,
+        osal_uint64_t timeout, osal_uint64_t period);
+
+//! \brief Cancel software timer.
+/*!
+ * Does not wait for a callback which is already running. May be called
+ * from timer callbacks.
+ *
+ * \param[in]   svc     Pointer to timer service.
+ * \param[in]   tmr     Pointer to timer.
+ *
+ * \retval OSAL_OK                  Timer was armed and will not expire.
+ * \retval OSAL_ERR_NOT_FOUND       Timer was not armed.
+ */
+osal_retval_t osal_timer_service_cancel(osal_timer_service_t *svc, osal_timer_service_timer_t *tmr);
+
+#ifdef __cplusplus
+};
+#endif
+
+/** @} */
+
+#endif /* LIBOSAL_TIMER_SERVICE__H */
+
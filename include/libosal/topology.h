@@ -0,0 +1,215 @@
+/**
+ * \file topology.h
+ *
+ * \author agent <agent@local>
+ *
+ * \date 18 Oct 2026
+ *
+ * \brief OSAL CPU topology header.
+ *
+ * OSAL CPU topology include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_TOPOLOGY__H
+#define LIBOSAL_TOPOLOGY__H
+
+#ifdef HAVE_CONFIG_H
+#include <libosal/config.h>
+#endif
+
+#include <libosal/types.h>
+#include <libosal/cpuset.h>
+
+/** \defgroup topology_group CPU topology
+ * SMT siblings, shared caches, NUMA nodes and isolated CPUs as reported by
+ * sysfs, and helpers to choose CPUs for realtime tasks, e.g. an isolated CPU
+ * whose SMT sibling is not used by another busy task.
+ *
+ * Only available on Linux.
+ *
+ * @{
+ */
+
+#define OSAL_TOPOLOGY_SYSFS_ROOT        "/sys"      //!< \brief Default sysfs mount point.
+
+#define OSAL_TOPOLOGY_CACHE_DATA        0x01u       //!< \brief Data cache.
+#define OSAL_TOPOLOGY_CACHE_INSTRUCTION 0x02u       //!< \brief Instruction cache.
+#define OSAL_TOPOLOGY_CACHE_UNIFIED     0x03u       //!< \brief Unified cache.
+
+#define OSAL_TOPOLOGY_PLACE__ISOLATED   0x01u       //!< \brief Only CPUs excluded from scheduler balancing (isolcpus).
+#define OSAL_TOPOLOGY_PLACE__NOHZ_FULL  0x02u       //!< \brief Only CPUs without scheduler tick (nohz_full).
+#define OSAL_TOPOLOGY_PLACE__IDLE_SMT   0x04u       //!< \brief No SMT sibling may be busy, siblings also have to satisfy the isolation flags.
+
+//! \brief CPU of the topology.
+typedef struct osal_topology_cpu {
+    osal_bool_t online;                 //!< \brief CPU is online, all other members are only valid if set.
+    osal_int32_t core_id;               //!< \brief Core id within the package.
+    osal_int32_t package_id;            //!< \brief Physical package (socket) id.
+    osal_int32_t node;                  //!< \brief NUMA node, -1 if unknown.
+    osal_cpuset_t siblings;             //!< \brief SMT siblings including the CPU itself.
+} osal_topology_cpu_t;                  //!< \brief Topology CPU type.
+
+//! \brief Cache of the topology.
+typedef struct osal_topology_cache {
+    osal_uint32_t level;                //!< \brief Cache level, 1 for L1.
+    osal_uint32_t type;                 //!< \brief OSAL_TOPOLOGY_CACHE_* type.
+    osal_uint64_t size;                 //!< \brief Size in [byte], 0 if unknown.
+    osal_cpuset_t cpus;                 //!< \brief CPUs sharing the cache.
+} osal_topology_cache_t;                //!< \brief Topology cache type.
+
+//! \brief NUMA node of the topology.
+typedef struct osal_topology_node {
+    osal_int32_t id;                    //!< \brief Node id.
+    osal_cpuset_t cpus;                 //!< \brief CPUs of the node.
+} osal_topology_node_t;                 //!< \brief Topology node type.
+
+//! \brief CPU topology.
+typedef struct osal_topology {
+    osal_cpuset_t possible;             //!< \brief CPUs that may ever be online.
+    osal_cpuset_t online;               //!< \brief Online CPUs.
+    osal_cpuset_t isolated;             //!< \brief CPUs isolated from scheduler balancing (isolcpus).
+    osal_cpuset_t nohz_full;            //!< \brief CPUs running without scheduler tick (nohz_full).
+
+    osal_uint32_t cpu_cnt;              //!< \brief Number of entries in \ref cpus, highest possible CPU + 1.
+    osal_topology_cpu_t *cpus;          //!< \brief CPUs, indexed by CPU number.
+
+    osal_uint32_t cache_cnt;            //!< \brief Number of entries in \ref caches.
+    osal_topology_cache_t *caches;      //!< \brief Distinct caches of all online CPUs.
+
+    osal_uint32_t node_cnt;             //!< \brief Number of entries in \ref nodes.
+    osal_topology_node_t *nodes;        //!< \brief NUMA nodes, empty without NUMA support.
+} osal_topology_t;                      //!< \brief CPU topology type.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! \brief Parse a CPU list.
+/*!
+ * Parses the list format used by sysfs and the kernel command line, e.g.
+ * "0-3,8,10-11". An empty list results in an empty set.
+ *
+ * \param[in]   str     String to parse, trailing whitespace is ignored.
+ * \param[out]  set     Returns parsed CPUs.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   Malformed list or CPU out of range.
+ */
+osal_retval_t osal_topology_parse_cpulist(const osal_char_t *str, osal_cpuset_t *set);
+
+//! \brief Read the CPU topology.
+/*!
+ * Parses devices/system/cpu and devices/system/node below \p sysfs_root.
+ * The topology is a snapshot, CPUs going on- or offline later are not
+ * reflected.
+ *
+ * \param[out]  topo        Pointer to topology structure.
+ * \param[in]   sysfs_root  Sysfs mount point, NULL for \ref OSAL_TOPOLOGY_SYSFS_ROOT.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_NOT_FOUND           No CPUs found below \p sysfs_root.
+ * \retval OSAL_ERR_OUT_OF_MEMORY       Topology could not be allocated.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED     Not supported on this platform.
+ */
+osal_retval_t osal_topology_init(osal_topology_t *topo, const osal_char_t *sysfs_root);
+
+//! \brief Release the CPU topology.
+/*!
+ * \param[in]   topo    Pointer to topology structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_topology_destroy(osal_topology_t *topo);
+
+//! \brief Get the SMT siblings of a CPU.
+/*!
+ * \param[in]   topo    Pointer to topology structure.
+ * \param[in]   cpu     CPU number.
+ * \param[out]  set     Returns the siblings including \p cpu.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_NOT_FOUND       \p cpu is not online.
+ */
+osal_retval_t osal_topology_get_siblings(const osal_topology_t *topo, osal_uint32_t cpu, osal_cpuset_t *set);
+
+//! \brief Get the CPUs sharing a cache with a CPU.
+/*!
+ * Instruction caches are ignored, e.g. level 3 returns all CPUs sharing
+ * the L3 with \p cpu.
+ *
+ * \param[in]   topo    Pointer to topology structure.
+ * \param[in]   cpu     CPU number.
+ * \param[in]   level   Cache level.
+ * \param[out]  set     Returns the CPUs including \p cpu.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_NOT_FOUND       \p cpu has no data or unified cache on \p level.
+ */
+osal_retval_t osal_topology_get_cache_cpus(const osal_topology_t *topo, osal_uint32_t cpu,
+        osal_uint32_t level, osal_cpuset_t *set);
+
+//! \brief Get the CPUs of the NUMA node of a CPU.
+/*!
+ * \param[in]   topo    Pointer to topology structure.
+ * \param[in]   cpu     CPU number.
+ * \param[out]  set     Returns the CPUs including \p cpu.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_NOT_FOUND       Node of \p cpu is unknown.
+ */
+osal_retval_t osal_topology_get_node_cpus(const osal_topology_t *topo, osal_uint32_t cpu, osal_cpuset_t *set);
+
+//! \brief Choose a CPU for a task.
+/*!
+ * Returns the lowest online CPU in \p candidates which is not in \p busy
+ * and satisfies all \p flags. With \ref OSAL_TOPOLOGY_PLACE__IDLE_SMT a
+ * CPU is only chosen if none of its SMT siblings is in \p busy, so a
+ * realtime task does not share a core with another noisy task. Together
+ * with \ref OSAL_TOPOLOGY_PLACE__ISOLATED or \ref OSAL_TOPOLOGY_PLACE__NOHZ_FULL
+ * the siblings also have to be isolated, otherwise the scheduler is free
+ * to run any task on them.
+ *
+ * \code
+ * // isolated CPU near CPU 2 whose hyperthread is not used by tasks on busy
+ * osal_cpuset_t l3;
+ * osal_topology_get_cache_cpus(&topo, 2, 3, &l3);
+ * osal_topology_place(&topo, OSAL_TOPOLOGY_PLACE__ISOLATED | OSAL_TOPOLOGY_PLACE__IDLE_SMT, &l3, &busy, &cpu);
+ * \endcode
+ *
+ * \param[in]   topo        Pointer to topology structure.
+ * \param[in]   flags       OSAL_TOPOLOGY_PLACE__* flags.
+ * \param[in]   candidates  CPUs to choose from, NULL for all online CPUs.
+ * \param[in]   busy        CPUs already used, NULL for none.
+ * \param[out]  cpu         Returns the chosen CPU.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_NOT_FOUND       No CPU satisfies the request.
+ */
+osal_retval_t osal_topology_place(const osal_topology_t *topo, osal_uint32_t flags,
+        const osal_cpuset_t *candidates, const osal_cpuset_t *busy, osal_uint32_t *cpu);
+
+#ifdef __cplusplus
+};
+#endif
+
+/** @} */
+
+#endif /* LIBOSAL_TOPOLOGY__H */
@@ -39,6 +39,7 @@
 #include <libosal/osal.h>
 #include <libosal/trace.h>
 #include <libosal/timer.h>
+#include <libosal/shm.h>
 
 /** \defgroup trace_group Trace 
  * This module implements timing traces for use in realtime systems. 
@@ -46,13 +47,176 @@
  * @{
  */
 
+#define OSAL_TRACE_ATTR__MODE__MASK             0x0000000Fu     //!< \brief Trace buffer mode mask.
+#define OSAL_TRACE_ATTR__MODE__DOUBLE_BUFFER    0x00000000u     //!< \brief Double buffer mode (default).
+#define OSAL_TRACE_ATTR__MODE__RING             0x00000001u     //!< \brief Lock-free single-producer/single-consumer ring mode.
+#define OSAL_TRACE_ATTR__REL                    0x00000010u     //!< \brief Online analysis (histogram, stats) records traced values instead of intervals.
+//! \brief Former name of \ref OSAL_TRACE_ATTR__REL, kept for existing users.
+#define OSAL_TRACE_ATTR__HIST_REL               OSAL_TRACE_ATTR__REL
+#define OSAL_TRACE_ATTR__STATS                  0x00000020u     //!< \brief Keep streaming statistics of every traced sample.
+#define OSAL_TRACE_ATTR__MEM_LOCK               0x00000040u     //!< \brief Lock and prefault sample buffers in RAM.
+#define OSAL_TRACE_ATTR__MEM_HUGEPAGE           0x00000080u     //!< \brief Back allocated sample buffers with huge pages if available.
+
+#define OSAL_TRACE_HIST_SUB_BUCKET_BITS_DEFAULT 7u              //!< \brief Default histogram precision (1.6% relative error).
+#define OSAL_TRACE_HIST_SUB_BUCKET_BITS_MIN     2u              //!< \brief Minimum histogram precision.
+#define OSAL_TRACE_HIST_SUB_BUCKET_BITS_MAX     16u             //!< \brief Maximum histogram precision.
+
+typedef osal_uint32_t osal_trace_attr_t;                        //!< \brief Trace attribute type.
+
+//! \brief Number of samples of caller storage needed by \ref osal_trace_init.
+#define OSAL_TRACE_STORAGE_CNT(attr, cnt)                                                   \
+    (((((attr) & OSAL_TRACE_ATTR__MODE__MASK) == OSAL_TRACE_ATTR__MODE__RING) ? 3u : 2u) * (cnt))
+
+//! \brief Define a statically allocated trace with \p cnt samples (\p cnt >= 2).
+/*!
+ * Defines trace \p name and its sample storage without any heap allocation,
+ * initialize it with \ref OSAL_TRACE_INIT_STATIC.
+ */
+#define OSAL_TRACE_DEFINE_STATIC(name, attr, cnt)                                           \
+    static osal_trace_t name;                                                               \
+    static osal_uint64_t name##_storage[OSAL_TRACE_STORAGE_CNT((attr), (cnt))];             \
+    static const osal_trace_attr_t name##_attr = (attr);                                    \
+    static const osal_uint32_t name##_cnt = (cnt)
+
+//! \brief Initialize trace defined by \ref OSAL_TRACE_DEFINE_STATIC.
+#define OSAL_TRACE_INIT_STATIC(name)                                                        \
+    osal_trace_init(&(name), &name##_attr, name##_cnt, name##_storage,                      \
+            sizeof(name##_storage) / sizeof(name##_storage[0]))
+
+#define OSAL_TRACE_KERNEL__AUTO                 0u              //!< \brief Best analysis kernel supported by cpu.
+#define OSAL_TRACE_KERNEL__SCALAR               1u              //!< \brief Portable scalar analysis kernel.
+#define OSAL_TRACE_KERNEL__SSE42                2u              //!< \brief x86-64 SSE4.2 analysis kernel.
+#define OSAL_TRACE_KERNEL__AVX2                 3u              //!< \brief x86-64 AVX2 analysis kernel.
+#define OSAL_TRACE_KERNEL__NEON                 4u              //!< \brief AArch64 NEON analysis kernel.
+
+typedef osal_uint32_t osal_trace_kernel_t;                      //!< \brief Trace analysis kernel type.
+
+//! \brief Log-linear (HDR style) histogram.
+/*!
+ * Values below 2^sub_bucket_bits are counted exactly. Above, every power of two 
+ * range is split into 2^(sub_bucket_bits-1) linear sub buckets, so the relative
+ * error of any reported value is below 2^-(sub_bucket_bits-1) over the whole 
+ * 64 bit range.
+ */
+typedef struct osal_trace_hist {
+    osal_uint32_t sub_bucket_bits;      //!< precision, linear sub buckets per power of two.
+    osal_uint32_t bucket_cnt;           //!< number of buckets in \ref counts.
+    osal_uint64_t min_val;              //!< minimum recorded value.
+    osal_uint64_t max_val;              //!< maximum recorded value.
+    osal_uint64_t *counts;              //!< bucket counters.
+} osal_trace_hist_t;                    //!< Trace histogram structure.
+
+#define OSAL_TRACE_SHM_MAGIC                    0x43415254u     //!< \brief Shared memory trace magic ("TRAC" on little endian).
+#define OSAL_TRACE_SHM_VERSION                  1u              //!< \brief Shared memory trace layout version.
+#define OSAL_TRACE_SHM_BUF_OFFSET               64u             //!< \brief Offset of first sample buffer in segment.
+
+//! \brief Shared memory trace header.
+/*!
+ * Layout of a trace exported with \ref osal_trace_alloc_shm, all values in 
+ * host byte order:
+ *
+ *     offset 0                 osal_trace_shm_header_t
+ *     offset buf_offset[0]     cnt x osal_uint64_t, sample buffer 0
+ *     offset buf_offset[1]     cnt x osal_uint64_t, sample buffer 1
+ *
+ * The tracing task fills the buffers alternately, starting with buffer 0, 
+ * and increments \ref seq after completing one. So buffer (seq - 1) % 2 holds 
+ * the newest complete samples while the other one is being written. A reader
+ * copying that buffer has to check that \ref seq is unchanged afterwards,
+ * otherwise the copy may be torn and has to be repeated.
+ */
+typedef struct osal_trace_shm_header {
+    osal_uint32_t magic;                //!< \ref OSAL_TRACE_SHM_MAGIC, set last when initialized.
+    osal_uint32_t version;              //!< \ref OSAL_TRACE_SHM_VERSION.
+    osal_uint32_t cnt;                  //!< samples per buffer.
+    osal_trace_attr_t attr;             //!< trace attributes, e.g. \ref OSAL_TRACE_ATTR__REL.
+    osal_uint64_t buf_offset[2];        //!< byte offset of sample buffers from segment start.
+    osal_uint64_t seq;                  //!< number of completed buffers.
+} osal_trace_shm_header_t;              //!< Shared memory trace header.
+
+//! \brief Streaming trace statistics.
+typedef struct osal_trace_stats {
+    osal_uint64_t cnt;                  //!< number of recorded samples.
+    double mean;                        //!< running mean.
+    double m2;                          //!< running sum of squared deviations from mean (Welford).
+    osal_uint64_t min_val;              //!< minimum sample.
+    osal_uint64_t max_val;              //!< maximum sample.
+} osal_trace_stats_t;                   //!< Trace statistics structure.
+
+//! \brief Snapshot slot of a trace trigger (internal).
+typedef struct osal_trace_trigger_slot {
+    osal_uint64_t seq;                  //!< trigger number of captured snapshot, 0 while written.
+    osal_uint64_t value;                //!< interval (or value) exceeding the threshold.
+    osal_uint32_t cnt;                  //!< valid samples.
+    osal_uint32_t trigger_pos;          //!< index of triggering sample.
+} osal_trace_trigger_slot_t;            //!< Trace trigger slot structure.
+
+//! \brief Latency outlier trigger.
+/*!
+ * Keeps the last \ref pre traced times. When an interval (or value with 
+ * \ref OSAL_TRACE_ATTR__REL) exceeds \ref threshold, those, the triggering time
+ * and the following \ref post times are frozen into one of \ref slot_cnt 
+ * snapshot slots, which are reused round robin.
+ */
+typedef struct osal_trace_trigger {
+    osal_uint64_t threshold;            //!< trigger if interval/value is above.
+    osal_uint32_t pre;                  //!< samples captured before trigger.
+    osal_uint32_t post;                 //!< samples captured after trigger.
+    osal_uint32_t slot_cnt;             //!< number of snapshot slots.
+    osal_uint32_t slot_len;             //!< samples per slot, pre + 1 + post.
+
+    osal_uint64_t *history;             //!< ring of last \ref pre traced times.
+    osal_uint32_t history_pos;          //!< next write position in \ref history.
+    osal_uint32_t history_cnt;          //!< valid times in \ref history.
+    osal_uint32_t post_left;            //!< samples left to capture, 0 if armed.
+
+    osal_uint64_t started;              //!< number of started snapshots, tracing task only.
+    osal_uint64_t completed;            //!< number of completed snapshots.
+    osal_uint64_t read_cnt;             //!< last snapshot read, reader only.
+    osal_binary_semaphore_t sync_sem;   //!< posted when a snapshot is completed.
+
+    osal_trace_trigger_slot_t *slots;   //!< snapshot slot headers.
+    osal_uint64_t *samples;             //!< slot_cnt x slot_len snapshot samples.
+} osal_trace_trigger_t;                 //!< Trace trigger structure.
+
+//! \brief Snapshot read from a trace trigger.
+typedef struct osal_trace_snapshot {
+    osal_uint64_t seq;                  //!< trigger number, starting with 1.
+    osal_uint64_t value;                //!< interval (or value) exceeding the threshold.
+    osal_uint64_t lost;                 //!< snapshots overwritten before they were read.
+    osal_uint32_t cnt;                  //!< valid samples copied to the caller buffer.
+    osal_uint32_t trigger_pos;          //!< index of triggering sample in caller buffer.
+} osal_trace_snapshot_t;                //!< Trace snapshot structure.
+
 typedef struct osal_trace {
     osal_uint32_t cnt;                  //!< number of measurements
     osal_uint32_t act_buf;              //!< actual number of double buffer
     osal_uint32_t pos;                  //!< position in actual buffer.
+    osal_trace_attr_t attr;             //!< trace attributes.
     osal_binary_semaphore_t sync_sem;   //!< sync when buffer is full.
     osal_uint64_t *time_in_ns[2];       //!< time double buffer.
-    osal_uint64_t *tmp;                 //!< calculation buffer.
+    osal_uint32_t storage;              //!< owner of sample buffers (internal).
+
+    osal_trace_hist_t *hist;            //!< attached histogram, may be NULL.
+    osal_trace_trigger_t *trigger;      //!< attached outlier trigger, may be NULL.
+    osal_uint64_t last_time;            //!< previous time for interval recording.
+    osal_uint32_t has_last_time;        //!< \ref last_time is valid.
+
+    osal_uint32_t stats_seq;            //!< stats sequence lock, odd while updating.
+    osal_uint32_t stats_reset;          //!< stats reset requested by reader.
+    osal_trace_stats_t stats;           //!< streaming statistics (stats mode only).
+
+    osal_shm_t shm;                     //!< shared memory segment (shm traces only).
+    osal_trace_shm_header_t *shm_hdr;   //!< mapped segment, NULL for private traces.
+    osal_char_t *shm_name;              //!< segment name to unlink, NULL for readers.
+    osal_uint64_t shm_seen;             //!< last buffer sequence fetched by reader.
+
+    osal_uint64_t ring_size;            //!< ring capacity in samples (ring mode only).
+    osal_uint64_t ring_head;            //!< ring write sequence, written by producer only.
+    osal_uint64_t ring_dropped;         //!< samples dropped by producer because ring was full.
+    osal_uint8_t  ring_pad[40];         //!< keep consumer sequence off the producer cache line.
+    osal_uint64_t ring_tail;            //!< ring read sequence, written by consumer only.
+    osal_uint64_t ring_dropped_seen;    //!< dropped counter already reported to consumer.
 } osal_trace_t;                         //!< Trace structure.
 
 #ifdef __cplusplus
@@ -70,6 +234,104 @@ extern "C" {
  */
 osal_retval_t osal_trace_alloc(osal_trace_t **trace, osal_uint32_t cnt);
 
+//! \brief Allocate trace struct with attributes.
+/*!
+ * In \ref OSAL_TRACE_ATTR__MODE__RING mode the trace keeps a lock-free ring of 
+ * 2 * \p cnt samples. The tracing task is the single producer, one analyzing task 
+ * is the single consumer which has to fetch complete chunks of \p cnt samples with
+ * \ref osal_trace_drain before calling any of the analyze functions. If the
+ * consumer falls behind, new samples are dropped and counted instead of 
+ * overwriting data which may currently be read.
+ *
+ * With \ref OSAL_TRACE_ATTR__STATS set, running statistics of all samples are
+ * kept additionally and can be read at any time with \ref osal_trace_get_stats 
+ * or \ref osal_trace_analyze_stats. If only those are needed, \p cnt may be 0 
+ * in double buffer mode and no sample buffers are allocated at all.
+ *
+ * See \ref osal_trace_init for \ref OSAL_TRACE_ATTR__MEM_LOCK and
+ * \ref OSAL_TRACE_ATTR__MEM_HUGEPAGE.
+ *
+ * \param[out]  trace   Pointer to trace* where allocated trace struct is returned.
+ * \param[in]   attr    Pointer to trace attributes. Can be NULL then the 
+ *                      default double buffer mode is used.
+ * \param[in]   cnt     Number of samples per buffer/chunk.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid mode or sample count.
+ * \retval OSAL_ERR_OUT_OF_MEMORY       System out of memory or memory lock limit reached.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Not allowed to lock memory.
+ */
+osal_retval_t osal_trace_alloc_attr(osal_trace_t **trace, const osal_trace_attr_t *attr, osal_uint32_t cnt);
+
+//! \brief Initialize trace struct in caller provided memory.
+/*!
+ * Same as \ref osal_trace_alloc_attr, but \p trace and optionally the sample
+ * buffers are provided by the caller, e.g. statically allocated with 
+ * \ref OSAL_TRACE_DEFINE_STATIC. Release it with \ref osal_trace_destroy.
+ *
+ * With \ref OSAL_TRACE_ATTR__MEM_LOCK the sample buffers and the trace struct
+ * are locked in RAM and every page is touched once, so the first pass through
+ * the trace does not page-fault. Allocated buffers are taken 
+ * directly from the operating system then, with \ref OSAL_TRACE_ATTR__MEM_HUGEPAGE
+ * preferably from huge pages.
+ *
+ * \param[out]  trace       Pointer to trace struct to initialize.
+ * \param[in]   attr        Pointer to trace attributes. Can be NULL.
+ * \param[in]   cnt         Number of samples per buffer/chunk.
+ * \param[in]   storage     Sample storage, NULL to allocate the sample buffers.
+ * \param[in]   storage_cnt Number of samples in \p storage, at least
+ *                          \ref OSAL_TRACE_STORAGE_CNT.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid mode, sample count or storage too small.
+ * \retval OSAL_ERR_OUT_OF_MEMORY       System out of memory or memory lock limit reached.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Not allowed to lock memory.
+ */
+osal_retval_t osal_trace_init(osal_trace_t *trace, const osal_trace_attr_t *attr, osal_uint32_t cnt,
+        osal_uint64_t *storage, osal_size_t storage_cnt);
+
+//! \brief Allocate trace struct with sample buffers in shared memory.
+/*!
+ * Same as \ref osal_trace_alloc_attr, but header and sample buffers are placed
+ * in a newly created shm segment \p name (see \ref osal_trace_shm_header_t), so 
+ * an external process can attach with \ref osal_trace_attach_shm and analyze 
+ * the samples there. An existing segment with the same name is replaced. The 
+ * segment is unlinked again by \ref osal_trace_free.
+ *
+ * Only double buffer mode is supported. \ref OSAL_TRACE_ATTR__MEM_LOCK locks the
+ * segment in RAM.
+ *
+ * \param[out]  trace   Pointer to trace* where allocated trace struct is returned.
+ * \param[in]   name    Shared memory name, e.g. "/my_trace".
+ * \param[in]   attr    Pointer to trace attributes. Can be NULL.
+ * \param[in]   cnt     Number of samples per buffer.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid mode, name or sample count.
+ * \retval OSAL_ERR_OUT_OF_MEMORY       System out of memory.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Not allowed to create shm or lock memory.
+ */
+osal_retval_t osal_trace_alloc_shm(osal_trace_t **trace, const osal_char_t *name, 
+        const osal_trace_attr_t *attr, osal_uint32_t cnt);
+
+//! \brief Attach read-only to a trace exported in shared memory.
+/*!
+ * The returned trace can only be used with \ref osal_trace_drain, which 
+ * copies the newest complete buffer out of the segment, and the analyze 
+ * functions afterwards. It never writes to the segment. Free it with 
+ * \ref osal_trace_free.
+ *
+ * \param[out]  trace   Pointer to trace* where attached trace struct is returned.
+ * \param[in]   name    Shared memory name passed to \ref osal_trace_alloc_shm.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_NOT_FOUND           No shm with that name.
+ * \retval OSAL_ERR_UNAVAILABLE         Segment not (yet) initialized.
+ * \retval OSAL_ERR_INVALID_PARAM       Segment has unknown layout version.
+ * \retval OSAL_ERR_OUT_OF_MEMORY       System out of memory.
+ */
+osal_retval_t osal_trace_attach_shm(osal_trace_t **trace, const osal_char_t *name);
+
 //! \brief Free trace struct.
 /*!
  * \param[in]   trace   Pointer to trace struct to free.
@@ -78,6 +340,17 @@ osal_retval_t osal_trace_alloc(osal_trace_t **trace, osal_uint32_t cnt);
  */
 void osal_trace_free(osal_trace_t *trace);
 
+//! \brief Destroy trace initialized with \ref osal_trace_init.
+/*!
+ * Releases all resources of the trace except the trace struct itself and
+ * caller provided storage.
+ *
+ * \param[in]   trace   Pointer to trace struct to destroy.
+ *
+ * \return N/A
+ */
+void osal_trace_destroy(osal_trace_t *trace);
+
 //! \brief Trace time.
 /*!
  * \param[in]   trace   Pointer to trace struct.
@@ -113,6 +386,59 @@ osal_uint64_t osal_trace_get_last_time(osal_trace_t *trace);
  */
 osal_retval_t osal_trace_timedwait(osal_trace_t *trace, osal_timer_t *timeout);
 
+//! \brief Sync to trace when buffer is full, with a deadline in nanoseconds.
+/*!
+ * \param[in]   trace       Pointer to trace struct.
+ * \param[in]   deadline_ns Absolute timeout in [ns], see \ref osal_timer_gettime_nsec.
+ *
+ * \retval OSAL_OK          success
+ * \retval OSAL_ERR_TIMEOUT timeout occured
+ */
+osal_retval_t osal_trace_wait_until_ns(osal_trace_t *trace, osal_uint64_t deadline_ns);
+
+//! \brief Sync to trace when buffer is full, waiting at most a time in nanoseconds.
+/*!
+ * \param[in]   trace       Pointer to trace struct.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \retval OSAL_OK          success
+ * \retval OSAL_ERR_TIMEOUT timeout occured
+ */
+osal_retval_t osal_trace_wait_for_ns(osal_trace_t *trace, osal_uint64_t rel_ns);
+
+//! \brief Fetch next complete chunk from a ring mode trace.
+/*!
+ * Copies the oldest complete chunk of \p cnt samples out of the ring into the
+ * analysis buffer and releases it to the producer. Afterwards the analyze functions 
+ * operate on exactly this chunk. As \ref osal_trace_timedwait may combine 
+ * several completed chunks into one wakeup, call this function until it 
+ * returns \ref OSAL_ERR_NO_DATA.
+ *
+ * Only one task may act as consumer of a trace.
+ *
+ * On a trace attached with \ref osal_trace_attach_shm the newest complete
+ * buffer is fetched instead and \p dropped counts the samples of buffers
+ * which were overwritten before the reader got to them.
+ *
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[out]  dropped Optional, returns the number of samples dropped by the
+ *                      producer since the last call. If not zero the drained 
+ *                      chunks are not contiguous in time around the gap.
+ *
+ * \retval OSAL_OK                  A new chunk is ready for analysis.
+ * \retval OSAL_ERR_NO_DATA         No complete chunk available.
+ * \retval OSAL_ERR_INVALID_PARAM   Trace is neither in ring mode nor attached to shm.
+ */
+osal_retval_t osal_trace_drain(osal_trace_t *trace, osal_uint64_t *dropped);
+
+//! \brief Return number of samples dropped in ring mode.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ *
+ * \return total number of samples dropped because the consumer fell behind.
+ */
+osal_uint64_t osal_trace_get_dropped(osal_trace_t *trace);
+
 //! \brief Analyze trace and return average and jitters.
 /*!
  * \param[in]   trace   Pointer to trace struct.
@@ -163,6 +489,264 @@ void osal_trace_analyze_rel(osal_trace_t *trace, osal_uint64_t *avg, osal_uint64
 void osal_trace_analyze_rel_min_max(osal_trace_t *trace, osal_uint64_t *avg, osal_uint64_t *avg_jit, 
         osal_uint64_t *max_jit, osal_uint64_t *min_val, osal_uint64_t *max_val);
 
+//! \brief Select analysis kernel.
+/*!
+ * The analyze functions reduce the sample buffers with a vectorized kernel 
+ * chosen at first use from what the build and cpu support. This forces
+ * a specific one, e.g. for benchmarking. The selection is process wide.
+ *
+ * \param[in]   kernel  Kernel to use, \ref OSAL_TRACE_KERNEL__AUTO for the best available.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       Unknown kernel.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED     Kernel not supported by build or cpu.
+ */
+osal_retval_t osal_trace_set_kernel(osal_trace_kernel_t kernel);
+
+//! \brief Return selected analysis kernel.
+/*!
+ * \return kernel used by the analyze functions.
+ */
+osal_trace_kernel_t osal_trace_get_kernel(void);
+
+//! \brief Get consistent snapshot of streaming statistics.
+/*!
+ * May be called from any task while the trace is running.
+ *
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[out]  stats   Return statistics.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       Trace was not allocated with \ref OSAL_TRACE_ATTR__STATS.
+ */
+osal_retval_t osal_trace_get_stats(osal_trace_t *trace, osal_trace_stats_t *stats);
+
+//! \brief Analyze streaming statistics and return average and jitters.
+/*!
+ * Same results as \ref osal_trace_analyze_min_max (or \ref osal_trace_analyze_rel_min_max
+ * with \ref OSAL_TRACE_ATTR__REL) but over all samples since allocation or the last
+ * \ref osal_trace_reset_stats, in O(1) without touching the sample buffers.
+ *
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[out]  avg     Return average.
+ * \param[out]  avg_jit Return average jitter (std-dev).
+ * \param[out]  max_jit Return maximum jitter (maximum deviation from average).
+ * \param[out]  min_val Return minimum value, may be NULL.
+ * \param[out]  max_val Return maximum value, may be NULL.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_NO_DATA             No samples recorded yet.
+ * \retval OSAL_ERR_INVALID_PARAM       Trace was not allocated with \ref OSAL_TRACE_ATTR__STATS.
+ */
+osal_retval_t osal_trace_analyze_stats(osal_trace_t *trace, osal_uint64_t *avg, osal_uint64_t *avg_jit, 
+        osal_uint64_t *max_jit, osal_uint64_t *min_val, osal_uint64_t *max_val);
+
+//! \brief Reset streaming statistics.
+/*!
+ * May be called from any task, the tracing task clears the statistics
+ * before recording its next sample.
+ *
+ * \param[in]   trace   Pointer to trace struct.
+ *
+ * \return N/A
+ */
+void osal_trace_reset_stats(osal_trace_t *trace);
+
+//! \brief Allocate trace histogram.
+/*!
+ * \param[out]  hist                Pointer to hist* where allocated histogram is returned.
+ * \param[in]   sub_bucket_bits     Precision, 0 selects \ref OSAL_TRACE_HIST_SUB_BUCKET_BITS_DEFAULT.
+ *                                  Memory usage is (66 - bits) * 2^(bits-1) * 8 byte.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       Precision out of range.
+ * \retval OSAL_ERR_OUT_OF_MEMORY       System out of memory.
+ */
+osal_retval_t osal_trace_hist_alloc(osal_trace_hist_t **hist, osal_uint32_t sub_bucket_bits);
+
+//! \brief Free trace histogram.
+/*!
+ * The histogram has to be detached from all traces before.
+ *
+ * \param[in]   hist    Pointer to histogram to free.
+ *
+ * \return N/A
+ */
+void osal_trace_hist_free(osal_trace_hist_t *hist);
+
+//! \brief Clear all counters of trace histogram.
+/*!
+ * \param[in]   hist    Pointer to histogram.
+ *
+ * \return N/A
+ */
+void osal_trace_hist_reset(osal_trace_hist_t *hist);
+
+//! \brief Record value in trace histogram.
+/*!
+ * Constant time, lock-free and safe to call from several tasks concurrently.
+ *
+ * \param[in]   hist    Pointer to histogram.
+ * \param[in]   value   Value to record.
+ *
+ * \return N/A
+ */
+void osal_trace_hist_record(osal_trace_hist_t *hist, osal_uint64_t value);
+
+//! \brief Get value at percentile.
+/*!
+ * \param[in]   hist        Pointer to histogram.
+ * \param[in]   percentile  Percentile in range [0.0, 100.0], e.g. 99.9.
+ *
+ * \return highest value equivalent to the bucket the percentile falls into,
+ *         limited by the recorded maximum. 0 if the histogram is empty.
+ */
+osal_uint64_t osal_trace_hist_get_percentile(osal_trace_hist_t *hist, double percentile);
+
+//! \brief Get number of recorded values.
+/*!
+ * \param[in]   hist    Pointer to histogram.
+ *
+ * \return number of recorded values.
+ */
+osal_uint64_t osal_trace_hist_get_count(osal_trace_hist_t *hist);
+
+//! \brief Get minimum and maximum recorded value.
+/*!
+ * \param[in]   hist    Pointer to histogram.
+ * \param[out]  min_val Return minimum value, 0 if the histogram is empty.
+ * \param[out]  max_val Return maximum value, 0 if the histogram is empty.
+ *
+ * \return N/A
+ */
+void osal_trace_hist_get_min_max(osal_trace_hist_t *hist, osal_uint64_t *min_val, osal_uint64_t *max_val);
+
+//! \brief Add all counts of one histogram to another.
+/*!
+ * \param[in]   dst     Pointer to histogram to add to.
+ * \param[in]   src     Pointer to histogram to add.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       Histograms differ in precision.
+ */
+osal_retval_t osal_trace_hist_merge(osal_trace_hist_t *dst, osal_trace_hist_t *src);
+
+//! \brief Attach histogram to trace.
+/*!
+ * Every time passed to \ref osal_trace_time or \ref osal_trace_point is 
+ * additionally recorded in \p hist. By default the interval to the previous 
+ * time is recorded, with \ref OSAL_TRACE_ATTR__REL set the value itself. 
+ * Unlike the trace buffers the histogram never overflows or drops samples.
+ * 
+ * Several traces may share one histogram. Attaching is not synchronized with
+ * tracing, call it before the trace is used or from the tracing task.
+ *
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[in]   hist    Pointer to histogram, NULL to detach.
+ *
+ * \return N/A
+ */
+void osal_trace_hist_attach(osal_trace_t *trace, osal_trace_hist_t *hist);
+
+//! \brief Allocate latency outlier trigger.
+/*!
+ * \param[out]  trig        Pointer to trigger* where allocated trigger is returned.
+ * \param[in]   threshold   Capture a snapshot if an interval (or value) is above.
+ * \param[in]   pre         Number of samples to capture before the triggering one.
+ * \param[in]   post        Number of samples to capture after the triggering one.
+ * \param[in]   slots       Number of snapshots kept until they are read.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       \p slots is 0.
+ * \retval OSAL_ERR_OUT_OF_MEMORY       System out of memory.
+ */
+osal_retval_t osal_trace_trigger_alloc(osal_trace_trigger_t **trig, osal_uint64_t threshold,
+        osal_uint32_t pre, osal_uint32_t post, osal_uint32_t slots);
+
+//! \brief Free latency outlier trigger.
+/*!
+ * \param[in]   trig    Pointer to trigger, has to be detached from all traces.
+ *
+ * \return N/A
+ */
+void osal_trace_trigger_free(osal_trace_trigger_t *trig);
+
+//! \brief Attach latency outlier trigger to trace.
+/*!
+ * Every time passed to \ref osal_trace_time or \ref osal_trace_point is 
+ * checked against the trigger threshold, by default the interval to the
+ * previous time, with \ref OSAL_TRACE_ATTR__REL set the value itself. On
+ * exceeding it the surrounding samples are captured into a snapshot while
+ * tracing continues normally. Triggers during a running capture are part
+ * of that snapshot and do not start a new one.
+ *
+ * Capturing copies the pre-trigger samples once in the tracing task, no
+ * allocation or locking is done. A trigger must only be attached to one trace.
+ * Attaching is not synchronized with tracing, call it before the trace is used
+ * or from the tracing task.
+ *
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[in]   trig    Pointer to trigger, NULL to detach.
+ *
+ * \return N/A
+ */
+void osal_trace_trigger_attach(osal_trace_t *trace, osal_trace_trigger_t *trig);
+
+//! \brief Change trigger threshold.
+/*!
+ * May be called from any task.
+ *
+ * \param[in]   trig        Pointer to trigger.
+ * \param[in]   threshold   New threshold, UINT64_MAX disarms the trigger.
+ *
+ * \return N/A
+ */
+void osal_trace_trigger_set_threshold(osal_trace_trigger_t *trig, osal_uint64_t threshold);
+
+//! \brief Wait for a completed snapshot.
+/*!
+ * Like \ref osal_trace_timedwait several snapshots may be combined into
+ * one wakeup, call \ref osal_trace_trigger_read until it returns
+ * \ref OSAL_ERR_NO_DATA.
+ *
+ * \param[in]   trig    Pointer to trigger.
+ * \param[in]   timeout Timeout.
+ *
+ * \retval OSAL_OK          snapshot completed
+ * \retval OSAL_ERR_TIMEOUT timeout occured
+ */
+osal_retval_t osal_trace_trigger_timedwait(osal_trace_trigger_t *trig, osal_timer_t *timeout);
+
+//! \brief Wait for a completed snapshot until a deadline in nanoseconds.
+/*!
+ * \param[in]   trig        Pointer to trigger.
+ * \param[in]   deadline_ns Absolute timeout in [ns], see \ref osal_timer_gettime_nsec.
+ *
+ * \retval OSAL_OK          snapshot completed
+ * \retval OSAL_ERR_TIMEOUT timeout occured
+ */
+osal_retval_t osal_trace_trigger_wait_until_ns(osal_trace_trigger_t *trig, osal_uint64_t deadline_ns);
+
+//! \brief Read oldest unread snapshot.
+/*!
+ * Copies the traced times of the oldest completed snapshot which was not 
+ * read yet to \p buf, oldest first, while tracing continues. If the tracing
+ * task reused slots before they were read, the overwritten snapshots are 
+ * skipped and counted in \ref osal_trace_snapshot_t::lost. Only one task
+ * may read snapshots of a trigger.
+ *
+ * \param[in]   trig    Pointer to trigger.
+ * \param[out]  snap    Returns snapshot information.
+ * \param[out]  buf     Buffer receiving the captured times.
+ * \param[in]   buf_cnt Size of \p buf, at least pre + 1 + post samples.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_NO_DATA         No unread snapshot completed.
+ * \retval OSAL_ERR_INVALID_PARAM   \p buf is too small.
+ */
+osal_retval_t osal_trace_trigger_read(osal_trace_trigger_t *trig, osal_trace_snapshot_t *snap,
+        osal_uint64_t *buf, osal_uint32_t buf_cnt);
+
 #ifdef __cplusplus
 };
 #endif
@@ -0,0 +1,581 @@
+/**
+ * \file executor.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 18 Oct 2026
+ *
+ * \brief OSAL executor source.
+ *
+ * OSAL executor source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <libosal/osal.h>
+#include <libosal/cpu.h>
+#include <libosal/executor.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if LIBOSAL_HAVE_UNISTD_H == 1
+#include <unistd.h>
+#endif
+
+//! Steal rounds before an idle worker goes to sleep.
+#define EXECUTOR_SPIN_ROUNDS    64u
+
+#ifdef LIBOSAL_BUILD_POSIX
+//! Worker running on the calling task, NULL if not a worker.
+static __thread osal_executor_worker_t *executor_tls_worker = NULL;
+#endif
+
+//! \brief Get worker running on the calling task, NULL if not a worker.
+static osal_executor_worker_t *executor_self(void) {
+    osal_executor_worker_t *worker = NULL;
+
+#ifdef LIBOSAL_BUILD_POSIX
+    worker = executor_tls_worker;
+#endif
+
+    return worker;
+}
+
+//! \brief Set worker running on the calling task.
+static void executor_set_self(osal_executor_worker_t *worker) {
+#ifdef LIBOSAL_BUILD_POSIX
+    executor_tls_worker = worker;
+#else
+    // no thread local storage, workers are treated like other tasks
+    (void)worker;
+#endif
+}
+
+//! \brief Push job to bottom of own deque, returns 0 if full.
+static int executor_deque_push(osal_executor_deque_t *dq, osal_executor_job_t *job) {
+    osal_int64_t b = __atomic_load_n(&dq->bottom, __ATOMIC_RELAXED);
+    osal_int64_t t = __atomic_load_n(&dq->top, __ATOMIC_ACQUIRE);
+    int ret = 0;
+
+    if ((b - t) <= dq->mask) {
+        __atomic_store_n(&dq->jobs[b & dq->mask], job, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        __atomic_store_n(&dq->bottom, b + 1, __ATOMIC_RELAXED);
+        ret = 1;
+    }
+
+    return ret;
+}
+
+//! \brief Pop job from bottom of own deque.
+static osal_executor_job_t *executor_deque_pop(osal_executor_deque_t *dq) {
+    osal_int64_t b = __atomic_load_n(&dq->bottom, __ATOMIC_RELAXED) - 1;
+    osal_executor_job_t *job = NULL;
+
+    __atomic_store_n(&dq->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    osal_int64_t t = __atomic_load_n(&dq->top, __ATOMIC_RELAXED);
+
+    if (t <= b) {
+        job = __atomic_load_n(&dq->jobs[b & dq->mask], __ATOMIC_RELAXED);
+
+        if (t == b) {
+            // last job, race against thieves
+            if (!__atomic_compare_exchange_n(&dq->top, &t, t + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+                job = NULL;
+            }
+
+            __atomic_store_n(&dq->bottom, b + 1, __ATOMIC_RELAXED);
+        }
+    } else {
+        __atomic_store_n(&dq->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+
+    return job;
+}
+
+//! \brief Steal job from top of another deque.
+static osal_executor_job_t *executor_deque_steal(osal_executor_deque_t *dq) {
+    osal_int64_t t = __atomic_load_n(&dq->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    osal_int64_t b = __atomic_load_n(&dq->bottom, __ATOMIC_ACQUIRE);
+    osal_executor_job_t *job = NULL;
+
+    if (t < b) {
+        job = __atomic_load_n(&dq->jobs[t & dq->mask], __ATOMIC_RELAXED);
+
+        if (!__atomic_compare_exchange_n(&dq->top, &t, t + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            // lost against owner or other thief
+            job = NULL;
+        }
+    }
+
+    return job;
+}
+
+//! \brief Take job from injection queue.
+static osal_executor_job_t *executor_inject_pop(osal_executor_t *exec) {
+    osal_executor_job_t *job = NULL;
+
+    if (__atomic_load_n(&exec->inject_cnt, __ATOMIC_RELAXED) != 0u) {
+        osal_mutex_lock(&exec->lock);
+
+        job = exec->inject_head;
+        if (job != NULL) {
+            exec->inject_head = job->next;
+            if (exec->inject_head == NULL) {
+                exec->inject_tail = NULL;
+            }
+
+            __atomic_store_n(&exec->inject_cnt, exec->inject_cnt - 1u, __ATOMIC_RELAXED);
+        }
+
+        osal_mutex_unlock(&exec->lock);
+    }
+
+    return job;
+}
+
+//! \brief Find next job for worker: own deque, injection queue, other deques.
+static osal_executor_job_t *executor_find_job(osal_executor_worker_t *worker) {
+    osal_executor_t *exec = worker->exec;
+    osal_executor_job_t *job = executor_deque_pop(&worker->deque);
+
+    if (job == NULL) {
+        job = executor_inject_pop(exec);
+    }
+
+    if ((job == NULL) && (exec->worker_cnt > 1u)) {
+        // xorshift, start at random victim to spread thieves
+        worker->seed ^= worker->seed << 13u;
+        worker->seed ^= worker->seed >> 17u;
+        worker->seed ^= worker->seed << 5u;
+
+        osal_uint32_t start = worker->seed % exec->worker_cnt;
+
+        for (osal_uint32_t i = 0u; (i < exec->worker_cnt) && (job == NULL); ++i) {
+            osal_executor_worker_t *victim = &exec->workers[(start + i) % exec->worker_cnt];
+
+            if (victim != worker) {
+                job = executor_deque_steal(&victim->deque);
+            }
+        }
+    }
+
+    return job;
+}
+
+//! \brief Check for queued jobs without taking them.
+static int executor_has_job(osal_executor_t *exec) {
+    int ret = __atomic_load_n(&exec->inject_cnt, __ATOMIC_RELAXED) != 0u;
+
+    for (osal_uint32_t i = 0u; (i < exec->worker_cnt) && (ret == 0); ++i) {
+        osal_executor_deque_t *dq = &exec->workers[i].deque;
+
+        ret = __atomic_load_n(&dq->bottom, __ATOMIC_RELAXED) > __atomic_load_n(&dq->top, __ATOMIC_RELAXED);
+    }
+
+    return ret;
+}
+
+//! \brief Wake one sleeping worker if there is any.
+static void executor_wake(osal_executor_t *exec) {
+    // pairs with the sleepers increment before the last check for jobs
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&exec->sleepers, __ATOMIC_RELAXED) != 0u) {
+        osal_mutex_lock(&exec->lock);
+        osal_condvar_signal(&exec->cond);
+        osal_mutex_unlock(&exec->lock);
+    }
+}
+
+//! \brief Mark one job of wait group as finished.
+static void executor_wg_done(osal_executor_wg_t *wg) {
+    osal_uint32_t cnt = __atomic_load_n(&wg->pending, __ATOMIC_RELAXED);
+    int done = 0;
+
+    while (done == 0) {
+        if (cnt == 1u) {
+            // last job, waiters check pending under the lock only
+            osal_mutex_lock(&wg->lock);
+            if (__atomic_sub_fetch(&wg->pending, 1u, __ATOMIC_ACQ_REL) == 0u) {
+                osal_condvar_broadcast(&wg->cond);
+            }
+            osal_mutex_unlock(&wg->lock);
+            done = 1;
+        } else if (__atomic_compare_exchange_n(&wg->pending, &cnt, cnt - 1u, 0,
+                    __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            done = 1;
+        }
+    }
+}
+
+//! \brief Run job and notify its wait group.
+static void executor_run(osal_executor_job_t *job) {
+    // job may be reused once the function returned
+    osal_executor_wg_t *wg = job->wg;
+
+    job->func(job->arg);
+
+    if (wg != NULL) {
+        executor_wg_done(wg);
+    }
+}
+
+//! \brief Worker task.
+static osal_void_t *executor_worker_task(osal_void_t *arg) {
+    osal_executor_worker_t *worker = (osal_executor_worker_t *)arg;
+    osal_executor_t *exec = worker->exec;
+    osal_uint32_t idle = 0u;
+
+    executor_set_self(worker);
+
+    while (__atomic_load_n(&exec->stop, __ATOMIC_RELAXED) == 0u) {
+        osal_executor_job_t *job = executor_find_job(worker);
+
+        if (job != NULL) {
+            executor_run(job);
+            idle = 0u;
+        } else if (idle < EXECUTOR_SPIN_ROUNDS) {
+            osal_cpu_relax();
+            idle++;
+        } else {
+            osal_mutex_lock(&exec->lock);
+
+            __atomic_add_fetch(&exec->sleepers, 1u, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+            while ((exec->stop == 0u) && (executor_has_job(exec) == 0)) {
+                osal_condvar_wait(&exec->cond, &exec->lock);
+            }
+            __atomic_sub_fetch(&exec->sleepers, 1u, __ATOMIC_RELAXED);
+
+            osal_mutex_unlock(&exec->lock);
+            idle = 0u;
+        }
+    }
+
+    executor_set_self(NULL);
+
+    return NULL;
+}
+
+//! \brief Return number of workers for attributes.
+static osal_uint32_t executor_worker_cnt(const osal_executor_attr_t *attr) {
+    osal_uint32_t ret = 1u;
+
+    if ((attr != NULL) && (attr->workers != 0u)) {
+        ret = attr->workers;
+    } else {
+#if (LIBOSAL_HAVE_UNISTD_H == 1) && defined(_SC_NPROCESSORS_ONLN)
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        if (cpus > 0) {
+            ret = (osal_uint32_t)cpus;
+        }
+#endif
+    }
+
+    return ret;
+}
+
+//! \brief Stop and join the first \p cnt workers.
+static osal_retval_t executor_stop_workers(osal_executor_t *exec, osal_uint32_t cnt) {
+    osal_retval_t ret = OSAL_OK;
+
+    osal_mutex_lock(&exec->lock);
+    __atomic_store_n(&exec->stop, 1u, __ATOMIC_RELAXED);
+    osal_condvar_broadcast(&exec->cond);
+    osal_mutex_unlock(&exec->lock);
+
+    for (osal_uint32_t i = 0u; i < cnt; ++i) {
+        osal_retval_t local_ret = osal_task_join(&exec->workers[i].task, NULL);
+        if (ret == OSAL_OK) {
+            ret = local_ret;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Free worker deques.
+static void executor_free(osal_executor_t *exec) {
+    if (exec->workers != NULL) {
+        for (osal_uint32_t i = 0u; i < exec->worker_cnt; ++i) {
+            free(exec->workers[i].deque.jobs);
+        }
+
+        free(exec->workers);
+        exec->workers = NULL;
+    }
+}
+
+//! \brief Initialize executor.
+/*!
+ * \param[out]  exec    Pointer to executor.
+ * \param[in]   attr    Pointer to executor attributes. Can be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_executor_init(osal_executor_t *exec, const osal_executor_attr_t *attr) {
+    assert(exec != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_uint32_t deque_size = ((attr != NULL) && (attr->deque_size != 0u)) ?
+        attr->deque_size : OSAL_EXECUTOR_DEQUE_SIZE_DEFAULT;
+    osal_uint32_t slots = 1u;
+
+    (void)memset(exec, 0, sizeof(*exec));
+    exec->worker_cnt = executor_worker_cnt(attr);
+
+    if (deque_size > 0x40000000u) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        while (slots < deque_size) {
+            slots <<= 1u;
+        }
+
+        exec->workers = (osal_executor_worker_t *)calloc(exec->worker_cnt, sizeof(osal_executor_worker_t));
+        if (exec->workers == NULL) {
+            ret = OSAL_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    for (osal_uint32_t i = 0u; (i < exec->worker_cnt) && (ret == OSAL_OK); ++i) {
+        osal_executor_worker_t *worker = &exec->workers[i];
+
+        worker->exec = exec;
+        worker->index = i;
+        worker->seed = (i + 1u) * 2654435761u;
+        worker->deque.mask = (osal_int64_t)slots - 1;
+        worker->deque.jobs = (osal_executor_job_t **)calloc(slots, sizeof(osal_executor_job_t *));
+        if (worker->deque.jobs == NULL) {
+            ret = OSAL_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (ret == OSAL_OK) {
+        ret = osal_mutex_init(&exec->lock, NULL);
+        if (ret == OSAL_OK) {
+            ret = osal_condvar_init(&exec->cond, NULL);
+            if (ret != OSAL_OK) {
+                (void)osal_mutex_destroy(&exec->lock);
+            }
+        }
+    }
+
+    if (ret == OSAL_OK) {
+        osal_uint32_t started = 0u;
+
+        while ((started < exec->worker_cnt) && (ret == OSAL_OK)) {
+            osal_task_attr_t task_attr;
+
+            if ((attr != NULL) && (attr->worker_attr != NULL)) {
+                task_attr = attr->worker_attr[started];
+            } else if (attr != NULL) {
+                task_attr = attr->task_attr;
+            } else {
+                (void)memset(&task_attr, 0, sizeof(task_attr));
+            }
+
+            if (task_attr.task_name[0] == '\0') {
+                (void)snprintf(task_attr.task_name, TASK_NAME_LEN, "osal-exec%u", (unsigned)started);
+            }
+
+            ret = osal_task_create(&exec->workers[started].task, &task_attr,
+                    executor_worker_task, &exec->workers[started]);
+            if (ret == OSAL_OK) {
+                started++;
+            }
+        }
+
+        if (ret != OSAL_OK) {
+            (void)executor_stop_workers(exec, started);
+            (void)osal_condvar_destroy(&exec->cond);
+            (void)osal_mutex_destroy(&exec->lock);
+        }
+    }
+
+    if (ret != OSAL_OK) {
+        executor_free(exec);
+    }
+
+    return ret;
+}
+
+//! \brief Destroy executor.
+/*!
+ * \param[in]   exec    Pointer to executor.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_executor_destroy(osal_executor_t *exec) {
+    assert(exec != NULL);
+
+    osal_retval_t ret = executor_stop_workers(exec, exec->worker_cnt);
+
+    if (ret == OSAL_OK) {
+        (void)osal_condvar_destroy(&exec->cond);
+        ret = osal_mutex_destroy(&exec->lock);
+        executor_free(exec);
+    }
+
+    return ret;
+}
+
+//! \brief Initialize job.
+/*!
+ * \param[out]  job     Pointer to job.
+ * \param[in]   func    Job function.
+ * \param[in]   arg     Job function argument.
+ */
+void osal_executor_job_init(osal_executor_job_t *job, osal_executor_func_t func, osal_void_t *arg) {
+    assert(job != NULL);
+    assert(func != NULL);
+
+    (void)memset(job, 0, sizeof(*job));
+    job->func = func;
+    job->arg = arg;
+}
+
+//! \brief Submit job.
+/*!
+ * \param[in]   exec    Pointer to executor.
+ * \param[in]   job     Pointer to initialized job.
+ * \param[in]   wg      Wait group to notify when the job has finished. Can be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_executor_submit(osal_executor_t *exec, osal_executor_job_t *job, osal_executor_wg_t *wg) {
+    assert(exec != NULL);
+    assert(job != NULL);
+
+    osal_executor_worker_t *worker = executor_self();
+
+    job->wg = wg;
+    job->next = NULL;
+
+    if (wg != NULL) {
+        __atomic_add_fetch(&wg->pending, 1u, __ATOMIC_RELAXED);
+    }
+
+    if ((worker != NULL) && (worker->exec == exec) && (executor_deque_push(&worker->deque, job) != 0)) {
+        executor_wake(exec);
+    } else {
+        osal_mutex_lock(&exec->lock);
+
+        if (exec->inject_tail != NULL) {
+            exec->inject_tail->next = job;
+        } else {
+            exec->inject_head = job;
+        }
+        exec->inject_tail = job;
+        __atomic_store_n(&exec->inject_cnt, exec->inject_cnt + 1u, __ATOMIC_RELAXED);
+
+        if (exec->sleepers != 0u) {
+            osal_condvar_signal(&exec->cond);
+        }
+
+        osal_mutex_unlock(&exec->lock);
+    }
+
+    return OSAL_OK;
+}
+
+//! \brief Initialize wait group.
+/*!
+ * \param[out]  wg      Pointer to wait group.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_executor_wg_init(osal_executor_wg_t *wg) {
+    assert(wg != NULL);
+
+    osal_retval_t ret;
+
+    wg->pending = 0u;
+
+    ret = osal_mutex_init(&wg->lock, NULL);
+    if (ret == OSAL_OK) {
+        ret = osal_condvar_init(&wg->cond, NULL);
+        if (ret != OSAL_OK) {
+            (void)osal_mutex_destroy(&wg->lock);
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Destroy wait group.
+/*!
+ * \param[in]   wg      Pointer to wait group without pending jobs.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_executor_wg_destroy(osal_executor_wg_t *wg) {
+    assert(wg != NULL);
+
+    osal_retval_t ret = OSAL_ERR_BUSY;
+
+    if (__atomic_load_n(&wg->pending, __ATOMIC_ACQUIRE) == 0u) {
+        (void)osal_condvar_destroy(&wg->cond);
+        ret = osal_mutex_destroy(&wg->lock);
+    }
+
+    return ret;
+}
+
+//! \brief Wait until all jobs of a wait group have finished.
+/*!
+ * \param[in]   exec    Pointer to executor.
+ * \param[in]   wg      Pointer to wait group.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_executor_wg_wait(osal_executor_t *exec, osal_executor_wg_t *wg) {
+    assert(exec != NULL);
+    assert(wg != NULL);
+
+    osal_executor_worker_t *worker = executor_self();
+
+    if ((worker != NULL) && (worker->exec == exec)) {
+        // help instead of blocking the worker, the awaited jobs may be queued behind us
+        while (__atomic_load_n(&wg->pending, __ATOMIC_ACQUIRE) != 0u) {
+            osal_executor_job_t *job = executor_find_job(worker);
+
+            if (job != NULL) {
+                executor_run(job);
+            } else {
+                osal_cpu_relax();
+            }
+        }
+    }
+
+    // the last job finishes under the lock, wg may be destroyed after this
+    osal_mutex_lock(&wg->lock);
+    while (__atomic_load_n(&wg->pending, __ATOMIC_ACQUIRE) != 0u) {
+        osal_condvar_wait(&wg->cond, &wg->lock);
+    }
+    osal_mutex_unlock(&wg->lock);
+
+    return OSAL_OK;
+}
@@ -0,0 +1,156 @@
+/**
+ * \file periodic.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 17 Oct 2026
+ *
+ * \brief OSAL periodic source.
+ *
+ * OSAL periodic source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <libosal/osal.h>
+#include <libosal/periodic.h>
+
+#include <assert.h>
+#include <string.h>
+
+//! \brief Record one sample into min/max/sum.
+static void periodic_record(osal_uint64_t *min_val, osal_uint64_t *max_val, osal_uint64_t *sum,
+        osal_uint64_t cnt, osal_uint64_t val)
+{
+    if ((cnt == 0u) || (val < *min_val)) {
+        *min_val = val;
+    }
+    if (val > *max_val) {
+        *max_val = val;
+    }
+
+    *sum += val;
+}
+
+//! \brief Initialize periodic execution.
+/*!
+ * \param[out]  per     Pointer to periodic struct.
+ * \param[in]   attr    Pointer to attributes. Can be NULL.
+ * \param[in]   period  Period in [ns].
+ * \param[in]   phase   Offset of first release from \p start in [ns].
+ * \param[in]   start   Absolute start time in [ns], 0 for now.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_periodic_init(osal_periodic_t *per, const osal_periodic_attr_t *attr,
+        osal_uint64_t period, osal_uint64_t phase, osal_uint64_t start)
+{
+    assert(per != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_periodic_attr_t flags = attr != NULL ? (*attr) : 0u;
+    osal_uint32_t policy = flags & OSAL_PERIODIC_ATTR__OVERRUN__MASK;
+
+    if (    (period == 0u) || 
+            ((policy != OSAL_PERIODIC_ATTR__OVERRUN__SKIP) && (policy != OSAL_PERIODIC_ATTR__OVERRUN__CATCH_UP))) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        (void)memset(per, 0, sizeof(*per));
+        per->attr = flags;
+        per->period = period;
+        per->release = (start != 0u ? start : osal_timer_gettime_nsec()) + phase;
+    }
+
+    return ret;
+}
+
+//! \brief Finish current job and wait for next release.
+/*!
+ * \param[in]   per     Pointer to periodic struct.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_periodic_wait_next_period(osal_periodic_t *per) {
+    assert(per != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_periodic_stats_t *stats = &per->stats;
+    osal_uint64_t now = osal_timer_gettime_nsec();
+
+    if (per->wakeup != 0u) {
+        // current job done, deadline is the next release
+        osal_uint64_t next = per->release + per->period;
+
+        periodic_record(&stats->exec_min, &stats->exec_max, &stats->exec_sum, stats->cycles, now - per->wakeup);
+        stats->cycles++;
+
+        if (now > next) {
+            stats->missed++;
+            ret = OSAL_ERR_TIMEOUT;
+
+            if ((per->attr & OSAL_PERIODIC_ATTR__OVERRUN__MASK) == OSAL_PERIODIC_ATTR__OVERRUN__SKIP) {
+                osal_uint64_t skip = (now - next) / per->period + 1u;
+
+                stats->skipped += skip;
+                next += skip * per->period;
+            }
+        }
+
+        per->release = next;
+    }
+
+    if (per->release > now) {
+        osal_retval_t local_ret = osal_sleep_until_nsec(per->release);
+        if (local_ret != OSAL_OK) {
+            ret = OSAL_ERR_OPERATION_FAILED;
+        }
+
+        now = osal_timer_gettime_nsec();
+    }
+
+    osal_uint64_t lat = now > per->release ? now - per->release : 0u;
+    periodic_record(&stats->lat_min, &stats->lat_max, &stats->lat_sum, stats->releases, lat);
+    stats->releases++;
+
+    per->wakeup = now;
+    return ret;
+}
+
+//! \brief Get statistics.
+/*!
+ * \param[in]   per     Pointer to periodic struct.
+ * \param[out]  stats   Returns statistics.
+ */
+void osal_periodic_get_stats(osal_periodic_t *per, osal_periodic_stats_t *stats) {
+    assert(per != NULL);
+    assert(stats != NULL);
+
+    (*stats) = per->stats;
+}
+
+//! \brief Reset statistics.
+/*!
+ * \param[in]   per     Pointer to periodic struct.
+ */
+void osal_periodic_reset_stats(osal_periodic_t *per) {
+    assert(per != NULL);
+
+    (void)memset(&per->stats, 0, sizeof(per->stats));
+}
+
@@ -65,6 +65,21 @@ int osal_timer_get_clock_source(void) {
     return -1;
 }
 
+//! Enables the CPU timestamp counter as fast time source. Not supported on Pikeos
+osal_retval_t osal_timer_tsc_enable(osal_uint64_t calibration_time) {
+    (void)calibration_time;
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! Disables the CPU timestamp counter as time source. Not supported on Pikeos
+void osal_timer_tsc_disable(void) {
+}
+
+//! Returns the calibrated timestamp counter frequency. Not supported on Pikeos
+osal_uint64_t osal_timer_tsc_get_frequency(void) {
+    return 0u;
+}
+
 // gets time in nanoseconds
 osal_uint64_t osal_timer_gettime_nsec(void) {
     osal_uint64_t ret = p4_get_time();
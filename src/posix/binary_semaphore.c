@@ -52,13 +52,13 @@
 osal_retval_t osal_binary_semaphore_init(osal_binary_semaphore_t *sem, const osal_binary_semaphore_attr_t *attr) {
     assert(sem != NULL);
 
-    (void)attr;
-
     sem->value = 0;
 
     pthread_condattr_t cond_attr;
     pthread_condattr_init(&cond_attr);
-    pthread_condattr_setclock(&cond_attr, osal_timer_get_clock_source());
+    sem->clock_id = osal_timer_posix_clock(attr != NULL ?
+            (((*attr) & OSAL_BINARY_SEMAPHORE_ATTR__CLOCK__MASK) >> OSAL_BINARY_SEMAPHORE_ATTR__CLOCK__SHIFT) : 0u);
+    pthread_condattr_setclock(&cond_attr, sem->clock_id);
 
     pthread_mutexattr_t posix_attr;
     pthread_mutexattr_init(&posix_attr);
@@ -133,6 +133,28 @@ osal_retval_t osal_binary_semaphore_trywait(osal_binary_semaphore_t *sem) {
     return ret;
 }
 
+//! \brief Wait for a binary_semaphore with absolute timespec timeout.
+static osal_retval_t osal_binary_semaphore_wait_ts(osal_binary_semaphore_t *sem, const struct timespec *ts) {
+    osal_retval_t ret = OSAL_OK;
+
+    pthread_mutex_lock(&sem->posix_mtx);
+    while (!sem->value) {
+        int local_ret = pthread_cond_timedwait(&sem->posix_cond, &sem->posix_mtx, ts);
+        if (local_ret == ETIMEDOUT) {
+            ret = OSAL_ERR_TIMEOUT;
+            break;
+        }
+    }
+
+    if (ret == OSAL_OK) {        
+        sem->value = 0;
+    }
+
+    pthread_mutex_unlock(&sem->posix_mtx);
+
+    return ret;
+}
+
 //! \brief Wait for a binary_semaphore.
 /*!
  * \param[in]   sem     Pointer to osal binary_semaphore structure. Content is OS dependent.
@@ -150,20 +172,7 @@ osal_retval_t osal_binary_semaphore_timedwait(osal_binary_semaphore_t *sem, cons
         ts.tv_sec = to->sec;
         ts.tv_nsec = to->nsec;
 
-        pthread_mutex_lock(&sem->posix_mtx);
-        while (!sem->value) {
-            int local_ret = pthread_cond_timedwait(&sem->posix_cond, &sem->posix_mtx, &ts);
-            if (local_ret == ETIMEDOUT) {
-                ret = OSAL_ERR_TIMEOUT;
-                break;
-            }
-        }
-
-        if (ret == OSAL_OK) {        
-            sem->value = 0;
-        }
-
-        pthread_mutex_unlock(&sem->posix_mtx);
+        ret = osal_binary_semaphore_wait_ts(sem, &ts);
     } else {
         if (sem->value == 0) {
             ret = OSAL_ERR_TIMEOUT;
@@ -173,6 +182,38 @@ osal_retval_t osal_binary_semaphore_timedwait(osal_binary_semaphore_t *sem, cons
     return ret;
 }
 
+//! \brief Wait for a binary_semaphore until a deadline in nanoseconds.
+/*!
+ * \param[in]   sem         Pointer to osal binary_semaphore structure. Content is OS dependent.
+ * \param[in]   deadline_ns Absolute timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_binary_semaphore_wait_until_ns(osal_binary_semaphore_t *sem, osal_uint64_t deadline_ns) {
+    assert(sem != NULL);
+
+    struct timespec ts;
+    osal_timer_posix_ns_to_timespec(deadline_ns, &ts);
+
+    return osal_binary_semaphore_wait_ts(sem, &ts);
+}
+
+//! \brief Wait for a binary_semaphore for a time in nanoseconds.
+/*!
+ * \param[in]   sem         Pointer to osal binary_semaphore structure. Content is OS dependent.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_binary_semaphore_wait_for_ns(osal_binary_semaphore_t *sem, osal_uint64_t rel_ns) {
+    assert(sem != NULL);
+
+    struct timespec ts;
+    osal_timer_posix_ns_to_timespec(osal_timer_posix_gettime_ns(sem->clock_id) + rel_ns, &ts);
+
+    return osal_binary_semaphore_wait_ts(sem, &ts);
+}
+
 //! \brief Destroys a binary_semaphore.
 /*!
  * \param[in]   sem     Pointer to osal binary_semaphore structure. Content is OS dependent.
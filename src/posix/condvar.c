@@ -52,8 +52,6 @@
 osal_retval_t osal_condvar_init(osal_condvar_t *cv, const osal_condvar_attr_t *attr) {
     assert(cv != NULL);
 
-    (void)attr;
-
     osal_retval_t ret = OSAL_OK;
     int local_ret;
 
@@ -63,7 +61,9 @@ osal_retval_t osal_condvar_init(osal_condvar_t *cv, const osal_condvar_attr_t *a
         // should only return ENOMEM
         ret = OSAL_ERR_OUT_OF_MEMORY;
     } else {
-        local_ret = pthread_condattr_setclock(&cond_attr, osal_timer_get_clock_source());
+        cv->clock_id = osal_timer_posix_clock(attr != NULL ?
+                (((*attr) & OSAL_CONDVAR_ATTR__CLOCK__MASK) >> OSAL_CONDVAR_ATTR__CLOCK__SHIFT) : 0u);
+        local_ret = pthread_condattr_setclock(&cond_attr, cv->clock_id);
         if (local_ret != 0) {
             // should only return EINVAL
             ret = OSAL_ERR_INVALID_PARAM;
@@ -143,6 +143,26 @@ osal_retval_t osal_condvar_wait(osal_condvar_t *cv, osal_mutex_t *mtx) {
     return OSAL_OK;
 }
 
+//! \brief Wait for a condvar with absolute timespec timeout.
+static osal_retval_t osal_condvar_wait_ts(osal_condvar_t *cv, osal_mutex_t *mtx, const struct timespec *ts) {
+    osal_retval_t ret = OSAL_OK;
+    int local_ret;
+
+    do {
+        local_ret = pthread_cond_timedwait(&cv->posix_cond, &mtx->posix_mtx, ts);
+        if (local_ret == ETIMEDOUT) {
+            ret = OSAL_ERR_TIMEOUT;
+            break;
+        } else if (local_ret == EINVAL) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else if (local_ret == EPERM) {
+            ret = OSAL_ERR_PERMISSION_DENIED;
+        }
+    } while (local_ret != 0);
+
+    return ret;
+}
+
 //! \brief Wait for a condvar.
 /*!
  * \param[in]   cv     Pointer to osal condvar structure. Content is OS dependent.
@@ -156,26 +176,47 @@ osal_retval_t osal_condvar_timedwait(osal_condvar_t *cv, osal_mutex_t *mtx, cons
     assert(mtx != NULL);
     assert(to != NULL);
 
-    osal_retval_t ret = OSAL_OK;
-    int local_ret;
-
     struct timespec ts;
     ts.tv_sec = to->sec;
     ts.tv_nsec = to->nsec;
 
-    do {
-        local_ret = pthread_cond_timedwait(&cv->posix_cond, &mtx->posix_mtx, &ts);
-        if (local_ret == ETIMEDOUT) {
-            ret = OSAL_ERR_TIMEOUT;
-            break;
-        } else if (local_ret == EINVAL) {
-            ret = OSAL_ERR_INVALID_PARAM;
-        } else if (local_ret == EPERM) {
-            ret = OSAL_ERR_PERMISSION_DENIED;
-        }
-    } while (local_ret != 0);
+    return osal_condvar_wait_ts(cv, mtx, &ts);
+}
 
-    return ret;
+//! \brief Wait for a condvar until a deadline in nanoseconds.
+/*!
+ * \param[in]   cv          Pointer to osal condvar structure. Content is OS dependent.
+ * \param[in]   mtx         Pointer to osal mutex structure. Content is OS dependent.
+ * \param[in]   deadline_ns Absolute timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_condvar_wait_until_ns(osal_condvar_t *cv, osal_mutex_t *mtx, osal_uint64_t deadline_ns) {
+    assert(cv != NULL);
+    assert(mtx != NULL);
+
+    struct timespec ts;
+    osal_timer_posix_ns_to_timespec(deadline_ns, &ts);
+
+    return osal_condvar_wait_ts(cv, mtx, &ts);
+}
+
+//! \brief Wait for a condvar for a time in nanoseconds.
+/*!
+ * \param[in]   cv          Pointer to osal condvar structure. Content is OS dependent.
+ * \param[in]   mtx         Pointer to osal mutex structure. Content is OS dependent.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_condvar_wait_for_ns(osal_condvar_t *cv, osal_mutex_t *mtx, osal_uint64_t rel_ns) {
+    assert(cv != NULL);
+    assert(mtx != NULL);
+
+    struct timespec ts;
+    osal_timer_posix_ns_to_timespec(osal_timer_posix_gettime_ns(cv->clock_id) + rel_ns, &ts);
+
+    return osal_condvar_wait_ts(cv, mtx, &ts);
 }
 
 //! \brief Destroys a condvar.
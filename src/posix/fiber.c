@@ -0,0 +1,677 @@
+/**
+ * \file posix/fiber.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 18 Oct 2026
+ *
+ * \brief OSAL fiber posix source.
+ *
+ * OSAL fiber posix source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <libosal/config.h>
+#include <libosal/osal.h>
+#include <libosal/fiber.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// define LIBOSAL_FIBER_UCONTEXT to use the portable but slower ucontext switch
+#if !defined(LIBOSAL_FIBER_UCONTEXT) && defined(__ELF__) && \
+        ((defined(__x86_64__) && !defined(__ILP32__)) || defined(__aarch64__))
+#define POSIX_FIBER_ASM
+#else
+#include <ucontext.h>
+#endif
+
+//! Scheduler running on this thread.
+static __thread osal_fiber_sched_t *posix_fiber_sched_self = NULL;
+
+#ifdef POSIX_FIBER_ASM
+
+//! \brief Switch to another context.
+/*!
+ * Saves the callee-saved registers on the current stack, stores the stack
+ * pointer to \p save and continues on the stack \p restore.
+ *
+ * \param[out]  save        Returns the stack pointer of the current context.
+ * \param[in]   restore     Stack pointer of the context to continue.
+ */
+extern void posix_fiber_switch(osal_void_t **save, osal_void_t *restore) __attribute__((visibility("hidden")));
+
+#if defined(__x86_64__)
+// frame: mxcsr/x87 control word, r15, r14, r13, r12, rbx, rbp, return address
+__asm__(
+    ".text\n"
+    ".globl posix_fiber_switch\n"
+    ".hidden posix_fiber_switch\n"
+    ".type posix_fiber_switch, @function\n"
+    ".p2align 4\n"
+    "posix_fiber_switch:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $8, %rsp\n"
+    "    stmxcsr (%rsp)\n"
+    "    fnstcw 4(%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr (%rsp)\n"
+    "    fldcw 4(%rsp)\n"
+    "    addq $8, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".size posix_fiber_switch, .-posix_fiber_switch\n"
+);
+
+#define POSIX_FIBER_FRAME_WORDS     9u      //!< Initial frame including the fake return address of the entry.
+#define POSIX_FIBER_FRAME_ENTRY     7u      //!< Word of the frame \ref posix_fiber_switch returns to.
+#define POSIX_FIBER_FRAME_CSR       0u      //!< Word of the frame holding mxcsr and x87 control word.
+#define POSIX_FIBER_CSR_DEFAULT     (((osal_uint64_t)0x037Fu << 32u) | 0x1F80u)   //!< Default x87 control word and mxcsr.
+#else
+// frame: x19-x28, x29 (fp), x30 (lr), d8-d15
+__asm__(
+    ".text\n"
+    ".globl posix_fiber_switch\n"
+    ".hidden posix_fiber_switch\n"
+    ".type posix_fiber_switch, %function\n"
+    ".p2align 4\n"
+    "posix_fiber_switch:\n"
+    "    sub sp, sp, #160\n"
+    "    stp x19, x20, [sp, #0]\n"
+    "    stp x21, x22, [sp, #16]\n"
+    "    stp x23, x24, [sp, #32]\n"
+    "    stp x25, x26, [sp, #48]\n"
+    "    stp x27, x28, [sp, #64]\n"
+    "    stp x29, x30, [sp, #80]\n"
+    "    stp d8, d9, [sp, #96]\n"
+    "    stp d10, d11, [sp, #112]\n"
+    "    stp d12, d13, [sp, #128]\n"
+    "    stp d14, d15, [sp, #144]\n"
+    "    mov x9, sp\n"
+    "    str x9, [x0]\n"
+    "    mov sp, x1\n"
+    "    ldp x19, x20, [sp, #0]\n"
+    "    ldp x21, x22, [sp, #16]\n"
+    "    ldp x23, x24, [sp, #32]\n"
+    "    ldp x25, x26, [sp, #48]\n"
+    "    ldp x27, x28, [sp, #64]\n"
+    "    ldp x29, x30, [sp, #80]\n"
+    "    ldp d8, d9, [sp, #96]\n"
+    "    ldp d10, d11, [sp, #112]\n"
+    "    ldp d12, d13, [sp, #128]\n"
+    "    ldp d14, d15, [sp, #144]\n"
+    "    add sp, sp, #160\n"
+    "    ret\n"
+    ".size posix_fiber_switch, .-posix_fiber_switch\n"
+);
+
+#define POSIX_FIBER_FRAME_WORDS     20u     //!< Initial frame, 16 byte aligned.
+#define POSIX_FIBER_FRAME_ENTRY     11u     //!< Word of the frame holding x30.
+#endif
+
+#else
+
+//! Context of the scheduler while a fiber runs.
+static __thread ucontext_t posix_fiber_sched_uc;
+
+#endif
+
+//! \brief Switch between scheduler and fiber.
+/*!
+ * \param[out]  save        Context to save to.
+ * \param[in]   restore     Context to continue.
+ */
+static void posix_fiber_swap(osal_void_t **save, osal_void_t *restore) {
+#ifdef POSIX_FIBER_ASM
+    posix_fiber_switch(save, restore);
+#else
+    (void)swapcontext((ucontext_t *)*save, (ucontext_t *)restore);
+#endif
+}
+
+//! \brief First function of every fiber.
+static void posix_fiber_entry(void) {
+    osal_fiber_sched_t *sched = posix_fiber_sched_self;
+    osal_fiber_t *fiber = sched->current;
+
+    fiber->func(fiber->arg);
+
+    // the scheduler releases the stack, this context is never continued
+    fiber->state = OSAL_FIBER_STATE_DONE;
+    posix_fiber_swap(&fiber->ctx, sched->ctx);
+    abort();
+}
+
+//! \brief Prepare the initial context of a fiber.
+/*!
+ * \param[in]   sched   Pointer to fiber scheduler.
+ * \param[in]   slot    Stack pool slot.
+ *
+ * \return Context to switch to.
+ */
+static osal_void_t *posix_fiber_ctx_init(osal_fiber_sched_t *sched, osal_uint32_t slot) {
+    osal_uint8_t *top = &sched->stacks[(osal_size_t)(slot + 1u) * sched->slot_size];
+
+#ifdef POSIX_FIBER_ASM
+    osal_uint64_t *frame = &((osal_uint64_t *)top)[-(int)POSIX_FIBER_FRAME_WORDS];
+
+    (void)memset(frame, 0, POSIX_FIBER_FRAME_WORDS * sizeof(osal_uint64_t));
+    frame[POSIX_FIBER_FRAME_ENTRY] = (osal_uint64_t)(uintptr_t)posix_fiber_entry;
+#ifdef POSIX_FIBER_CSR_DEFAULT
+    frame[POSIX_FIBER_FRAME_CSR] = POSIX_FIBER_CSR_DEFAULT;
+#endif
+
+    return frame;
+#else
+    osal_uint8_t *base = &sched->stacks[((osal_size_t)slot * sched->slot_size) + (sched->slot_size - sched->attr.stack_size)];
+    ucontext_t *uc = (ucontext_t *)(top - ((sizeof(ucontext_t) + 63u) & ~(osal_size_t)63u));
+
+    (void)getcontext(uc);
+    uc->uc_stack.ss_sp = base;
+    uc->uc_stack.ss_size = (osal_size_t)((osal_uint8_t *)uc - base);
+    uc->uc_link = NULL;
+    makecontext(uc, posix_fiber_entry, 0);
+
+    return uc;
+#endif
+}
+
+//! \brief Append fiber to the ready list.
+/*!
+ * \param[in]   sched   Pointer to fiber scheduler.
+ * \param[in]   fiber   Pointer to fiber.
+ */
+static void posix_fiber_ready(osal_fiber_sched_t *sched, osal_fiber_t *fiber) {
+    fiber->state = OSAL_FIBER_STATE_READY;
+    fiber->next = NULL;
+
+    if (sched->ready_tail == NULL) {
+        sched->ready_head = fiber;
+    } else {
+        sched->ready_tail->next = fiber;
+    }
+
+    sched->ready_tail = fiber;
+}
+
+//! \brief Move waiting fibers whose condition or deadline is met to the ready list.
+/*!
+ * \param[in]   sched   Pointer to fiber scheduler.
+ */
+static void posix_fiber_poll(osal_fiber_sched_t *sched) {
+    osal_fiber_t **link = &sched->waiting;
+    osal_uint64_t now = 0u;
+
+    while (*link != NULL) {
+        osal_fiber_t *fiber = *link;
+        osal_bool_t wake = OSAL_FALSE;
+
+        if ((fiber->wait_try != NULL) && (fiber->wait_try(fiber->wait_obj) == OSAL_OK)) {
+            fiber->wait_result = OSAL_OK;
+            wake = OSAL_TRUE;
+        } else if (fiber->wait_deadline != 0u) {
+            if (now == 0u) {
+                now = osal_timer_gettime_nsec();
+            }
+
+            if (now >= fiber->wait_deadline) {
+                fiber->wait_result = (fiber->wait_try != NULL) ? OSAL_ERR_TIMEOUT : OSAL_OK;
+                wake = OSAL_TRUE;
+            }
+        }
+
+        if (wake == OSAL_TRUE) {
+            *link = fiber->next;
+            posix_fiber_ready(sched, fiber);
+        } else {
+            link = &fiber->next;
+        }
+    }
+}
+
+//! \brief Sleep while all fibers wait.
+/*!
+ * \param[in]   sched   Pointer to fiber scheduler.
+ */
+static void posix_fiber_idle(osal_fiber_sched_t *sched) {
+    osal_uint64_t deadline = 0u;
+    osal_bool_t polling = OSAL_FALSE;
+
+    for (osal_fiber_t *fiber = sched->waiting; fiber != NULL; fiber = fiber->next) {
+        if (fiber->wait_try != NULL) {
+            polling = OSAL_TRUE;
+        }
+
+        if ((fiber->wait_deadline != 0u) && ((deadline == 0u) || (fiber->wait_deadline < deadline))) {
+            deadline = fiber->wait_deadline;
+        }
+    }
+
+    if (polling == OSAL_TRUE) {
+        osal_uint64_t poll = osal_timer_gettime_nsec() + sched->attr.poll_interval;
+
+        if ((deadline == 0u) || (poll < deadline)) {
+            deadline = poll;
+        }
+    }
+
+    // fails if the deadline has already passed
+    (void)osal_sleep_until_nsec(deadline);
+}
+
+//! \brief Run a fiber until it yields, waits or is done.
+/*!
+ * \param[in]   sched   Pointer to fiber scheduler.
+ * \param[in]   fiber   Pointer to fiber.
+ */
+static void posix_fiber_run(osal_fiber_sched_t *sched, osal_fiber_t *fiber) {
+    sched->current = fiber;
+    sched->switches++;
+    fiber->state = OSAL_FIBER_STATE_RUNNING;
+
+    posix_fiber_swap(&sched->ctx, fiber->ctx);
+
+    sched->current = NULL;
+
+    if (fiber->state == OSAL_FIBER_STATE_DONE) {
+        sched->free_slots[sched->free_cnt] = fiber->slot;
+        sched->free_cnt++;
+        sched->fiber_cnt--;
+    }
+}
+
+//! \brief Initialize a fiber scheduler.
+/*!
+ * \param[out]  sched   Pointer to fiber scheduler.
+ * \param[in]   attr    Attributes, NULL for defaults.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_sched_init(osal_fiber_sched_t *sched, const osal_fiber_sched_attr_t *attr) {
+    assert(sched != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_size_t page = (osal_size_t)sysconf(_SC_PAGESIZE);
+
+    (void)memset(sched, 0, sizeof(*sched));
+
+    if (attr != NULL) {
+        sched->attr = *attr;
+    }
+
+    if (sched->attr.stack_size == 0u) {
+        sched->attr.stack_size = OSAL_FIBER_STACK_SIZE_DEFAULT;
+    }
+
+    if (sched->attr.max_fibers == 0u) {
+        sched->attr.max_fibers = OSAL_FIBER_MAX_DEFAULT;
+    }
+
+    if (sched->attr.poll_interval == 0u) {
+        sched->attr.poll_interval = OSAL_FIBER_POLL_INTERVAL_DEFAULT;
+    }
+
+    // one guard page below every stack
+    sched->attr.stack_size = (sched->attr.stack_size + page - 1u) & ~(page - 1u);
+    sched->slot_size = sched->attr.stack_size + page;
+    sched->map_size = sched->slot_size * sched->attr.max_fibers;
+
+    sched->free_slots = (osal_uint32_t *)calloc(sched->attr.max_fibers, sizeof(osal_uint32_t));
+    void *stacks = mmap(NULL, sched->map_size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if ((sched->free_slots == NULL) || (stacks == MAP_FAILED)) {
+        ret = OSAL_ERR_OUT_OF_MEMORY;
+    } else {
+        sched->stacks = (osal_uint8_t *)stacks;
+
+        for (osal_uint32_t i = 0u; (ret == OSAL_OK) && (i < sched->attr.max_fibers); ++i) {
+            if (mprotect(&sched->stacks[(osal_size_t)i * sched->slot_size], page, PROT_NONE) != 0) {
+                ret = OSAL_ERR_OUT_OF_MEMORY;
+            }
+
+            // lowest slots are used first
+            sched->free_slots[i] = sched->attr.max_fibers - 1u - i;
+        }
+
+        sched->free_cnt = sched->attr.max_fibers;
+    }
+
+    if (ret != OSAL_OK) {
+        if (stacks != MAP_FAILED) {
+            (void)munmap(stacks, sched->map_size);
+        }
+
+        free(sched->free_slots);
+        (void)memset(sched, 0, sizeof(*sched));
+    }
+
+    return ret;
+}
+
+//! \brief Destroy a fiber scheduler.
+/*!
+ * \param[in]   sched   Pointer to fiber scheduler.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_sched_destroy(osal_fiber_sched_t *sched) {
+    assert(sched != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    if (sched->fiber_cnt != 0u) {
+        ret = OSAL_ERR_BUSY;
+    } else {
+        (void)munmap(sched->stacks, sched->map_size);
+        free(sched->free_slots);
+        (void)memset(sched, 0, sizeof(*sched));
+    }
+
+    return ret;
+}
+
+//! \brief Run fibers on the calling thread.
+/*!
+ * \param[in]   sched   Pointer to fiber scheduler.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_sched_run(osal_fiber_sched_t *sched) {
+    assert(sched != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    if (posix_fiber_sched_self != NULL) {
+        ret = OSAL_ERR_BUSY;
+    } else {
+        posix_fiber_sched_self = sched;
+#ifndef POSIX_FIBER_ASM
+        sched->ctx = &posix_fiber_sched_uc;
+#endif
+
+        while (sched->fiber_cnt > 0u) {
+            posix_fiber_poll(sched);
+
+            if (sched->ready_head == NULL) {
+                posix_fiber_idle(sched);
+            } else {
+                // fibers made ready meanwhile run after the next poll
+                osal_fiber_t *last = sched->ready_tail;
+                osal_fiber_t *fiber;
+
+                do {
+                    fiber = sched->ready_head;
+                    sched->ready_head = fiber->next;
+                    if (sched->ready_head == NULL) {
+                        sched->ready_tail = NULL;
+                    }
+
+                    posix_fiber_run(sched, fiber);
+                } while (fiber != last);
+            }
+        }
+
+        posix_fiber_sched_self = NULL;
+    }
+
+    return ret;
+}
+
+//! \brief Create a fiber.
+/*!
+ * \param[in]   sched   Pointer to fiber scheduler.
+ * \param[out]  fiber   Pointer to fiber, valid until the fiber is done.
+ * \param[in]   func    Fiber function.
+ * \param[in]   arg     Argument to \p func.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_create(osal_fiber_sched_t *sched, osal_fiber_t *fiber,
+        osal_fiber_func_t func, osal_void_t *arg) {
+    assert(sched != NULL);
+    assert(fiber != NULL);
+    assert(func != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    if (sched->free_cnt == 0u) {
+        ret = OSAL_ERR_SYSTEM_LIMIT_REACHED;
+    } else {
+        sched->free_cnt--;
+
+        (void)memset(fiber, 0, sizeof(*fiber));
+        fiber->sched = sched;
+        fiber->func = func;
+        fiber->arg = arg;
+        fiber->slot = sched->free_slots[sched->free_cnt];
+        fiber->ctx = posix_fiber_ctx_init(sched, fiber->slot);
+
+        sched->fiber_cnt++;
+        posix_fiber_ready(sched, fiber);
+    }
+
+    return ret;
+}
+
+//! \brief Return the running fiber.
+/*!
+ * \return Running fiber, NULL if not called from a fiber.
+ */
+osal_fiber_t *osal_fiber_self(osal_void_t) {
+    osal_fiber_sched_t *sched = posix_fiber_sched_self;
+
+    return (sched != NULL) ? sched->current : NULL;
+}
+
+//! \brief Let other ready fibers run.
+/*!
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_yield(osal_void_t) {
+    osal_retval_t ret = OSAL_OK;
+    osal_fiber_t *fiber = osal_fiber_self();
+
+    if (fiber == NULL) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        posix_fiber_ready(fiber->sched, fiber);
+        posix_fiber_swap(&fiber->ctx, fiber->sched->ctx);
+    }
+
+    return ret;
+}
+
+//! \brief Wait for a condition.
+/*!
+ * \param[in]   cond        Condition, NULL to wait for \p deadline only.
+ * \param[in]   obj         Argument to \p cond.
+ * \param[in]   deadline    Absolute time in [ns], 0 for none.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_wait(osal_fiber_trywait_t cond, osal_void_t *obj, osal_uint64_t deadline) {
+    osal_retval_t ret = OSAL_OK;
+    osal_fiber_t *fiber = osal_fiber_self();
+
+    if ((fiber == NULL) || ((cond == NULL) && (deadline == 0u))) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else if ((cond == NULL) || (cond(obj) != OSAL_OK)) {     // no switch if already met
+        osal_fiber_sched_t *sched = fiber->sched;
+
+        fiber->state = OSAL_FIBER_STATE_WAITING;
+        fiber->wait_try = cond;
+        fiber->wait_obj = obj;
+        fiber->wait_deadline = deadline;
+        fiber->next = sched->waiting;
+        sched->waiting = fiber;
+
+        posix_fiber_swap(&fiber->ctx, sched->ctx);
+
+        fiber->wait_try = NULL;
+        fiber->wait_obj = NULL;
+        fiber->wait_deadline = 0u;
+        ret = fiber->wait_result;
+    }
+
+    return ret;
+}
+
+//! \brief Sleep for a delay.
+/*!
+ * \param[in]   nsec    Delay in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_sleep(osal_uint64_t nsec) {
+    osal_retval_t ret = OSAL_OK;
+
+    if (osal_fiber_self() == NULL) {
+        osal_sleep(nsec);
+    } else {
+        ret = osal_fiber_wait(NULL, NULL, osal_timer_gettime_nsec() + nsec);
+    }
+
+    return ret;
+}
+
+//! \brief Sleep until an absolute time.
+/*!
+ * \param[in]   nsec    Absolute time in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_sleep_until_nsec(osal_uint64_t nsec) {
+    osal_retval_t ret;
+
+    if (osal_fiber_self() == NULL) {
+        ret = osal_sleep_until_nsec(nsec);
+    } else {
+        // 0 means no deadline
+        ret = osal_fiber_wait(NULL, NULL, (nsec == 0u) ? 1u : nsec);
+    }
+
+    return ret;
+}
+
+//! \brief Sleep until a timer expires.
+/*!
+ * \param[in]   timer   Pointer to osal timer structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_sleep_until(osal_timer_t *timer) {
+    assert(timer != NULL);
+
+    osal_retval_t ret;
+
+    if (osal_fiber_self() == NULL) {
+        ret = osal_sleep_until(timer);
+    } else {
+        ret = osal_fiber_sleep_until_nsec(((osal_uint64_t)timer->sec * 1000000000u) + (osal_uint64_t)timer->nsec);
+    }
+
+    return ret;
+}
+
+//! \brief Poll a semaphore for a waiting fiber.
+static osal_retval_t posix_fiber_try_semaphore(osal_void_t *obj) {
+    return osal_semaphore_trywait((osal_semaphore_t *)obj);
+}
+
+//! \brief Poll a binary semaphore for a waiting fiber.
+static osal_retval_t posix_fiber_try_binary_semaphore(osal_void_t *obj) {
+    return osal_binary_semaphore_trywait((osal_binary_semaphore_t *)obj);
+}
+
+//! \brief Wait for a semaphore.
+/*!
+ * \param[in]   sem     Pointer to osal semaphore structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_semaphore_wait(osal_semaphore_t *sem) {
+    assert(sem != NULL);
+
+    osal_retval_t ret;
+
+    if (osal_fiber_self() == NULL) {
+        ret = osal_semaphore_wait(sem);
+    } else {
+        ret = osal_fiber_wait(posix_fiber_try_semaphore, sem, 0u);
+    }
+
+    return ret;
+}
+
+//! \brief Wait for a semaphore with deadline.
+/*!
+ * \param[in]   sem         Pointer to osal semaphore structure.
+ * \param[in]   deadline_ns Absolute time in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_semaphore_wait_until_ns(osal_semaphore_t *sem, osal_uint64_t deadline_ns) {
+    assert(sem != NULL);
+
+    osal_retval_t ret;
+
+    if (osal_fiber_self() == NULL) {
+        ret = osal_semaphore_wait_until_ns(sem, deadline_ns);
+    } else {
+        ret = osal_fiber_wait(posix_fiber_try_semaphore, sem, (deadline_ns == 0u) ? 1u : deadline_ns);
+    }
+
+    return ret;
+}
+
+//! \brief Wait for a binary semaphore.
+/*!
+ * \param[in]   sem     Pointer to osal binary semaphore structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_fiber_binary_semaphore_wait(osal_binary_semaphore_t *sem) {
+    assert(sem != NULL);
+
+    osal_retval_t ret;
+
+    if (osal_fiber_self() == NULL) {
+        ret = osal_binary_semaphore_wait(sem);
+    } else {
+        ret = osal_fiber_wait(posix_fiber_try_binary_semaphore, sem, 0u);
+    }
+
+    return ret;
+}
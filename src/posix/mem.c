@@ -0,0 +1,363 @@
+/**
+ * \file posix/mem.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 17 Oct 2026
+ *
+ * \brief OSAL mem posix source.
+ *
+ * OSAL mem posix source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#define _GNU_SOURCE             /* See feature_test_macros(7) */
+#include <libosal/mem.h>
+#include <libosal/osal.h>
+#include <libosal/config.h>
+
+#include <assert.h>
+
+#ifdef LIBOSAL_HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+//! Bookkeeping in front of every allocation, keeps returned memory cache line aligned.
+#define OSAL_MEM_HEADER_SIZE            64u
+
+//! \brief Return system page size.
+static osal_size_t osal_mem_page_size(void) {
+    long page_size = sysconf(_SC_PAGESIZE);
+    return page_size > 0 ? (osal_size_t)page_size : 4096u;
+}
+
+#ifdef LIBOSAL_HAVE_SYS_MMAN_H
+
+//! Huge page size if it cannot be determined.
+#define OSAL_MEM_HUGEPAGE_SIZE_DEFAULT  (2u * 1024u * 1024u)
+
+//! \brief Allocation header.
+typedef struct osal_mem_header {
+    osal_size_t map_len;        //!< Length of the whole mapping.
+} osal_mem_header_t;
+
+//! \brief Map errno of mmap/mlock to osal return value.
+static osal_retval_t osal_mem_errno_to_ret(int err) {
+    osal_retval_t ret = OSAL_ERR_OPERATION_FAILED;
+
+    if (err == EPERM) {
+        ret = OSAL_ERR_PERMISSION_DENIED;
+    } else if ((err == ENOMEM) || (err == EAGAIN)) {
+        ret = OSAL_ERR_OUT_OF_MEMORY;
+    } else if (err == EINVAL) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    }
+
+    return ret;
+}
+
+//! \brief Return default huge page size.
+static osal_size_t osal_mem_hugepage_size(void) {
+    osal_size_t ret = OSAL_MEM_HUGEPAGE_SIZE_DEFAULT;
+    FILE *fp = fopen("/proc/meminfo", "r");
+
+    if (fp != NULL) {
+        char line[128];
+        unsigned long kb;
+
+        while (fgets(line, sizeof(line), fp) != NULL) {
+            if (sscanf(line, "Hugepagesize: %lu kB", &kb) == 1) {
+                ret = (osal_size_t)kb * 1024u;
+                break;
+            }
+        }
+
+        (void)fclose(fp);
+    }
+
+    return ret;
+}
+
+//! \brief Allocate realtime memory.
+/*!
+ * \param[out]  ptr     Returns pointer to allocated memory.
+ * \param[in]   size    Size in bytes.
+ * \param[in]   attr    Pointer to memory attributes. Can be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_alloc(osal_void_t **ptr, osal_size_t size, const osal_mem_attr_t *attr) {
+    assert(ptr != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_mem_attr_t flags = attr != NULL ? (*attr) : 0u;
+    osal_size_t total = size + OSAL_MEM_HEADER_SIZE;
+    osal_size_t map_len = 0u;
+    void *base = MAP_FAILED;
+
+    if (size == 0u) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+#ifdef MAP_HUGETLB
+        if ((flags & OSAL_MEM_ATTR__HUGEPAGE) != 0u) {
+            osal_size_t hp_size = osal_mem_hugepage_size();
+
+            // fails if no huge pages are reserved
+            map_len = ((total + hp_size - 1u) / hp_size) * hp_size;
+            base = mmap(NULL, map_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+#endif
+
+        if (base == MAP_FAILED) {
+            osal_size_t page_size = osal_mem_page_size();
+
+            map_len = ((total + page_size - 1u) / page_size) * page_size;
+            base = mmap(NULL, map_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+#ifdef MADV_HUGEPAGE
+            if ((base != MAP_FAILED) && ((flags & OSAL_MEM_ATTR__HUGEPAGE) != 0u)) {
+                // transparent huge pages, best effort
+                (void)madvise(base, map_len, MADV_HUGEPAGE);
+            }
+#endif
+        }
+
+        if (base == MAP_FAILED) {
+            ret = osal_mem_errno_to_ret(errno);
+        } else {
+            ((osal_mem_header_t *)base)->map_len = map_len;
+
+            ret = osal_mem_prepare(base, map_len, &flags);
+            if (ret != OSAL_OK) {
+                (void)munmap(base, map_len);
+            } else {
+                (*ptr) = (osal_uint8_t *)base + OSAL_MEM_HEADER_SIZE;
+            }
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Free realtime memory.
+/*!
+ * \param[in]   ptr     Pointer returned by \ref osal_mem_alloc.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_free(osal_void_t *ptr) {
+    assert(ptr != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_mem_header_t *hdr = (osal_mem_header_t *)((osal_uint8_t *)ptr - OSAL_MEM_HEADER_SIZE);
+
+    if (munmap(hdr, hdr->map_len) != 0) {
+        ret = OSAL_ERR_OPERATION_FAILED;
+    }
+
+    return ret;
+}
+
+//! \brief Prepare existing memory for realtime use.
+/*!
+ * \param[in]   ptr     Start of memory region.
+ * \param[in]   size    Size in bytes.
+ * \param[in]   attr    Pointer to memory attributes. Can be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_prepare(osal_void_t *ptr, osal_size_t size, const osal_mem_attr_t *attr) {
+    assert(ptr != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_mem_attr_t flags = attr != NULL ? (*attr) : 0u;
+
+    if ((flags & OSAL_MEM_ATTR__PREFAULT) != 0u) {
+        osal_size_t page_size = osal_mem_page_size();
+        volatile osal_uint8_t *start = (volatile osal_uint8_t *)ptr;
+        volatile osal_uint8_t *page = (volatile osal_uint8_t *)((osal_size_t)ptr & ~(page_size - 1u));
+
+        // write fault every page, reading alone may only map the shared zero page
+        if (page < start) {
+            page += page_size;
+            start[0] = start[0];
+        }
+
+        for (; page < (start + size); page += page_size) {
+            page[0] = page[0];
+        }
+    }
+
+    if ((flags & OSAL_MEM_ATTR__LOCK) != 0u) {
+        if (mlock(ptr, size) != 0) {
+            ret = osal_mem_errno_to_ret(errno);
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Lock all memory of the process.
+/*!
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_lock_all(void) {
+    osal_retval_t ret = OSAL_OK;
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        ret = osal_mem_errno_to_ret(errno);
+    }
+
+#ifdef __GLIBC__
+    if (ret == OSAL_OK) {
+        // never give heap back with sbrk/munmap and never serve malloc from
+        // fresh mmaps, freed memory stays locked and mapped for reuse
+        (void)mallopt(M_TRIM_THRESHOLD, -1);
+        (void)mallopt(M_MMAP_MAX, 0);
+    }
+#endif
+
+    return ret;
+}
+
+//! \brief Unlock all memory of the process.
+/*!
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_unlock_all(void) {
+    osal_retval_t ret = OSAL_OK;
+
+    if (munlockall() != 0) {
+        ret = osal_mem_errno_to_ret(errno);
+    }
+
+    return ret;
+}
+
+#else /* LIBOSAL_HAVE_SYS_MMAN_H */
+
+//! \brief Allocate realtime memory.
+/*!
+ * Without mmap the memory comes from the heap and cannot be locked.
+ *
+ * \param[out]  ptr     Returns pointer to allocated memory.
+ * \param[in]   size    Size in bytes.
+ * \param[in]   attr    Pointer to memory attributes. Can be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_alloc(osal_void_t **ptr, osal_size_t size, const osal_mem_attr_t *attr) {
+    assert(ptr != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_uint8_t *base;
+
+    if (size == 0u) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        base = malloc(size + OSAL_MEM_HEADER_SIZE);
+        if (base == NULL) {
+            ret = OSAL_ERR_OUT_OF_MEMORY;
+        } else {
+            memset(base, 0, size + OSAL_MEM_HEADER_SIZE);
+
+            ret = osal_mem_prepare(base, size + OSAL_MEM_HEADER_SIZE, attr);
+            if (ret != OSAL_OK) {
+                free(base);
+            } else {
+                (*ptr) = base + OSAL_MEM_HEADER_SIZE;
+            }
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Free realtime memory.
+/*!
+ * \param[in]   ptr     Pointer returned by \ref osal_mem_alloc.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_free(osal_void_t *ptr) {
+    assert(ptr != NULL);
+
+    free((osal_uint8_t *)ptr - OSAL_MEM_HEADER_SIZE);
+
+    return OSAL_OK;
+}
+
+//! \brief Prepare existing memory for realtime use.
+/*!
+ * \param[in]   ptr     Start of memory region.
+ * \param[in]   size    Size in bytes.
+ * \param[in]   attr    Pointer to memory attributes. Can be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_prepare(osal_void_t *ptr, osal_size_t size, const osal_mem_attr_t *attr) {
+    assert(ptr != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_mem_attr_t flags = attr != NULL ? (*attr) : 0u;
+
+    if ((flags & OSAL_MEM_ATTR__PREFAULT) != 0u) {
+        osal_size_t page_size = osal_mem_page_size();
+        volatile osal_uint8_t *start = (volatile osal_uint8_t *)ptr;
+
+        for (osal_size_t off = 0u; off < size; off += page_size) {
+            start[off] = start[off];
+        }
+    }
+
+    if ((flags & OSAL_MEM_ATTR__LOCK) != 0u) {
+        ret = OSAL_ERR_NOT_IMPLEMENTED;
+    }
+
+    return ret;
+}
+
+//! \brief Lock all memory of the process.
+/*!
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_lock_all(void) {
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Unlock all memory of the process.
+/*!
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_unlock_all(void) {
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+#endif /* LIBOSAL_HAVE_SYS_MMAN_H */
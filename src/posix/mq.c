@@ -81,6 +81,8 @@ osal_retval_t osal_mq_open(osal_mq_t *mq, const osal_char_t *name,  const osal_m
         local_attr.mq_msgsize = attr->max_message_size;
     }
 
+    mq->clock_id = osal_timer_posix_clock(attr != NULL ?
+            ((attr->oflags & OSAL_MQ_ATTR__CLOCK__MASK) >> OSAL_MQ_ATTR__CLOCK__SHIFT) : 0u);
     mq->mq_desc = mq_open(name, oflags, mode, &local_attr);
 	if (mq->mq_desc == (mqd_t)-1) {
         switch (errno) {
@@ -175,30 +177,13 @@ osal_retval_t osal_mq_send(osal_mq_t *mq, const osal_char_t *msg, const osal_siz
 }
 
 
-//! \brief Send a message through message queue.
-/*!
- * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
- * \param[in]   msg     Pointer to message buffer.
- * \param[in]   msg_len Lenght of message to send.
- * \param[in]   prio    Send priority.
- * \param[in]   to      Timeout waiting if message queue is full.
- *
- * \return OK or ERROR_CODE.
- */
-osal_retval_t osal_mq_timedsend(osal_mq_t *mq, const osal_char_t *msg, const osal_size_t msg_len, 
-        const osal_uint32_t prio, const osal_timer_t *to) {
-    assert(mq != NULL);
-    assert(msg != NULL);
-    assert(to != NULL);
-
+//! \brief Send a message with absolute CLOCK_REALTIME timespec timeout.
+static osal_retval_t osal_mq_send_ts(osal_mq_t *mq, const osal_char_t *msg, const osal_size_t msg_len, 
+        const osal_uint32_t prio, const struct timespec *ts) {
     osal_retval_t ret = OSAL_ERR_INTERRUPTED;
 
-    struct timespec ts;
-    ts.tv_sec = to->sec;
-    ts.tv_nsec = to->nsec;
-
     while (ret == OSAL_ERR_INTERRUPTED) {
-        int local_ret = mq_timedsend(mq->mq_desc, msg, msg_len, prio, &ts);
+        int local_ret = mq_timedsend(mq->mq_desc, msg, msg_len, prio, ts);
         if (local_ret == -1) {
             switch (errno) {
                 case EAGAIN:    // The queue was full, and the O_NONBLOCK flag was set for the message queue description 
@@ -234,6 +219,76 @@ osal_retval_t osal_mq_timedsend(osal_mq_t *mq, const osal_char_t *msg, const osa
     return ret;
 }
 
+//! \brief Send a message through message queue.
+/*!
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   msg     Pointer to message buffer.
+ * \param[in]   msg_len Lenght of message to send.
+ * \param[in]   prio    Send priority.
+ * \param[in]   to      Timeout waiting if message queue is full.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_timedsend(osal_mq_t *mq, const osal_char_t *msg, const osal_size_t msg_len, 
+        const osal_uint32_t prio, const osal_timer_t *to) {
+    assert(mq != NULL);
+    assert(msg != NULL);
+    assert(to != NULL);
+
+    // mq_timed* only accept CLOCK_REALTIME timeouts
+    struct timespec ts;
+    if (mq->clock_id == CLOCK_REALTIME) {
+        ts.tv_sec = to->sec;
+        ts.tv_nsec = to->nsec;
+    } else {
+        osal_timer_posix_to_realtime(mq->clock_id, osal_timer_to_nsec(to), &ts);
+    }
+
+    return osal_mq_send_ts(mq, msg, msg_len, prio, &ts);
+}
+
+//! \brief Send a message through message queue until a deadline in nanoseconds.
+/*!
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   msg         Pointer to message buffer.
+ * \param[in]   msg_len     Lenght of message to send.
+ * \param[in]   prio        Send priority.
+ * \param[in]   deadline_ns Absolute timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_send_until_ns(osal_mq_t *mq, const osal_char_t *msg, const osal_size_t msg_len, 
+        const osal_uint32_t prio, osal_uint64_t deadline_ns) {
+    assert(mq != NULL);
+    assert(msg != NULL);
+
+    // mq_timed* only accept CLOCK_REALTIME timeouts
+    struct timespec ts;
+    osal_timer_posix_to_realtime(mq->clock_id, deadline_ns, &ts);
+
+    return osal_mq_send_ts(mq, msg, msg_len, prio, &ts);
+}
+
+//! \brief Send a message through message queue waiting at most a time in nanoseconds.
+/*!
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   msg         Pointer to message buffer.
+ * \param[in]   msg_len     Lenght of message to send.
+ * \param[in]   prio        Send priority.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_send_for_ns(osal_mq_t *mq, const osal_char_t *msg, const osal_size_t msg_len, 
+        const osal_uint32_t prio, osal_uint64_t rel_ns) {
+    assert(mq != NULL);
+    assert(msg != NULL);
+
+    struct timespec ts;
+    osal_timer_posix_ns_to_timespec(osal_timer_posix_gettime_ns(CLOCK_REALTIME) + rel_ns, &ts);
+
+    return osal_mq_send_ts(mq, msg, msg_len, prio, &ts);
+}
 
 //! \brief Receive a message through message queue.
 /*!
@@ -280,30 +335,13 @@ osal_retval_t osal_mq_receive(osal_mq_t *mq, osal_char_t *msg, const osal_size_t
 }
 
 
-//! \brief Receive a message through message queue.
-/*!
- * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
- * \param[out]  msg     Pointer to message buffer.
- * \param[in]   msg_len Lenght of message to receive.
- * \param[out]  prio    Receive priority.
- * \param[in]   to      Timeout waiting if message queue is full.
- *
- * \return OK or ERROR_CODE.
- */
-osal_retval_t osal_mq_timedreceive(osal_mq_t *mq, osal_char_t *msg, const osal_size_t msg_len, 
-        osal_uint32_t *prio, const osal_timer_t *to) {
-    assert(mq != NULL);
-    assert(msg != NULL);
-    assert(to != NULL);
-
+//! \brief Receive a message with absolute CLOCK_REALTIME timespec timeout.
+static osal_retval_t osal_mq_receive_ts(osal_mq_t *mq, osal_char_t *msg, const osal_size_t msg_len, 
+        osal_uint32_t *prio, const struct timespec *ts) {
     osal_retval_t ret = OSAL_ERR_INTERRUPTED;
 
-    struct timespec ts;
-    ts.tv_sec = to->sec;
-    ts.tv_nsec = to->nsec;
-
     while (ret == OSAL_ERR_INTERRUPTED) {
-        int local_ret = mq_timedreceive(mq->mq_desc, msg, msg_len, prio, &ts);
+        int local_ret = mq_timedreceive(mq->mq_desc, msg, msg_len, prio, ts);
         if (local_ret == -1) {
             switch (errno) {
                 case EAGAIN:    // The queue was full, and the O_NONBLOCK flag was set for the message queue description 
@@ -338,6 +376,76 @@ osal_retval_t osal_mq_timedreceive(osal_mq_t *mq, osal_char_t *msg, const osal_s
     return ret;
 }
 
+//! \brief Receive a message through message queue.
+/*!
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[out]  msg     Pointer to message buffer.
+ * \param[in]   msg_len Lenght of message to receive.
+ * \param[out]  prio    Receive priority.
+ * \param[in]   to      Timeout waiting if message queue is full.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_timedreceive(osal_mq_t *mq, osal_char_t *msg, const osal_size_t msg_len, 
+        osal_uint32_t *prio, const osal_timer_t *to) {
+    assert(mq != NULL);
+    assert(msg != NULL);
+    assert(to != NULL);
+
+    // mq_timed* only accept CLOCK_REALTIME timeouts
+    struct timespec ts;
+    if (mq->clock_id == CLOCK_REALTIME) {
+        ts.tv_sec = to->sec;
+        ts.tv_nsec = to->nsec;
+    } else {
+        osal_timer_posix_to_realtime(mq->clock_id, osal_timer_to_nsec(to), &ts);
+    }
+
+    return osal_mq_receive_ts(mq, msg, msg_len, prio, &ts);
+}
+
+//! \brief Receive a message through message queue until a deadline in nanoseconds.
+/*!
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[out]  msg         Pointer to message buffer.
+ * \param[in]   msg_len     Lenght of message to receive.
+ * \param[out]  prio        Receive priority.
+ * \param[in]   deadline_ns Absolute timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_receive_until_ns(osal_mq_t *mq, osal_char_t *msg, const osal_size_t msg_len, 
+        osal_uint32_t *prio, osal_uint64_t deadline_ns) {
+    assert(mq != NULL);
+    assert(msg != NULL);
+
+    // mq_timed* only accept CLOCK_REALTIME timeouts
+    struct timespec ts;
+    osal_timer_posix_to_realtime(mq->clock_id, deadline_ns, &ts);
+
+    return osal_mq_receive_ts(mq, msg, msg_len, prio, &ts);
+}
+
+//! \brief Receive a message through message queue waiting at most a time in nanoseconds.
+/*!
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[out]  msg         Pointer to message buffer.
+ * \param[in]   msg_len     Lenght of message to receive.
+ * \param[out]  prio        Receive priority.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_receive_for_ns(osal_mq_t *mq, osal_char_t *msg, const osal_size_t msg_len, 
+        osal_uint32_t *prio, osal_uint64_t rel_ns) {
+    assert(mq != NULL);
+    assert(msg != NULL);
+
+    struct timespec ts;
+    osal_timer_posix_ns_to_timespec(osal_timer_posix_gettime_ns(CLOCK_REALTIME) + rel_ns, &ts);
+
+    return osal_mq_receive_ts(mq, msg, msg_len, prio, &ts);
+}
 
 //! \brief Closes an open mq.
 /*!
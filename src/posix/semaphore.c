@@ -28,7 +28,9 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#define _GNU_SOURCE             /* See feature_test_macros(7) */
 #include <libosal/osal.h>
+#include <libosal/config.h>
 #include <assert.h>
 #include <errno.h>
 
@@ -55,6 +57,9 @@ osal_retval_t osal_semaphore_init(osal_semaphore_t *sem, const osal_semaphore_at
         }
     }
 
+    sem->clock_id = osal_timer_posix_clock(attr != NULL ?
+            (((*attr) & OSAL_SEMAPHORE_ATTR__CLOCK__MASK) >> OSAL_SEMAPHORE_ATTR__CLOCK__SHIFT) : 0u);
+
     local_ret = sem_init(&sem->posix_sem, pshared, posix_initval);
     if (local_ret != 0) {
         if (local_ret == ENOSYS) {
@@ -141,6 +146,34 @@ osal_retval_t osal_semaphore_trywait(osal_semaphore_t *sem) {
     return ret;
 }
 
+//! \brief Wait for a semaphore with absolute timespec timeout.
+static osal_retval_t osal_semaphore_wait_ts(osal_semaphore_t *sem, const struct timespec *ts) {
+    osal_retval_t ret = OSAL_OK;
+
+    while (ret == OSAL_OK) {
+#if LIBOSAL_HAVE_SEM_CLOCKWAIT == 1
+        int local_ret = sem_clockwait(&sem->posix_sem, sem->clock_id, ts);
+#else
+        int local_ret = sem_timedwait(&sem->posix_sem, ts);
+#endif
+        int local_errno = errno;
+
+        if (local_ret == 0) {
+            break;
+        } else if (local_errno == EINTR) {
+            // continue while loop here
+        } else if (local_errno == EINVAL) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else if (local_errno == ETIMEDOUT) {
+            ret = OSAL_ERR_TIMEOUT;
+        } else {
+            ret = OSAL_ERR_OPERATION_FAILED;
+        }
+    }
+
+    return ret;
+}
+
 //! \brief Wait for a semaphore.
 /*!
  * \param[in]   sem     Pointer to osal semaphore structure. Content is OS dependent.
@@ -152,51 +185,65 @@ osal_retval_t osal_semaphore_timedwait(osal_semaphore_t *sem, const osal_timer_t
     assert(sem != NULL);
     assert(to != NULL);
 
-    osal_retval_t ret = OSAL_OK;
-
     struct timespec ts;
 
-    if (global_clock_id == CLOCK_REALTIME) {
+#if LIBOSAL_HAVE_SEM_CLOCKWAIT == 1
+    ts.tv_sec = to->sec;
+    ts.tv_nsec = to->nsec;
+#else
+    if (sem->clock_id == CLOCK_REALTIME) {
         ts.tv_sec = to->sec;
         ts.tv_nsec = to->nsec;
     } else {
         // need to convert because sem_timedwait needs absolute timeout based on CLOCK_REALTIME
-        osal_uint64_t to_nsec = osal_timer_to_nsec(to),
-                      act_nsec = osal_timer_gettime_nsec();
-
-        if (act_nsec > to_nsec) {
-            // timeout already in the past
-            ret = OSAL_ERR_TIMEOUT;            
-        } else {
-            clock_gettime(CLOCK_REALTIME, &ts);
-            ts.tv_sec += (to_nsec - act_nsec) / NSEC_PER_SEC;
-            ts.tv_nsec += (to_nsec - act_nsec) % NSEC_PER_SEC;
-
-            if (ts.tv_nsec > NSEC_PER_SEC) {
-                ts.tv_nsec -= NSEC_PER_SEC;
-                ts.tv_sec++;
-            }
-        }
+        osal_timer_posix_to_realtime(sem->clock_id, osal_timer_to_nsec(to), &ts);
     }
+#endif
 
-    while (ret == OSAL_OK) {
-        int local_ret = sem_timedwait(&sem->posix_sem, &ts);
-        int local_errno = errno;
+    return osal_semaphore_wait_ts(sem, &ts);
+}
 
-        if (local_ret == 0) {
-            break;
-        } else if (local_errno == EINTR) {
-            // continue while loop here
-        } else if (local_errno == EINVAL) {
-            ret = OSAL_ERR_INVALID_PARAM;
-        } else if (local_errno == ETIMEDOUT) {
-            ret = OSAL_ERR_TIMEOUT;
-        } else {
-            ret = OSAL_ERR_OPERATION_FAILED;
-        }
-    }
+//! \brief Wait for a semaphore until a deadline in nanoseconds.
+/*!
+ * \param[in]   sem         Pointer to osal semaphore structure. Content is OS dependent.
+ * \param[in]   deadline_ns Absolute timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_semaphore_wait_until_ns(osal_semaphore_t *sem, osal_uint64_t deadline_ns) {
+    assert(sem != NULL);
 
-    return ret;
+    struct timespec ts;
+
+#if LIBOSAL_HAVE_SEM_CLOCKWAIT == 1
+    osal_timer_posix_ns_to_timespec(deadline_ns, &ts);
+#else
+    // need to convert because sem_timedwait needs absolute timeout based on CLOCK_REALTIME
+    osal_timer_posix_to_realtime(sem->clock_id, deadline_ns, &ts);
+#endif
+
+    return osal_semaphore_wait_ts(sem, &ts);
+}
+
+//! \brief Wait for a semaphore for a time in nanoseconds.
+/*!
+ * \param[in]   sem         Pointer to osal semaphore structure. Content is OS dependent.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_semaphore_wait_for_ns(osal_semaphore_t *sem, osal_uint64_t rel_ns) {
+    assert(sem != NULL);
+
+    struct timespec ts;
+
+#if LIBOSAL_HAVE_SEM_CLOCKWAIT == 1
+    osal_timer_posix_ns_to_timespec(osal_timer_posix_gettime_ns(sem->clock_id) + rel_ns, &ts);
+#else
+    osal_timer_posix_ns_to_timespec(osal_timer_posix_gettime_ns(CLOCK_REALTIME) + rel_ns, &ts);
+#endif
+
+    return osal_semaphore_wait_ts(sem, &ts);
 }
 
 //! \brief Destroys a semaphore.
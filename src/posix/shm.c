@@ -44,6 +44,8 @@
 #include <errno.h>
 #include <unistd.h>
 
+#ifdef LIBOSAL_HAVE_SYS_MMAN_H
+
 //! \brief Initialize a shm.
 /*!
  * \param[in]   shm     Pointer to osal shm structure. Content is OS dependent.
@@ -248,3 +250,138 @@ osal_retval_t osal_shm_close(osal_shm_t *shm) {
 }
 
 
+//! \brief Unmap a shm.
+/*!
+ * \param[in]   shm     Pointer to osal shm structure. Content is OS dependent.
+ * \param[in]   ptr     Pointer returned by \ref osal_shm_map.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_unmap(osal_shm_t *shm, osal_void_t *ptr) {
+    assert(shm != NULL);
+    assert(ptr != NULL);
+    osal_retval_t ret = OSAL_OK;
+
+    if (munmap(ptr, shm->size) != 0) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    }
+
+    return ret;
+}
+
+//! \brief Remove a shm name.
+/*!
+ * \param[in]   name    Shared memory name.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_unlink(const osal_char_t *name) {
+    assert(name != NULL);
+    osal_retval_t ret = OSAL_OK;
+
+    if (shm_unlink(name) != 0) {
+        switch (errno) {
+            case EACCES:    // The caller does not have permission to shm_unlink() this object.
+                ret = OSAL_ERR_PERMISSION_DENIED;
+                break;
+            case ENOENT:    // An attempt was to made to shm_unlink() a name that does not exist.
+                ret = OSAL_ERR_NOT_FOUND;
+                break;
+            case ENAMETOOLONG:
+            case EINVAL:
+                ret = OSAL_ERR_INVALID_PARAM;
+                break;
+            default:
+                ret = OSAL_ERR_OPERATION_FAILED;
+                break;
+        }
+    }
+
+    return ret;
+}
+
+#else /* LIBOSAL_HAVE_SYS_MMAN_H */
+
+//! \brief Initialize a shm.
+/*!
+ * Not supported without sys/mman.h.
+ *
+ * \param[in]   shm     Pointer to osal shm structure. Content is OS dependent.
+ * \param[in]   name    Shared memory name.
+ * \param[in]   attr    Pointer to initial shm attributes. Can be NULL.
+ * \param[in]   size    Size for shm creation.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_open(osal_shm_t *shm, const osal_char_t *name,  const osal_shm_attr_t *attr, const osal_size_t size) {
+    assert(shm != NULL);
+    assert(name != NULL);
+    (void)attr;
+    (void)size;
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Map a shm.
+/*!
+ * Not supported without sys/mman.h.
+ *
+ * \param[in]   shm     Pointer to osal shm structure. Content is OS dependent.
+ * \param[in]   attr    Pointer to map attributes.
+ * \param[out]  ptr     Pointer where to returned mapped data pointer.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_map(osal_shm_t *shm, const osal_shm_map_attr_t *attr, osal_void_t **ptr) {
+    assert(shm != NULL);
+    assert(ptr != NULL);
+    (void)attr;
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Closes an open shm.
+/*!
+ * Not supported without sys/mman.h.
+ *
+ * \param[in]   shm     Pointer to osal shm structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_close(osal_shm_t *shm) {
+    assert(shm != NULL);
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Unmap a shm.
+/*!
+ * Not supported without sys/mman.h.
+ *
+ * \param[in]   shm     Pointer to osal shm structure. Content is OS dependent.
+ * \param[in]   ptr     Pointer returned by \ref osal_shm_map.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_unmap(osal_shm_t *shm, osal_void_t *ptr) {
+    assert(shm != NULL);
+    (void)ptr;
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Remove a shm name.
+/*!
+ * Not supported without sys/mman.h.
+ *
+ * \param[in]   name    Shared memory name.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_unlink(const osal_char_t *name) {
+    assert(name != NULL);
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+#endif /* LIBOSAL_HAVE_SYS_MMAN_H */
@@ -0,0 +1,338 @@
+/**
+ * \file posix/span.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 17 Oct 2026
+ *
+ * \brief OSAL span posix source.
+ *
+ * OSAL span posix source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#define _GNU_SOURCE             /* See feature_test_macros(7) */
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include <libosal/config.h>
+#include <libosal/osal.h>
+#include <libosal/span.h>
+#include <libosal/timer.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//! Completed span.
+typedef struct osal_span_event {
+    osal_uint64_t seq;                              //!< Span index + 1, 0 while written.
+    const char *name;                               //!< Static span name.
+    osal_uint64_t start;                            //!< Begin time in [ns].
+    osal_uint64_t dur;                              //!< Duration in [ns].
+} osal_span_event_t;
+
+//! Span buffer of one thread.
+typedef struct osal_span_buffer {
+    struct osal_span_buffer *next;                  //!< Next registered buffer.
+    osal_uint32_t tid;                              //!< Kernel thread id.
+    char thread_name[OSAL_SPAN_THREAD_NAME_LEN];    //!< Thread name for export.
+
+    osal_uint32_t mask;                             //!< Number of events - 1.
+    osal_uint64_t head;                             //!< Number of completed spans, written by owner.
+    osal_uint64_t dropped;                          //!< Dropped spans.
+
+    osal_uint32_t depth;                            //!< Currently open spans.
+    const char *open_name[OSAL_SPAN_MAX_DEPTH];     //!< Names of open spans.
+    osal_uint64_t open_start[OSAL_SPAN_MAX_DEPTH];  //!< Begin times of open spans.
+
+    osal_span_event_t *events;                      //!< Completed spans ring.
+} osal_span_buffer_t;
+
+static pthread_mutex_t span_lock = PTHREAD_MUTEX_INITIALIZER;
+static osal_span_buffer_t *span_buffers = NULL;
+//! Incremented by cleanup to invalidate thread local buffer pointers.
+static osal_uint32_t span_generation = 1u;
+
+static __thread osal_span_buffer_t *span_tls_buf = NULL;
+static __thread osal_uint32_t span_tls_generation = 0u;
+
+//! \brief Get span buffer of calling thread or NULL.
+static inline osal_span_buffer_t *span_get_buffer(void) {
+    osal_span_buffer_t *buf = span_tls_buf;
+
+    if ((buf != NULL) && (span_tls_generation != __atomic_load_n(&span_generation, __ATOMIC_RELAXED))) {
+        buf = NULL;
+    }
+
+    return buf;
+}
+
+//! \brief Initialize span buffer of calling thread.
+/*!
+ * \param[in]   size            Number of spans to keep, rounded up to a power of two.
+ * \param[in]   thread_name     Thread name shown in the export, NULL for the OS thread name.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_span_thread_init(osal_uint32_t size, const char *thread_name) {
+    osal_retval_t ret = OSAL_OK;
+    osal_span_buffer_t *buf = NULL;
+    osal_uint32_t cnt = 1u;
+
+    if ((size == 0u) || (size > 0x80000000u)) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else if (span_get_buffer() != NULL) {
+        ret = OSAL_ERR_BUSY;
+    } else {
+        while (cnt < size) {
+            cnt <<= 1u;
+        }
+
+        buf = (osal_span_buffer_t *)calloc(1u, sizeof(osal_span_buffer_t));
+        if (buf != NULL) {
+            buf->events = (osal_span_event_t *)calloc(cnt, sizeof(osal_span_event_t));
+        }
+
+        if ((buf == NULL) || (buf->events == NULL)) {
+            free(buf);
+            ret = OSAL_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (ret == OSAL_OK) {
+        buf->mask = cnt - 1u;
+        buf->tid = (osal_uint32_t)syscall(SYS_gettid);
+
+        if (thread_name != NULL) {
+            (void)strncpy(buf->thread_name, thread_name, OSAL_SPAN_THREAD_NAME_LEN - 1u);
+        } else if (pthread_getname_np(pthread_self(), buf->thread_name, OSAL_SPAN_THREAD_NAME_LEN) != 0) {
+            (void)snprintf(buf->thread_name, OSAL_SPAN_THREAD_NAME_LEN, "%u", (unsigned)buf->tid);
+        }
+
+        pthread_mutex_lock(&span_lock);
+        buf->next = span_buffers;
+        span_buffers = buf;
+        span_tls_generation = span_generation;
+        pthread_mutex_unlock(&span_lock);
+
+        span_tls_buf = buf;
+    }
+
+    return ret;
+}
+
+//! \brief Begin a span.
+/*!
+ * \param[in]   name    Span name with static lifetime.
+ */
+void osal_span_begin(const char *name) {
+    osal_span_buffer_t *buf = span_get_buffer();
+
+    if (buf != NULL) {
+        if (buf->depth < OSAL_SPAN_MAX_DEPTH) {
+            buf->open_name[buf->depth] = name;
+            buf->open_start[buf->depth] = osal_timer_gettime_nsec();
+        } else {
+            buf->dropped++;
+        }
+
+        buf->depth++;
+    }
+}
+
+//! \brief End the innermost open span.
+/*!
+ * Records the span in the buffer of the calling thread, counts it as
+ * dropped if no span is open.
+ */
+void osal_span_end(void) {
+    osal_span_buffer_t *buf = span_get_buffer();
+
+    if (buf == NULL) {
+        // no span buffer on this thread
+    } else if (buf->depth == 0u) {
+        buf->dropped++;
+    } else {
+        buf->depth--;
+
+        if (buf->depth < OSAL_SPAN_MAX_DEPTH) {
+            osal_uint64_t now = osal_timer_gettime_nsec();
+            osal_span_event_t *ev = &buf->events[buf->head & buf->mask];
+
+            // invalidate slot for exporter while overwriting it
+            __atomic_store_n(&ev->seq, 0u, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+
+            ev->name = buf->open_name[buf->depth];
+            ev->start = buf->open_start[buf->depth];
+            ev->dur = now - ev->start;
+
+            __atomic_store_n(&ev->seq, buf->head + 1u, __ATOMIC_RELEASE);
+            __atomic_store_n(&buf->head, buf->head + 1u, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+//! \brief Get dropped spans of calling thread.
+/*!
+ * \return Number of dropped spans.
+ */
+osal_uint64_t osal_span_get_dropped(void) {
+    osal_span_buffer_t *buf = span_get_buffer();
+
+    return buf != NULL ? buf->dropped : 0u;
+}
+
+//! \brief Write JSON string with escaping.
+static void span_write_string(FILE *fp, const char *str) {
+    (void)fputc('"', fp);
+
+    for (const char *c = str != NULL ? str : "(null)"; *c != '\0'; ++c) {
+        if ((*c == '"') || (*c == '\\')) {
+            (void)fputc('\\', fp);
+            (void)fputc(*c, fp);
+        } else if ((unsigned char)*c < 0x20u) {
+            (void)fprintf(fp, "\\u%04x", (unsigned)*c);
+        } else {
+            (void)fputc(*c, fp);
+        }
+    }
+
+    (void)fputc('"', fp);
+}
+
+//! \brief Write completed spans of one buffer.
+static osal_retval_t span_export_buffer(FILE *fp, osal_span_buffer_t *buf, unsigned pid,
+        osal_span_event_t *tmp) {
+    osal_uint64_t size = (osal_uint64_t)buf->mask + 1u;
+    osal_uint64_t head = __atomic_load_n(&buf->head, __ATOMIC_ACQUIRE);
+    osal_uint64_t first = head > size ? head - size : 0u;
+    osal_uint64_t cnt = 0u;
+
+    for (osal_uint64_t i = first; i < head; ++i) {
+        const osal_span_event_t *ev = &buf->events[i & buf->mask];
+        osal_uint64_t seq = __atomic_load_n(&ev->seq, __ATOMIC_ACQUIRE);
+
+        tmp[cnt] = *ev;
+
+        // skip slots the owner overwrote while copying
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if ((seq == (i + 1u)) && (__atomic_load_n(&ev->seq, __ATOMIC_RELAXED) == seq)) {
+            cnt++;
+        }
+    }
+
+    (void)fprintf(fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":",
+            pid, (unsigned)buf->tid);
+    span_write_string(fp, buf->thread_name);
+    (void)fprintf(fp, "}}");
+
+    for (osal_uint64_t i = 0u; i < cnt; ++i) {
+        const osal_span_event_t *ev = &tmp[i];
+
+        (void)fprintf(fp, ",\n{\"name\":");
+        span_write_string(fp, ev->name);
+        (void)fprintf(fp, ",\"ph\":\"X\",\"ts\":%lu.%03u,\"dur\":%lu.%03u,\"pid\":%u,\"tid\":%u}",
+                (unsigned long)(ev->start / 1000u), (unsigned)(ev->start % 1000u),
+                (unsigned long)(ev->dur / 1000u), (unsigned)(ev->dur % 1000u),
+                pid, (unsigned)buf->tid);
+    }
+
+    return ferror(fp) != 0 ? OSAL_ERR_OPERATION_FAILED : OSAL_OK;
+}
+
+//! \brief Export recorded spans.
+/*!
+ * \param[in]   filename    Output file name.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_span_export_chrome(const char *filename) {
+    osal_retval_t ret = OSAL_OK;
+    osal_span_event_t *tmp = NULL;
+    FILE *fp = NULL;
+
+    if (filename == NULL) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        fp = fopen(filename, "w");
+        if (fp == NULL) {
+            ret = ((errno == EACCES) || (errno == EPERM)) ? OSAL_ERR_PERMISSION_DENIED : OSAL_ERR_OPERATION_FAILED;
+        }
+    }
+
+    if (ret == OSAL_OK) {
+        unsigned pid = (unsigned)getpid();
+
+        (void)fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+        (void)fprintf(fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"libosal\"}}", pid);
+
+        pthread_mutex_lock(&span_lock);
+
+        for (osal_span_buffer_t *buf = span_buffers; (buf != NULL) && (ret == OSAL_OK); buf = buf->next) {
+            osal_span_event_t *new_tmp = (osal_span_event_t *)realloc(tmp,
+                    ((osal_uint64_t)buf->mask + 1u) * sizeof(osal_span_event_t));
+            if (new_tmp == NULL) {
+                ret = OSAL_ERR_OUT_OF_MEMORY;
+            } else {
+                tmp = new_tmp;
+                ret = span_export_buffer(fp, buf, pid, tmp);
+            }
+        }
+
+        pthread_mutex_unlock(&span_lock);
+
+        (void)fprintf(fp, "\n]}\n");
+
+        if ((fclose(fp) != 0) && (ret == OSAL_OK)) {
+            ret = OSAL_ERR_OPERATION_FAILED;
+        }
+    }
+
+    free(tmp);
+    return ret;
+}
+
+//! \brief Free all span buffers.
+/*!
+ * No thread may record spans concurrently.
+ */
+void osal_span_cleanup(void) {
+    pthread_mutex_lock(&span_lock);
+
+    osal_span_buffer_t *buf = span_buffers;
+    span_buffers = NULL;
+    __atomic_add_fetch(&span_generation, 1u, __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&span_lock);
+
+    while (buf != NULL) {
+        osal_span_buffer_t *next = buf->next;
+        free(buf->events);
+        free(buf);
+        buf = next;
+    }
+
+    span_tls_buf = NULL;
+}
+
@@ -29,10 +29,124 @@
  */
 
 #include <libosal/osal.h>
+#include <libosal/cpu.h>
 
 #include <errno.h>
 #include <pthread.h>
 #include <assert.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+//! Spins before a waiter yields the CPU, lets a preempted owner run.
+#define POSIX_SPINLOCK_SPINS_BEFORE_YIELD   1024u
+//! Upper bound of the TTAS backoff in spins.
+#define POSIX_SPINLOCK_BACKOFF_MAX          1024u
+
+//! Cached thread id + 1 of this thread, selects the preferred MCS node.
+static __thread osal_uint32_t posix_spinlock_mcs_hint = 0u;
+
+//! \brief Spin once, yield the CPU now and then.
+/*!
+ * \param[in,out]   spins   Spin counter of the caller.
+ */
+static inline void posix_spinlock_relax(osal_uint32_t *spins) {
+    osal_cpu_relax();
+
+    (*spins)++;
+    if (*spins >= POSIX_SPINLOCK_SPINS_BEFORE_YIELD) {
+        *spins = 0u;
+        (void)sched_yield();
+    }
+}
+
+//! \brief Lock a ticket lock.
+/*!
+ * \param[in]   mtx     Pointer to osal spinlock structure.
+ */
+static void posix_spinlock_ticket_lock(osal_spinlock_t *mtx) {
+    osal_uint32_t ticket = __atomic_fetch_add(&mtx->next, 1u, __ATOMIC_RELAXED);
+    osal_uint32_t spins = 0u;
+
+    while (__atomic_load_n(&mtx->owner, __ATOMIC_ACQUIRE) != ticket) {
+        posix_spinlock_relax(&spins);
+    }
+}
+
+//! \brief Unlock a ticket lock.
+/*!
+ * \param[in]   mtx     Pointer to osal spinlock structure.
+ */
+static void posix_spinlock_ticket_unlock(osal_spinlock_t *mtx) {
+    // only the owner writes owner
+    __atomic_store_n(&mtx->owner, __atomic_load_n(&mtx->owner, __ATOMIC_RELAXED) + 1u, __ATOMIC_RELEASE);
+}
+
+//! \brief Lock a test-and-test-and-set lock.
+/*!
+ * \param[in]   mtx     Pointer to osal spinlock structure.
+ */
+static void posix_spinlock_ttas_lock(osal_spinlock_t *mtx) {
+    osal_uint32_t backoff = 1u;
+    osal_uint32_t spins = 0u;
+
+    while (__atomic_exchange_n(&mtx->next, 1u, __ATOMIC_ACQUIRE) != 0u) {
+        // wait on the cached value, only retry the exchange when free
+        do {
+            for (osal_uint32_t i = 0u; i < backoff; ++i) {
+                posix_spinlock_relax(&spins);
+            }
+
+            if (backoff < POSIX_SPINLOCK_BACKOFF_MAX) {
+                backoff <<= 1u;
+            }
+        } while (__atomic_load_n(&mtx->next, __ATOMIC_RELAXED) != 0u);
+    }
+}
+
+//! \brief Unlock a test-and-test-and-set lock.
+/*!
+ * \param[in]   mtx     Pointer to osal spinlock structure.
+ */
+static void posix_spinlock_ttas_unlock(osal_spinlock_t *mtx) {
+    __atomic_store_n(&mtx->next, 0u, __ATOMIC_RELEASE);
+}
+
+//! \brief Claim a free MCS queue node.
+/*!
+ * Starts at a node derived from the thread id, so threads usually get
+ * the same node without touching a shared word.
+ *
+ * \param[in]   mtx     Pointer to osal MCS spinlock structure.
+ *
+ * \return Index of the claimed node.
+ */
+static osal_uint32_t posix_spinlock_mcs_claim(osal_spinlock_mcs_t *mtx) {
+    osal_uint32_t spins = 0u;
+    osal_bool_t claimed = OSAL_FALSE;
+
+    if (posix_spinlock_mcs_hint == 0u) {
+        posix_spinlock_mcs_hint = (osal_uint32_t)syscall(SYS_gettid) + 1u;
+    }
+
+    osal_uint32_t idx = posix_spinlock_mcs_hint % OSAL_SPINLOCK_MCS_NODES;
+
+    while (claimed == OSAL_FALSE) {
+        osal_uint32_t *used = &mtx->nodes[idx].used;
+        osal_uint32_t expected = 0u;
+
+        if ((__atomic_load_n(used, __ATOMIC_RELAXED) == 0u) &&
+                __atomic_compare_exchange_n(used, &expected, 1u, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            claimed = OSAL_TRUE;
+        } else {
+            idx = (idx + 1u) % OSAL_SPINLOCK_MCS_NODES;
+            posix_spinlock_relax(&spins);
+        }
+    }
+
+    return idx;
+}
 
 //! \brief Initialize a spinlock.
 /*!
@@ -46,49 +160,26 @@ osal_retval_t osal_spinlock_init(osal_spinlock_t *mtx, const osal_spinlock_attr_
     assert(mtx != NULL);
 
     osal_retval_t ret = OSAL_OK;
-    int posix_ret;
+    int posix_ret = 0;
+    int pshared = PTHREAD_PROCESS_PRIVATE;
 
-    (void)attr;
-/*
-    pthread_spinlockattr_t posix_attr;
-    pthread_spinlockattr_t *pposix_attr = NULL;
+    (void)memset(mtx, 0, sizeof(*mtx));
 
     if (attr != NULL) {
-        pthread_spinlockattr_init(&posix_attr);
-
-        if (((*attr) & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__NORMAL) {
-            pthread_spinlockattr_settype(&posix_attr, PTHREAD_SPINLOCK_NORMAL);
-        } else if (((*attr) & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__ERRORCHECK) {
-            pthread_spinlockattr_settype(&posix_attr, PTHREAD_SPINLOCK_ERRORCHECK);
-        } else if (((*attr) & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__RECURSIVE) {
-            pthread_spinlockattr_settype(&posix_attr, PTHREAD_SPINLOCK_RECURSIVE);
-        }
-
-        if (((*attr) & OSAL_SPINLOCK_ATTR__ROBUST) == OSAL_SPINLOCK_ATTR__ROBUST) {
-            pthread_spinlockattr_setrobust(&posix_attr, PTHREAD_SPINLOCK_ROBUST);
-        }
+        mtx->algorithm = (*attr) & OSAL_SPINLOCK_ATTR__ALGORITHM__MASK;
 
         if (((*attr) & OSAL_SPINLOCK_ATTR__PROCESS_SHARED) == OSAL_SPINLOCK_ATTR__PROCESS_SHARED) {
-            pthread_spinlockattr_setpshared(&posix_attr, PTHREAD_PROCESS_SHARED);
-        }
-        
-        if (((*attr) & OSAL_SPINLOCK_ATTR__PROTOCOL__MASK) == OSAL_SPINLOCK_ATTR__PROTOCOL__NONE) {
-            pthread_spinlockattr_setprotocol(&posix_attr, PTHREAD_PRIO_NONE);
-        } else if (((*attr) & OSAL_SPINLOCK_ATTR__PROTOCOL__MASK) == OSAL_SPINLOCK_ATTR__PROTOCOL__INHERIT) {
-            pthread_spinlockattr_setprotocol(&posix_attr, PTHREAD_PRIO_INHERIT);
-        } else if (((*attr) & OSAL_SPINLOCK_ATTR__PROTOCOL__MASK) == OSAL_SPINLOCK_ATTR__PROTOCOL__PROTECT) {
-            pthread_spinlockattr_setprotocol(&posix_attr, PTHREAD_PRIO_PROTECT);
+            pshared = PTHREAD_PROCESS_SHARED;
         }
+    }
 
-        if (((*attr) & OSAL_SPINLOCK_ATTR__PRIOCEILING__MASK) != 0u) {
-            int prioceiling = (((*attr) & OSAL_SPINLOCK_ATTR__PRIOCEILING__MASK) >> OSAL_SPINLOCK_ATTR__PRIOCEILING__SHIFT);
-            pthread_spinlockattr_setprioceiling(&posix_attr, prioceiling);
-        }
-
-        pposix_attr = &posix_attr;
-    }*/
-
-    posix_ret = pthread_spin_init(&mtx->posix_sl, 0);//pposix_attr);
+    // own algorithms are ready after zeroing
+    if (mtx->algorithm == OSAL_SPINLOCK_ATTR__ALGORITHM__DEFAULT) {
+        posix_ret = pthread_spin_init(&mtx->posix_sl, pshared);
+    } else if ((mtx->algorithm != OSAL_SPINLOCK_ATTR__ALGORITHM__TICKET) &&
+            (mtx->algorithm != OSAL_SPINLOCK_ATTR__ALGORITHM__TTAS)) {
+        posix_ret = EINVAL;
+    }
 
     if (posix_ret != 0) {
         if (posix_ret == EAGAIN) {
@@ -119,9 +210,16 @@ osal_retval_t osal_spinlock_lock(osal_spinlock_t *mtx) {
     assert(mtx != NULL);
 
     osal_retval_t ret;
-    int posix_ret;
+    int posix_ret = 0;
+
+    if (mtx->algorithm == OSAL_SPINLOCK_ATTR__ALGORITHM__TICKET) {
+        posix_spinlock_ticket_lock(mtx);
+    } else if (mtx->algorithm == OSAL_SPINLOCK_ATTR__ALGORITHM__TTAS) {
+        posix_spinlock_ttas_lock(mtx);
+    } else {
+        posix_ret = pthread_spin_lock(&mtx->posix_sl);
+    }
 
-    posix_ret = pthread_spin_lock(&mtx->posix_sl);
     if (posix_ret != 0) {
         if (posix_ret == EAGAIN) {
             ret = OSAL_ERR_SYSTEM_LIMIT_REACHED;
@@ -155,9 +253,16 @@ osal_retval_t osal_spinlock_unlock(osal_spinlock_t *mtx) {
     assert(mtx != NULL);
 
     osal_retval_t ret;
-    int posix_ret;
+    int posix_ret = 0;
+
+    if (mtx->algorithm == OSAL_SPINLOCK_ATTR__ALGORITHM__TICKET) {
+        posix_spinlock_ticket_unlock(mtx);
+    } else if (mtx->algorithm == OSAL_SPINLOCK_ATTR__ALGORITHM__TTAS) {
+        posix_spinlock_ttas_unlock(mtx);
+    } else {
+        posix_ret = pthread_spin_unlock(&mtx->posix_sl);
+    }
 
-    posix_ret = pthread_spin_unlock(&mtx->posix_sl);
     if (posix_ret != 0) {
         if (posix_ret == EPERM) {
             ret = OSAL_ERR_PERMISSION_DENIED;
@@ -181,12 +286,109 @@ osal_retval_t osal_spinlock_destroy(osal_spinlock_t *mtx) {
     assert(mtx != NULL);
 
     osal_retval_t ret = OSAL_OK;
-    int posix_ret;
+    int posix_ret = 0;
+
+    if (mtx->algorithm == OSAL_SPINLOCK_ATTR__ALGORITHM__DEFAULT) {
+        posix_ret = pthread_spin_destroy(&mtx->posix_sl);
+    }
 
-    posix_ret = pthread_spin_destroy(&mtx->posix_sl);
     if (posix_ret != 0) {
         ret = OSAL_ERR_OPERATION_FAILED;
     }
 
     return ret;
 }
+
+//! \brief Initialize an MCS queue lock.
+/*!
+ * \param[in]   mtx     Pointer to osal MCS spinlock structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_spinlock_mcs_init(osal_spinlock_mcs_t *mtx) {
+    assert(mtx != NULL);
+
+    (void)memset(mtx, 0, sizeof(*mtx));
+
+    return OSAL_OK;
+}
+
+//! \brief Locks an MCS queue lock.
+/*!
+ * Nodes are linked by index instead of pointer, so the lock works at
+ * different addresses in different processes.
+ *
+ * \param[in]   mtx     Pointer to osal MCS spinlock structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_spinlock_mcs_lock(osal_spinlock_mcs_t *mtx) {
+    assert(mtx != NULL);
+
+    osal_uint32_t idx = posix_spinlock_mcs_claim(mtx);
+    osal_spinlock_mcs_node_t *node = &mtx->nodes[idx];
+    osal_uint32_t spins = 0u;
+
+    __atomic_store_n(&node->next, 0u, __ATOMIC_RELAXED);
+    __atomic_store_n(&node->locked, 1u, __ATOMIC_RELAXED);
+
+    osal_uint32_t prev = __atomic_exchange_n(&mtx->tail, idx + 1u, __ATOMIC_ACQ_REL);
+    if (prev != 0u) {
+        __atomic_store_n(&mtx->nodes[prev - 1u].next, idx + 1u, __ATOMIC_RELEASE);
+
+        while (__atomic_load_n(&node->locked, __ATOMIC_ACQUIRE) != 0u) {
+            posix_spinlock_relax(&spins);
+        }
+    }
+
+    mtx->owner = idx;
+
+    return OSAL_OK;
+}
+
+//! \brief Unlocks an MCS queue lock.
+/*!
+ * \param[in]   mtx     Pointer to osal MCS spinlock structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_spinlock_mcs_unlock(osal_spinlock_mcs_t *mtx) {
+    assert(mtx != NULL);
+
+    osal_uint32_t idx = mtx->owner;
+    osal_spinlock_mcs_node_t *node = &mtx->nodes[idx];
+    osal_uint32_t succ = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+    osal_uint32_t spins = 0u;
+
+    if (succ == 0u) {
+        osal_uint32_t expected = idx + 1u;
+
+        if (__atomic_compare_exchange_n(&mtx->tail, &expected, 0u, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED) == 0) {
+            // a waiter swapped the tail but has not linked itself yet
+            while ((succ = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE)) == 0u) {
+                posix_spinlock_relax(&spins);
+            }
+        }
+    }
+
+    if (succ != 0u) {
+        __atomic_store_n(&mtx->nodes[succ - 1u].locked, 0u, __ATOMIC_RELEASE);
+    }
+
+    __atomic_store_n(&node->used, 0u, __ATOMIC_RELEASE);
+
+    return OSAL_OK;
+}
+
+//! \brief Destroys an MCS queue lock.
+/*!
+ * \param[in]   mtx     Pointer to osal MCS spinlock structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_spinlock_mcs_destroy(osal_spinlock_mcs_t *mtx) {
+    assert(mtx != NULL);
+    (void)mtx;
+
+    return OSAL_OK;
+}
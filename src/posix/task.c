@@ -31,11 +31,13 @@
 #define _GNU_SOURCE             /* See feature_test_macros(7) */
 #include <sched.h>
 #include <pthread.h>
+#include <semaphore.h>
 #include <signal.h>
 
 #include <libosal/config.h>
 #include <libosal/osal.h>
 #include <libosal/task.h>
+#include <libosal/task_registry.h>
 #include <libosal/io.h>
 
 #if LIBOSAL_HAVE_SYS_PRCTL_H == 1
@@ -44,17 +46,296 @@
 
 #include <errno.h>
 #include <assert.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 
 #include <string.h>
 
+#ifndef SCHED_BATCH
+#define SCHED_BATCH     3
+#endif
+#ifndef SCHED_IDLE
+#define SCHED_IDLE      5
+#endif
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE  6
+#endif
+
+//! Kernel sched_attr, not declared by older C libraries.
+typedef struct posix_sched_attr {
+    osal_uint32_t size;
+    osal_uint32_t sched_policy;
+    osal_uint64_t sched_flags;
+    osal_int32_t sched_nice;
+    osal_uint32_t sched_priority;
+    osal_uint64_t sched_runtime;
+    osal_uint64_t sched_deadline;
+    osal_uint64_t sched_period;
+} posix_sched_attr_t;
+
+//! Policy and priority already set with the pthread attributes.
+#define POSIX_TASK_APPLIED_SCHED        0x01u
+//! Affinity already set with the pthread attributes.
+#define POSIX_TASK_APPLIED_AFFINITY     0x02u
+
 typedef struct posix_start_args {
-    int running;
+    sem_t started;                  //!< Posted by the new task when start_args are no longer used.
+    unsigned applied;               //!< POSIX_TASK_APPLIED_* flags.
 
     osal_task_handler_t user_handler;
     osal_task_handler_arg_t user_arg;
     const osal_task_attr_t *user_attr;
+    osal_task_t *hdl;
 } posix_start_args_t;
 
+//! \brief Map osal policy to posix policy, -1 for deadline.
+static int posix_policy_from_osal(osal_task_sched_policy_t policy) {
+    int ret = SCHED_OTHER;
+
+    if (policy == OSAL_SCHED_POLICY_FIFO) {
+        ret = SCHED_FIFO;
+    } else if (policy == OSAL_SCHED_POLICY_ROUND_ROBIN) {
+        ret = SCHED_RR;
+    } else if (policy == OSAL_SCHED_POLICY_BATCH) {
+        ret = SCHED_BATCH;
+    } else if (policy == OSAL_SCHED_POLICY_IDLE) {
+        ret = SCHED_IDLE;
+    } else if (policy == OSAL_SCHED_POLICY_DEADLINE) {
+        // needs runtime, deadline and period
+        ret = -1;
+    }
+
+    return ret;
+}
+
+//! \brief Map posix policy to osal policy.
+static osal_task_sched_policy_t posix_policy_to_osal(int policy) {
+    osal_task_sched_policy_t ret = OSAL_SCHED_POLICY_OTHER;
+
+    if (policy == SCHED_FIFO) {
+        ret = OSAL_SCHED_POLICY_FIFO;
+    } else if (policy == SCHED_RR) {
+        ret = OSAL_SCHED_POLICY_ROUND_ROBIN;
+    } else if (policy == SCHED_BATCH) {
+        ret = OSAL_SCHED_POLICY_BATCH;
+    } else if (policy == SCHED_IDLE) {
+        ret = OSAL_SCHED_POLICY_IDLE;
+    } else if (policy == SCHED_DEADLINE) {
+        ret = OSAL_SCHED_POLICY_DEADLINE;
+    }
+
+    return ret;
+}
+
+//! \brief Get affinity of task attributes, returns 0 if none is set.
+/*!
+ * A set with CPUs from 32 on cannot come from the legacy mask, so it wins
+ * over a mask that was filled from the same set.
+ */
+static int posix_task_attr_cpuset(const osal_task_attr_t *attr, osal_cpuset_t *cpuset) {
+    if ((attr->affinity != 0u) && (osal_cpuset_next(&attr->cpuset, 31) < 0)) {
+        osal_cpuset_from_mask(cpuset, attr->affinity);
+    } else {
+        (*cpuset) = attr->cpuset;
+    }
+
+    return osal_cpuset_count(cpuset) != 0u;
+}
+
+#if LIBOSAL_HAVE_PTHREAD_SETAFFINITY_NP
+//! \brief Convert osal CPU set to posix CPU set.
+static void posix_cpuset_from_osal(cpu_set_t *dst, const osal_cpuset_t *src) {
+    CPU_ZERO(dst);
+
+    for (osal_int32_t cpu = osal_cpuset_next(src, -1); (cpu >= 0) && (cpu < CPU_SETSIZE);
+            cpu = osal_cpuset_next(src, cpu)) {
+        CPU_SET(cpu, dst);
+    }
+}
+
+//! \brief Convert posix CPU set to osal CPU set.
+static void posix_cpuset_to_osal(osal_cpuset_t *dst, const cpu_set_t *src) {
+    osal_cpuset_zero(dst);
+
+    for (osal_uint32_t cpu = 0u; (cpu < CPU_SETSIZE) && (cpu < OSAL_CPUSET_SIZE); ++cpu) {
+        if (CPU_ISSET(cpu, src) != 0) {
+            osal_cpuset_set(dst, cpu);
+        }
+    }
+}
+#endif
+
+//! \brief Fields of /proc/self/task/<tid>/stat.
+typedef struct posix_task_proc_stat {
+    char state;                     //!< Scheduler state, e.g. 'R' or 'S'.
+    osal_uint64_t minor_faults;     //!< Page faults served without I/O.
+    osal_uint64_t major_faults;     //!< Page faults which needed I/O.
+    osal_int32_t cpu;               //!< CPU the thread last ran on.
+} posix_task_proc_stat_t;
+
+//! \brief Read a procfs file of a thread of this process.
+/*!
+ * \param[in]   ktid    Kernel thread id.
+ * \param[in]   name    File name in the thread directory.
+ * \param[out]  buf     Buffer for file content, null terminated.
+ * \param[in]   size    Size of \p buf.
+ *
+ * \return 0 on success, -1 if the thread does not exist.
+ */
+static int posix_task_read_proc(pid_t ktid, const char *name, char *buf, osal_size_t size) {
+    int ret = -1;
+    char path[64];
+
+    if (ktid > 0) {
+        (void)snprintf(path, sizeof(path), "/proc/self/task/%d/%s", (int)ktid, name);
+
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            ssize_t len = read(fd, buf, size - 1u);
+            if (len > 0) {
+                buf[len] = '\0';
+                ret = 0;
+            }
+
+            (void)close(fd);
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Read state, faults and CPU of a thread from procfs.
+/*!
+ * \param[in]   ktid    Kernel thread id.
+ * \param[out]  stat    Returns the parsed fields.
+ *
+ * \return 0 on success, -1 if the thread does not exist.
+ */
+static int posix_task_read_proc_stat(pid_t ktid, posix_task_proc_stat_t *stat) {
+    char buf[512];
+    int ret = posix_task_read_proc(ktid, "stat", buf, sizeof(buf));
+
+    if (ret == 0) {
+        // the name in field 2 may contain spaces and parentheses
+        char *pos = strrchr(buf, ')');
+
+        if ((pos == NULL) || (pos[1] != ' ')) {
+            ret = -1;
+        } else {
+            stat->state = pos[2];
+            pos = &pos[3];
+
+            // fields 4 and following, see proc(5)
+            for (int field = 4; (field <= 39) && (*pos != '\0'); ++field) {
+                char *end;
+                unsigned long long val = strtoull(pos, &end, 10);
+
+                if (field == 10) {
+                    stat->minor_faults = val;
+                } else if (field == 12) {
+                    stat->major_faults = val;
+                } else if (field == 39) {
+                    stat->cpu = (osal_int32_t)val;
+                }
+
+                pos = end;
+            }
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Read context switch counters of a thread from procfs.
+/*!
+ * \param[in]   ktid    Kernel thread id.
+ * \param[out]  stats   Returns the counters.
+ *
+ * \return 0 on success, -1 if the thread does not exist.
+ */
+static int posix_task_read_proc_switches(pid_t ktid, osal_task_stats_t *stats) {
+    char buf[2048];
+    int ret = posix_task_read_proc(ktid, "status", buf, sizeof(buf));
+
+    if (ret == 0) {
+        const char *vol = strstr(buf, "\nvoluntary_ctxt_switches:");
+        const char *invol = strstr(buf, "\nnonvoluntary_ctxt_switches:");
+
+        if ((vol == NULL) || (invol == NULL)) {
+            ret = -1;
+        } else {
+            stats->voluntary_switches = strtoull(strchr(vol, ':') + 1, NULL, 10);
+            stats->involuntary_switches = strtoull(strchr(invol, ':') + 1, NULL, 10);
+        }
+    }
+
+    return ret;
+}
+
+//! Bytes of stack touched by one call of \ref posix_task_prefault_frame.
+#define POSIX_TASK_PREFAULT_FRAME   4096u
+
+//! \brief Return bytes of stack left below the caller.
+/*!
+ * \return Bytes left, 0 if the stack cannot be determined.
+ */
+static osal_size_t posix_task_stack_left(void) {
+    volatile osal_uint8_t marker = 0u;
+    osal_size_t ret = 0u;
+
+#ifdef __GLIBC__
+    pthread_attr_t pattr;
+    void *stack_addr;
+    size_t stack_size;
+
+    if (pthread_getattr_np(pthread_self(), &pattr) == 0) {
+        // the guard pages lie below stack_addr
+        if (pthread_attr_getstack(&pattr, &stack_addr, &stack_size) == 0) {
+            ret = (osal_size_t)((const osal_uint8_t *)&marker - (const osal_uint8_t *)stack_addr);
+        }
+
+        (void)pthread_attr_destroy(&pattr);
+    }
+#endif
+
+    (void)marker;
+
+    return ret;
+}
+
+//! \brief Touch \p size bytes of stack below the caller.
+/*!
+ * Recurses with one fixed size frame per call. The first and last byte of
+ * every frame are written, frames are less than a page apart, so every
+ * page is write faulted.
+ *
+ * \param[in]   size    Bytes to touch.
+ *
+ * \return Always 0, keeps the recursion from being turned into a loop.
+ */
+static osal_uint8_t __attribute__((noinline)) posix_task_prefault_frame(osal_size_t size) {
+    volatile osal_uint8_t frame[POSIX_TASK_PREFAULT_FRAME];
+    osal_uint8_t ret = 0u;
+
+    frame[0] = 0u;
+    frame[POSIX_TASK_PREFAULT_FRAME - 1u] = 0u;
+
+    if (size > POSIX_TASK_PREFAULT_FRAME) {
+        ret = posix_task_prefault_frame(size - POSIX_TASK_PREFAULT_FRAME);
+    }
+
+    return ret | frame[0];
+}
+
+//! \brief Remove an exiting task from the task registry.
+static void posix_task_unregister(void *arg) {
+    (void)osal_task_registry_remove((const osal_task_t *)arg);
+}
+
 static void *posix_task_wrapper(void *args) {
     // cppcheck-suppress misra-c2012-11.5
     posix_start_args_t *start_args = (posix_start_args_t *)args;
@@ -63,9 +344,13 @@ static void *posix_task_wrapper(void *args) {
     osal_task_handler_t user_handler = start_args->user_handler;
     osal_task_handler_arg_t user_arg = start_args->user_arg;
     const osal_task_attr_t *user_attr = start_args->user_attr;
+    osal_retval_t sched_status = OSAL_OK;
+
+    start_args->hdl->ktid = (pid_t)syscall(SYS_gettid);
 
     if (user_attr != NULL) {
-        if (user_attr->policy != 0u) {
+        if (((start_args->applied & POSIX_TASK_APPLIED_SCHED) == 0u) &&
+                (user_attr->policy != 0u) && (user_attr->policy != OSAL_SCHED_POLICY_DEADLINE)) {
             osal_retval_t local_ret = osal_task_set_policy(NULL, user_attr->policy);
             if (local_ret != OSAL_OK) {
                 switch (local_ret) {
@@ -79,10 +364,13 @@ static void *posix_task_wrapper(void *args) {
                         fprintf(stderr, "unknown error occured setting policy to %d: %d\n", user_attr->policy, local_ret);
                         break;
                 }
+
+                sched_status = local_ret;
             }
         }
 
-        if (user_attr->priority != 0u) {
+        if (((start_args->applied & POSIX_TASK_APPLIED_SCHED) == 0u) &&
+                (user_attr->priority != 0u) && (user_attr->policy != OSAL_SCHED_POLICY_DEADLINE)) {
             osal_retval_t local_ret = osal_task_set_priority(NULL, user_attr->priority);
             if (local_ret != OSAL_OK) {
                 switch (local_ret) {
@@ -96,20 +384,52 @@ static void *posix_task_wrapper(void *args) {
                         fprintf(stderr, "unknown error occured setting priority to %d: %d\n", user_attr->priority, local_ret);
                         break;
                 }
+
+                if (sched_status == OSAL_OK) {
+                    sched_status = local_ret;
+                }
             }
         }
 
-        if (user_attr->affinity > 0u) {
-            osal_retval_t local_ret = osal_task_set_affinity(NULL, user_attr->affinity);
+        osal_cpuset_t cpuset;
+        if (((start_args->applied & POSIX_TASK_APPLIED_AFFINITY) == 0u) && (posix_task_attr_cpuset(user_attr, &cpuset) != 0)) {
+            osal_retval_t local_ret = osal_task_set_cpuset(NULL, &cpuset);
             if (local_ret != OSAL_OK) {
                 switch (local_ret) {
                     case OSAL_ERR_INVALID_PARAM:
-                        fprintf(stderr, "unknown error occured setting affinity to %d: INVALID PARAMETER\n", user_attr->affinity);
+                        fprintf(stderr, "unknown error occured setting affinity to %u cpus: INVALID PARAMETER\n", osal_cpuset_count(&cpuset));
+                        break;
+                    default:
+                        fprintf(stderr, "unknown error occured setting affinity to %u cpus: %d\n", osal_cpuset_count(&cpuset), local_ret);
+                        break;
+                }
+
+                if (sched_status == OSAL_OK) {
+                    sched_status = local_ret;
+                }
+            }
+        }
+
+        // after affinity, deadline tasks may not change it afterwards
+        if (user_attr->policy == OSAL_SCHED_POLICY_DEADLINE) {
+            osal_retval_t local_ret = osal_task_set_deadline(NULL, user_attr->runtime,
+                    user_attr->deadline, user_attr->period);
+            if (local_ret != OSAL_OK) {
+                switch (local_ret) {
+                    case OSAL_ERR_ADMISSION_DENIED:
+                        fprintf(stderr, "error setting deadline policy: ADMISSION DENIED\n");
+                        break;
+                    case OSAL_ERR_PERMISSION_DENIED:
+                        fprintf(stderr, "error setting deadline policy: PERMISSION DENIED\n");
                         break;
                     default:
-                        fprintf(stderr, "unknown error occured setting affinity to %d: %d\n", user_attr->affinity, local_ret);
+                        fprintf(stderr, "error setting deadline policy: %d\n", local_ret);
                         break;
                 }
+
+                if (sched_status == OSAL_OK) {
+                    sched_status = local_ret;
+                }
             }
         }
 
@@ -117,13 +437,147 @@ static void *posix_task_wrapper(void *args) {
         if (strlen(user_attr->task_name) > 0u) {
             prctl(PR_SET_NAME, user_attr->task_name, 0, 0, 0);
         }
+
+        if (user_attr->timer_slack != 0u) {
+            if (prctl(PR_SET_TIMERSLACK, (unsigned long)user_attr->timer_slack, 0, 0, 0) != 0) {
+                fprintf(stderr, "error setting timer slack to %lu ns: %s\n", 
+                        (unsigned long)user_attr->timer_slack, strerror(errno));
+
+                if (sched_status == OSAL_OK) {
+                    sched_status = OSAL_ERR_OPERATION_FAILED;
+                }
+            }
+        }
 #endif
+
+        if (user_attr->stack_prefault != 0u) {
+            osal_size_t prefault = user_attr->stack_prefault;
+            osal_size_t left = posix_task_stack_left();
+
+            // leave room for the frame overhead of the recursion
+            left -= left / 4u;
+            if (prefault > left) {
+                prefault = left;
+            }
+
+            // every call touches a whole frame
+            prefault -= prefault % POSIX_TASK_PREFAULT_FRAME;
+            if (prefault != 0u) {
+                (void)posix_task_prefault_frame(prefault);
+            }
+        }
     }       
         
-    // after setting running to 1, we start_args will be invalid
-    start_args->running = 1;
+    start_args->hdl->sched_status = sched_status;
+    (void)osal_task_registry_add(start_args->hdl, user_attr);
+
+    // the caller's handle may be gone when the task exits
+    osal_task_t self = *start_args->hdl;
+    void *ret;
+
+    // after posting, start_args will be invalid
+    (void)sem_post(&start_args->started);
+
+    // unregister on return and on pthread_exit, before the kernel thread id can be reused
+    pthread_cleanup_push(posix_task_unregister, &self);
+    ret = (*user_handler)(user_arg);
+    pthread_cleanup_pop(1);
+
+    return ret;
+}
+
+//! \brief Set scheduling attributes of a new thread before it is started.
+/*!
+ * \param[in]   pattr   Initialized pthread attributes.
+ * \param[in]   attr    Osal task attributes.
+ *
+ * \return POSIX_TASK_APPLIED_* flags of attributes which were set.
+ */
+static unsigned posix_task_prepare_attr(pthread_attr_t *pattr, const osal_task_attr_t *attr) {
+    unsigned applied = 0u;
+
+    if ((attr->policy != OSAL_SCHED_POLICY_DEADLINE) && ((attr->policy != 0u) || (attr->priority != 0u))) {
+        int policy;
+        struct sched_param param;
+
+        // unspecified values are inherited from the creating thread like before
+        if (pthread_getschedparam(pthread_self(), &policy, &param) == 0) {
+            if (attr->policy != 0u) {
+                policy = posix_policy_from_osal(attr->policy);
+            }
+            if (attr->priority != 0u) {
+                param.sched_priority = (int)attr->priority;
+            }
+
+            if (sched_get_priority_min(policy) > param.sched_priority) {
+                param.sched_priority = sched_get_priority_min(policy);
+            } else if (sched_get_priority_max(policy) < param.sched_priority) {
+                param.sched_priority = sched_get_priority_max(policy);
+            }
+
+            if ((pthread_attr_setinheritsched(pattr, PTHREAD_EXPLICIT_SCHED) == 0) &&
+                    (pthread_attr_setschedpolicy(pattr, policy) == 0) &&
+                    (pthread_attr_setschedparam(pattr, &param) == 0)) {
+                applied |= POSIX_TASK_APPLIED_SCHED;
+            } else {
+                (void)pthread_attr_setinheritsched(pattr, PTHREAD_INHERIT_SCHED);
+            }
+        }
+    }
+
+#if LIBOSAL_HAVE_PTHREAD_SETAFFINITY_NP
+    osal_cpuset_t cpus;
+    if (posix_task_attr_cpuset(attr, &cpus) != 0) {
+        cpu_set_t cpuset;
+        posix_cpuset_from_osal(&cpuset, &cpus);
+
+        if (pthread_attr_setaffinity_np(pattr, sizeof(cpu_set_t), &cpuset) == 0) {
+            applied |= POSIX_TASK_APPLIED_AFFINITY;
+        }
+    }
+#endif
+
+    return applied;
+}
+
+//! \brief Create thread with pthread attributes from osal task attributes.
+/*!
+ * \param[in]   hdl         Pointer to osal task structure.
+ * \param[in]   attr        Osal task attributes.
+ * \param[in]   start_args  Arguments of the task wrapper, \p applied is set.
+ * \param[in]   with_sched  Also set scheduling attributes and affinity.
+ *
+ * \return 0 or error number of pthread functions.
+ */
+static int posix_task_create_attr(osal_task_t *hdl, const osal_task_attr_t *attr,
+        posix_start_args_t *start_args, int with_sched)
+{
+    pthread_attr_t pattr;
+    int local_ret = pthread_attr_init(&pattr);
+
+    start_args->applied = 0u;
+
+    if (local_ret == 0) {
+        if (attr->stack_size != 0u) {
+            local_ret = pthread_attr_setstacksize(&pattr, attr->stack_size);
+        }
+
+        if ((local_ret == 0) && (attr->guard_size != 0u)) {
+            local_ret = pthread_attr_setguardsize(&pattr, attr->guard_size);
+        }
+
+        if (local_ret == 0) {
+            if (with_sched != 0) {
+                start_args->applied = posix_task_prepare_attr(&pattr, attr);
+            }
+
+            local_ret = pthread_create(&hdl->tid, &pattr, posix_task_wrapper, start_args);
+        }
 
-    return (*user_handler)(user_arg);
+        (void)pthread_attr_destroy(&pattr);
+    }
+
+    return local_ret;
 }
 
 //! \brief Create a task.
@@ -142,27 +596,51 @@ osal_retval_t osal_task_create(osal_task_t *hdl, const osal_task_attr_t *attr,
 
     osal_retval_t ret = OSAL_OK;
     int local_ret;
-    posix_start_args_t start_args = { 0, handler, arg, attr };
+    posix_start_args_t start_args;
 
-    local_ret = pthread_create(&hdl->tid, NULL, posix_task_wrapper, &start_args);
-    
-    if (local_ret != 0) {
-        if (local_ret == EAGAIN) {
-            ret = OSAL_ERR_SYSTEM_LIMIT_REACHED;
-        } else if (local_ret == EPERM) {
-            ret = OSAL_ERR_PERMISSION_DENIED;
-        } else if (local_ret == EINVAL) {
-            ret = OSAL_ERR_INVALID_PARAM;
+    start_args.applied = 0u;
+    start_args.user_handler = handler;
+    start_args.user_arg = arg;
+    start_args.user_attr = attr;
+    start_args.hdl = hdl;
+
+    hdl->ktid = 0;
+    hdl->sched_status = OSAL_OK;
+
+    if (sem_init(&start_args.started, 0, 0) != 0) {
+        ret = OSAL_ERR_OPERATION_FAILED;
+    } else {
+        if (attr != NULL) {
+            local_ret = posix_task_create_attr(hdl, attr, &start_args, 1);
+
+            if (((local_ret == EPERM) || (local_ret == EINVAL)) && (start_args.applied != 0u)) {
+                // e.g. no realtime privileges or offline cpus, start anyway and
+                // report the error with osal_task_get_sched_status like before
+                local_ret = posix_task_create_attr(hdl, attr, &start_args, 0);
+            }
         } else {
-            ret = OSAL_ERR_OPERATION_FAILED;
+            local_ret = pthread_create(&hdl->tid, NULL, posix_task_wrapper, &start_args);
         }
-    }
 
-    if (ret == OSAL_OK) {
-        // only wait if thread has been started successfully
-        while (start_args.running == 0) {
-            osal_sleep(1000000);
+        if (local_ret != 0) {
+            if (local_ret == EAGAIN) {
+                ret = OSAL_ERR_SYSTEM_LIMIT_REACHED;
+            } else if (local_ret == EPERM) {
+                ret = OSAL_ERR_PERMISSION_DENIED;
+            } else if (local_ret == EINVAL) {
+                ret = OSAL_ERR_INVALID_PARAM;
+            } else {
+                ret = OSAL_ERR_OPERATION_FAILED;
+            }
+        }
+
+        if (ret == OSAL_OK) {
+            // only wait if thread has been started successfully
+            while ((sem_wait(&start_args.started) != 0) && (errno == EINTR)) {
+            }
         }
+
+        (void)sem_destroy(&start_args.started);
     }
 
     return ret;
@@ -223,11 +701,11 @@ osal_retval_t osal_task_destroy(osal_task_t *hdl) {
 osal_retval_t osal_task_get_hdl(osal_task_t *hdl) {
     assert(hdl != NULL);
 
-    (void)hdl;
-
-    osal_retval_t ret = OSAL_ERR_NOT_IMPLEMENTED;
+    hdl->tid = pthread_self();
+    hdl->ktid = (pid_t)syscall(SYS_gettid);
+    hdl->sched_status = OSAL_OK;
 
-    return ret;
+    return OSAL_OK;
 }
 
 //! \brief Change the task attributes of the specified task.
@@ -243,32 +721,28 @@ osal_retval_t osal_task_set_task_attr(osal_task_t *hdl, osal_task_attr_t *attr)
     osal_retval_t ret = OSAL_OK;
     int local_ret;
 
-    struct sched_param param;
-    param.sched_priority = attr->priority;
-    local_ret = pthread_setschedparam(hdl->tid, attr->policy, &param);
-    if (local_ret != 0) {
-        if ((local_ret == ESRCH) || (local_ret == EINVAL)) {
-            ret = OSAL_ERR_INVALID_PARAM;
-        } else if (local_ret == EPERM) {
-            ret = OSAL_ERR_PERMISSION_DENIED;
-        } else {
-            ret = OSAL_ERR_OPERATION_FAILED;
+    if (attr->policy == OSAL_SCHED_POLICY_DEADLINE) {
+        ret = osal_task_set_deadline(hdl, attr->runtime, attr->deadline, attr->period);
+    } else {
+        struct sched_param param;
+        param.sched_priority = attr->priority;
+        local_ret = pthread_setschedparam(hdl->tid, posix_policy_from_osal(attr->policy), &param);
+        if (local_ret != 0) {
+            if ((local_ret == ESRCH) || (local_ret == EINVAL)) {
+                ret = OSAL_ERR_INVALID_PARAM;
+            } else if (local_ret == EPERM) {
+                ret = OSAL_ERR_PERMISSION_DENIED;
+            } else {
+                ret = OSAL_ERR_OPERATION_FAILED;
+            }
         }
     }
 
     if (ret == OSAL_OK) {
 #if LIBOSAL_HAVE_PTHREAD_SETAFFINITY_NP
-        cpu_set_t cpuset;
-        CPU_ZERO(&cpuset);
-        for (uint32_t i = 0u; i < (sizeof(attr->affinity) * 8u); ++i) {
-            if ((attr->affinity & ((uint32_t)1u << i)) != 0u) {
-                CPU_SET(i, &cpuset);
-            }
-        }
-
-        local_ret = pthread_setaffinity_np(hdl->tid, sizeof(cpu_set_t), &cpuset);
-        if (local_ret != 0) {
-            ret = OSAL_ERR_INVALID_PARAM;
+        osal_cpuset_t cpuset;
+        if (posix_task_attr_cpuset(attr, &cpuset) != 0) {
+            ret = osal_task_set_cpuset(hdl, &cpuset);
         }
 #endif
     }
@@ -299,8 +773,22 @@ osal_retval_t osal_task_get_task_attr(osal_task_t *hdl, osal_task_attr_t *attr)
     struct sched_param param;
     local_ret = pthread_getschedparam(hdl->tid, &policy, &param);
     if (local_ret == 0) {
-        attr->policy = policy;
+        attr->policy = posix_policy_to_osal(policy);
         attr->priority = param.sched_priority;
+        attr->runtime = 0u;
+        attr->deadline = 0u;
+        attr->period = 0u;
+
+#ifdef SYS_sched_getattr
+        if ((policy == SCHED_DEADLINE) && (hdl->ktid != 0)) {
+            posix_sched_attr_t sattr;
+            if (syscall(SYS_sched_getattr, hdl->ktid, &sattr, sizeof(sattr), 0) == 0) {
+                attr->runtime = sattr.sched_runtime;
+                attr->deadline = sattr.sched_deadline;
+                attr->period = sattr.sched_period;
+            }
+        }
+#endif
     } else {
         if ((local_ret == ESRCH) || (local_ret == EINVAL)) {
             ret = OSAL_ERR_INVALID_PARAM;
@@ -313,21 +801,9 @@ osal_retval_t osal_task_get_task_attr(osal_task_t *hdl, osal_task_attr_t *attr)
 
     if (ret == OSAL_OK) {
 #if LIBOSAL_HAVE_PTHREAD_SETAFFINITY_NP
-        attr->affinity = 0;
-
-        cpu_set_t cpuset;
-        CPU_ZERO(&cpuset);
-
-        local_ret = pthread_getaffinity_np(hdl->tid, sizeof(cpuset), &cpuset);
-        if (local_ret != 0) {
-            ret = OSAL_ERR_INVALID_PARAM;
-        } else {
-            for (osal_uint32_t j = 0; j < CPU_SETSIZE; j++) {
-                if (CPU_ISSET(j, &cpuset) != 0u) {
-                    attr->affinity |= (1u << j);
-                }
-            }
-        }
+        // only the set, a mask would override it and drop CPUs from 32 on
+        ret = osal_task_get_cpuset(hdl, &attr->cpuset);
+        attr->affinity = 0u;
 #endif
     }
 
@@ -369,13 +845,13 @@ osal_retval_t osal_task_set_policy(osal_task_t *hdl, osal_task_sched_policy_t po
     }
 
     if (ret == OSAL_OK) {
-        if (policy == OSAL_SCHED_POLICY_FIFO) {
-            tmp_policy = SCHED_FIFO;
-        } else if (policy == OSAL_SCHED_POLICY_ROUND_ROBIN) {
-            tmp_policy = SCHED_RR;
-        } else {
-            tmp_policy = SCHED_OTHER;
+        tmp_policy = posix_policy_from_osal(policy);
+        if (tmp_policy < 0) {
+            ret = OSAL_ERR_INVALID_PARAM;
         }
+    }
+
+    if (ret == OSAL_OK) {
 
         if (sched_get_priority_min(tmp_policy) > param.sched_priority) {
             param.sched_priority = sched_get_priority_min(tmp_policy);
@@ -431,18 +907,103 @@ osal_retval_t osal_task_get_policy(osal_task_t *hdl, osal_task_sched_policy_t *p
     }
 
     if (ret == OSAL_OK) {
-        if (tmp_policy == SCHED_FIFO) {
-            (*policy) = OSAL_SCHED_POLICY_FIFO;
-        } else if (tmp_policy == SCHED_RR) {
-            (*policy) = OSAL_SCHED_POLICY_ROUND_ROBIN;
-        } else {
-            (*policy) = OSAL_SCHED_POLICY_OTHER;
+        (*policy) = posix_policy_to_osal(tmp_policy);
+    }
+
+    return ret;
+}
+
+//! \brief Set earliest deadline first scheduling for the specified thread.
+/*!
+ * \param[in]   hdl         Pointer to osal task structure. Content is OS dependent.
+ *                          If \p hdl is NULL, set policy for calling thread.
+ * \param[in]   runtime     Runtime per period in [ns].
+ * \param[in]   deadline    Relative deadline in [ns], 0 for \p period.
+ * \param[in]   period      Period in [ns], 0 for \p deadline.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_set_deadline(osal_task_t *hdl, osal_uint64_t runtime,
+                                        osal_uint64_t deadline, osal_uint64_t period)
+{
+    osal_retval_t ret = OSAL_OK;
+
+#ifdef SYS_sched_setattr
+    posix_sched_attr_t sattr;
+    pid_t ktid = 0;
+
+    if (hdl != NULL) {
+        ktid = hdl->ktid;
+        if (ktid == 0) {
+            // unknown kernel thread id, 0 would select calling thread
+            ret = OSAL_ERR_INVALID_PARAM;
+        }
+    }
+
+    if (deadline == 0u) {
+        deadline = period;
+    }
+    if (period == 0u) {
+        period = deadline;
+    }
+
+    if ((runtime == 0u) || (deadline == 0u)) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    }
+
+    if (ret == OSAL_OK) {
+        (void)memset(&sattr, 0, sizeof(sattr));
+        sattr.size = sizeof(sattr);
+        sattr.sched_policy = SCHED_DEADLINE;
+        sattr.sched_runtime = runtime;
+        sattr.sched_deadline = deadline;
+        sattr.sched_period = period;
+
+        if (syscall(SYS_sched_setattr, ktid, &sattr, 0) != 0) {
+            int local_errno = errno;
+
+            if (local_errno == EBUSY) {
+                // bandwidth admission control
+                ret = OSAL_ERR_ADMISSION_DENIED;
+            } else if (local_errno == EPERM) {
+                ret = OSAL_ERR_PERMISSION_DENIED;
+            } else if ((local_errno == EINVAL) || (local_errno == ESRCH) || (local_errno == E2BIG)) {
+                ret = OSAL_ERR_INVALID_PARAM;
+            } else if (local_errno == ENOSYS) {
+                ret = OSAL_ERR_NOT_IMPLEMENTED;
+            } else {
+                ret = OSAL_ERR_OPERATION_FAILED;
+            }
         }
     }
+#else
+    (void)hdl;
+    (void)runtime;
+    (void)deadline;
+    (void)period;
+
+    ret = OSAL_ERR_NOT_IMPLEMENTED;
+#endif
 
     return ret;
 }
 
+//! \brief Get the result of applying the scheduling attributes at task creation.
+/*!
+ * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
+ * \param[out]  status  Returns first error applying the attributes.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_get_sched_status(osal_task_t *hdl, osal_retval_t *status) {
+    assert(hdl != NULL);
+    assert(status != NULL);
+
+    (*status) = hdl->sched_status;
+
+    return OSAL_OK;
+}
+
 //! \brief Change the priority of the specified thread.
 /*!
  * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
@@ -542,31 +1103,24 @@ osal_retval_t osal_task_set_affinity(osal_task_t *hdl,
     osal_retval_t ret = OSAL_OK;
     
     if (affinity > 0u) {
-#if LIBOSAL_HAVE_PTHREAD_SETAFFINITY_NP
-        pthread_t tid = hdl != NULL ? hdl->tid : pthread_self();
-        cpu_set_t cpuset;
-        CPU_ZERO(&cpuset);
-        for (uint32_t i = 0u; i < (sizeof(affinity) * 8u); ++i) {
-            if ((affinity & ((uint32_t)1u << i)) != 0u) {
-                CPU_SET(i, &cpuset);
-            }
-        }
+        osal_cpuset_t cpuset;
+        osal_cpuset_from_mask(&cpuset, affinity);
 
-        int local_ret = pthread_setaffinity_np(tid, sizeof(cpu_set_t), &cpuset);
-        if (local_ret != 0) {
-            ret = OSAL_ERR_INVALID_PARAM;
+        ret = osal_task_set_cpuset(hdl, &cpuset);
+        if (ret == OSAL_ERR_NOT_IMPLEMENTED) {
+            // silently ignored as before
+            ret = OSAL_OK;
         }
-#endif
     }
 
     return ret;
 }
 
-//! \brief Change the affinity of the specified thread.
+//! \brief Get the affinity of the specified thread.
 /*!
  * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
- *                      If <b> hdl is NULL, set affinity for calling thread.
- * \param[in]   prio    The thread affinity as member of osal_task_sched_priority_t
+ *                      If <b> hdl is NULL, get affinity of calling thread.
+ * \param[out]  prio    The thread affinity as member of osal_task_sched_priority_t
  *
  * \return OK or ERROR_CODE.
  */
@@ -576,24 +1130,81 @@ osal_retval_t osal_task_get_affinity(osal_task_t *hdl,
     osal_retval_t ret = OSAL_OK;
 
 #if LIBOSAL_HAVE_PTHREAD_SETAFFINITY_NP
-    int local_ret;
-    pthread_t tid = hdl != NULL ? hdl->tid : pthread_self();
+    osal_cpuset_t cpuset;
 
-    cpu_set_t cpuset;
     (*affinity) = 0;
-    CPU_ZERO(&cpuset);
 
-    local_ret = pthread_getaffinity_np(tid, sizeof(cpuset), &cpuset);
+    ret = osal_task_get_cpuset(hdl, &cpuset);
+    if (ret == OSAL_OK) {
+        (*affinity) = osal_cpuset_to_mask(&cpuset);
+    }
+#endif
+    return ret;
+}
+
+//! \brief Change the affinity of the specified thread to a CPU set.
+/*!
+ * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
+ *                      If <b> hdl is NULL, set affinity for calling thread.
+ * \param[in]   cpuset  CPUs the thread may run on.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_set_cpuset(osal_task_t *hdl, const osal_cpuset_t *cpuset) {
+    assert(cpuset != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+#if LIBOSAL_HAVE_PTHREAD_SETAFFINITY_NP
+    pthread_t tid = hdl != NULL ? hdl->tid : pthread_self();
+    cpu_set_t posix_cpuset;
+
+    posix_cpuset_from_osal(&posix_cpuset, cpuset);
+
+    int local_ret = pthread_setaffinity_np(tid, sizeof(cpu_set_t), &posix_cpuset);
+    if (local_ret != 0) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    }
+#else
+    (void)hdl;
+    ret = OSAL_ERR_NOT_IMPLEMENTED;
+#endif
+
+    return ret;
+}
+
+//! \brief Get the affinity of the specified thread as CPU set.
+/*!
+ * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
+ *                      If <b> hdl is NULL, get affinity of calling thread.
+ * \param[out]  cpuset  CPUs the thread may run on.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_get_cpuset(osal_task_t *hdl, osal_cpuset_t *cpuset) {
+    assert(cpuset != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+#if LIBOSAL_HAVE_PTHREAD_SETAFFINITY_NP
+    pthread_t tid = hdl != NULL ? hdl->tid : pthread_self();
+    cpu_set_t posix_cpuset;
+
+    CPU_ZERO(&posix_cpuset);
+
+    int local_ret = pthread_getaffinity_np(tid, sizeof(posix_cpuset), &posix_cpuset);
     if (local_ret != 0) {
+        osal_cpuset_zero(cpuset);
         ret = OSAL_ERR_INVALID_PARAM;
     } else {
-        for (osal_uint32_t j = 0; j < CPU_SETSIZE; j++) {
-            if (CPU_ISSET(j, &cpuset) != 0u) {
-                (*affinity) |= (1u << j);
-            }
-        }
+        posix_cpuset_to_osal(cpuset, &posix_cpuset);
     }
+#else
+    (void)hdl;
+    osal_cpuset_zero(cpuset);
+    ret = OSAL_ERR_NOT_IMPLEMENTED;
 #endif
+
     return ret;
 }
 
@@ -668,11 +1279,90 @@ osal_retval_t osal_task_get_state(osal_task_t *hdl,
                                      osal_task_state_t *state)
 {
     assert(hdl != NULL);
+    assert(state != NULL);
 
-    (void)hdl;
-    (void)state;
+    osal_retval_t ret = OSAL_OK;
+    posix_task_proc_stat_t stat;
+
+    if (posix_task_read_proc_stat(hdl->ktid, &stat) != 0) {
+        (*state) = OSAL_STATE_THREAD_UNKNOWN_ID;
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        switch (stat.state) {
+            case 'R':
+                (*state) = OSAL_STATE_THREAD_ACTIVE;
+                break;
+            case 'S':   // interruptible sleep
+            case 'D':   // uninterruptible sleep, usually I/O
+                (*state) = OSAL_STATE_THREAD_BLOCKED;
+                break;
+            default:    // stopped, traced or exiting
+                (*state) = OSAL_STATE_THREAD_INACTIVE;
+                break;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Get runtime statistics of a created thread.
+/*!
+ * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
+ * \param[out]  stats   Returns the statistics.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_get_stats(osal_task_t *hdl, osal_task_stats_t *stats) {
+    assert(hdl != NULL);
+    assert(stats != NULL);
 
-    osal_retval_t ret = OSAL_ERR_NOT_IMPLEMENTED;
+    osal_retval_t ret = OSAL_OK;
+    clockid_t clk = CLOCK_THREAD_CPUTIME_ID;
+    struct timespec ts;
+
+    (void)memset(stats, 0, sizeof(*stats));
+    stats->cpu = -1;
+
+    if (pthread_equal(hdl->tid, pthread_self()) != 0) {
+        // calling thread, no need to go through procfs
+        struct rusage usage;
+
+        if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+            stats->voluntary_switches = (osal_uint64_t)usage.ru_nvcsw;
+            stats->involuntary_switches = (osal_uint64_t)usage.ru_nivcsw;
+            stats->minor_faults = (osal_uint64_t)usage.ru_minflt;
+            stats->major_faults = (osal_uint64_t)usage.ru_majflt;
+        } else {
+            ret = OSAL_ERR_OPERATION_FAILED;
+        }
+
+        stats->cpu = (osal_int32_t)sched_getcpu();
+    } else {
+        // read before touching the pthread handle, fails if the thread is gone
+        posix_task_proc_stat_t stat;
+
+        if (posix_task_read_proc_stat(hdl->ktid, &stat) != 0) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else {
+            stats->minor_faults = stat.minor_faults;
+            stats->major_faults = stat.major_faults;
+            stats->cpu = stat.cpu;
+
+            if (posix_task_read_proc_switches(hdl->ktid, stats) != 0) {
+                ret = OSAL_ERR_OPERATION_FAILED;
+            } else if (pthread_getcpuclockid(hdl->tid, &clk) != 0) {
+                ret = OSAL_ERR_INVALID_PARAM;
+            }
+        }
+    }
+
+    if (ret == OSAL_OK) {
+        if (clock_gettime(clk, &ts) == 0) {
+            stats->cpu_time = ((osal_uint64_t)ts.tv_sec * 1000000000u) + (osal_uint64_t)ts.tv_nsec;
+        } else {
+            ret = OSAL_ERR_INVALID_PARAM;
+        }
+    }
 
     return ret;
 }
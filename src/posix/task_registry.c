@@ -0,0 +1,395 @@
+/**
+ * \file posix/task_registry.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 18 Oct 2026
+ *
+ * \brief OSAL task registry posix source.
+ *
+ * OSAL task registry posix source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#define _GNU_SOURCE             /* See feature_test_macros(7) */
+#include <libosal/config.h>
+#include <libosal/osal.h>
+#include <libosal/task_registry.h>
+
+#ifdef LIBOSAL_HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+//! Registry in process memory while not published.
+static osal_task_registry_t posix_task_registry_local;
+//! Current registry, local or shared memory.
+static osal_task_registry_t *posix_task_registry = &posix_task_registry_local;
+//! Serializes writers.
+static pthread_mutex_t posix_task_registry_lock = PTHREAD_MUTEX_INITIALIZER;
+//! Environment variable has been checked.
+static int posix_task_registry_env_checked = 0;
+//! Exit handler has been installed.
+static int posix_task_registry_atexit_installed = 0;
+
+//! \brief Build shared memory name of a process.
+static void posix_task_registry_name(char *name, osal_size_t size, osal_int32_t pid) {
+    (void)snprintf(name, size, "%s%d", OSAL_TASK_REGISTRY_SHM_PREFIX, (int)pid);
+}
+
+//! \brief Return registry of this process, forked children do not share the parent's.
+static osal_task_registry_t *posix_task_registry_get(void) {
+    if ((posix_task_registry != &posix_task_registry_local) &&
+            (posix_task_registry->pid != (osal_int32_t)getpid())) {
+        (void)memset(&posix_task_registry_local, 0, sizeof(posix_task_registry_local));
+        posix_task_registry = &posix_task_registry_local;
+    }
+
+    return posix_task_registry;
+}
+
+//! \brief Change a registry entry with the sequence lock held.
+static void posix_task_registry_write(osal_task_registry_entry_t *entry,
+        const osal_task_registry_entry_t *val) {
+    osal_uint32_t seq = entry->seq;
+
+    __atomic_store_n(&entry->seq, seq + 1u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    entry->ktid = val->ktid;
+    (void)memcpy(entry->name, val->name, sizeof(entry->name));
+    entry->policy = val->policy;
+    entry->priority = val->priority;
+    entry->cpuset = val->cpuset;
+    entry->sched_status = val->sched_status;
+    entry->created = val->created;
+
+    __atomic_store_n(&entry->seq, seq + 2u, __ATOMIC_RELEASE);
+}
+
+#ifdef LIBOSAL_HAVE_SYS_MMAN_H
+//! \brief Remove the published segment at process exit.
+static void posix_task_registry_atexit(void) {
+    char name[64];
+
+    if ((posix_task_registry != &posix_task_registry_local) &&
+            (posix_task_registry->pid == (osal_int32_t)getpid())) {
+        posix_task_registry_name(name, sizeof(name), posix_task_registry->pid);
+        (void)shm_unlink(name);
+    }
+}
+#endif
+
+//! \brief Publish the task registry of this process.
+/*!
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_registry_publish(osal_void_t) {
+#ifdef LIBOSAL_HAVE_SYS_MMAN_H
+    osal_retval_t ret = OSAL_OK;
+    osal_task_registry_t *local = &posix_task_registry_local;
+    osal_task_registry_t *shared;
+    osal_int32_t pid = (osal_int32_t)getpid();
+    char name[64];
+
+    posix_task_registry_name(name, sizeof(name), pid);
+
+    (void)pthread_mutex_lock(&posix_task_registry_lock);
+
+    if (posix_task_registry_get() == local) {
+        // a segment left by a crashed process with the same pid is replaced
+        (void)shm_unlink(name);
+
+        int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            ret = (errno == EACCES) ? OSAL_ERR_PERMISSION_DENIED : OSAL_ERR_OPERATION_FAILED;
+        } else {
+            void *base = MAP_FAILED;
+
+            if (ftruncate(fd, (off_t)sizeof(osal_task_registry_t)) == 0) {
+                base = mmap(NULL, sizeof(osal_task_registry_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+
+            (void)close(fd);
+
+            if (base == MAP_FAILED) {
+                (void)shm_unlink(name);
+                ret = OSAL_ERR_OPERATION_FAILED;
+            } else {
+                shared = (osal_task_registry_t *)base;
+                (void)memcpy(shared->entry, local->entry, sizeof(shared->entry));
+                shared->version = OSAL_TASK_REGISTRY_VERSION;
+                shared->pid = pid;
+                shared->entries = OSAL_TASK_REGISTRY_ENTRIES;
+                shared->dropped = local->dropped;
+                __atomic_store_n(&shared->magic, OSAL_TASK_REGISTRY_MAGIC, __ATOMIC_RELEASE);
+
+                posix_task_registry = shared;
+
+                if (posix_task_registry_atexit_installed == 0) {
+                    posix_task_registry_atexit_installed = 1;
+                    (void)atexit(posix_task_registry_atexit);
+                }
+            }
+        }
+    }
+
+    (void)pthread_mutex_unlock(&posix_task_registry_lock);
+
+    return ret;
+#else
+    return OSAL_ERR_NOT_IMPLEMENTED;
+#endif
+}
+
+//! \brief Stop publishing the task registry of this process.
+/*!
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_registry_unpublish(osal_void_t) {
+#ifdef LIBOSAL_HAVE_SYS_MMAN_H
+    osal_task_registry_t *local = &posix_task_registry_local;
+    osal_task_registry_t *shared;
+    char name[64];
+
+    (void)pthread_mutex_lock(&posix_task_registry_lock);
+
+    shared = posix_task_registry_get();
+    if (shared != local) {
+        (void)memcpy(local->entry, shared->entry, sizeof(local->entry));
+        local->dropped = shared->dropped;
+        posix_task_registry = local;
+
+        posix_task_registry_name(name, sizeof(name), shared->pid);
+        (void)shm_unlink(name);
+        (void)munmap(shared, sizeof(osal_task_registry_t));
+    }
+
+    (void)pthread_mutex_unlock(&posix_task_registry_lock);
+
+    return OSAL_OK;
+#else
+    return OSAL_ERR_NOT_IMPLEMENTED;
+#endif
+}
+
+//! \brief Register a task.
+/*!
+ * \param[in]   hdl     Pointer to osal task structure.
+ * \param[in]   attr    Attributes the task was created with. Can be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_registry_add(const osal_task_t *hdl, const osal_task_attr_t *attr) {
+    assert(hdl != NULL);
+
+    osal_retval_t ret = OSAL_ERR_SYSTEM_LIMIT_REACHED;
+    osal_task_registry_entry_t val;
+
+    if (__atomic_exchange_n(&posix_task_registry_env_checked, 1, __ATOMIC_ACQ_REL) == 0) {
+        const char *env = getenv(OSAL_TASK_REGISTRY_ENV);
+
+        if ((env != NULL) && (strcmp(env, "1") == 0)) {
+            (void)osal_task_registry_publish();
+        }
+    }
+
+    (void)memset(&val, 0, sizeof(val));
+    val.ktid = (osal_int32_t)hdl->ktid;
+    val.sched_status = hdl->sched_status;
+    val.created = osal_timer_gettime_nsec();
+
+    if (attr != NULL) {
+        (void)memcpy(val.name, attr->task_name, sizeof(val.name) - 1u);
+        val.policy = attr->policy;
+        val.priority = attr->priority;
+        // the legacy mask overrides a set without CPUs from 32 on, as in osal_task_create
+        if ((attr->affinity != 0u) && (osal_cpuset_next(&attr->cpuset, 31) < 0)) {
+            osal_cpuset_from_mask(&val.cpuset, attr->affinity);
+        } else {
+            val.cpuset = attr->cpuset;
+        }
+    }
+
+    (void)pthread_mutex_lock(&posix_task_registry_lock);
+
+    osal_task_registry_t *reg = posix_task_registry_get();
+
+    for (osal_uint32_t i = 0u; i < OSAL_TASK_REGISTRY_ENTRIES; ++i) {
+        if (reg->entry[i].ktid == 0) {
+            posix_task_registry_write(&reg->entry[i], &val);
+            ret = OSAL_OK;
+            break;
+        }
+    }
+
+    if (ret != OSAL_OK) {
+        reg->dropped++;
+    }
+
+    (void)pthread_mutex_unlock(&posix_task_registry_lock);
+
+    return ret;
+}
+
+//! \brief Remove a task from the registry.
+/*!
+ * \param[in]   hdl     Pointer to osal task structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_registry_remove(const osal_task_t *hdl) {
+    assert(hdl != NULL);
+
+    osal_retval_t ret = OSAL_ERR_NOT_FOUND;
+    osal_task_registry_entry_t val;
+
+    (void)memset(&val, 0, sizeof(val));
+
+    (void)pthread_mutex_lock(&posix_task_registry_lock);
+
+    osal_task_registry_t *reg = posix_task_registry_get();
+
+    for (osal_uint32_t i = 0u; (i < OSAL_TASK_REGISTRY_ENTRIES) && (hdl->ktid > 0); ++i) {
+        if (reg->entry[i].ktid == (osal_int32_t)hdl->ktid) {
+            posix_task_registry_write(&reg->entry[i], &val);
+            ret = OSAL_OK;
+            break;
+        }
+    }
+
+    (void)pthread_mutex_unlock(&posix_task_registry_lock);
+
+    return ret;
+}
+
+//! \brief Attach to the published task registry of a process.
+/*!
+ * \param[in]   pid     Process id.
+ * \param[out]  reg     Returns read-only mapping of the registry.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_registry_attach(osal_int32_t pid, const osal_task_registry_t **reg) {
+    assert(reg != NULL);
+
+#ifdef LIBOSAL_HAVE_SYS_MMAN_H
+    osal_retval_t ret = OSAL_OK;
+    struct stat st;
+    char name[64];
+
+    posix_task_registry_name(name, sizeof(name), pid);
+
+    int fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0) {
+        ret = (errno == ENOENT) ? OSAL_ERR_NOT_FOUND : OSAL_ERR_OPERATION_FAILED;
+    } else {
+        if ((fstat(fd, &st) != 0) || (st.st_size < (off_t)sizeof(osal_task_registry_t))) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else {
+            void *base = mmap(NULL, sizeof(osal_task_registry_t), PROT_READ, MAP_SHARED, fd, 0);
+
+            if (base == MAP_FAILED) {
+                ret = OSAL_ERR_OPERATION_FAILED;
+            } else {
+                const osal_task_registry_t *shared = (const osal_task_registry_t *)base;
+
+                if ((__atomic_load_n(&shared->magic, __ATOMIC_ACQUIRE) != OSAL_TASK_REGISTRY_MAGIC) ||
+                        (shared->version != OSAL_TASK_REGISTRY_VERSION) ||
+                        (shared->entries > OSAL_TASK_REGISTRY_ENTRIES)) {
+                    (void)munmap(base, sizeof(osal_task_registry_t));
+                    ret = OSAL_ERR_INVALID_PARAM;
+                } else {
+                    (*reg) = shared;
+                }
+            }
+        }
+
+        (void)close(fd);
+    }
+
+    return ret;
+#else
+    (void)pid;
+    (void)reg;
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+#endif
+}
+
+//! \brief Detach from a task registry.
+/*!
+ * \param[in]   reg     Registry returned by \ref osal_task_registry_attach.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_registry_detach(const osal_task_registry_t *reg) {
+    assert(reg != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+#ifdef LIBOSAL_HAVE_SYS_MMAN_H
+    if (munmap((void *)reg, sizeof(osal_task_registry_t)) != 0) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    }
+#else
+    ret = OSAL_ERR_NOT_IMPLEMENTED;
+#endif
+
+    return ret;
+}
+
+//! \brief Read one entry of a task registry consistently.
+/*!
+ * \param[in]   reg     Registry.
+ * \param[in]   idx     Entry index.
+ * \param[out]  entry   Returns a copy of the entry.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_registry_read(const osal_task_registry_t *reg, osal_uint32_t idx,
+        osal_task_registry_entry_t *entry) {
+    assert(reg != NULL);
+    assert(idx < OSAL_TASK_REGISTRY_ENTRIES);
+    assert(entry != NULL);
+
+    const osal_task_registry_entry_t *src = &reg->entry[idx];
+    osal_uint32_t seq;
+
+    do {
+        seq = __atomic_load_n(&src->seq, __ATOMIC_ACQUIRE);
+        (void)memcpy(entry, src, sizeof(*entry));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (((seq & 1u) != 0u) || (__atomic_load_n(&src->seq, __ATOMIC_RELAXED) != seq));
+
+    entry->seq = seq;
+    entry->name[sizeof(entry->name) - 1u] = '\0';
+
+    return entry->ktid != 0 ? OSAL_OK : OSAL_ERR_NO_DATA;
+}
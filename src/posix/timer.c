@@ -30,6 +30,7 @@
 
 #include <libosal/osal.h>
 #include <libosal/timer.h>
+#include <libosal/cpu.h>
 
 // cppcheck-suppress misra-c2012-21.6
 #include <stdio.h>
@@ -37,11 +38,136 @@
 #include <time.h>
 #include <assert.h>
 #include <errno.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define OSAL_TIMER_HAVE_TSC
+#elif defined(__aarch64__)
+#define OSAL_TIMER_HAVE_TSC
+#endif
 
 //! Global configuration option for the clock source used by the timer
 //! functions.
 int global_clock_id = CLOCK_REALTIME;
 
+#ifdef OSAL_TIMER_HAVE_TSC
+//! Fixed point shift of the cycles to nanoseconds multiplier.
+#define OSAL_TIMER_TSC_SHIFT            40u
+//! Number of samples to find the tightest counter/clock pair.
+#define OSAL_TIMER_TSC_SAMPLES          8
+
+//! Timestamp counter conversion parameters.
+typedef struct osal_timer_tsc {
+    osal_uint64_t base_cycles;      //!< Counter value at base_nsec.
+    osal_uint64_t base_nsec;        //!< Time of global_clock_id at base_cycles.
+    osal_uint64_t mult;             //!< Nanoseconds per cycle << OSAL_TIMER_TSC_SHIFT.
+    osal_uint64_t freq;             //!< Counter frequency in [Hz].
+} osal_timer_tsc_t;
+
+//! Two parameter sets, a new one is published while readers may use the old one.
+static osal_timer_tsc_t tsc_params[2];
+static unsigned tsc_slot = 0u;
+static osal_timer_tsc_t *tsc_active = NULL;
+
+//! \brief Read the raw timestamp counter.
+static inline osal_uint64_t tsc_read(void) {
+#if defined(__x86_64__)
+    unsigned int aux;
+    return __rdtscp(&aux);
+#else
+    osal_uint64_t val;
+    __asm__ __volatile__ ("isb\n\tmrs %0, cntvct_el0" : "=r" (val) : : "memory");
+    return val;
+#endif
+}
+
+//! \brief Convert counter value to nanoseconds.
+static inline osal_uint64_t tsc_to_nsec(const osal_timer_tsc_t *tsc, osal_uint64_t cycles) {
+    osal_uint64_t ret;
+
+    // cores may read slightly behind the base counter value
+    if (cycles >= tsc->base_cycles) {
+        ret = tsc->base_nsec + (osal_uint64_t)(((unsigned __int128)(cycles - tsc->base_cycles) * 
+                tsc->mult) >> OSAL_TIMER_TSC_SHIFT);
+    } else {
+        ret = tsc->base_nsec - (osal_uint64_t)(((unsigned __int128)(tsc->base_cycles - cycles) * 
+                tsc->mult) >> OSAL_TIMER_TSC_SHIFT);
+    }
+
+    return ret;
+}
+
+//! \brief Check if the timestamp counter is usable as time source.
+static osal_retval_t tsc_check_invariant(void) {
+    osal_retval_t ret = OSAL_OK;
+#if defined(__x86_64__)
+    unsigned int eax, ebx, ecx, edx;
+
+    if ((__get_cpuid(0x80000000u, &eax, &ebx, &ecx, &edx) == 0) || (eax < 0x80000007u)) {
+        ret = OSAL_ERR_UNAVAILABLE;
+    } else if ((__get_cpuid(0x80000001u, &eax, &ebx, &ecx, &edx) == 0) || ((edx & (1u << 27)) == 0u)) {
+        // no rdtscp
+        ret = OSAL_ERR_UNAVAILABLE;
+    } else if ((__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx) == 0) || ((edx & (1u << 8)) == 0u)) {
+        // no invariant tsc
+        ret = OSAL_ERR_UNAVAILABLE;
+    } else {
+        // the kernel switches away from the tsc if it detected it as unstable
+        FILE *fp = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+        if (fp != NULL) {
+            char buf[32] = { 0 };
+            if ((fgets(buf, sizeof(buf), fp) == NULL) || (strncmp(buf, "tsc", 3) != 0)) {
+                ret = OSAL_ERR_UNAVAILABLE;
+            }
+
+            (void)fclose(fp);
+        }
+    }
+#endif
+    // the aarch64 generic timer is architecturally constant
+    return ret;
+}
+
+//! \brief Get matching pair of counter and clock value.
+static osal_retval_t tsc_sample(int clock_id, osal_uint64_t *cycles, osal_uint64_t *nsec) {
+    osal_retval_t ret = OSAL_ERR_UNAVAILABLE;
+    osal_uint64_t best = ~(osal_uint64_t)0u;
+
+    for (int i = 0; i < OSAL_TIMER_TSC_SAMPLES; ++i) {
+        struct timespec ts;
+        osal_uint64_t t0 = tsc_read();
+        int local_ret = clock_gettime(clock_id, &ts);
+        osal_uint64_t t1 = tsc_read();
+
+        if ((local_ret == 0) && (t1 >= t0) && ((t1 - t0) < best)) {
+            best = t1 - t0;
+            *cycles = t0 + ((t1 - t0) / 2u);
+            *nsec = ((osal_uint64_t)ts.tv_sec * NSEC_PER_SEC) + (osal_uint64_t)ts.tv_nsec;
+            ret = OSAL_OK;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Publish conversion parameters with new base for global_clock_id.
+static osal_retval_t tsc_publish(osal_uint64_t mult, osal_uint64_t freq) {
+    osal_timer_tsc_t *tsc = &tsc_params[tsc_slot];
+    osal_retval_t ret = tsc_sample(global_clock_id, &tsc->base_cycles, &tsc->base_nsec);
+
+    if (ret == OSAL_OK) {
+        tsc->mult = mult;
+        tsc->freq = freq;
+        tsc_slot ^= 1u;
+        __atomic_store_n(&tsc_active, tsc, __ATOMIC_RELEASE);
+    }
+
+    return ret;
+}
+#endif
+
 // sleep in nanoseconds
 void osal_sleep(osal_uint64_t nsec) {
     struct timespec ts = { (nsec / NSEC_PER_SEC), (nsec % NSEC_PER_SEC) };
@@ -86,14 +212,261 @@ osal_retval_t osal_sleep_until_nsec(osal_uint64_t nsec) {
     return osal_sleep_until(&abs_to);
 }
 
+//! Sub buckets per power of two in the wakeup latency histogram.
+#define PRECISE_SUB_BITS        2u
+//! Latencies from 2^PRECISE_MAX_BITS ns on share the last bucket.
+#define PRECISE_MAX_BITS        25u
+#define PRECISE_BUCKETS         ((PRECISE_MAX_BITS - 1u) << PRECISE_SUB_BITS)
+//! Recalibrate after this many sleeps, then halve the histogram.
+#define PRECISE_WINDOW          256u
+//! Wakeup latency percentile covered by the slack, in 1/1000.
+#define PRECISE_PERMILLE        999u
+
+//! Per thread calibration of osal_sleep_until_precise.
+typedef struct precise_state {
+    osal_timer_precise_stats_t stats;
+    osal_uint32_t window;                       //!< Sleeps since last recalibration.
+    osal_uint32_t total;                        //!< Sum of histogram counts.
+    osal_uint32_t hist[PRECISE_BUCKETS];        //!< Log-linear wakeup latency histogram.
+} precise_state_t;
+
+static __thread precise_state_t precise_state;
+
+//! \brief Get histogram bucket of wakeup latency.
+static osal_uint32_t precise_bucket(osal_uint64_t lat) {
+    osal_uint32_t idx;
+
+    if (lat >= ((osal_uint64_t)1u << PRECISE_MAX_BITS)) {
+        idx = PRECISE_BUCKETS - 1u;
+    } else if (lat < (1u << PRECISE_SUB_BITS)) {
+        idx = (osal_uint32_t)lat;
+    } else {
+        osal_uint32_t msb = 63u - (osal_uint32_t)__builtin_clzll(lat);
+        osal_uint32_t sub = (osal_uint32_t)(lat >> (msb - PRECISE_SUB_BITS)) & ((1u << PRECISE_SUB_BITS) - 1u);
+        idx = ((msb - PRECISE_SUB_BITS + 1u) << PRECISE_SUB_BITS) + sub;
+    }
+
+    return idx;
+}
+
+//! \brief Get largest latency falling into bucket.
+static osal_uint64_t precise_bucket_max(osal_uint32_t idx) {
+    osal_uint64_t ret;
+
+    if (idx < (1u << PRECISE_SUB_BITS)) {
+        ret = idx;
+    } else {
+        osal_uint32_t shift = (idx >> PRECISE_SUB_BITS) - 1u;
+        osal_uint64_t sub = (idx & ((1u << PRECISE_SUB_BITS) - 1u)) + (1u << PRECISE_SUB_BITS) + 1u;
+        ret = (sub << shift) - 1u;
+    }
+
+    return ret;
+}
+
+//! \brief Limit slack to allowed range.
+static osal_uint64_t precise_clamp(osal_uint64_t slack) {
+    if (slack < OSAL_TIMER_PRECISE_SLACK_MIN) {
+        slack = OSAL_TIMER_PRECISE_SLACK_MIN;
+    } else if (slack > OSAL_TIMER_PRECISE_SLACK_MAX) {
+        slack = OSAL_TIMER_PRECISE_SLACK_MAX;
+    }
+
+    return slack;
+}
+
+//! \brief Record wakeup latency and recalibrate slack.
+static void precise_record(precise_state_t *st, osal_uint64_t lat) {
+    st->hist[precise_bucket(lat)]++;
+    st->total++;
+    st->window++;
+
+    if (st->window >= PRECISE_WINDOW) {
+        osal_uint32_t limit = (osal_uint32_t)(((osal_uint64_t)st->total * PRECISE_PERMILLE) / 1000u);
+        osal_uint32_t sum = 0u;
+        osal_uint32_t idx = 0u;
+
+        for (; idx < (PRECISE_BUCKETS - 1u); ++idx) {
+            sum += st->hist[idx];
+            if (sum > limit) {
+                break;
+            }
+        }
+
+        st->stats.slack = precise_clamp(precise_bucket_max(idx) + OSAL_TIMER_PRECISE_SLACK_MIN);
+
+        // exponential decay, recent wakeups dominate
+        st->total = 0u;
+        for (idx = 0u; idx < PRECISE_BUCKETS; ++idx) {
+            st->hist[idx] >>= 1u;
+            st->total += st->hist[idx];
+        }
+
+        st->window = 0u;
+    }
+}
+
+// Sleep, then busy-wait until current time equals nsec value
+osal_retval_t osal_sleep_until_precise(osal_uint64_t nsec) {
+    osal_retval_t ret = OSAL_OK;
+    precise_state_t *st = &precise_state;
+    osal_uint64_t now = osal_timer_gettime_nsec();
+
+    if (st->stats.slack == 0u) {
+        st->stats.slack = OSAL_TIMER_PRECISE_SLACK_DEFAULT;
+    }
+
+    if ((nsec > now) && ((nsec - now) > st->stats.slack)) {
+        osal_uint64_t target = nsec - st->stats.slack;
+
+        ret = osal_sleep_until_nsec(target);
+        now = osal_timer_gettime_nsec();
+
+        if (ret == OSAL_OK) {
+            osal_uint64_t lat = now > target ? now - target : 0u;
+
+            if (now > nsec) {
+                st->stats.late++;
+                st->stats.slack = precise_clamp(lat * 2u);
+            }
+
+            precise_record(st, lat);
+        }
+    }
+
+    while ((ret == OSAL_OK) && (now < nsec)) {
+        osal_cpu_relax();
+        now = osal_timer_gettime_nsec();
+    }
+
+    st->stats.cnt++;
+    return ret;
+}
+
+// Get calibration state of osal_sleep_until_precise for calling thread.
+void osal_timer_precise_get_stats(osal_timer_precise_stats_t *stats) {
+    assert(stats != NULL);
+
+    (*stats) = precise_state.stats;
+    if (stats->slack == 0u) {
+        stats->slack = OSAL_TIMER_PRECISE_SLACK_DEFAULT;
+    }
+}
+
+// Reset calibration of osal_sleep_until_precise for calling thread.
+void osal_timer_precise_reset(osal_uint64_t slack) {
+    (void)memset(&precise_state, 0, sizeof(precise_state));
+    precise_state.stats.slack = slack != 0u ? precise_clamp(slack) : OSAL_TIMER_PRECISE_SLACK_DEFAULT;
+}
+
 //! Sets globally the internal clock source
-void osal_timer_set_clock_source(int clock_id) { global_clock_id = clock_id; }
+void osal_timer_set_clock_source(int clock_id) { 
+    global_clock_id = clock_id; 
+
+#ifdef OSAL_TIMER_HAVE_TSC
+    const osal_timer_tsc_t *tsc = __atomic_load_n(&tsc_active, __ATOMIC_ACQUIRE);
+    if (tsc != NULL) {
+        // rebase timestamp counter on new clock
+        if (tsc_publish(tsc->mult, tsc->freq) != OSAL_OK) {
+            osal_timer_tsc_disable();
+        }
+    }
+#endif
+}
 
 //! Returns the globally configured internal clock source
 int osal_timer_get_clock_source(){
     return global_clock_id;
 }
 
+//! Get clock id from clock attribute (internal).
+clockid_t osal_timer_posix_clock(osal_uint32_t clock_attr) {
+    clockid_t ret = global_clock_id;
+
+    if (clock_attr == 1u) {
+        ret = CLOCK_REALTIME;
+    } else if (clock_attr == 2u) {
+        ret = CLOCK_MONOTONIC;
+    }
+
+    return ret;
+}
+
+//! Convert absolute timeout of a clock to CLOCK_REALTIME (internal).
+void osal_timer_posix_to_realtime(clockid_t clock_id, osal_uint64_t deadline_ns, struct timespec *ts) {
+    assert(ts != NULL);
+
+    if (clock_id != CLOCK_REALTIME) {
+        osal_uint64_t act_ns = osal_timer_posix_gettime_ns(clock_id);
+        osal_uint64_t rel_ns = deadline_ns > act_ns ? deadline_ns - act_ns : 0u;
+
+        deadline_ns = osal_timer_posix_gettime_ns(CLOCK_REALTIME) + rel_ns;
+    }
+
+    osal_timer_posix_ns_to_timespec(deadline_ns, ts);
+}
+
+//! Enables the CPU timestamp counter as fast time source.
+osal_retval_t osal_timer_tsc_enable(osal_uint64_t calibration_time) {
+    osal_retval_t ret = OSAL_ERR_NOT_IMPLEMENTED;
+
+#ifdef OSAL_TIMER_HAVE_TSC
+    osal_uint64_t c0 = 0u, n0 = 0u, c1 = 0u, n1 = 0u;
+
+    if (calibration_time == 0u) {
+        calibration_time = OSAL_TIMER_TSC_CALIBRATION_DEFAULT;
+    }
+
+    ret = tsc_check_invariant();
+    if (ret == OSAL_OK) {
+        ret = tsc_sample(CLOCK_MONOTONIC, &c0, &n0);
+    }
+
+    if (ret == OSAL_OK) {
+        struct timespec ts = { (calibration_time / NSEC_PER_SEC), (calibration_time % NSEC_PER_SEC) };
+        while (nanosleep(&ts, &ts) != 0) {}
+
+        ret = tsc_sample(CLOCK_MONOTONIC, &c1, &n1);
+    }
+
+    if ((ret == OSAL_OK) && ((c1 <= c0) || (n1 <= n0))) {
+        ret = OSAL_ERR_UNAVAILABLE;
+    }
+
+    if (ret == OSAL_OK) {
+        osal_uint64_t mult = (osal_uint64_t)(((unsigned __int128)(n1 - n0) << OSAL_TIMER_TSC_SHIFT) / (c1 - c0));
+        osal_uint64_t freq = (osal_uint64_t)(((unsigned __int128)(c1 - c0) * NSEC_PER_SEC) / (n1 - n0));
+
+        ret = tsc_publish(mult, freq);
+    }
+#else
+    (void)calibration_time;
+#endif
+
+    return ret;
+}
+
+//! Disables the CPU timestamp counter as time source.
+void osal_timer_tsc_disable(void) {
+#ifdef OSAL_TIMER_HAVE_TSC
+    __atomic_store_n(&tsc_active, NULL, __ATOMIC_RELEASE);
+#endif
+}
+
+//! Returns the calibrated timestamp counter frequency.
+osal_uint64_t osal_timer_tsc_get_frequency(void) {
+    osal_uint64_t ret = 0u;
+
+#ifdef OSAL_TIMER_HAVE_TSC
+    const osal_timer_tsc_t *tsc = __atomic_load_n(&tsc_active, __ATOMIC_ACQUIRE);
+    if (tsc != NULL) {
+        ret = tsc->freq;
+    }
+#endif
+
+    return ret;
+}
+
 //! gets timer 
 osal_retval_t osal_timer_gettime(osal_timer_t *timer) {
     assert(timer != NULL);
@@ -114,11 +487,21 @@ osal_retval_t osal_timer_gettime(osal_timer_t *timer) {
 // gets time in nanoseconds
 osal_uint64_t osal_timer_gettime_nsec(void) {
     osal_uint64_t ret = 0;
-    osal_timer_t tmr = { 0, 0 };
-    int local_ret = osal_timer_gettime(&tmr);
 
-    if (local_ret == OSAL_OK) {
-        ret = ((tmr.sec * NSEC_PER_SEC) + tmr.nsec);
+#ifdef OSAL_TIMER_HAVE_TSC
+    const osal_timer_tsc_t *tsc = __atomic_load_n(&tsc_active, __ATOMIC_ACQUIRE);
+    if (tsc != NULL) {
+        ret = tsc_to_nsec(tsc, tsc_read());
+    } else
+#endif
+    {
+        struct timespec ts;
+
+        if (clock_gettime(global_clock_id, &ts) == -1) {
+            perror("clock_gettime");
+        } else {
+            ret = (((osal_uint64_t)ts.tv_sec * NSEC_PER_SEC) + (osal_uint64_t)ts.tv_nsec);
+        }
     }
 
     return ret;
@@ -0,0 +1,560 @@
+/**
+ * \file posix/topology.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 18 Oct 2026
+ *
+ * \brief OSAL CPU topology posix source.
+ *
+ * OSAL CPU topology posix source, parses Linux sysfs.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <libosal/config.h>
+#include <libosal/osal.h>
+#include <libosal/topology.h>
+
+#include <assert.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+//! Large enough for a CPU list of every other CPU of a full set.
+#define POSIX_TOPOLOGY_BUF_SIZE     4096u
+
+//! \brief Read a sysfs file.
+/*!
+ * \param[in]   root    Sysfs mount point.
+ * \param[out]  buf     Returns the content, zero terminated.
+ * \param[in]   size    Size of \p buf.
+ * \param[in]   fmt     Path below \p root as printf format.
+ *
+ * \return 0 on success, -1 if the file could not be read.
+ */
+static int posix_topology_read(const char *root, char *buf, osal_size_t size, const char *fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static int posix_topology_read(const char *root, char *buf, osal_size_t size, const char *fmt, ...) {
+    int ret = -1;
+    char path[512];
+    int len = snprintf(path, sizeof(path), "%s/", root);
+
+    if ((len > 0) && ((osal_size_t)len < sizeof(path))) {
+        va_list args;
+        va_start(args, fmt);
+        (void)vsnprintf(&path[len], sizeof(path) - (osal_size_t)len, fmt, args);
+        va_end(args);
+
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            ssize_t cnt = read(fd, buf, size - 1u);
+            if (cnt >= 0) {
+                buf[cnt] = '\0';
+                ret = 0;
+            }
+
+            (void)close(fd);
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Parse a decimal number of a sysfs file.
+/*!
+ * \param[in]   buf     File content.
+ * \param[in]   def     Value returned if \p buf is no number.
+ *
+ * \return Parsed number or \p def.
+ */
+static osal_int32_t posix_topology_parse_int(const char *buf, osal_int32_t def) {
+    char *end;
+    long val = strtol(buf, &end, 10);
+
+    return ((end != buf) && ((*end == '\0') || isspace((unsigned char)*end))) ? (osal_int32_t)val : def;
+}
+
+//! \brief Parse a cache size like "32K".
+/*!
+ * \param[in]   buf     File content.
+ *
+ * \return Size in [byte], 0 if \p buf is no size.
+ */
+static osal_uint64_t posix_topology_parse_size(const char *buf) {
+    char *end;
+    osal_uint64_t size = (osal_uint64_t)strtoull(buf, &end, 10);
+
+    if (end == buf) {
+        size = 0u;
+    } else if (*end == 'K') {
+        size <<= 10u;
+    } else if (*end == 'M') {
+        size <<= 20u;
+    } else if (*end == 'G') {
+        size <<= 30u;
+    }
+
+    return size;
+}
+
+//! \brief Read a CPU list file.
+/*!
+ * \param[in]   root    Sysfs mount point.
+ * \param[in]   buf     Buffer of \ref POSIX_TOPOLOGY_BUF_SIZE bytes.
+ * \param[in]   path    Path below \p root.
+ * \param[out]  set     Returns the CPUs, empty if the file is missing or malformed.
+ *
+ * \return 0 on success, -1 if the file is missing or malformed.
+ */
+static int posix_topology_read_cpulist(const char *root, char *buf, const char *path, osal_cpuset_t *set) {
+    int ret = posix_topology_read(root, buf, POSIX_TOPOLOGY_BUF_SIZE, "%s", path);
+
+    // nohz_full reads "(null)" if not configured
+    if ((ret != 0) || (osal_topology_parse_cpulist(buf, set) != OSAL_OK)) {
+        osal_cpuset_zero(set);
+        ret = -1;
+    }
+
+    return ret;
+}
+
+//! \brief Add a cache unless another CPU already added it.
+/*!
+ * \param[in,out]   topo    Pointer to topology structure.
+ * \param[in,out]   cap     Allocated entries of topo->caches.
+ * \param[in]       cache   Cache to add.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t posix_topology_add_cache(osal_topology_t *topo, osal_uint32_t *cap,
+        const osal_topology_cache_t *cache) {
+    osal_retval_t ret = OSAL_OK;
+    osal_bool_t known = OSAL_FALSE;
+
+    for (osal_uint32_t i = 0u; (i < topo->cache_cnt) && (known == OSAL_FALSE); ++i) {
+        const osal_topology_cache_t *other = &topo->caches[i];
+
+        if ((other->level == cache->level) && (other->type == cache->type) &&
+                (memcmp(&other->cpus, &cache->cpus, sizeof(osal_cpuset_t)) == 0)) {
+            known = OSAL_TRUE;
+        }
+    }
+
+    if (known == OSAL_FALSE) {
+        if (topo->cache_cnt == *cap) {
+            osal_uint32_t new_cap = (*cap == 0u) ? 8u : (*cap * 2u);
+            osal_topology_cache_t *caches = (osal_topology_cache_t *)realloc(topo->caches,
+                    new_cap * sizeof(osal_topology_cache_t));
+
+            if (caches == NULL) {
+                ret = OSAL_ERR_OUT_OF_MEMORY;
+            } else {
+                topo->caches = caches;
+                *cap = new_cap;
+            }
+        }
+
+        if (ret == OSAL_OK) {
+            topo->caches[topo->cache_cnt] = *cache;
+            topo->cache_cnt++;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Read topology and caches of an online CPU.
+/*!
+ * \param[in,out]   topo    Pointer to topology structure.
+ * \param[in]       root    Sysfs mount point.
+ * \param[in]       buf     Buffer of \ref POSIX_TOPOLOGY_BUF_SIZE bytes.
+ * \param[in]       cpu     CPU number.
+ * \param[in,out]   cap     Allocated entries of topo->caches.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t posix_topology_read_cpu(osal_topology_t *topo, const char *root, char *buf,
+        osal_uint32_t cpu, osal_uint32_t *cap) {
+    osal_retval_t ret = OSAL_OK;
+    osal_topology_cpu_t *entry = &topo->cpus[cpu];
+    char path[128];
+
+    entry->online = OSAL_TRUE;
+    entry->core_id = -1;
+    entry->package_id = -1;
+    entry->node = -1;
+
+    if (posix_topology_read(root, buf, POSIX_TOPOLOGY_BUF_SIZE,
+                "devices/system/cpu/cpu%u/topology/core_id", cpu) == 0) {
+        entry->core_id = posix_topology_parse_int(buf, -1);
+    }
+
+    if (posix_topology_read(root, buf, POSIX_TOPOLOGY_BUF_SIZE,
+                "devices/system/cpu/cpu%u/topology/physical_package_id", cpu) == 0) {
+        entry->package_id = posix_topology_parse_int(buf, -1);
+    }
+
+    (void)snprintf(path, sizeof(path), "devices/system/cpu/cpu%u/topology/thread_siblings_list", cpu);
+    if (posix_topology_read_cpulist(root, buf, path, &entry->siblings) != 0) {
+        osal_cpuset_set(&entry->siblings, cpu);
+    }
+
+    // cache/indexN directories are numbered without gaps
+    for (osal_uint32_t idx = 0u; (ret == OSAL_OK) && (posix_topology_read(root, buf, POSIX_TOPOLOGY_BUF_SIZE,
+                "devices/system/cpu/cpu%u/cache/index%u/level", cpu, idx) == 0); ++idx) {
+        osal_topology_cache_t cache;
+
+        (void)memset(&cache, 0, sizeof(cache));
+        cache.level = (osal_uint32_t)posix_topology_parse_int(buf, 0);
+        cache.type = OSAL_TOPOLOGY_CACHE_UNIFIED;
+
+        if (posix_topology_read(root, buf, POSIX_TOPOLOGY_BUF_SIZE,
+                    "devices/system/cpu/cpu%u/cache/index%u/type", cpu, idx) == 0) {
+            if (strncmp(buf, "Data", 4) == 0) {
+                cache.type = OSAL_TOPOLOGY_CACHE_DATA;
+            } else if (strncmp(buf, "Instruction", 11) == 0) {
+                cache.type = OSAL_TOPOLOGY_CACHE_INSTRUCTION;
+            }
+        }
+
+        if (posix_topology_read(root, buf, POSIX_TOPOLOGY_BUF_SIZE,
+                    "devices/system/cpu/cpu%u/cache/index%u/size", cpu, idx) == 0) {
+            cache.size = posix_topology_parse_size(buf);
+        }
+
+        (void)snprintf(path, sizeof(path), "devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", cpu, idx);
+        if (posix_topology_read_cpulist(root, buf, path, &cache.cpus) != 0) {
+            osal_cpuset_set(&cache.cpus, cpu);
+        }
+
+        ret = posix_topology_add_cache(topo, cap, &cache);
+    }
+
+    return ret;
+}
+
+//! \brief Read the NUMA nodes.
+/*!
+ * \param[in,out]   topo    Pointer to topology structure.
+ * \param[in]       root    Sysfs mount point.
+ * \param[in]       buf     Buffer of \ref POSIX_TOPOLOGY_BUF_SIZE bytes.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t posix_topology_read_nodes(osal_topology_t *topo, const char *root, char *buf) {
+    osal_retval_t ret = OSAL_OK;
+    osal_cpuset_t ids;
+
+    // kernels without NUMA support have no node directory
+    if (posix_topology_read_cpulist(root, buf, "devices/system/node/possible", &ids) == 0) {
+        topo->nodes = (osal_topology_node_t *)calloc(osal_cpuset_count(&ids), sizeof(osal_topology_node_t));
+
+        if (topo->nodes == NULL) {
+            ret = OSAL_ERR_OUT_OF_MEMORY;
+        } else {
+            for (osal_int32_t id = osal_cpuset_next(&ids, -1); id >= 0; id = osal_cpuset_next(&ids, id)) {
+                char path[64];
+                osal_topology_node_t *node = &topo->nodes[topo->node_cnt];
+
+                (void)snprintf(path, sizeof(path), "devices/system/node/node%d/cpulist", id);
+                if (posix_topology_read_cpulist(root, buf, path, &node->cpus) == 0) {
+                    node->id = id;
+                    topo->node_cnt++;
+
+                    for (osal_int32_t cpu = osal_cpuset_next(&node->cpus, -1); cpu >= 0;
+                            cpu = osal_cpuset_next(&node->cpus, cpu)) {
+                        if ((osal_uint32_t)cpu < topo->cpu_cnt) {
+                            topo->cpus[cpu].node = id;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Parse a CPU list.
+osal_retval_t osal_topology_parse_cpulist(const osal_char_t *str, osal_cpuset_t *set) {
+    assert(str != NULL);
+    assert(set != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    const char *pos = str;
+
+    osal_cpuset_zero(set);
+
+    while ((ret == OSAL_OK) && (*pos != '\0') && (isspace((unsigned char)*pos) == 0)) {
+        char *end = NULL;
+        unsigned long first = 0u;
+        unsigned long last = 0u;
+
+        if (isdigit((unsigned char)*pos) == 0) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else {
+            first = strtoul(pos, &end, 10);
+            last = first;
+
+            if (*end == '-') {
+                pos = &end[1];
+
+                if (isdigit((unsigned char)*pos) == 0) {
+                    ret = OSAL_ERR_INVALID_PARAM;
+                } else {
+                    last = strtoul(pos, &end, 10);
+                }
+            }
+        }
+
+        if (ret == OSAL_OK) {
+            if ((first > last) || (last >= OSAL_CPUSET_SIZE)) {
+                ret = OSAL_ERR_INVALID_PARAM;
+            } else {
+                for (unsigned long cpu = first; cpu <= last; ++cpu) {
+                    osal_cpuset_set(set, (osal_uint32_t)cpu);
+                }
+
+                if (*end == ',') {
+                    pos = &end[1];
+
+                    if (isdigit((unsigned char)*pos) == 0) {
+                        ret = OSAL_ERR_INVALID_PARAM;
+                    }
+                } else if ((*end == '\0') || (isspace((unsigned char)*end) != 0)) {
+                    pos = end;
+                } else {
+                    ret = OSAL_ERR_INVALID_PARAM;
+                }
+            }
+        }
+    }
+
+    while ((ret == OSAL_OK) && (*pos != '\0')) {
+        if (isspace((unsigned char)*pos) == 0) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        }
+
+        pos++;
+    }
+
+    if (ret != OSAL_OK) {
+        osal_cpuset_zero(set);
+    }
+
+    return ret;
+}
+
+//! \brief Read the CPU topology.
+osal_retval_t osal_topology_init(osal_topology_t *topo, const osal_char_t *sysfs_root) {
+    assert(topo != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    const char *root = (sysfs_root != NULL) ? sysfs_root : OSAL_TOPOLOGY_SYSFS_ROOT;
+    char *buf = (char *)malloc(POSIX_TOPOLOGY_BUF_SIZE);
+    osal_uint32_t cache_cap = 0u;
+
+    (void)memset(topo, 0, sizeof(*topo));
+
+    if (buf == NULL) {
+        ret = OSAL_ERR_OUT_OF_MEMORY;
+    } else {
+        (void)posix_topology_read_cpulist(root, buf, "devices/system/cpu/possible", &topo->possible);
+        if (posix_topology_read_cpulist(root, buf, "devices/system/cpu/online", &topo->online) != 0) {
+            topo->online = topo->possible;
+        }
+
+        for (osal_uint32_t i = 0u; i < OSAL_CPUSET_WORDS; ++i) {
+            topo->possible.bits[i] |= topo->online.bits[i];
+        }
+
+        (void)posix_topology_read_cpulist(root, buf, "devices/system/cpu/isolated", &topo->isolated);
+        (void)posix_topology_read_cpulist(root, buf, "devices/system/cpu/nohz_full", &topo->nohz_full);
+
+        for (osal_int32_t cpu = osal_cpuset_next(&topo->possible, -1); cpu >= 0;
+                cpu = osal_cpuset_next(&topo->possible, cpu)) {
+            topo->cpu_cnt = (osal_uint32_t)cpu + 1u;
+        }
+
+        if (topo->cpu_cnt == 0u) {
+            ret = OSAL_ERR_NOT_FOUND;
+        } else {
+            topo->cpus = (osal_topology_cpu_t *)calloc(topo->cpu_cnt, sizeof(osal_topology_cpu_t));
+
+            if (topo->cpus == NULL) {
+                ret = OSAL_ERR_OUT_OF_MEMORY;
+            }
+        }
+
+        for (osal_int32_t cpu = osal_cpuset_next(&topo->online, -1); (ret == OSAL_OK) && (cpu >= 0);
+                cpu = osal_cpuset_next(&topo->online, cpu)) {
+            ret = posix_topology_read_cpu(topo, root, buf, (osal_uint32_t)cpu, &cache_cap);
+        }
+
+        if (ret == OSAL_OK) {
+            ret = posix_topology_read_nodes(topo, root, buf);
+        }
+
+        free(buf);
+    }
+
+    if (ret != OSAL_OK) {
+        (void)osal_topology_destroy(topo);
+    }
+
+    return ret;
+}
+
+//! \brief Release the CPU topology.
+osal_retval_t osal_topology_destroy(osal_topology_t *topo) {
+    assert(topo != NULL);
+
+    free(topo->cpus);
+    free(topo->caches);
+    free(topo->nodes);
+    (void)memset(topo, 0, sizeof(*topo));
+
+    return OSAL_OK;
+}
+
+//! \brief Get the SMT siblings of a CPU.
+osal_retval_t osal_topology_get_siblings(const osal_topology_t *topo, osal_uint32_t cpu, osal_cpuset_t *set) {
+    assert(topo != NULL);
+    assert(set != NULL);
+
+    osal_retval_t ret = OSAL_ERR_NOT_FOUND;
+
+    if ((cpu < topo->cpu_cnt) && (topo->cpus[cpu].online == OSAL_TRUE)) {
+        *set = topo->cpus[cpu].siblings;
+        ret = OSAL_OK;
+    }
+
+    return ret;
+}
+
+//! \brief Get the CPUs sharing a cache with a CPU.
+osal_retval_t osal_topology_get_cache_cpus(const osal_topology_t *topo, osal_uint32_t cpu,
+        osal_uint32_t level, osal_cpuset_t *set) {
+    assert(topo != NULL);
+    assert(set != NULL);
+
+    osal_retval_t ret = OSAL_ERR_NOT_FOUND;
+
+    for (osal_uint32_t i = 0u; (i < topo->cache_cnt) && (ret != OSAL_OK); ++i) {
+        const osal_topology_cache_t *cache = &topo->caches[i];
+
+        if ((cache->level == level) && (cache->type != OSAL_TOPOLOGY_CACHE_INSTRUCTION) &&
+                (osal_cpuset_isset(&cache->cpus, cpu) == OSAL_TRUE)) {
+            *set = cache->cpus;
+            ret = OSAL_OK;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Get the CPUs of the NUMA node of a CPU.
+osal_retval_t osal_topology_get_node_cpus(const osal_topology_t *topo, osal_uint32_t cpu, osal_cpuset_t *set) {
+    assert(topo != NULL);
+    assert(set != NULL);
+
+    osal_retval_t ret = OSAL_ERR_NOT_FOUND;
+
+    if ((cpu < topo->cpu_cnt) && (topo->cpus[cpu].online == OSAL_TRUE)) {
+        for (osal_uint32_t i = 0u; (i < topo->node_cnt) && (ret != OSAL_OK); ++i) {
+            if (topo->nodes[i].id == topo->cpus[cpu].node) {
+                *set = topo->nodes[i].cpus;
+                ret = OSAL_OK;
+            }
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Check if a CPU satisfies the isolation flags.
+/*!
+ * \param[in]   topo    Pointer to topology structure.
+ * \param[in]   flags   OSAL_TOPOLOGY_PLACE__* flags.
+ * \param[in]   cpu     CPU number.
+ *
+ * \return OSAL_TRUE if \p cpu is isolated as requested.
+ */
+static osal_bool_t posix_topology_is_isolated(const osal_topology_t *topo, osal_uint32_t flags, osal_uint32_t cpu) {
+    osal_bool_t ret = OSAL_TRUE;
+
+    if (((flags & OSAL_TOPOLOGY_PLACE__ISOLATED) != 0u) && (osal_cpuset_isset(&topo->isolated, cpu) == OSAL_FALSE)) {
+        ret = OSAL_FALSE;
+    }
+
+    if (((flags & OSAL_TOPOLOGY_PLACE__NOHZ_FULL) != 0u) && (osal_cpuset_isset(&topo->nohz_full, cpu) == OSAL_FALSE)) {
+        ret = OSAL_FALSE;
+    }
+
+    return ret;
+}
+
+//! \brief Choose a CPU for a task.
+osal_retval_t osal_topology_place(const osal_topology_t *topo, osal_uint32_t flags,
+        const osal_cpuset_t *candidates, const osal_cpuset_t *busy, osal_uint32_t *cpu) {
+    assert(topo != NULL);
+    assert(cpu != NULL);
+
+    osal_retval_t ret = OSAL_ERR_NOT_FOUND;
+
+    for (osal_int32_t i = osal_cpuset_next(&topo->online, -1); (i >= 0) && (ret != OSAL_OK);
+            i = osal_cpuset_next(&topo->online, i)) {
+        osal_uint32_t c = (osal_uint32_t)i;
+        osal_bool_t usable = posix_topology_is_isolated(topo, flags, c);
+
+        if ((candidates != NULL) && (osal_cpuset_isset(candidates, c) == OSAL_FALSE)) {
+            usable = OSAL_FALSE;
+        }
+
+        if ((busy != NULL) && (osal_cpuset_isset(busy, c) == OSAL_TRUE)) {
+            usable = OSAL_FALSE;
+        }
+
+        if ((usable == OSAL_TRUE) && ((flags & OSAL_TOPOLOGY_PLACE__IDLE_SMT) != 0u)) {
+            const osal_cpuset_t *siblings = &topo->cpus[c].siblings;
+
+            // a sibling outside the isolated set gets arbitrary tasks from the scheduler
+            for (osal_int32_t s = osal_cpuset_next(siblings, -1); (s >= 0) && (usable == OSAL_TRUE);
+                    s = osal_cpuset_next(siblings, s)) {
+                if (((busy != NULL) && (osal_cpuset_isset(busy, (osal_uint32_t)s) == OSAL_TRUE)) ||
+                        (posix_topology_is_isolated(topo, flags, (osal_uint32_t)s) == OSAL_FALSE)) {
+                    usable = OSAL_FALSE;
+                }
+            }
+        }
+
+        if (usable == OSAL_TRUE) {
+            *cpu = c;
+            ret = OSAL_OK;
+        }
+    }
+
+    return ret;
+}
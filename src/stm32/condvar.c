@@ -178,6 +178,34 @@ osal_retval_t osal_condvar_timedwait(osal_condvar_t *cv, osal_mutex_t *mtx, cons
     return ret;
 }
 
+//! \brief Wait for a condvar until a deadline in nanoseconds.
+/*!
+ * \param[in]   cv          Pointer to osal condvar structure. Content is OS dependent.
+ * \param[in]   mtx         Pointer to osal mutex structure. Content is OS dependent.
+ * \param[in]   deadline_ns Absolute timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_condvar_wait_until_ns(osal_condvar_t *cv, osal_mutex_t *mtx, osal_uint64_t deadline_ns) {
+    osal_timer_t to;
+    to.sec = deadline_ns / NSEC_PER_SEC;
+    to.nsec = deadline_ns % NSEC_PER_SEC;
+
+    return osal_condvar_timedwait(cv, mtx, &to);
+}
+
+//! \brief Wait for a condvar for a time in nanoseconds.
+/*!
+ * \param[in]   cv          Pointer to osal condvar structure. Content is OS dependent.
+ * \param[in]   mtx         Pointer to osal mutex structure. Content is OS dependent.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_condvar_wait_for_ns(osal_condvar_t *cv, osal_mutex_t *mtx, osal_uint64_t rel_ns) {
+    return osal_condvar_wait_until_ns(cv, mtx, osal_timer_gettime_nsec() + rel_ns);
+}
+
 //! \brief Destroys a condvar.
 /*!
  * \param[in]   cv     Pointer to osal condvar structure. Content is OS dependent.
@@ -342,6 +342,74 @@ osal_retval_t osal_mq_timedreceive(osal_mq_t *mq, osal_char_t *msg, const osal_s
 }
 
 
+//! \brief Send a message through message queue until a deadline in nanoseconds.
+/*!
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   msg         Pointer to message buffer.
+ * \param[in]   msg_len     Lenght of message to send.
+ * \param[in]   prio        Send priority.
+ * \param[in]   deadline_ns Absolute timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_send_until_ns(osal_mq_t *mq, const osal_char_t *msg, const osal_size_t msg_len, 
+        const osal_uint32_t prio, osal_uint64_t deadline_ns) {
+    osal_timer_t to;
+    to.sec = deadline_ns / NSEC_PER_SEC;
+    to.nsec = deadline_ns % NSEC_PER_SEC;
+
+    return osal_mq_timedsend(mq, msg, msg_len, prio, &to);
+}
+
+//! \brief Send a message through message queue waiting at most a time in nanoseconds.
+/*!
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   msg         Pointer to message buffer.
+ * \param[in]   msg_len     Lenght of message to send.
+ * \param[in]   prio        Send priority.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_send_for_ns(osal_mq_t *mq, const osal_char_t *msg, const osal_size_t msg_len, 
+        const osal_uint32_t prio, osal_uint64_t rel_ns) {
+    return osal_mq_send_until_ns(mq, msg, msg_len, prio, osal_timer_gettime_nsec() + rel_ns);
+}
+
+//! \brief Receive a message through message queue until a deadline in nanoseconds.
+/*!
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[out]  msg         Pointer to message buffer.
+ * \param[in]   msg_len     Lenght of message to receive.
+ * \param[out]  prio        Receive priority.
+ * \param[in]   deadline_ns Absolute timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_receive_until_ns(osal_mq_t *mq, osal_char_t *msg, const osal_size_t msg_len, 
+        osal_uint32_t *prio, osal_uint64_t deadline_ns) {
+    osal_timer_t to;
+    to.sec = deadline_ns / NSEC_PER_SEC;
+    to.nsec = deadline_ns % NSEC_PER_SEC;
+
+    return osal_mq_timedreceive(mq, msg, msg_len, prio, &to);
+}
+
+//! \brief Receive a message through message queue waiting at most a time in nanoseconds.
+/*!
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[out]  msg         Pointer to message buffer.
+ * \param[in]   msg_len     Lenght of message to receive.
+ * \param[out]  prio        Receive priority.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_receive_for_ns(osal_mq_t *mq, osal_char_t *msg, const osal_size_t msg_len, 
+        osal_uint32_t *prio, osal_uint64_t rel_ns) {
+    return osal_mq_receive_until_ns(mq, msg, msg_len, prio, osal_timer_gettime_nsec() + rel_ns);
+}
+
 //! \brief Closes an open mq.
 /*!
  * \param[in]   mq     Pointer to osal mq structure. Content is OS dependent.
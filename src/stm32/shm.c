@@ -245,4 +245,30 @@ osal_retval_t osal_shm_close(osal_shm_t *shm) {
     return ret;
 }
 
+//! \brief Unmap a shm.
+/*!
+ * \param[in]   shm     Pointer to osal shm structure. Content is OS dependent.
+ * \param[in]   ptr     Pointer returned by \ref osal_shm_map.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_unmap(osal_shm_t *shm, osal_void_t *ptr) {
+    assert(shm != NULL);
+    (void)shm;
+    (void)ptr;
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Remove a shm name.
+/*!
+ * \param[in]   name    Shared memory name.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_unlink(const osal_char_t *name) {
+    assert(name != NULL);
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
 
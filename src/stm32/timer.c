@@ -61,6 +61,21 @@ osal_retval_t osal_sleep_until_nsec(osal_uint64_t nsec) {
     return osal_sleep_until(&abs_to);
 }
 
+//! Enables the CPU timestamp counter as fast time source. Not supported on STM32
+osal_retval_t osal_timer_tsc_enable(osal_uint64_t calibration_time) {
+    (void)calibration_time;
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! Disables the CPU timestamp counter as time source. Not supported on STM32
+void osal_timer_tsc_disable(void) {
+}
+
+//! Returns the calibrated timestamp counter frequency. Not supported on STM32
+osal_uint64_t osal_timer_tsc_get_frequency(void) {
+    return 0u;
+}
+
 //! gets timer 
 osal_retval_t osal_timer_gettime(osal_timer_t *timer) {
     assert(timer != NULL);
@@ -0,0 +1,288 @@
+/**
+ * \file timer_service.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 17 Oct 2026
+ *
+ * \brief OSAL timer service source.
+ *
+ * OSAL timer service source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <libosal/osal.h>
+#include <libosal/timer_service.h>
+
+#include <assert.h>
+#include <string.h>
+
+#define WHEEL_MASK  ((osal_uint64_t)OSAL_TIMER_SERVICE_WHEEL_SIZE - 1u)
+
+//! \brief Link timer into the wheel slot of its expiry tick.
+static void timer_service_insert(osal_timer_service_t *svc, osal_timer_service_timer_t *tmr) {
+    osal_uint64_t expire = tmr->expire;
+    osal_uint64_t delta = expire - svc->now;
+    osal_uint32_t level = 0u;
+
+    while (     (level < (OSAL_TIMER_SERVICE_LEVELS - 1u)) && 
+                (delta >= ((osal_uint64_t)1u << (OSAL_TIMER_SERVICE_WHEEL_BITS * (level + 1u))))) {
+        level++;
+    }
+
+    if (delta >= ((osal_uint64_t)1u << (OSAL_TIMER_SERVICE_WHEEL_BITS * OSAL_TIMER_SERVICE_LEVELS))) {
+        // beyond the wheel, park in the last slot and cascade again later
+        expire = svc->now + ((osal_uint64_t)1u << (OSAL_TIMER_SERVICE_WHEEL_BITS * OSAL_TIMER_SERVICE_LEVELS)) - 1u;
+    }
+
+    osal_uint64_t idx = (expire >> (OSAL_TIMER_SERVICE_WHEEL_BITS * level)) & WHEEL_MASK;
+    LIST_INSERT_HEAD(&svc->wheel[level][idx], tmr, entry);
+}
+
+//! \brief Move all timers of a slot to another list.
+static void timer_service_splice(struct osal_timer_service_slot *from, struct osal_timer_service_slot *to) {
+    LIST_FIRST(to) = LIST_FIRST(from);
+    if (LIST_FIRST(to) != NULL) {
+        LIST_FIRST(to)->entry.le_prev = &LIST_FIRST(to);
+    }
+
+    LIST_INIT(from);
+}
+
+//! \brief Advance wheel by one tick, return timers expiring in it.
+static void timer_service_advance(osal_timer_service_t *svc, struct osal_timer_service_slot *batch) {
+    osal_uint64_t now = svc->now;
+
+    // redistribute the next slot of higher levels when the lower level wraps
+    for (osal_uint32_t level = 1u; level < OSAL_TIMER_SERVICE_LEVELS; ++level) {
+        if ((now & (((osal_uint64_t)1u << (OSAL_TIMER_SERVICE_WHEEL_BITS * level)) - 1u)) != 0u) {
+            break;
+        }
+
+        struct osal_timer_service_slot cascade;
+        timer_service_splice(&svc->wheel[level][(now >> (OSAL_TIMER_SERVICE_WHEEL_BITS * level)) & WHEEL_MASK], &cascade);
+
+        while (!LIST_EMPTY(&cascade)) {
+            osal_timer_service_timer_t *tmr = LIST_FIRST(&cascade);
+            LIST_REMOVE(tmr, entry);
+            timer_service_insert(svc, tmr);
+        }
+    }
+
+    timer_service_splice(&svc->wheel[0][now & WHEEL_MASK], batch);
+    svc->now++;
+}
+
+//! \brief Call expired timers of one tick.
+static void timer_service_dispatch(osal_timer_service_t *svc, struct osal_timer_service_slot *batch) {
+    while (!LIST_EMPTY(batch)) {
+        osal_timer_service_timer_t *tmr = LIST_FIRST(batch);
+        osal_timer_service_cb_t cb = tmr->cb;
+        osal_void_t *arg = tmr->arg;
+        osal_uint64_t period = tmr->period;
+        osal_uint32_t gen = tmr->gen;
+
+        LIST_REMOVE(tmr, entry);
+        tmr->armed = 0u;
+        svc->armed_cnt--;
+
+        osal_mutex_unlock(&svc->lock);
+        cb(arg);
+        osal_mutex_lock(&svc->lock);
+
+        // one-shot timers may have been freed or reused by their callback,
+        // re-arm periodic timer unless callback re-armed or cancelled it
+        if ((period != 0u) && (tmr->gen == gen) && (svc->stop == 0u)) {
+            tmr->expire += tmr->period;
+            if (tmr->expire < svc->now) {
+                tmr->expire = svc->now;
+            }
+
+            tmr->armed = 1u;
+            svc->armed_cnt++;
+            timer_service_insert(svc, tmr);
+        }
+    }
+}
+
+//! \brief Dispatching task.
+static osal_void_t *timer_service_task(osal_void_t *arg) {
+    osal_timer_service_t *svc = (osal_timer_service_t *)arg;
+    struct osal_timer_service_slot batch;
+
+    LIST_INIT(&batch);
+
+    while (__atomic_load_n(&svc->stop, __ATOMIC_RELAXED) == 0u) {
+        (void)osal_sleep_until_nsec(svc->start + (svc->now * svc->tick));
+
+        osal_uint64_t cur = osal_timer_gettime_nsec();
+
+        osal_mutex_lock(&svc->lock);
+
+        while (((svc->start + (svc->now * svc->tick)) <= cur) && (svc->stop == 0u)) {
+            timer_service_advance(svc, &batch);
+            timer_service_dispatch(svc, &batch);
+        }
+
+        osal_mutex_unlock(&svc->lock);
+    }
+
+    return NULL;
+}
+
+//! \brief Initialize timer service.
+/*!
+ * \param[out]  svc     Pointer to timer service.
+ * \param[in]   attr    Pointer to service attributes. Can be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_timer_service_init(osal_timer_service_t *svc, const osal_timer_service_attr_t *attr) {
+    assert(svc != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    (void)memset(svc, 0, sizeof(*svc));
+    svc->tick = ((attr != NULL) && (attr->tick != 0u)) ? attr->tick : OSAL_TIMER_SERVICE_TICK_DEFAULT;
+
+    for (osal_uint32_t level = 0u; level < OSAL_TIMER_SERVICE_LEVELS; ++level) {
+        for (osal_uint32_t idx = 0u; idx < OSAL_TIMER_SERVICE_WHEEL_SIZE; ++idx) {
+            LIST_INIT(&svc->wheel[level][idx]);
+        }
+    }
+
+    ret = osal_mutex_init(&svc->lock, NULL);
+    if (ret == OSAL_OK) {
+        svc->start = osal_timer_gettime_nsec();
+
+        ret = osal_task_create(&svc->task, attr != NULL ? &attr->task_attr : NULL, timer_service_task, svc);
+        if (ret != OSAL_OK) {
+            (void)osal_mutex_destroy(&svc->lock);
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Destroy timer service.
+/*!
+ * \param[in]   svc     Pointer to timer service.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_timer_service_destroy(osal_timer_service_t *svc) {
+    assert(svc != NULL);
+
+    osal_retval_t ret;
+
+    osal_mutex_lock(&svc->lock);
+    __atomic_store_n(&svc->stop, 1u, __ATOMIC_RELAXED);
+    osal_mutex_unlock(&svc->lock);
+
+    ret = osal_task_join(&svc->task, NULL);
+    if (ret == OSAL_OK) {
+        ret = osal_mutex_destroy(&svc->lock);
+    }
+
+    return ret;
+}
+
+//! \brief Initialize software timer.
+/*!
+ * \param[out]  tmr     Pointer to timer.
+ * \param[in]   cb      Callback called on the dispatching task on expiry.
+ * \param[in]   arg     Callback argument.
+ */
+void osal_timer_service_timer_init(osal_timer_service_timer_t *tmr, osal_timer_service_cb_t cb, osal_void_t *arg) {
+    assert(tmr != NULL);
+    assert(cb != NULL);
+
+    (void)memset(tmr, 0, sizeof(*tmr));
+    tmr->cb = cb;
+    tmr->arg = arg;
+}
+
+//! \brief Arm software timer.
+/*!
+ * \param[in]   svc         Pointer to timer service.
+ * \param[in]   tmr         Pointer to timer.
+ * \param[in]   timeout     Relative timeout in [ns].
+ * \param[in]   period      Period in [ns] rounded up to ticks, 0 for one-shot.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_timer_service_arm(osal_timer_service_t *svc, osal_timer_service_timer_t *tmr,
+        osal_uint64_t timeout, osal_uint64_t period)
+{
+    assert(svc != NULL);
+    assert(tmr != NULL);
+
+    osal_uint64_t cur = osal_timer_gettime_nsec();
+    // first tick starting at or after the deadline
+    osal_uint64_t expire = ((cur - svc->start) + timeout + svc->tick - 1u) / svc->tick;
+
+    osal_mutex_lock(&svc->lock);
+
+    if (tmr->armed != 0u) {
+        LIST_REMOVE(tmr, entry);
+    } else {
+        tmr->armed = 1u;
+        svc->armed_cnt++;
+    }
+
+    tmr->gen++;
+    tmr->period = (period + svc->tick - 1u) / svc->tick;
+    tmr->expire = expire < svc->now ? svc->now : expire;
+    timer_service_insert(svc, tmr);
+
+    osal_mutex_unlock(&svc->lock);
+
+    return OSAL_OK;
+}
+
+//! \brief Cancel software timer.
+/*!
+ * \param[in]   svc     Pointer to timer service.
+ * \param[in]   tmr     Pointer to timer.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_timer_service_cancel(osal_timer_service_t *svc, osal_timer_service_timer_t *tmr) {
+    assert(svc != NULL);
+    assert(tmr != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    osal_mutex_lock(&svc->lock);
+
+    tmr->gen++;
+    if (tmr->armed != 0u) {
+        LIST_REMOVE(tmr, entry);
+        tmr->armed = 0u;
+        svc->armed_cnt--;
+    } else {
+        ret = OSAL_ERR_NOT_FOUND;
+    }
+
+    osal_mutex_unlock(&svc->lock);
+
+    return ret;
+}
+
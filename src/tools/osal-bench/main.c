@@ -0,0 +1,415 @@
+/**
+ * \file main.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 17 Oct 2026
+ *
+ * \brief OSAL micro benchmarks.
+ *
+ * Collection of micro benchmarks for libosal, selected by sub command.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+#include <libosal/osal.h>
+#include <libosal/executor.h>
+#include <libosal/trace.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+
+//! Benchmark entry point, gets arguments following the sub command.
+typedef int (*bench_func_t)(int argc, char **argv);
+
+typedef struct bench {
+    const char *name;               //!< sub command name.
+    const char *args;               //!< argument synopsis.
+    const char *help;               //!< one line description.
+    bench_func_t func;              //!< benchmark function.
+} bench_t;
+
+//! \brief Parse unsigned argument or return default.
+static osal_uint64_t arg_u64(int argc, char **argv, int idx, osal_uint64_t def) {
+    return idx < argc ? strtoull(argv[idx], NULL, 0) : def;
+}
+
+//! \brief Benchmark trace analysis kernels.
+static int bench_trace_analyze(int argc, char **argv) {
+    static const struct { osal_trace_kernel_t kernel; const char *name; } kernels[] = {
+        { OSAL_TRACE_KERNEL__SCALAR,    "scalar" },
+        { OSAL_TRACE_KERNEL__SSE42,     "sse4.2" },
+        { OSAL_TRACE_KERNEL__AVX2,      "avx2" },
+        { OSAL_TRACE_KERNEL__NEON,      "neon" },
+    };
+
+    osal_uint32_t samples = (osal_uint32_t)arg_u64(argc, argv, 0, 1000000u);
+    osal_uint32_t loops   = (osal_uint32_t)arg_u64(argc, argv, 1, 100u);
+    osal_uint64_t scalar_ns = 0u;
+    osal_trace_t *trace;
+
+    if ((samples < 2u) || (loops == 0u)) {
+        printf("samples must be >= 2, loops > 0\n");
+        return 1;
+    }
+
+    if (osal_trace_alloc(&trace, samples) != OSAL_OK) {
+        printf("cannot allocate trace with %u samples\n", samples);
+        return 1;
+    }
+
+    // 1 ms cycle with deterministic +-1 us jitter
+    osal_uint64_t t = 1000000000u;
+    for (osal_uint32_t i = 0u; i < samples; ++i) {
+        t += 1000000u + ((i * 7919u) % 2001u) - 1000u;
+        osal_trace_time(trace, t);
+    }
+
+    printf("trace-analyze: %u samples, %u loops\n", samples, loops);
+    printf("%-8s %12s %12s %10s %12s %12s\n", "kernel", "ns/loop", "ns/sample", "speedup", "avg", "avg_jit");
+
+    for (unsigned k = 0u; k < (sizeof(kernels) / sizeof(kernels[0])); ++k) {
+        osal_uint64_t avg, avg_jit, max_jit, min_val, max_val;
+
+        if (osal_trace_set_kernel(kernels[k].kernel) != OSAL_OK) {
+            printf("%-8s %12s\n", kernels[k].name, "n/a");
+            continue;
+        }
+
+        // warm up caches
+        osal_trace_analyze_min_max(trace, &avg, &avg_jit, &max_jit, &min_val, &max_val);
+
+        osal_uint64_t start = osal_timer_gettime_nsec();
+        for (osal_uint32_t l = 0u; l < loops; ++l) {
+            osal_trace_analyze_min_max(trace, &avg, &avg_jit, &max_jit, &min_val, &max_val);
+        }
+        osal_uint64_t per_loop = (osal_timer_gettime_nsec() - start) / loops;
+
+        if (kernels[k].kernel == OSAL_TRACE_KERNEL__SCALAR) {
+            scalar_ns = per_loop;
+        }
+
+        printf("%-8s %12lu %12.3f %9.2fx %12lu %12lu\n", kernels[k].name, 
+                (unsigned long)per_loop, (double)per_loop / samples, 
+                per_loop != 0u ? (double)scalar_ns / per_loop : 0., 
+                (unsigned long)avg, (unsigned long)avg_jit);
+    }
+
+    (void)osal_trace_set_kernel(OSAL_TRACE_KERNEL__AUTO);
+    osal_trace_free(trace);
+    return 0;
+}
+
+//! \brief Benchmark osal_timer_gettime_nsec with clock_gettime and timestamp counter.
+static int bench_timer_gettime(int argc, char **argv) {
+    osal_uint32_t loops = (osal_uint32_t)arg_u64(argc, argv, 0, 10000000u);
+    volatile osal_uint64_t sink = 0u;
+
+    if (loops == 0u) {
+        printf("loops must be > 0\n");
+        return 1;
+    }
+
+    printf("timer-gettime: %u loops\n", loops);
+    printf("%-8s %12s\n", "source", "ns/call");
+
+    for (int use_tsc = 0; use_tsc < 2; ++use_tsc) {
+        if (use_tsc != 0) {
+            osal_retval_t ret = osal_timer_tsc_enable(0u);
+            if (ret != OSAL_OK) {
+                printf("%-8s %12s\n", "tsc", "n/a");
+                break;
+            }
+        }
+
+        osal_uint64_t start = osal_timer_gettime_nsec();
+        for (osal_uint32_t l = 0u; l < loops; ++l) {
+            sink = osal_timer_gettime_nsec();
+        }
+        osal_uint64_t total = osal_timer_gettime_nsec() - start;
+
+        printf("%-8s %12.2f", use_tsc != 0 ? "tsc" : "clock", (double)total / loops);
+        if (use_tsc != 0) {
+            printf("   (%lu Hz)", (unsigned long)osal_timer_tsc_get_frequency());
+        }
+        printf("\n");
+    }
+
+    osal_timer_tsc_disable();
+    (void)sink;
+    return 0;
+}
+
+//! Work of one executor benchmark job.
+typedef struct bench_job {
+    osal_uint32_t work;             //!< loop iterations.
+    volatile osal_uint64_t result;  //!< keeps the loop from being optimized away.
+} bench_job_t;
+
+//! \brief Executor benchmark job function.
+static void bench_job_func(osal_void_t *arg) {
+    bench_job_t *job = (bench_job_t *)arg;
+    osal_uint64_t x = job->work;
+
+    for (osal_uint32_t i = 0u; i < job->work; ++i) {
+        x = (x * 6364136223846793005u) + 1442695040888963407u;
+    }
+
+    job->result = x;
+}
+
+//! \brief Task handler running one job.
+static osal_void_t *bench_job_task(osal_void_t *arg) {
+    bench_job_func(arg);
+    return NULL;
+}
+
+//! \brief Benchmark executor against one task per job.
+static int bench_executor(int argc, char **argv) {
+    osal_uint32_t jobs    = (osal_uint32_t)arg_u64(argc, argv, 0, 100000u);
+    osal_uint32_t work    = (osal_uint32_t)arg_u64(argc, argv, 1, 1000u);
+    osal_uint32_t workers = (osal_uint32_t)arg_u64(argc, argv, 2, 0u);
+    osal_executor_attr_t attr;
+    osal_executor_t exec;
+    osal_executor_wg_t wg;
+    int ret = 0;
+
+    if (jobs == 0u) {
+        printf("jobs must be > 0\n");
+        return 1;
+    }
+
+    bench_job_t *data = (bench_job_t *)calloc(jobs, sizeof(bench_job_t));
+    osal_executor_job_t *ejobs = (osal_executor_job_t *)calloc(jobs, sizeof(osal_executor_job_t));
+    osal_task_t *tasks = NULL;
+
+    (void)memset(&attr, 0, sizeof(attr));
+    attr.workers = workers;
+
+    if ((data == NULL) || (ejobs == NULL)) {
+        printf("cannot allocate %u jobs\n", jobs);
+        ret = 1;
+    } else if (osal_executor_init(&exec, &attr) != OSAL_OK) {
+        printf("cannot create executor\n");
+        ret = 1;
+    } else {
+        workers = exec.worker_cnt;
+        tasks = (osal_task_t *)calloc(workers, sizeof(osal_task_t));
+
+        for (osal_uint32_t i = 0u; i < jobs; ++i) {
+            data[i].work = work;
+        }
+
+        printf("executor: %u jobs, %u iterations/job, %u workers\n", jobs, work, workers);
+        printf("%-16s %12s %12s\n", "mode", "ms", "ns/job");
+
+        // same parallelism without pool: batches of one task per job
+        osal_uint64_t start = osal_timer_gettime_nsec();
+        for (osal_uint32_t i = 0u; (tasks != NULL) && (i < jobs); i += workers) {
+            osal_uint32_t batch = (jobs - i) < workers ? (jobs - i) : workers;
+
+            for (osal_uint32_t t = 0u; t < batch; ++t) {
+                (void)osal_task_create(&tasks[t], NULL, bench_job_task, &data[i + t]);
+            }
+            for (osal_uint32_t t = 0u; t < batch; ++t) {
+                (void)osal_task_join(&tasks[t], NULL);
+            }
+        }
+        osal_uint64_t dur = osal_timer_gettime_nsec() - start;
+        printf("%-16s %12.3f %12.1f\n", "task-per-job", dur / 1e6, (double)dur / jobs);
+
+        (void)osal_executor_wg_init(&wg);
+
+        start = osal_timer_gettime_nsec();
+        for (osal_uint32_t i = 0u; i < jobs; ++i) {
+            osal_executor_job_init(&ejobs[i], bench_job_func, &data[i]);
+            (void)osal_executor_submit(&exec, &ejobs[i], &wg);
+        }
+        (void)osal_executor_wg_wait(&exec, &wg);
+        dur = osal_timer_gettime_nsec() - start;
+        printf("%-16s %12.3f %12.1f\n", "executor", dur / 1e6, (double)dur / jobs);
+
+        (void)osal_executor_wg_destroy(&wg);
+        (void)osal_executor_destroy(&exec);
+    }
+
+    free(tasks);
+    free(ejobs);
+    free(data);
+    return ret;
+}
+
+typedef struct bench_spin {
+    osal_spinlock_t *lock;          //!< lock under test.
+    osal_spinlock_mcs_t *mcs;       //!< MCS lock under test, used instead of lock if set.
+    osal_uint32_t *stop;            //!< set to end the run.
+    osal_uint64_t *shared;          //!< data protected by the lock.
+    osal_uint32_t work;             //!< loop iterations inside the lock.
+    osal_uint64_t count;            //!< acquisitions of this task.
+} bench_spin_t;
+
+//! \brief Task locking in a loop until stopped.
+static osal_void_t *bench_spin_task(osal_void_t *arg) {
+    bench_spin_t *spin = (bench_spin_t *)arg;
+
+    while (__atomic_load_n(spin->stop, __ATOMIC_RELAXED) == 0u) {
+        if (spin->mcs != NULL) {
+            (void)osal_spinlock_mcs_lock(spin->mcs);
+        } else {
+            (void)osal_spinlock_lock(spin->lock);
+        }
+
+        osal_uint64_t x = *spin->shared;
+        for (osal_uint32_t i = 0u; i < spin->work; ++i) {
+            x = (x * 6364136223846793005u) + 1442695040888963407u;
+        }
+        *spin->shared = x + 1u;
+
+        if (spin->mcs != NULL) {
+            (void)osal_spinlock_mcs_unlock(spin->mcs);
+        } else {
+            (void)osal_spinlock_unlock(spin->lock);
+        }
+        spin->count++;
+    }
+
+    return NULL;
+}
+
+//! \brief Benchmark spinlock algorithms under contention.
+static int bench_spinlock(int argc, char **argv) {
+    // the MCS queue lock is its own type, selected by is_mcs
+    static const struct { osal_spinlock_attr_t attr; int is_mcs; const char *name; } algorithms[] = {
+        { OSAL_SPINLOCK_ATTR__ALGORITHM__DEFAULT,   0, "system" },
+        { OSAL_SPINLOCK_ATTR__ALGORITHM__TICKET,    0, "ticket" },
+        { OSAL_SPINLOCK_ATTR__ALGORITHM__DEFAULT,   1, "mcs" },
+        { OSAL_SPINLOCK_ATTR__ALGORITHM__TTAS,      0, "ttas" },
+    };
+
+    osal_uint32_t max_threads = (osal_uint32_t)arg_u64(argc, argv, 0, 64u);
+    osal_uint64_t duration    = arg_u64(argc, argv, 1, 200u);
+    osal_uint32_t work        = (osal_uint32_t)arg_u64(argc, argv, 2, 0u);
+
+    if ((max_threads < 2u) || (duration == 0u)) {
+        printf("threads must be >= 2, ms > 0\n");
+        return 1;
+    }
+
+    osal_task_t *tasks = (osal_task_t *)calloc(max_threads, sizeof(osal_task_t));
+    bench_spin_t *spins = (bench_spin_t *)calloc(max_threads, sizeof(bench_spin_t));
+    osal_spinlock_t *lock = (osal_spinlock_t *)calloc(1u, sizeof(osal_spinlock_t));
+    osal_spinlock_mcs_t *mcs = (osal_spinlock_mcs_t *)calloc(1u, sizeof(osal_spinlock_mcs_t));
+
+    if ((tasks == NULL) || (spins == NULL) || (lock == NULL) || (mcs == NULL)) {
+        printf("cannot allocate %u tasks\n", max_threads);
+        free(tasks);
+        free(spins);
+        free(lock);
+        free(mcs);
+        return 1;
+    }
+
+    printf("spinlock: %u ms per run, %u iterations in lock, %ld cpus\n",
+            (unsigned)duration, work, sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%-8s %-10s %12s %12s %10s\n", "threads", "algorithm", "Mlocks/s", "ns/lock", "min/max");
+
+    for (osal_uint32_t threads = 2u; threads <= max_threads; threads *= 2u) {
+        for (unsigned a = 0u; a < (sizeof(algorithms) / sizeof(algorithms[0])); ++a) {
+            osal_uint32_t stop = 0u;
+            osal_uint64_t shared = 0u;
+
+            osal_spinlock_mcs_t *run_mcs = algorithms[a].is_mcs ? mcs : NULL;
+            if (run_mcs != NULL) {
+                (void)osal_spinlock_mcs_init(run_mcs);
+            } else {
+                (void)osal_spinlock_init(lock, &algorithms[a].attr);
+            }
+
+            osal_uint64_t start = osal_timer_gettime_nsec();
+            for (osal_uint32_t t = 0u; t < threads; ++t) {
+                spins[t] = (bench_spin_t){ lock, run_mcs, &stop, &shared, work, 0u };
+                (void)osal_task_create(&tasks[t], NULL, bench_spin_task, &spins[t]);
+            }
+
+            osal_sleep(duration * 1000000u);
+            __atomic_store_n(&stop, 1u, __ATOMIC_RELAXED);
+
+            osal_uint64_t total = 0u;
+            osal_uint64_t min = UINT64_MAX;
+            osal_uint64_t max = 0u;
+            for (osal_uint32_t t = 0u; t < threads; ++t) {
+                (void)osal_task_join(&tasks[t], NULL);
+                total += spins[t].count;
+                min = spins[t].count < min ? spins[t].count : min;
+                max = spins[t].count > max ? spins[t].count : max;
+            }
+            osal_uint64_t dur = osal_timer_gettime_nsec() - start;
+
+            if (run_mcs != NULL) {
+                (void)osal_spinlock_mcs_destroy(run_mcs);
+            } else {
+                (void)osal_spinlock_destroy(lock);
+            }
+
+            // min/max shows fairness, 1.0 if all tasks got the lock equally often
+            printf("%-8u %-10s %12.3f %12.1f %10.3f\n", threads, algorithms[a].name,
+                    (double)total / ((double)dur / 1e3), (double)dur / (double)(total ? total : 1u),
+                    max ? (double)min / (double)max : 0.0);
+        }
+    }
+
+    free(mcs);
+    free(lock);
+    free(spins);
+    free(tasks);
+    return 0;
+}
+
+static const bench_t benches[] = {
+    { "trace-analyze", "[samples] [loops]", "compare osal_trace analysis kernels", bench_trace_analyze },
+    { "timer-gettime", "[loops]",           "compare clock_gettime and timestamp counter", bench_timer_gettime },
+    { "executor",      "[jobs] [work] [workers]", "compare executor with one task per job", bench_executor },
+    { "spinlock",      "[threads] [ms] [work]", "compare spinlock algorithms under contention", bench_spinlock },
+};
+
+//! \brief Print usage.
+static void usage(const char *prog) {
+    printf("usage: %s <benchmark> [args]\n\nbenchmarks:\n", prog);
+
+    for (unsigned i = 0u; i < (sizeof(benches) / sizeof(benches[0])); ++i) {
+        printf("  %-16s %-24s %s\n", benches[i].name, benches[i].args, benches[i].help);
+    }
+}
+    
+extern int main(int argc, char **argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    for (unsigned i = 0u; i < (sizeof(benches) / sizeof(benches[0])); ++i) {
+        if (strcmp(argv[1], benches[i].name) == 0) {
+            return benches[i].func(argc - 2, &argv[2]);
+        }
+    }
+
+    usage(argv[0]);
+    return 1;
+}
@@ -0,0 +1,359 @@
+/**
+ * \file main.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 17 Oct 2026
+ *
+ * \brief OSAL scheduling latency benchmark.
+ *
+ * Measures the wakeup latency of periodic realtime tasks in the style of
+ * cyclictest, using osal tasks, timers and traces only.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+#include <libosal/osal.h>
+#include <libosal/cpuset.h>
+#include <libosal/trace.h>
+
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define CYCLIC_MAX_THREADS      32u
+
+#define CYCLIC_MODE__SLEEP      0x00000001u     //!< Wait with osal_sleep_until_nsec.
+#define CYCLIC_MODE__BUSY       0x00000002u     //!< Wait with osal_busy_wait_until_nsec.
+#define CYCLIC_MODE__PRECISE    0x00000004u     //!< Wait with osal_sleep_until_precise.
+
+typedef osal_uint32_t cyclic_mode_t;
+
+//! Command line options.
+typedef struct cyclic_opts {
+    osal_uint32_t threads;                  //!< Number of measuring tasks.
+    osal_task_sched_policy_t policy;        //!< Scheduling policy.
+    osal_task_sched_priority_t priority;    //!< Priority of first task.
+    int cpu;                                //!< First cpu, task i runs on cpu + i. -1 for no pinning.
+    osal_uint64_t interval;                 //!< Period of first task [ns].
+    osal_uint64_t distance;                 //!< Period increment per task [ns].
+    osal_uint64_t loops;                    //!< Cycles per task and mode, 0 until interrupted.
+    cyclic_mode_t modes;                    //!< Modes to run one after the other.
+    osal_uint64_t max_allowed;              //!< Fail if a maximum latency exceeds this [ns], 0 to disable.
+    int lock_memory;                        //!< Lock process memory.
+    int quiet;                              //!< No live output.
+} cyclic_opts_t;
+
+//! State of one measuring task.
+typedef struct cyclic_thread {
+    osal_uint32_t id;                       //!< Task index.
+    osal_task_t hdl;                        //!< Task handle.
+    osal_task_attr_t attr;                  //!< Task attributes.
+    cyclic_mode_t mode;                     //!< Wait mode of current run.
+    osal_uint64_t interval;                 //!< Period [ns].
+    osal_uint64_t loops;                    //!< Cycles to run, 0 until interrupted.
+    osal_trace_t *trace;                    //!< Latencies with streaming statistics.
+    osal_trace_hist_t *hist;                //!< Latency histogram for percentiles.
+    volatile int done;                      //!< Set when loop finished.
+} cyclic_thread_t;
+
+static volatile sig_atomic_t cyclic_stop = 0;
+
+static void cyclic_signal(int sig) {
+    (void)sig;
+    cyclic_stop = 1;
+}
+
+//! \brief Periodic measuring loop.
+static void *cyclic_task(void *arg) {
+    cyclic_thread_t *thr = (cyclic_thread_t *)arg;
+    osal_uint64_t next = osal_timer_gettime_nsec() + thr->interval;
+
+    for (osal_uint64_t i = 0u; ((thr->loops == 0u) || (i < thr->loops)) && !cyclic_stop; ++i) {
+        if (thr->mode == CYCLIC_MODE__BUSY) {
+            (void)osal_busy_wait_until_nsec(next);
+        } else if (thr->mode == CYCLIC_MODE__PRECISE) {
+            (void)osal_sleep_until_precise(next);
+        } else {
+            (void)osal_sleep_until_nsec(next);
+        }
+
+        osal_uint64_t now = osal_timer_gettime_nsec();
+        osal_trace_time(thr->trace, now - next);
+
+        // absolute period, skip missed cycles instead of catching up
+        next += thr->interval;
+        while (next <= now) {
+            next += thr->interval;
+        }
+    }
+
+    thr->done = 1;
+    return NULL;
+}
+
+//! \brief Parse scheduling policy name.
+static int cyclic_parse_policy(const char *name, osal_task_sched_policy_t *policy) {
+    int ret = 0;
+
+    if (strcmp(name, "fifo") == 0) {
+        *policy = OSAL_SCHED_POLICY_FIFO;
+    } else if (strcmp(name, "rr") == 0) {
+        *policy = OSAL_SCHED_POLICY_ROUND_ROBIN;
+    } else if (strcmp(name, "other") == 0) {
+        *policy = OSAL_SCHED_POLICY_OTHER;
+    } else {
+        ret = -1;
+    }
+
+    return ret;
+}
+
+//! \brief Parse wait mode name.
+static int cyclic_parse_mode(const char *name, cyclic_mode_t *modes) {
+    int ret = 0;
+
+    if (strcmp(name, "sleep") == 0) {
+        *modes = CYCLIC_MODE__SLEEP;
+    } else if (strcmp(name, "busy") == 0) {
+        *modes = CYCLIC_MODE__BUSY;
+    } else if (strcmp(name, "precise") == 0) {
+        *modes = CYCLIC_MODE__PRECISE;
+    } else if (strcmp(name, "both") == 0) {
+        *modes = CYCLIC_MODE__SLEEP | CYCLIC_MODE__BUSY;
+    } else if (strcmp(name, "all") == 0) {
+        *modes = CYCLIC_MODE__SLEEP | CYCLIC_MODE__BUSY | CYCLIC_MODE__PRECISE;
+    } else {
+        ret = -1;
+    }
+
+    return ret;
+}
+
+//! \brief Print usage.
+static void usage(const char *prog) {
+    printf("usage: %s [options]\n\n", prog);
+    printf("  -t <threads>   number of measuring tasks, default 1, max %u\n", CYCLIC_MAX_THREADS);
+    printf("  -P <policy>    fifo, rr or other, default fifo\n");
+    printf("  -p <prio>      priority of first task, task i gets prio - i, default 80\n");
+    printf("  -a <cpu>       pin task i to cpu + i, default no pinning\n");
+    printf("  -i <us>        period of first task, default 1000\n");
+    printf("  -d <us>        period increment per task, default 0\n");
+    printf("  -l <loops>     cycles per task and mode, 0 until interrupted, default 10000\n");
+    printf("  -w <mode>      wait with sleep, busy, precise (sleep then spin), both (sleep and\n");
+    printf("                 busy one after the other) or all, default sleep\n");
+    printf("  -T <us>        exit with 2 if any maximum latency exceeds this\n");
+    printf("  -m             lock current and future memory\n");
+    printf("  -q             print results only\n");
+}
+
+//! \brief Print statistics of one task.
+static void cyclic_print(cyclic_thread_t *thr, int final) {
+    osal_trace_stats_t stats;
+    osal_uint64_t avg = 0u, avg_jit = 0u, max_jit = 0u;
+
+    (void)osal_trace_get_stats(thr->trace, &stats);
+    if (stats.cnt == 0u) {
+        stats.min_val = 0u;
+        stats.max_val = 0u;
+    } else {
+        (void)osal_trace_analyze_stats(thr->trace, &avg, &avg_jit, &max_jit, NULL, NULL);
+    }
+
+    printf("T:%2u C:%10lu Min:%8lu Avg:%8lu Max:%8lu", thr->id, (unsigned long)stats.cnt,
+            (unsigned long)stats.min_val / 1000u, (unsigned long)avg / 1000u,
+            (unsigned long)stats.max_val / 1000u);
+
+    if (final) {
+        // histogram is only read after the task finished
+        printf(" P99:%8lu P99.9:%8lu P99.99:%8lu",
+                (unsigned long)osal_trace_hist_get_percentile(thr->hist, 99.) / 1000u,
+                (unsigned long)osal_trace_hist_get_percentile(thr->hist, 99.9) / 1000u,
+                (unsigned long)osal_trace_hist_get_percentile(thr->hist, 99.99) / 1000u);
+    }
+
+    printf("\n");
+}
+
+//! \brief Run all tasks in one wait mode.
+static int cyclic_run(const cyclic_opts_t *opts, cyclic_thread_t *thr, cyclic_mode_t mode) {
+    int ret = 0;
+    osal_uint32_t started = 0u;
+
+    printf("mode %s, latencies in [us]\n", mode == CYCLIC_MODE__BUSY ? "busy" :
+            mode == CYCLIC_MODE__PRECISE ? "precise" : "sleep");
+
+    memset(thr, 0, opts->threads * sizeof(thr[0]));
+
+    for (osal_uint32_t i = 0u; i < opts->threads; ++i) {
+        osal_trace_attr_t trace_attr = OSAL_TRACE_ATTR__REL | OSAL_TRACE_ATTR__STATS;
+
+        thr[i].id = i;
+        thr[i].mode = mode;
+        thr[i].interval = opts->interval + (i * opts->distance);
+        thr[i].loops = opts->loops;
+
+        (void)snprintf(thr[i].attr.task_name, TASK_NAME_LEN, "cyclic%u", i);
+        thr[i].attr.policy = opts->policy;
+        thr[i].attr.priority = (opts->policy == OSAL_SCHED_POLICY_OTHER) || (opts->priority <= i) ?
+            opts->priority : opts->priority - i;
+        if (opts->cpu >= 0) {
+            osal_cpuset_zero(&thr[i].attr.cpuset);
+            osal_cpuset_set(&thr[i].attr.cpuset, (osal_uint32_t)opts->cpu + i);
+        }
+
+        if (    (osal_trace_alloc_attr(&thr[i].trace, &trace_attr, 0u) != OSAL_OK) ||
+                (osal_trace_hist_alloc(&thr[i].hist, 0u) != OSAL_OK)) {
+            printf("cannot allocate trace for task %u\n", i);
+            ret = 1;
+            break;
+        }
+
+        osal_trace_hist_attach(thr[i].trace, thr[i].hist);
+    }
+
+    for (osal_uint32_t i = 0u; (ret == 0) && (i < opts->threads); ++i) {
+        osal_retval_t orv = osal_task_create(&thr[i].hdl, &thr[i].attr, cyclic_task, &thr[i]);
+        if (orv != OSAL_OK) {
+            printf("cannot create task %u (%d)%s\n", i, orv, orv == OSAL_ERR_PERMISSION_DENIED ?
+                    ", realtime priorities need CAP_SYS_NICE or an rtprio limit" : "");
+            cyclic_stop = 1;
+            ret = 1;
+        } else {
+            started++;
+        }
+    }
+
+    for (int running = 1; running && (ret == 0); ) {
+        osal_sleep(opts->quiet ? 10000000u : 1000000000u);
+
+        running = 0;
+        for (osal_uint32_t i = 0u; i < opts->threads; ++i) {
+            running |= !thr[i].done;
+        }
+
+        if (running && !opts->quiet) {
+            for (osal_uint32_t i = 0u; i < opts->threads; ++i) {
+                cyclic_print(&thr[i], 0);
+            }
+        }
+    }
+
+    for (osal_uint32_t i = 0u; i < started; ++i) {
+        osal_task_join(&thr[i].hdl, NULL);
+    }
+
+    for (osal_uint32_t i = 0u; i < opts->threads; ++i) {
+        if ((ret == 0) && (thr[i].trace != NULL)) {
+            osal_trace_stats_t stats;
+
+            cyclic_print(&thr[i], 1);
+
+            (void)osal_trace_get_stats(thr[i].trace, &stats);
+            if ((opts->max_allowed != 0u) && (stats.cnt > 0u) && (stats.max_val > opts->max_allowed)) {
+                ret = 2;
+            }
+        }
+
+        if (thr[i].trace != NULL) {
+            osal_trace_free(thr[i].trace);
+        }
+        if (thr[i].hist != NULL) {
+            osal_trace_hist_free(thr[i].hist);
+        }
+    }
+
+    return ret;
+}
+
+extern int main(int argc, char **argv) {
+    static cyclic_thread_t thr[CYCLIC_MAX_THREADS];
+    cyclic_opts_t opts = { 1u, OSAL_SCHED_POLICY_FIFO, 80u, -1, 1000000u, 0u, 10000u,
+        CYCLIC_MODE__SLEEP, 0u, 0, 0 };
+    int ret = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:P:p:a:i:d:l:w:T:mqh")) != -1) {
+        switch (opt) {
+            case 't': opts.threads = (osal_uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'p': opts.priority = (osal_uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'a': opts.cpu = (int)strtol(optarg, NULL, 0); break;
+            case 'i': opts.interval = strtoull(optarg, NULL, 0) * 1000u; break;
+            case 'd': opts.distance = strtoull(optarg, NULL, 0) * 1000u; break;
+            case 'l': opts.loops = strtoull(optarg, NULL, 0); break;
+            case 'T': opts.max_allowed = strtoull(optarg, NULL, 0) * 1000u; break;
+            case 'm': opts.lock_memory = 1; break;
+            case 'q': opts.quiet = 1; break;
+            case 'P': ret = cyclic_parse_policy(optarg, &opts.policy); break;
+            case 'w': ret = cyclic_parse_mode(optarg, &opts.modes); break;
+            default: ret = -1; break;
+        }
+
+        if (ret != 0) {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if ((opts.threads == 0u) || (opts.threads > CYCLIC_MAX_THREADS) || (opts.interval == 0u)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (opts.cpu >= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+
+        if ((online > 0) && (((long)opts.cpu + (long)opts.threads) > online)) {
+            printf("cannot pin %u task(s) to cpu %d and up, only %ld cpu(s) online\n",
+                    opts.threads, opts.cpu, online);
+            return 1;
+        }
+    }
+
+    if (opts.lock_memory && (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)) {
+        perror("mlockall");
+        return 1;
+    }
+
+    signal(SIGINT, cyclic_signal);
+    signal(SIGTERM, cyclic_signal);
+
+    printf("%u task(s), period %lu us + %lu us per task, %lu loops\n", opts.threads,
+            (unsigned long)opts.interval / 1000u, (unsigned long)opts.distance / 1000u,
+            (unsigned long)opts.loops);
+
+    if ((opts.modes & CYCLIC_MODE__SLEEP) != 0u) {
+        ret = cyclic_run(&opts, thr, CYCLIC_MODE__SLEEP);
+    }
+
+    if (((opts.modes & CYCLIC_MODE__BUSY) != 0u) && (ret != 1) && !cyclic_stop) {
+        int local_ret = cyclic_run(&opts, thr, CYCLIC_MODE__BUSY);
+        ret = local_ret > ret ? local_ret : ret;
+    }
+
+    if (((opts.modes & CYCLIC_MODE__PRECISE) != 0u) && (ret != 1) && !cyclic_stop) {
+        int local_ret = cyclic_run(&opts, thr, CYCLIC_MODE__PRECISE);
+        ret = local_ret > ret ? local_ret : ret;
+    }
+
+    return ret;
+}
+
@@ -0,0 +1,379 @@
+/**
+ * \file main.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 18 Oct 2026
+ *
+ * \brief OSAL task monitor.
+ *
+ * Attaches read-only to the task registries published by processes using
+ * libosal and shows live what every task asked for and what the kernel
+ * actually gave it: policy, priority, affinity, CPU usage and context
+ * switch rates.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+#define _GNU_SOURCE
+#include <libosal/osal.h>
+#include <libosal/task_registry.h>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define TOP_MAX_PROCS   16u                                             //!< Maximum number of monitored processes.
+#define TOP_MAX_TASKS   (TOP_MAX_PROCS * OSAL_TASK_REGISTRY_ENTRIES)    //!< Maximum number of monitored tasks.
+
+//! What the kernel reports for a task.
+typedef struct top_kernel {
+    char state;                     //!< Scheduler state, 0 if the task is gone.
+    char comm[16];                  //!< Kernel task name.
+    int cpu;                        //!< CPU the task last ran on.
+    int policy;                     //!< Linux scheduling policy.
+    int priority;                   //!< Realtime priority.
+    osal_cpuset_t cpuset;           //!< Allowed CPUs.
+    osal_uint64_t cpu_time;         //!< Consumed CPU time [ns].
+    osal_uint64_t vcsw;             //!< Voluntary context switches.
+    osal_uint64_t icsw;             //!< Involuntary context switches.
+} top_kernel_t;
+
+//! Previous sample of a task for rates.
+typedef struct top_sample {
+    osal_int32_t pid;               //!< Process id.
+    osal_int32_t ktid;              //!< Kernel thread id.
+    osal_uint64_t cpu_time;         //!< Consumed CPU time [ns].
+    osal_uint64_t vcsw;             //!< Voluntary context switches.
+    osal_uint64_t icsw;             //!< Involuntary context switches.
+} top_sample_t;
+
+static volatile sig_atomic_t top_stop = 0;
+
+static void top_signal(int sig) {
+    (void)sig;
+    top_stop = 1;
+}
+
+static void usage(const char *prog) {
+    printf("usage: %s [-p pid] [-d interval_ms] [-n iterations]\n", prog);
+    printf("  -p pid          only monitor this process, default all publishing processes\n");
+    printf("  -d interval_ms  refresh interval, default 1000\n");
+    printf("  -n iterations   exit after this many refreshes, default until interrupted\n");
+    printf("\n");
+    printf("Processes publish their tasks with osal_task_registry_publish() or when\n");
+    printf("started with %s=1 in the environment.\n", OSAL_TASK_REGISTRY_ENV);
+}
+
+//! \brief Read a small procfs file, returns 0 on success.
+static int top_read_file(const char *path, char *buf, size_t size) {
+    int ret = -1;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd >= 0) {
+        ssize_t len = read(fd, buf, size - 1u);
+        if (len > 0) {
+            buf[len] = '\0';
+            ret = 0;
+        }
+
+        close(fd);
+    }
+
+    return ret;
+}
+
+//! \brief Read kernel view of a task, returns 0 if it exists.
+static int top_read_kernel(osal_int32_t pid, osal_int32_t ktid, top_kernel_t *k) {
+    char path[64], buf[2048];
+    unsigned long long utime = 0u, stime = 0u;
+
+    memset(k, 0, sizeof(*k));
+
+    snprintf(path, sizeof(path), "/proc/%d/task/%d/stat", (int)pid, (int)ktid);
+    if (top_read_file(path, buf, sizeof(buf)) != 0) {
+        return -1;
+    }
+
+    char *open_paren = strchr(buf, '(');
+    char *pos = strrchr(buf, ')');
+    if ((open_paren == NULL) || (pos == NULL) || (pos[1] != ' ')) {
+        return -1;
+    }
+
+    size_t len = (size_t)(pos - open_paren - 1);
+    if (len >= sizeof(k->comm)) {
+        len = sizeof(k->comm) - 1u;
+    }
+    memcpy(k->comm, open_paren + 1, len);
+
+    k->state = pos[2];
+    pos = &pos[3];
+
+    // fields 4 and following, see proc(5)
+    for (int field = 4; (field <= 41) && (*pos != '\0'); ++field) {
+        char *end;
+        unsigned long long val = strtoull(pos, &end, 10);
+
+        switch (field) {
+            case 14: utime = val; break;
+            case 15: stime = val; break;
+            case 39: k->cpu = (int)val; break;
+            case 40: k->priority = (int)val; break;
+            case 41: k->policy = (int)val; break;
+            default: break;
+        }
+
+        pos = end;
+    }
+
+    // schedstat has ns resolution, stat only clock ticks
+    snprintf(path, sizeof(path), "/proc/%d/task/%d/schedstat", (int)pid, (int)ktid);
+    if (top_read_file(path, buf, sizeof(buf)) == 0) {
+        k->cpu_time = strtoull(buf, NULL, 10);
+    } else {
+        k->cpu_time = (utime + stime) * (1000000000u / (unsigned long long)sysconf(_SC_CLK_TCK));
+    }
+
+    snprintf(path, sizeof(path), "/proc/%d/task/%d/status", (int)pid, (int)ktid);
+    if (top_read_file(path, buf, sizeof(buf)) == 0) {
+        const char *vol = strstr(buf, "\nvoluntary_ctxt_switches:");
+        const char *invol = strstr(buf, "\nnonvoluntary_ctxt_switches:");
+
+        k->vcsw = vol != NULL ? strtoull(strchr(vol, ':') + 1, NULL, 10) : 0u;
+        k->icsw = invol != NULL ? strtoull(strchr(invol, ':') + 1, NULL, 10) : 0u;
+    }
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (sched_getaffinity(ktid, sizeof(cpus), &cpus) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &cpus)) {
+                osal_cpuset_set(&k->cpuset, (osal_uint32_t)cpu);
+            }
+        }
+    }
+
+    return 0;
+}
+
+//! \brief Linux policy number of an osal policy, -1 if inherited.
+static int top_policy_linux(osal_task_sched_policy_t policy) {
+    switch (policy) {
+        case OSAL_SCHED_POLICY_FIFO: return 1;
+        case OSAL_SCHED_POLICY_ROUND_ROBIN: return 2;
+        case OSAL_SCHED_POLICY_OTHER: return 0;
+        case OSAL_SCHED_POLICY_BATCH: return 3;
+        case OSAL_SCHED_POLICY_IDLE: return 5;
+        case OSAL_SCHED_POLICY_DEADLINE: return 6;
+        default: return -1;
+    }
+}
+
+static const char *top_policy_name(int policy) {
+    switch (policy) {
+        case 0: return "OTHER";
+        case 1: return "FIFO";
+        case 2: return "RR";
+        case 3: return "BATCH";
+        case 5: return "IDLE";
+        case 6: return "DEADLINE";
+        default: return "?";
+    }
+}
+
+static const char *top_status_name(osal_retval_t status) {
+    switch (status) {
+        case OSAL_OK: return "ok";
+        case OSAL_ERR_PERMISSION_DENIED: return "permission denied";
+        case OSAL_ERR_ADMISSION_DENIED: return "admission denied";
+        case OSAL_ERR_INVALID_PARAM: return "invalid param";
+        case OSAL_ERR_NOT_IMPLEMENTED: return "not implemented";
+        default: return "failed";
+    }
+}
+
+//! \brief Find processes publishing a registry.
+static osal_uint32_t top_find_procs(osal_int32_t *pids, osal_uint32_t max) {
+    osal_uint32_t cnt = 0u;
+    const char *prefix = &OSAL_TASK_REGISTRY_SHM_PREFIX[1];
+    DIR *dir = opendir("/dev/shm");
+
+    while ((dir != NULL) && (cnt < max)) {
+        struct dirent *de = readdir(dir);
+        char path[64];
+
+        if (de == NULL) {
+            break;
+        } else if (strncmp(de->d_name, prefix, strlen(prefix)) != 0) {
+            continue;
+        }
+
+        // segments of crashed processes stay until the pid is reused
+        pids[cnt] = (osal_int32_t)strtol(&de->d_name[strlen(prefix)], NULL, 10);
+        snprintf(path, sizeof(path), "/proc/%d", (int)pids[cnt]);
+        if ((pids[cnt] > 0) && (access(path, F_OK) == 0)) {
+            cnt++;
+        }
+    }
+
+    if (dir != NULL) {
+        closedir(dir);
+    }
+
+    return cnt;
+}
+
+//! \brief Print all tasks of one process, returns number of samples stored in \p next.
+static osal_uint32_t top_print_proc(osal_int32_t pid, const top_sample_t *prev, osal_uint32_t prev_cnt,
+        top_sample_t *next, osal_uint32_t next_max, osal_uint64_t dt) {
+    const osal_task_registry_t *reg;
+    osal_uint32_t cnt = 0u;
+
+    if (osal_task_registry_attach(pid, &reg) != OSAL_OK) {
+        return 0u;
+    }
+
+    for (osal_uint32_t i = 0u; i < reg->entries; ++i) {
+        osal_task_registry_entry_t e;
+        top_kernel_t k;
+
+        if (osal_task_registry_read(reg, i, &e) != OSAL_OK) {
+            continue;
+        }
+
+        int alive = top_read_kernel(pid, e.ktid, &k) == 0;
+        int req_policy = top_policy_linux(e.policy);
+        int rt = (k.policy == 1) || (k.policy == 2);
+        char policy[16], prio[16], affinity[16], cpu_pct[16], vcsw[16], icsw[16];
+
+        snprintf(policy, sizeof(policy), "%s%s", top_policy_name(k.policy),
+                ((req_policy >= 0) && (req_policy != k.policy)) ? "*" : "");
+        snprintf(prio, sizeof(prio), "%d%s", rt ? k.priority : 0,
+                ((e.priority != 0u) && rt && ((int)e.priority != k.priority)) ? "*" : "");
+        snprintf(affinity, sizeof(affinity), "%08x%s%s", osal_cpuset_to_mask(&k.cpuset),
+                osal_cpuset_next(&k.cpuset, 31) >= 0 ? "+" : "",
+                ((osal_cpuset_count(&e.cpuset) != 0u) &&
+                 (memcmp(&e.cpuset, &k.cpuset, sizeof(k.cpuset)) != 0)) ? "*" : "");
+        strcpy(cpu_pct, "-");
+        strcpy(vcsw, "-");
+        strcpy(icsw, "-");
+
+        for (osal_uint32_t j = 0u; alive && (dt > 0u) && (j < prev_cnt); ++j) {
+            if ((prev[j].pid == pid) && (prev[j].ktid == e.ktid)) {
+                snprintf(cpu_pct, sizeof(cpu_pct), "%.1f", 100. * (double)(k.cpu_time - prev[j].cpu_time) / (double)dt);
+                snprintf(vcsw, sizeof(vcsw), "%.0f", 1e9 * (double)(k.vcsw - prev[j].vcsw) / (double)dt);
+                snprintf(icsw, sizeof(icsw), "%.0f", 1e9 * (double)(k.icsw - prev[j].icsw) / (double)dt);
+                break;
+            }
+        }
+
+        if (alive && (cnt < next_max)) {
+            top_sample_t s = { pid, e.ktid, k.cpu_time, k.vcsw, k.icsw };
+            next[cnt++] = s;
+        }
+
+        printf("%7d %7d %-16.16s %-9s %5s %4d %-10s %6s %8s %8s  %s\n", (int)pid, (int)e.ktid,
+                e.name[0] != '\0' ? e.name : k.comm, alive ? policy : "-", alive ? prio : "-",
+                alive ? k.cpu : -1, alive ? affinity : "-", cpu_pct, vcsw, icsw,
+                alive ? top_status_name(e.sched_status) : "exited");
+    }
+
+    if (reg->dropped != 0u) {
+        printf("%7d %u tasks not registered, registry full\n", (int)pid, reg->dropped);
+    }
+
+    (void)osal_task_registry_detach(reg);
+
+    return cnt;
+}
+
+extern int main(int argc, char **argv) {
+    static top_sample_t samples[2][TOP_MAX_TASKS];
+    osal_int32_t pids[TOP_MAX_PROCS];
+    osal_int32_t pid = 0;
+    osal_uint64_t interval_ns = 1000000000u;
+    osal_uint64_t iterations = 0u;
+    osal_uint64_t last = 0u;
+    osal_uint32_t prev_cnt = 0u;
+    int cur = 0;
+    int tty = isatty(STDOUT_FILENO);
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:d:n:h")) != -1) {
+        switch (opt) {
+            case 'p': pid = (osal_int32_t)strtol(optarg, NULL, 0); break;
+            case 'd': interval_ns = strtoull(optarg, NULL, 0) * 1000000u; break;
+            case 'n': iterations = strtoull(optarg, NULL, 0); break;
+            default: usage(argv[0]); return 1;
+        }
+    }
+
+    if (interval_ns == 0u) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    signal(SIGINT, top_signal);
+    signal(SIGTERM, top_signal);
+
+    for (osal_uint64_t it = 0u; !top_stop && ((iterations == 0u) || (it < iterations)); ++it) {
+        osal_uint64_t now = osal_timer_gettime_nsec();
+        osal_uint32_t procs = 1u;
+        osal_uint32_t next_cnt = 0u;
+
+        if (pid != 0) {
+            pids[0] = pid;
+        } else {
+            procs = top_find_procs(pids, TOP_MAX_PROCS);
+        }
+
+        if (tty) {
+            printf("\033[H\033[2J");
+        }
+
+        printf("%7s %7s %-16s %-9s %5s %4s %-10s %6s %8s %8s  %s\n", "PID", "TID", "NAME", "POLICY",
+                "PRIO", "CPU", "AFFINITY", "CPU%", "VCSW/s", "ICSW/s", "STATUS");
+
+        for (osal_uint32_t i = 0u; i < procs; ++i) {
+            next_cnt += top_print_proc(pids[i], samples[cur], prev_cnt, &samples[cur ^ 1][next_cnt],
+                    TOP_MAX_TASKS - next_cnt, last != 0u ? now - last : 0u);
+        }
+
+        if (procs == 0u) {
+            printf("no process publishes its tasks, start it with %s=1\n", OSAL_TASK_REGISTRY_ENV);
+        }
+        printf("* differs from the attributes the task was created with\n");
+        fflush(stdout);
+
+        cur ^= 1;
+        prev_cnt = next_cnt;
+        last = now;
+
+        if ((iterations == 0u) || ((it + 1u) < iterations)) {
+            osal_sleep(interval_ns);
+        }
+    }
+
+    return 0;
+}
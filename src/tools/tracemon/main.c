@@ -0,0 +1,150 @@
+/**
+ * \file main.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 17 Oct 2026
+ *
+ * \brief OSAL trace monitor.
+ *
+ * Attaches read-only to a trace exported with osal_trace_alloc_shm and 
+ * prints live statistics, so no analysis runs inside the traced process.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+#include <libosal/osal.h>
+#include <libosal/trace.h>
+
+#include <signal.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+//! Reattach if the tracer did not complete a buffer for this long [ns].
+#define TRACEMON_STALE_NS   5000000000u
+
+static volatile sig_atomic_t tracemon_stop = 0;
+
+static void tracemon_signal(int sig) {
+    (void)sig;
+    tracemon_stop = 1;
+}
+
+//! \brief Record fetched buffer in histogram.
+static void tracemon_record(osal_trace_t *trace, osal_trace_hist_t *hist) {
+    const osal_uint64_t *buf = trace->time_in_ns[1];
+
+    for (osal_uint32_t i = 0u; i < trace->cnt; ++i) {
+        if ((trace->attr & OSAL_TRACE_ATTR__REL) != 0u) {
+            osal_trace_hist_record(hist, buf[i]);
+        } else if (i > 0u) {
+            osal_trace_hist_record(hist, buf[i] - buf[i - 1u]);
+        }
+    }
+}
+
+extern int main(int argc, char **argv) {
+    osal_trace_t *trace = NULL;
+    osal_trace_hist_t *hist = NULL;
+    osal_uint64_t interval_ns;
+    osal_uint64_t last_data = 0u;
+    osal_uint64_t buffers = 0u;
+    osal_uint64_t dropped_total = 0u;
+    int waiting = 0;
+
+    if (argc < 2) {
+        printf("usage: %s <shm_name> [interval_ms]\n", argv[0]);
+        printf("  <shm_name>     name passed to osal_trace_alloc_shm, e.g. /my_trace\n");
+        printf("  [interval_ms]  poll interval, default 100\n");
+        return 0;
+    }
+
+    interval_ns = (argc > 2 ? strtoull(argv[2], NULL, 0) : 100u) * 1000000u;
+
+    if (osal_trace_hist_alloc(&hist, 0u) != OSAL_OK) {
+        printf("cannot allocate histogram\n");
+        return 1;
+    }
+
+    signal(SIGINT, tracemon_signal);
+    signal(SIGTERM, tracemon_signal);
+
+    while (!tracemon_stop) {
+        osal_uint64_t now = osal_timer_gettime_nsec();
+
+        if ((trace != NULL) && ((now - last_data) > TRACEMON_STALE_NS)) {
+            // tracer may have been restarted with a new segment
+            osal_trace_free(trace);
+            trace = NULL;
+        }
+
+        if (trace == NULL) {
+            osal_retval_t ret = osal_trace_attach_shm(&trace, argv[1]);
+            if (ret != OSAL_OK) {
+                if (!waiting) {
+                    printf("waiting for trace %s (%d)\n", argv[1], ret);
+                    waiting = 1;
+                }
+
+                osal_sleep(interval_ns);
+                continue;
+            }
+
+            waiting = 0;
+            last_data = now;
+            printf("attached to %s, %u samples per buffer%s\n", argv[1], trace->cnt,
+                    (trace->attr & OSAL_TRACE_ATTR__REL) != 0u ? ", values" : ", intervals");
+            printf("%10s %12s %10s %10s %12s %12s %12s %12s %10s\n", "buffer", "avg", "avg_jit", 
+                    "max_jit", "min", "max", "p99", "p99.99", "dropped");
+        }
+
+        osal_uint64_t dropped = 0u;
+        if (osal_trace_drain(trace, &dropped) == OSAL_OK) {
+            osal_uint64_t avg, avg_jit, max_jit, min_val, max_val;
+
+            if ((trace->attr & OSAL_TRACE_ATTR__REL) != 0u) {
+                osal_trace_analyze_rel_min_max(trace, &avg, &avg_jit, &max_jit, &min_val, &max_val);
+            } else {
+                osal_trace_analyze_min_max(trace, &avg, &avg_jit, &max_jit, &min_val, &max_val);
+            }
+
+            tracemon_record(trace, hist);
+
+            buffers++;
+            dropped_total += dropped;
+            last_data = now;
+
+            printf("%10lu %12lu %10lu %10lu %12lu %12lu %12lu %12lu %10lu\n", 
+                    (unsigned long)buffers, (unsigned long)avg, (unsigned long)avg_jit, 
+                    (unsigned long)max_jit, (unsigned long)min_val, (unsigned long)max_val, 
+                    (unsigned long)osal_trace_hist_get_percentile(hist, 99.), 
+                    (unsigned long)osal_trace_hist_get_percentile(hist, 99.99),
+                    (unsigned long)dropped_total);
+            fflush(stdout);
+        }
+
+        osal_sleep(interval_ns);
+    }
+
+    if (trace != NULL) {
+        osal_trace_free(trace);
+    }
+
+    osal_trace_hist_free(hist);
+    return 0;
+}
@@ -34,6 +34,7 @@
 
 #include <libosal/osal.h>
 #include <libosal/trace.h>
+#include <libosal/mem.h>
 #include <assert.h>
 #include <stdlib.h>
 
@@ -45,290 +46,1881 @@
 #include <string.h>
 #endif
 
+//! \brief Clear statistics.
+static void osal_trace_stats_clear(osal_trace_stats_t *stats) {
+    stats->cnt     = 0u;
+    stats->mean    = 0.;
+    stats->m2      = 0.;
+    stats->min_val = UINT64_MAX;
+    stats->max_val = 0u;
+}
+
+//! \brief Add sample to statistics (Welford's online algorithm).
+static inline void osal_trace_stats_update(osal_trace_stats_t *stats, osal_uint64_t value) {
+    double delta = (double)value - stats->mean;
+
+    stats->cnt++;
+    stats->mean += delta / (double)stats->cnt;
+    stats->m2   += delta * ((double)value - stats->mean);
+
+    if (value < stats->min_val) { stats->min_val = value; }
+    if (value > stats->max_val) { stats->max_val = value; }
+}
+
+//! \brief Calculate jitters from sum of squared deviations and extremes.
+/*!
+ * \param[in]   avg     Average value.
+ * \param[in]   sq_dev  Sum of squared deviations from \p avg.
+ * \param[in]   divisor Divisor for variance.
+ * \param[in]   min_val Minimum value.
+ * \param[in]   max_val Maximum value.
+ * \param[out]  avg_jit Return average jitter (std-dev).
+ * \param[out]  max_jit Return maximum jitter.
+ */
+static void osal_trace_eval_jitter(osal_uint64_t avg, double sq_dev, osal_uint64_t divisor, 
+        osal_uint64_t min_val, osal_uint64_t max_val, osal_uint64_t *avg_jit, osal_uint64_t *max_jit) 
+{
+    osal_uint64_t dev_lo = avg > min_val ? avg - min_val : 0u;
+    osal_uint64_t dev_hi = max_val > avg ? max_val - avg : 0u;
+
+    (*max_jit) = dev_lo > dev_hi ? dev_lo : dev_hi;
+    (*avg_jit) = sq_dev > 0. ? (osal_uint64_t)sqrt(sq_dev / (double)divisor) : 0u;
+}
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define OSAL_TRACE_HAVE_X86_KERNELS
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define OSAL_TRACE_HAVE_NEON_KERNEL
+#endif
+
+//! \brief Analysis kernel, reduces sample buffer in one pass.
+/*!
+ * \param[in]   buf     Sample buffer.
+ * \param[in]   n       Number of values to analyze.
+ * \param[in]   delta   Analyze differences buf[i+1] - buf[i] instead of values.
+ * \param[in]   base    Offset subtracted before squaring.
+ * \param[out]  sum     Return sum of values.
+ * \param[out]  sq      Return sum of (value - base)^2.
+ * \param[out]  lo      Return minimum value.
+ * \param[out]  hi      Return maximum value.
+ *
+ * \return 0 on success, -1 if the kernel cannot handle the value range.
+ */
+typedef int (*osal_trace_kernel_fn_t)(const osal_uint64_t *buf, osal_uint32_t n, int delta, osal_uint64_t base,
+        osal_uint64_t *sum, double *sq, osal_uint64_t *lo, osal_uint64_t *hi);
+
+//! \brief Scalar analysis kernel loop.
+static inline void osal_trace_kernel_scalar_loop(const osal_uint64_t *buf, osal_uint32_t start, osal_uint32_t n, 
+        int delta, osal_uint64_t base, osal_uint64_t *sum, double *sq, osal_uint64_t *lo, osal_uint64_t *hi) 
+{
+    for (osal_uint32_t i = start; i < n; ++i) {
+        osal_uint64_t val = delta ? buf[i + 1u] - buf[i] : buf[i];
+        double diff = (double)(osal_int64_t)(val - base);
+
+        (*sum) += val;
+        (*sq)  += diff * diff;
+
+        if (val < (*lo)) { (*lo) = val; }
+        if (val > (*hi)) { (*hi) = val; }
+    }
+}
+
+//! \brief Scalar analysis kernel, always available.
+static int osal_trace_kernel_scalar(const osal_uint64_t *buf, osal_uint32_t n, int delta, osal_uint64_t base,
+        osal_uint64_t *sum, double *sq, osal_uint64_t *lo, osal_uint64_t *hi) 
+{
+    (*sum) = 0u;
+    (*sq)  = 0.;
+    (*lo)  = UINT64_MAX;
+    (*hi)  = 0u;
+
+    // separate loops so the delta decision is not taken per element
+    if (delta) {
+        osal_trace_kernel_scalar_loop(buf, 0u, n, 1, base, sum, sq, lo, hi);
+    } else {
+        osal_trace_kernel_scalar_loop(buf, 0u, n, 0, base, sum, sq, lo, hi);
+    }
+
+    return 0;
+}
+
+#ifdef OSAL_TRACE_HAVE_X86_KERNELS
+
+// x86 has no packed int64 -> double conversion before AVX-512. For |x| < 2^51,
+// adding x to the bit pattern of 1.5 * 2^52 yields the double 1.5 * 2^52 + x exactly.
+#define OSAL_TRACE_CVT_MAGIC_BITS   0x4338000000000000ll
+#define OSAL_TRACE_CVT_MAGIC        6755399441055744.0
+#define OSAL_TRACE_CVT_RANGE        0x0008000000000000ll
+
+//! \brief AVX2 analysis kernel, 4 samples per step.
+__attribute__((target("avx2")))
+static int osal_trace_kernel_avx2(const osal_uint64_t *buf, osal_uint32_t n, int delta, osal_uint64_t base,
+        osal_uint64_t *sum, double *sq, osal_uint64_t *lo, osal_uint64_t *hi) 
+{
+    // unsigned compares are done on sign flipped values
+    const __m256i sign    = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i magic_i = _mm256_set1_epi64x(OSAL_TRACE_CVT_MAGIC_BITS);
+    const __m256d magic_d = _mm256_set1_pd(OSAL_TRACE_CVT_MAGIC);
+    const __m256i range   = _mm256_set1_epi64x(OSAL_TRACE_CVT_RANGE);
+    const __m256i vbase   = _mm256_set1_epi64x((osal_int64_t)base);
+    __m256i vsum = _mm256_setzero_si256();
+    __m256i vlo  = _mm256_set1_epi64x(INT64_MAX);
+    __m256i vhi  = _mm256_set1_epi64x(INT64_MIN);
+    __m256i vbad = _mm256_setzero_si256();
+    __m256d vsq  = _mm256_setzero_pd();
+    osal_uint32_t i = 0u;
+
+    for (; (i + 4u) <= n; i += 4u) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)&buf[i]);
+        if (delta) {
+            v = _mm256_sub_epi64(_mm256_loadu_si256((const __m256i *)&buf[i + 1u]), v);
+        }
+
+        vsum = _mm256_add_epi64(vsum, v);
+
+        __m256i vs = _mm256_xor_si256(v, sign);
+        vlo = _mm256_blendv_epi8(vlo, vs, _mm256_cmpgt_epi64(vlo, vs));
+        vhi = _mm256_blendv_epi8(vhi, vs, _mm256_cmpgt_epi64(vs, vhi));
+
+        __m256i d = _mm256_sub_epi64(v, vbase);
+        vbad = _mm256_or_si256(vbad, _mm256_srli_epi64(_mm256_add_epi64(d, range), 52));
+
+        __m256d df = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(d, magic_i)), magic_d);
+        vsq = _mm256_add_pd(vsq, _mm256_mul_pd(df, df));
+    }
+
+    if (!_mm256_testz_si256(vbad, vbad)) {
+        return -1;
+    }
+
+    osal_uint64_t a_sum[4], a_lo[4], a_hi[4];
+    double a_sq[4];
+    _mm256_storeu_si256((__m256i *)a_sum, vsum);
+    _mm256_storeu_si256((__m256i *)a_lo, _mm256_xor_si256(vlo, sign));
+    _mm256_storeu_si256((__m256i *)a_hi, _mm256_xor_si256(vhi, sign));
+    _mm256_storeu_pd(a_sq, vsq);
+
+    (*sum) = a_sum[0] + a_sum[1] + a_sum[2] + a_sum[3];
+    (*sq)  = (a_sq[0] + a_sq[1]) + (a_sq[2] + a_sq[3]);
+    (*lo)  = UINT64_MAX;
+    (*hi)  = 0u;
+
+    for (int k = 0; k < 4; ++k) {
+        if (a_lo[k] < (*lo)) { (*lo) = a_lo[k]; }
+        if (a_hi[k] > (*hi)) { (*hi) = a_hi[k]; }
+    }
+
+    osal_trace_kernel_scalar_loop(buf, i, n, delta, base, sum, sq, lo, hi);
+    return 0;
+}
+
+//! \brief SSE4.2 analysis kernel, 2 samples per step.
+__attribute__((target("sse4.2")))
+static int osal_trace_kernel_sse42(const osal_uint64_t *buf, osal_uint32_t n, int delta, osal_uint64_t base,
+        osal_uint64_t *sum, double *sq, osal_uint64_t *lo, osal_uint64_t *hi) 
+{
+    const __m128i sign    = _mm_set1_epi64x(INT64_MIN);
+    const __m128i magic_i = _mm_set1_epi64x(OSAL_TRACE_CVT_MAGIC_BITS);
+    const __m128d magic_d = _mm_set1_pd(OSAL_TRACE_CVT_MAGIC);
+    const __m128i range   = _mm_set1_epi64x(OSAL_TRACE_CVT_RANGE);
+    const __m128i vbase   = _mm_set1_epi64x((osal_int64_t)base);
+    __m128i vsum = _mm_setzero_si128();
+    __m128i vlo  = _mm_set1_epi64x(INT64_MAX);
+    __m128i vhi  = _mm_set1_epi64x(INT64_MIN);
+    __m128i vbad = _mm_setzero_si128();
+    __m128d vsq  = _mm_setzero_pd();
+    osal_uint32_t i = 0u;
+
+    for (; (i + 2u) <= n; i += 2u) {
+        __m128i v = _mm_loadu_si128((const __m128i *)&buf[i]);
+        if (delta) {
+            v = _mm_sub_epi64(_mm_loadu_si128((const __m128i *)&buf[i + 1u]), v);
+        }
+
+        vsum = _mm_add_epi64(vsum, v);
+
+        __m128i vs = _mm_xor_si128(v, sign);
+        vlo = _mm_blendv_epi8(vlo, vs, _mm_cmpgt_epi64(vlo, vs));
+        vhi = _mm_blendv_epi8(vhi, vs, _mm_cmpgt_epi64(vs, vhi));
+
+        __m128i d = _mm_sub_epi64(v, vbase);
+        vbad = _mm_or_si128(vbad, _mm_srli_epi64(_mm_add_epi64(d, range), 52));
+
+        __m128d df = _mm_sub_pd(_mm_castsi128_pd(_mm_add_epi64(d, magic_i)), magic_d);
+        vsq = _mm_add_pd(vsq, _mm_mul_pd(df, df));
+    }
+
+    if (!_mm_testz_si128(vbad, vbad)) {
+        return -1;
+    }
+
+    osal_uint64_t a_sum[2], a_lo[2], a_hi[2];
+    double a_sq[2];
+    _mm_storeu_si128((__m128i *)a_sum, vsum);
+    _mm_storeu_si128((__m128i *)a_lo, _mm_xor_si128(vlo, sign));
+    _mm_storeu_si128((__m128i *)a_hi, _mm_xor_si128(vhi, sign));
+    _mm_storeu_pd(a_sq, vsq);
+
+    (*sum) = a_sum[0] + a_sum[1];
+    (*sq)  = a_sq[0] + a_sq[1];
+    (*lo)  = a_lo[0] < a_lo[1] ? a_lo[0] : a_lo[1];
+    (*hi)  = a_hi[0] > a_hi[1] ? a_hi[0] : a_hi[1];
+
+    osal_trace_kernel_scalar_loop(buf, i, n, delta, base, sum, sq, lo, hi);
+    return 0;
+}
+
+#endif /* OSAL_TRACE_HAVE_X86_KERNELS */
+
+#ifdef OSAL_TRACE_HAVE_NEON_KERNEL
+
+//! \brief NEON analysis kernel, 2 samples per step.
+static int osal_trace_kernel_neon(const osal_uint64_t *buf, osal_uint32_t n, int delta, osal_uint64_t base,
+        osal_uint64_t *sum, double *sq, osal_uint64_t *lo, osal_uint64_t *hi) 
+{
+    const uint64x2_t vbase = vdupq_n_u64(base);
+    uint64x2_t vsum = vdupq_n_u64(0u);
+    uint64x2_t vlo  = vdupq_n_u64(UINT64_MAX);
+    uint64x2_t vhi  = vdupq_n_u64(0u);
+    float64x2_t vsq = vdupq_n_f64(0.);
+    osal_uint32_t i = 0u;
+
+    for (; (i + 2u) <= n; i += 2u) {
+        uint64x2_t v = vld1q_u64(&buf[i]);
+        if (delta) {
+            v = vsubq_u64(vld1q_u64(&buf[i + 1u]), v);
+        }
+
+        vsum = vaddq_u64(vsum, v);
+        vlo  = vbslq_u64(vcltq_u64(v, vlo), v, vlo);
+        vhi  = vbslq_u64(vcgtq_u64(v, vhi), v, vhi);
+
+        float64x2_t df = vcvtq_f64_s64(vreinterpretq_s64_u64(vsubq_u64(v, vbase)));
+        vsq = vfmaq_f64(vsq, df, df);
+    }
+
+    (*sum) = vaddvq_u64(vsum);
+    (*sq)  = vaddvq_f64(vsq);
+    (*lo)  = vgetq_lane_u64(vlo, 0) < vgetq_lane_u64(vlo, 1) ? vgetq_lane_u64(vlo, 0) : vgetq_lane_u64(vlo, 1);
+    (*hi)  = vgetq_lane_u64(vhi, 0) > vgetq_lane_u64(vhi, 1) ? vgetq_lane_u64(vhi, 0) : vgetq_lane_u64(vhi, 1);
+
+    osal_trace_kernel_scalar_loop(buf, i, n, delta, base, sum, sq, lo, hi);
+    return 0;
+}
+
+#endif /* OSAL_TRACE_HAVE_NEON_KERNEL */
+
+//! \brief Return kernel function if supported by build and cpu.
+static osal_trace_kernel_fn_t osal_trace_kernel_lookup(osal_trace_kernel_t kernel) {
+    osal_trace_kernel_fn_t fn = NULL;
+
+#ifdef OSAL_TRACE_HAVE_X86_KERNELS
+    __builtin_cpu_init();
+#endif
+
+    switch (kernel) {
+        case OSAL_TRACE_KERNEL__SCALAR:
+            fn = osal_trace_kernel_scalar;
+            break;
+#ifdef OSAL_TRACE_HAVE_X86_KERNELS
+        case OSAL_TRACE_KERNEL__SSE42:
+            if (__builtin_cpu_supports("sse4.2")) { fn = osal_trace_kernel_sse42; }
+            break;
+        case OSAL_TRACE_KERNEL__AVX2:
+            if (__builtin_cpu_supports("avx2")) { fn = osal_trace_kernel_avx2; }
+            break;
+#endif
+#ifdef OSAL_TRACE_HAVE_NEON_KERNEL
+        case OSAL_TRACE_KERNEL__NEON:
+            fn = osal_trace_kernel_neon;
+            break;
+#endif
+        default:
+            break;
+    }
+
+    return fn;
+}
+
+static osal_trace_kernel_t osal_trace_kernel_act = OSAL_TRACE_KERNEL__AUTO;     //!< selected kernel
+static osal_trace_kernel_fn_t osal_trace_kernel_act_fn = NULL;                  //!< selected kernel function
+
+//! \brief Select analysis kernel.
+/*!
+ * \param[in]   kernel  Kernel to use, \ref OSAL_TRACE_KERNEL__AUTO for the best available.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_set_kernel(osal_trace_kernel_t kernel) {
+    static const osal_trace_kernel_t preference[] = {
+        OSAL_TRACE_KERNEL__AVX2, OSAL_TRACE_KERNEL__NEON, 
+        OSAL_TRACE_KERNEL__SSE42, OSAL_TRACE_KERNEL__SCALAR };
+
+    osal_retval_t ret = OSAL_OK;
+    osal_trace_kernel_fn_t fn = NULL;
+
+    if (kernel == OSAL_TRACE_KERNEL__AUTO) {
+        for (unsigned i = 0u; (fn == NULL) && (i < (sizeof(preference) / sizeof(preference[0]))); ++i) {
+            kernel = preference[i];
+            fn = osal_trace_kernel_lookup(kernel);
+        }
+    } else if (kernel > OSAL_TRACE_KERNEL__NEON) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        fn = osal_trace_kernel_lookup(kernel);
+        if (fn == NULL) {
+            ret = OSAL_ERR_NOT_IMPLEMENTED;
+        }
+    }
+
+    if (ret == OSAL_OK) {
+        __atomic_store_n(&osal_trace_kernel_act, kernel, __ATOMIC_RELAXED);
+        __atomic_store_n(&osal_trace_kernel_act_fn, fn, __ATOMIC_RELEASE);
+    }
+
+    return ret;
+}
+
+//! \brief Return selected analysis kernel.
+/*!
+ * \return kernel used by the analyze functions.
+ */
+osal_trace_kernel_t osal_trace_get_kernel(void) {
+    if (__atomic_load_n(&osal_trace_kernel_act_fn, __ATOMIC_ACQUIRE) == NULL) {
+        (void)osal_trace_set_kernel(OSAL_TRACE_KERNEL__AUTO);
+    }
+
+    return __atomic_load_n(&osal_trace_kernel_act, __ATOMIC_RELAXED);
+}
+
+//! \brief Single pass analysis of sample buffer.
+/*!
+ * Accumulates around the first value to keep the squared sums small, so 
+ * average, deviations and extremes are available after one pass of the 
+ * selected kernel without any temporary buffer.
+ *
+ * \param[in]   buf     Sample buffer.
+ * \param[in]   n       Number of values to analyze.
+ * \param[in]   delta   Analyze differences buf[i+1] - buf[i] instead of values.
+ * \param[in]   divisor Divisor for variance.
+ * \param[out]  avg     Return average.
+ * \param[out]  avg_jit Return average jitter (std-dev).
+ * \param[out]  max_jit Return maximum jitter.
+ * \param[out]  min_val Return minimum value, may be NULL.
+ * \param[out]  max_val Return maximum value, may be NULL.
+ */
+static void osal_trace_analyze_buffer(const osal_uint64_t *buf, osal_uint32_t n, int delta, osal_uint64_t divisor,
+        osal_uint64_t *avg, osal_uint64_t *avg_jit, osal_uint64_t *max_jit, osal_uint64_t *min_val, osal_uint64_t *max_val)
+{
+    osal_uint64_t base = delta ? buf[1] - buf[0] : buf[0];
+    osal_uint64_t sum;
+    osal_uint64_t lo;
+    osal_uint64_t hi;
+    double sq;
+
+    osal_trace_kernel_fn_t fn = __atomic_load_n(&osal_trace_kernel_act_fn, __ATOMIC_ACQUIRE);
+    if (fn == NULL) {
+        (void)osal_trace_set_kernel(OSAL_TRACE_KERNEL__AUTO);
+        fn = __atomic_load_n(&osal_trace_kernel_act_fn, __ATOMIC_ACQUIRE);
+    }
+
+    if (fn(buf, n, delta, base, &sum, &sq, &lo, &hi) != 0) {
+        // values too far apart for the vector kernel
+        (void)osal_trace_kernel_scalar(buf, n, delta, base, &sum, &sq, &lo, &hi);
+    }
+
+    (*avg) = sum / n;
+
+    // shift squared sum from base to average
+    double s1  = (double)(osal_int64_t)(sum - (n * base));
+    double off = (double)(osal_int64_t)(base - (*avg));
+    double sq_dev = sq + (2. * off * s1) + ((double)n * off * off);
+
+    osal_trace_eval_jitter((*avg), sq_dev, divisor, lo, hi, avg_jit, max_jit);
+
+    if (min_val) { *min_val = lo; }
+    if (max_val) { *max_val = hi; }
+}
+
+#define OSAL_TRACE_STORAGE__MALLOC      0u      //!< \brief Sample buffers allocated with malloc.
+#define OSAL_TRACE_STORAGE__MEM         1u      //!< \brief Sample buffers allocated with osal_mem_alloc.
+#define OSAL_TRACE_STORAGE__EXTERNAL    2u      //!< \brief Sample buffers owned by caller or shm segment.
+
+//! \brief Initialize trace struct without sample buffers.
+/*!
+ * \param[out]  trace   Pointer to trace struct.
+ * \param[in]   flags   Trace attributes.
+ * \param[in]   cnt     Number of samples per buffer.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t osal_trace_init_struct(osal_trace_t *trace, osal_trace_attr_t flags, osal_uint32_t cnt) {
+    memset(trace, 0, sizeof(osal_trace_t));
+
+    trace->cnt       = cnt;
+    trace->act_buf   = 0;
+    trace->pos       = 0;
+    trace->attr      = flags;
+
+    osal_trace_stats_clear(&trace->stats);
+
+    return osal_binary_semaphore_init(&trace->sync_sem, NULL);
+}
+
+//! \brief Allocate and initialize trace struct without sample buffers.
+/*!
+ * \param[out]  trace   Pointer to trace* where allocated trace struct is returned.
+ * \param[in]   flags   Trace attributes.
+ * \param[in]   cnt     Number of samples per buffer.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t osal_trace_alloc_struct(osal_trace_t **trace, osal_trace_attr_t flags, osal_uint32_t cnt) {
+    osal_retval_t ret = OSAL_OK;
+
+    (*trace) = malloc(sizeof(osal_trace_t));
+
+    if ((*trace) == NULL) {
+        ret = OSAL_ERR_OUT_OF_MEMORY;
+    } else {
+        ret = osal_trace_init_struct((*trace), flags, cnt);
+        if (ret != OSAL_OK) {
+            free((*trace));
+            (*trace) = NULL;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Check trace attributes and sample count.
+/*!
+ * \param[in]   flags   Trace attributes.
+ * \param[in]   cnt     Number of samples per buffer/chunk.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t osal_trace_check_attr(osal_trace_attr_t flags, osal_uint32_t cnt) {
+    osal_retval_t ret = OSAL_OK;
+    osal_trace_attr_t mode = flags & OSAL_TRACE_ATTR__MODE__MASK;
+
+    if ((mode != OSAL_TRACE_ATTR__MODE__RING) && (mode != OSAL_TRACE_ATTR__MODE__DOUBLE_BUFFER)) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else if (cnt < 2u) {
+        // only a stats trace may go without any sample buffers
+        if (    (cnt != 0u) || (mode != OSAL_TRACE_ATTR__MODE__DOUBLE_BUFFER) ||
+                ((flags & OSAL_TRACE_ATTR__STATS) == 0u)) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Setup sample buffers of initialized trace struct.
+/*!
+ * \param[in]   trace       Pointer to trace struct.
+ * \param[in]   storage     Caller provided storage or NULL to allocate.
+ * \param[in]   storage_cnt Number of samples in \p storage.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t osal_trace_init_buffers(osal_trace_t *trace, osal_uint64_t *storage, osal_size_t storage_cnt) {
+    osal_retval_t ret = OSAL_OK;
+    osal_size_t buf_cnt[2] = { trace->cnt, trace->cnt };
+    osal_mem_attr_t mem_attr = 0u;
+
+    if ((trace->attr & OSAL_TRACE_ATTR__MODE__MASK) == OSAL_TRACE_ATTR__MODE__RING) {
+        // time_in_ns[0] is the ring, time_in_ns[1] receives drained chunks
+        buf_cnt[0] = 2u * (osal_size_t)trace->cnt;
+        trace->ring_size = buf_cnt[0];
+    }
+
+    if ((trace->attr & OSAL_TRACE_ATTR__MEM_LOCK) != 0u) {
+        mem_attr |= OSAL_MEM_ATTR__LOCK | OSAL_MEM_ATTR__PREFAULT;
+    }
+
+    if ((trace->attr & OSAL_TRACE_ATTR__MEM_HUGEPAGE) != 0u) {
+        mem_attr |= OSAL_MEM_ATTR__HUGEPAGE;
+    }
+
+    if (trace->cnt == 0u) {
+        // stats only trace
+    } else if (storage != NULL) {
+        if (storage_cnt < (buf_cnt[0] + buf_cnt[1])) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else {
+            trace->storage       = OSAL_TRACE_STORAGE__EXTERNAL;
+            trace->time_in_ns[0] = storage;
+            trace->time_in_ns[1] = &storage[buf_cnt[0]];
+
+            memset(storage, 0, sizeof(osal_uint64_t) * (buf_cnt[0] + buf_cnt[1]));
+
+            if (mem_attr != 0u) {
+                ret = osal_mem_prepare(storage, sizeof(osal_uint64_t) * (buf_cnt[0] + buf_cnt[1]), &mem_attr);
+            }
+        }
+    } else if (mem_attr != 0u) {
+        osal_void_t *mem = NULL;
+
+        ret = osal_mem_alloc(&mem, sizeof(osal_uint64_t) * (buf_cnt[0] + buf_cnt[1]), &mem_attr);
+        if (ret == OSAL_OK) {
+            trace->storage       = OSAL_TRACE_STORAGE__MEM;
+            trace->time_in_ns[0] = (osal_uint64_t *)mem;
+            trace->time_in_ns[1] = &trace->time_in_ns[0][buf_cnt[0]];
+        }
+    } else {
+        trace->storage       = OSAL_TRACE_STORAGE__MALLOC;
+        trace->time_in_ns[0] = malloc(sizeof(osal_uint64_t) * buf_cnt[0]);
+        trace->time_in_ns[1] = malloc(sizeof(osal_uint64_t) * buf_cnt[1]);
+
+        if ((trace->time_in_ns[0] == NULL) || (trace->time_in_ns[1] == NULL)) {
+            ret = OSAL_ERR_OUT_OF_MEMORY;
+        } else {
+            memset(trace->time_in_ns[0], 0, sizeof(osal_uint64_t) * buf_cnt[0]);
+            memset(trace->time_in_ns[1], 0, sizeof(osal_uint64_t) * buf_cnt[1]);
+        }
+    }
+
+    if ((ret == OSAL_OK) && ((trace->attr & OSAL_TRACE_ATTR__MEM_LOCK) != 0u)) {
+        ret = osal_mem_prepare(trace, sizeof(osal_trace_t), &mem_attr);
+    }
+
+    return ret;
+}
+
 //! \brief Allocate trace struct.
 /*!
- * \param[out]  trace   Pointer to trace* where allocated trace struct is returned.
- * \param[in]   cnt     Number of samples to allocate.
- *                      the defaults of the underlying task will be used.
+ * \param[out]  trace   Pointer to trace* where allocated trace struct is returned.
+ * \param[in]   cnt     Number of samples to allocate.
+ *                      the defaults of the underlying task will be used.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_alloc(osal_trace_t **trace, osal_uint32_t cnt) {
+    return osal_trace_alloc_attr(trace, NULL, cnt);
+}
+
+//! \brief Allocate trace struct with attributes.
+/*!
+ * \param[out]  trace   Pointer to trace* where allocated trace struct is returned.
+ * \param[in]   attr    Pointer to trace attributes. Can be NULL then the 
+ *                      default double buffer mode is used.
+ * \param[in]   cnt     Number of samples per buffer/chunk.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_alloc_attr(osal_trace_t **trace, const osal_trace_attr_t *attr, osal_uint32_t cnt) {
+    assert(trace != NULL);
+    osal_trace_attr_t flags = attr != NULL ? (*attr) : 0u;
+    osal_retval_t ret = osal_trace_check_attr(flags, cnt);
+
+    if (ret == OSAL_OK) {
+        ret = osal_trace_alloc_struct(trace, flags, cnt);
+    }
+
+    if (ret == OSAL_OK) {
+        ret = osal_trace_init_buffers((*trace), NULL, 0u);
+        if (ret != OSAL_OK) {
+            osal_trace_free((*trace));
+            (*trace) = NULL;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Initialize trace struct in caller provided memory.
+/*!
+ * \param[out]  trace       Pointer to trace struct to initialize.
+ * \param[in]   attr        Pointer to trace attributes. Can be NULL.
+ * \param[in]   cnt         Number of samples per buffer/chunk.
+ * \param[in]   storage     Sample storage, NULL to allocate the sample buffers.
+ * \param[in]   storage_cnt Number of samples in \p storage.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_init(osal_trace_t *trace, const osal_trace_attr_t *attr, osal_uint32_t cnt,
+        osal_uint64_t *storage, osal_size_t storage_cnt)
+{
+    assert(trace != NULL);
+    osal_trace_attr_t flags = attr != NULL ? (*attr) : 0u;
+    osal_retval_t ret = osal_trace_check_attr(flags, cnt);
+
+    if (ret == OSAL_OK) {
+        ret = osal_trace_init_struct(trace, flags, cnt);
+    }
+
+    if (ret == OSAL_OK) {
+        ret = osal_trace_init_buffers(trace, storage, storage_cnt);
+        if (ret != OSAL_OK) {
+            osal_trace_destroy(trace);
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Destroy trace initialized with \ref osal_trace_init.
+/*!
+ * \param[in]   trace   Pointer to trace struct to destroy.
+ *
+ * \return N/A
+ */
+void osal_trace_destroy(osal_trace_t *trace) {
+    assert(trace != NULL);
+
+    if (trace->shm_hdr != NULL) {
+        if (trace->shm_name != NULL) {
+            // exported sample buffers are part of the segment
+            trace->time_in_ns[0] = NULL;
+            trace->time_in_ns[1] = NULL;
+        }
+
+        (void)osal_shm_unmap(&trace->shm, trace->shm_hdr);
+        (void)osal_shm_close(&trace->shm);
+        trace->shm_hdr = NULL;
+    }
+
+    if (trace->shm_name != NULL) {
+        (void)osal_shm_unlink(trace->shm_name);
+        free(trace->shm_name);
+        trace->shm_name = NULL;
+    }
+
+    if (trace->storage == OSAL_TRACE_STORAGE__MEM) {
+        if (trace->time_in_ns[0] != NULL) {
+            (void)osal_mem_free(trace->time_in_ns[0]);
+        }
+    } else if (trace->storage == OSAL_TRACE_STORAGE__MALLOC) {
+        if (trace->time_in_ns[1] != 0) {
+            free(trace->time_in_ns[1]);
+        }
+
+        if (trace->time_in_ns[0] != 0) {
+            free(trace->time_in_ns[0]);
+        }
+    }
+
+    trace->time_in_ns[0] = NULL;
+    trace->time_in_ns[1] = NULL;
+
+    (void)osal_binary_semaphore_destroy(&trace->sync_sem);
+}
+
+//! \brief Free trace struct.
+/*!
+ * \param[in]   trace   Pointer to trace struct to free.
+ *
+ * \return N/A
+ */
+void osal_trace_free(osal_trace_t *trace) {
+    assert(trace != NULL);
+
+    osal_trace_destroy(trace);
+    free(trace);
+}
+
+//! \brief Allocate trace struct with sample buffers in shared memory.
+/*!
+ * \param[out]  trace   Pointer to trace* where allocated trace struct is returned.
+ * \param[in]   name    Shared memory name.
+ * \param[in]   attr    Pointer to trace attributes. Can be NULL.
+ * \param[in]   cnt     Number of samples per buffer.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_alloc_shm(osal_trace_t **trace, const osal_char_t *name, 
+        const osal_trace_attr_t *attr, osal_uint32_t cnt) 
+{
+    assert(trace != NULL);
+    assert(name != NULL);
+
+    osal_retval_t ret;
+    osal_trace_attr_t flags = attr != NULL ? (*attr) : 0u;
+    osal_shm_attr_t shm_attr = OSAL_SHM_ATTR__FLAG__CREAT | OSAL_SHM_ATTR__FLAG__EXCL | 
+        OSAL_SHM_ATTR__FLAG__RDWR | OSAL_SHM_ATTR__FLAG__MAP | (0644u << OSAL_SHM_ATTR__MODE__SHIFT);
+    osal_shm_map_attr_t map_attr = OSAL_SHM_MAP_ATTR__SHARED | 
+        OSAL_SHM_MAP_ATTR__PROT_READ | OSAL_SHM_MAP_ATTR__PROT_WRITE;
+    osal_size_t buf_size = sizeof(osal_uint64_t) * cnt;
+    osal_void_t *base = NULL;
+    osal_trace_shm_header_t *hdr;
+
+    if (    ((flags & OSAL_TRACE_ATTR__MODE__MASK) != OSAL_TRACE_ATTR__MODE__DOUBLE_BUFFER) ||
+            (cnt < 2u)) {
+        return OSAL_ERR_INVALID_PARAM;
+    }
+
+    ret = osal_trace_alloc_struct(trace, flags, cnt);
+    if (ret != OSAL_OK) {
+        return ret;
+    }
+
+    (*trace)->shm_name = malloc(strlen(name) + 1u);
+    if ((*trace)->shm_name == NULL) {
+        ret = OSAL_ERR_OUT_OF_MEMORY;
+        goto error_exit;
+    }
+    memcpy((*trace)->shm_name, name, strlen(name) + 1u);
+
+    // replace segment of a previous run, readers still attached to it keep their mapping
+    (void)osal_shm_unlink(name);
+
+    ret = osal_shm_open(&(*trace)->shm, name, &shm_attr, OSAL_TRACE_SHM_BUF_OFFSET + (2u * buf_size));
+    if (ret != OSAL_OK) {
+        goto error_exit;
+    }
+
+    ret = osal_shm_map(&(*trace)->shm, &map_attr, &base);
+    if (ret != OSAL_OK) {
+        (void)osal_shm_close(&(*trace)->shm);
+        goto error_exit;
+    }
+
+    hdr = (osal_trace_shm_header_t *)base;
+    hdr->version       = OSAL_TRACE_SHM_VERSION;
+    hdr->cnt           = cnt;
+    hdr->attr          = flags;
+    hdr->buf_offset[0] = OSAL_TRACE_SHM_BUF_OFFSET;
+    hdr->buf_offset[1] = OSAL_TRACE_SHM_BUF_OFFSET + buf_size;
+    hdr->seq           = 0u;
+
+    (*trace)->shm_hdr       = hdr;
+    (*trace)->time_in_ns[0] = (osal_uint64_t *)((osal_uint8_t *)base + hdr->buf_offset[0]);
+    (*trace)->time_in_ns[1] = (osal_uint64_t *)((osal_uint8_t *)base + hdr->buf_offset[1]);
+
+    (*trace)->storage       = OSAL_TRACE_STORAGE__EXTERNAL;
+
+    memset((*trace)->time_in_ns[0], 0, 2u * buf_size);
+
+    if ((flags & OSAL_TRACE_ATTR__MEM_LOCK) != 0u) {
+        osal_mem_attr_t mem_attr = OSAL_MEM_ATTR__LOCK | OSAL_MEM_ATTR__PREFAULT;
+
+        ret = osal_mem_prepare(base, OSAL_TRACE_SHM_BUF_OFFSET + (2u * buf_size), &mem_attr);
+        if (ret == OSAL_OK) {
+            ret = osal_mem_prepare((*trace), sizeof(osal_trace_t), &mem_attr);
+        }
+
+        if (ret != OSAL_OK) {
+            goto error_exit;
+        }
+    }
+
+    // readers check the magic before trusting anything else
+    __atomic_store_n(&hdr->magic, OSAL_TRACE_SHM_MAGIC, __ATOMIC_RELEASE);
+
+    return ret;
+
+error_exit:
+    osal_trace_free((*trace));
+    (*trace) = NULL;
+
+    return ret;
+}
+
+//! \brief Attach read-only to a trace exported in shared memory.
+/*!
+ * \param[out]  trace   Pointer to trace* where attached trace struct is returned.
+ * \param[in]   name    Shared memory name.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_attach_shm(osal_trace_t **trace, const osal_char_t *name) {
+    assert(trace != NULL);
+    assert(name != NULL);
+
+    osal_retval_t ret;
+    osal_shm_t shm;
+    osal_shm_attr_t shm_attr = OSAL_SHM_ATTR__FLAG__RDONLY | OSAL_SHM_ATTR__FLAG__MAP;
+    osal_shm_map_attr_t map_attr = OSAL_SHM_MAP_ATTR__SHARED | OSAL_SHM_MAP_ATTR__PROT_READ;
+    osal_void_t *base = NULL;
+    osal_trace_shm_header_t *hdr;
+
+    (*trace) = NULL;
+
+    ret = osal_shm_open(&shm, name, &shm_attr, 0u);
+    if (ret != OSAL_OK) {
+        return ret;
+    }
+
+    if (shm.size < OSAL_TRACE_SHM_BUF_OFFSET) {
+        (void)osal_shm_close(&shm);
+        return OSAL_ERR_UNAVAILABLE;
+    }
+
+    ret = osal_shm_map(&shm, &map_attr, &base);
+    if (ret != OSAL_OK) {
+        (void)osal_shm_close(&shm);
+        return ret;
+    }
+
+    hdr = (osal_trace_shm_header_t *)base;
+
+    if (__atomic_load_n(&hdr->magic, __ATOMIC_ACQUIRE) != OSAL_TRACE_SHM_MAGIC) {
+        ret = OSAL_ERR_UNAVAILABLE;
+    } else if (    (hdr->version != OSAL_TRACE_SHM_VERSION) || (hdr->cnt < 2u) ||
+            ((hdr->buf_offset[0] + (sizeof(osal_uint64_t) * hdr->cnt)) > shm.size) ||
+            ((hdr->buf_offset[1] + (sizeof(osal_uint64_t) * hdr->cnt)) > shm.size)) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        ret = osal_trace_alloc_struct(trace, hdr->attr & OSAL_TRACE_ATTR__REL, hdr->cnt);
+    }
+
+    if (ret != OSAL_OK) {
+        (void)osal_shm_unmap(&shm, base);
+        (void)osal_shm_close(&shm);
+        return ret;
+    }
+
+    osal_uint64_t seq = __atomic_load_n(&hdr->seq, __ATOMIC_ACQUIRE);
+
+    (*trace)->shm      = shm;
+    (*trace)->shm_hdr  = hdr;
+    (*trace)->shm_seen = seq != 0u ? seq - 1u : 0u;     // newest complete buffer is fetched first
+
+    // analyze functions read buffer 1 as long as act_buf stays 0
+    (*trace)->time_in_ns[1] = malloc(sizeof(osal_uint64_t) * hdr->cnt);
+    if ((*trace)->time_in_ns[1] == NULL) {
+        osal_trace_free((*trace));
+        (*trace) = NULL;
+        ret = OSAL_ERR_OUT_OF_MEMORY;
+    } else {
+        memset((*trace)->time_in_ns[1], 0, sizeof(osal_uint64_t) * hdr->cnt);
+    }
+
+    return ret;
+}
+
+//! \brief Publish completed buffer to shm readers.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ *
+ * \return N/A
+ */
+static inline void osal_trace_shm_publish(osal_trace_t *trace) {
+    osal_trace_shm_header_t *hdr = trace->shm_hdr;
+
+    // samples are visible before seq, the fence keeps the following sample 
+    // stores into the now reused buffer behind it
+    __atomic_store_n(&hdr->seq, hdr->seq + 1u, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+//! \brief Fetch newest complete buffer from shm trace (reader side).
+/*!
+ * \param[in]   trace   Pointer to attached trace struct.
+ * \param[out]  dropped Optional, returns the number of samples in skipped buffers.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t osal_trace_shm_fetch(osal_trace_t *trace, osal_uint64_t *dropped) {
+    const osal_trace_shm_header_t *hdr = trace->shm_hdr;
+    osal_retval_t ret = OSAL_ERR_NO_DATA;
+    osal_uint64_t skipped = 0u;
+    osal_uint64_t seq = __atomic_load_n(&hdr->seq, __ATOMIC_ACQUIRE);
+
+    while (seq != trace->shm_seen) {
+        memcpy(trace->time_in_ns[1], (const osal_uint8_t *)hdr + hdr->buf_offset[(seq - 1u) & 1u],
+                sizeof(osal_uint64_t) * trace->cnt);
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        osal_uint64_t seq_check = __atomic_load_n(&hdr->seq, __ATOMIC_ACQUIRE);
+
+        if (seq_check == seq) {
+            skipped = (seq - trace->shm_seen - 1u) * trace->cnt;
+            trace->shm_seen = seq;
+            ret = OSAL_OK;
+            break;
+        }
+
+        // tracer completed another buffer meanwhile, copy may be torn
+        seq = seq_check;
+    }
+
+    if (dropped != NULL) {
+        (*dropped) = skipped;
+    }
+
+    return ret;
+}
+
+//! \brief Store time in ring mode trace (producer side).
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[in]   time    Time to store in trace.
+ *
+ * \return N/A
+ */
+static void osal_trace_ring_time(osal_trace_t *trace, osal_uint64_t time) {
+    osal_uint64_t head = trace->ring_head;
+    osal_uint64_t tail = __atomic_load_n(&trace->ring_tail, __ATOMIC_ACQUIRE);
+
+    if ((head - tail) >= trace->ring_size) {
+        // consumer is behind, never overwrite samples which may be read right now
+        (void)__atomic_fetch_add(&trace->ring_dropped, 1u, __ATOMIC_RELAXED);
+        return;
+    }
+
+    trace->time_in_ns[0][trace->pos] = time;
+
+    trace->pos++;
+    if (trace->pos >= trace->ring_size) {
+        trace->pos = 0;
+    }
+
+    // publish sample, pairs with acquire load in osal_trace_drain
+    __atomic_store_n(&trace->ring_head, head + 1u, __ATOMIC_RELEASE);
+
+    if ((trace->pos % trace->cnt) == 0u) {
+        osal_binary_semaphore_post(&(trace->sync_sem));
+    }
+}
+
+//! \brief Record sample in streaming statistics (tracing task only).
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[in]   value   Sample to record.
+ *
+ * \return N/A
+ */
+static void osal_trace_stats_record(osal_trace_t *trace, osal_uint64_t value) {
+    osal_uint32_t seq = trace->stats_seq;
+
+    // sequence lock, readers retry while seq is odd or has changed
+    __atomic_store_n(&trace->stats_seq, seq + 1u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    if (__atomic_exchange_n(&trace->stats_reset, 0u, __ATOMIC_RELAXED) != 0u) {
+        osal_trace_stats_clear(&trace->stats);
+    }
+
+    osal_trace_stats_update(&trace->stats, value);
+
+    __atomic_store_n(&trace->stats_seq, seq + 2u, __ATOMIC_RELEASE);
+}
+
+//! \brief Finish running snapshot capture (tracing task only).
+/*!
+ * \param[in]   trig    Pointer to trigger.
+ * \param[in]   slot    Slot of running capture.
+ *
+ * \return N/A
+ */
+static void osal_trace_trigger_complete(osal_trace_trigger_t *trig, osal_trace_trigger_slot_t *slot) {
+    __atomic_store_n(&slot->seq, trig->started, __ATOMIC_RELEASE);
+    __atomic_store_n(&trig->completed, trig->started, __ATOMIC_RELEASE);
+
+    osal_binary_semaphore_post(&trig->sync_sem);
+}
+
+//! \brief Feed outlier trigger with traced time (tracing task only).
+/*!
+ * \param[in]   trig    Pointer to trigger.
+ * \param[in]   time    Traced time.
+ * \param[in]   value   Interval or value checked against threshold.
+ * \param[in]   valid   \p value is valid.
+ *
+ * \return N/A
+ */
+static void osal_trace_trigger_record(osal_trace_trigger_t *trig, osal_uint64_t time, 
+        osal_uint64_t value, int valid) 
+{
+    if (trig->post_left != 0u) {
+        osal_uint32_t idx = (osal_uint32_t)((trig->started - 1u) % trig->slot_cnt);
+        osal_trace_trigger_slot_t *slot = &trig->slots[idx];
+
+        trig->samples[((osal_size_t)idx * trig->slot_len) + slot->cnt] = time;
+        slot->cnt++;
+
+        trig->post_left--;
+        if (trig->post_left == 0u) {
+            osal_trace_trigger_complete(trig, slot);
+        }
+    } else if (valid && (value > __atomic_load_n(&trig->threshold, __ATOMIC_RELAXED))) {
+        osal_uint32_t idx = (osal_uint32_t)(trig->started % trig->slot_cnt);
+        osal_trace_trigger_slot_t *slot = &trig->slots[idx];
+        osal_uint64_t *samples = &trig->samples[(osal_size_t)idx * trig->slot_len];
+        osal_uint32_t first = (trig->history_pos + trig->pre - trig->history_cnt) % (trig->pre != 0u ? trig->pre : 1u);
+
+        trig->started++;
+
+        // invalidate slot for reader while overwriting it
+        __atomic_store_n(&slot->seq, 0u, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+
+        for (osal_uint32_t i = 0u; i < trig->history_cnt; ++i) {
+            samples[i] = trig->history[(first + i) % trig->pre];
+        }
+
+        slot->value = value;
+        slot->trigger_pos = trig->history_cnt;
+        samples[slot->trigger_pos] = time;
+        slot->cnt = slot->trigger_pos + 1u;
+
+        trig->post_left = trig->post;
+        if (trig->post_left == 0u) {
+            osal_trace_trigger_complete(trig, slot);
+        }
+    }
+
+    if (trig->pre != 0u) {
+        trig->history[trig->history_pos] = time;
+        trig->history_pos = (trig->history_pos + 1u) % trig->pre;
+
+        if (trig->history_cnt < trig->pre) {
+            trig->history_cnt++;
+        }
+    }
+}
+
+//! \brief Feed online analysis with traced time.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[in]   time    Traced time.
+ *
+ * \return N/A
+ */
+static void osal_trace_record(osal_trace_t *trace, osal_uint64_t time) {
+    osal_uint64_t value = time;
+    int valid = 1;
+
+    if ((trace->attr & OSAL_TRACE_ATTR__REL) == 0u) {
+        valid = trace->has_last_time != 0u;
+        value = time > trace->last_time ? time - trace->last_time : 0u;
+        trace->has_last_time = 1u;
+    }
+
+    trace->last_time = time;
+
+    if (trace->trigger != NULL) {
+        osal_trace_trigger_record(trace->trigger, time, value, valid);
+    }
+
+    if (valid) {
+        if (trace->hist != NULL) {
+            osal_trace_hist_record(trace->hist, value);
+        }
+
+        if ((trace->attr & OSAL_TRACE_ATTR__STATS) != 0u) {
+            osal_trace_stats_record(trace, value);
+        }
+    }
+}
+
+//! \brief Trace time.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ *
+ * \return stored trace time in [ns].
+ */
+osal_uint64_t osal_trace_point(osal_trace_t *trace) {
+    osal_uint64_t ret_time;
+
+    assert(trace != NULL);
+
+    ret_time = osal_timer_gettime_nsec();
+    osal_trace_time(trace, ret_time);
+
+    return ret_time;
+}
+
+//! \brief Trace time.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[in]   time    Time to store in trace.
+ *
+ * \return N/A
+ */
+void osal_trace_time(osal_trace_t *trace, osal_uint64_t time) {
+    assert(trace != NULL);
+
+    if (    (trace->hist != NULL) || (trace->trigger != NULL) || 
+            ((trace->attr & OSAL_TRACE_ATTR__STATS) != 0u)) {
+        osal_trace_record(trace, time);
+    }
+
+    if (trace->ring_size != 0u) {
+        osal_trace_ring_time(trace, time);
+        return;
+    } 
+    
+    if (trace->cnt == 0u) {
+        // stats only trace
+        return;
+    }
+
+    trace->time_in_ns[trace->act_buf][trace->pos] = time;
+
+    trace->pos++;
+    if (trace->pos >= trace->cnt) {
+        trace->act_buf = trace->act_buf == 0 ? 1 : 0;
+        trace->pos = 0;
+
+        if (trace->shm_hdr != NULL) {
+            osal_trace_shm_publish(trace);
+        }
+
+        osal_binary_semaphore_post(&(trace->sync_sem));
+    }
+}
+
+//! \brief Return last time stored in trace.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ * 
+ * \return last store trace time in [ns].
+ */
+osal_uint64_t osal_trace_get_last_time(osal_trace_t *trace) {
+    assert(trace != NULL);
+
+    osal_uint64_t last_time = 0u;
+    osal_uint32_t last_buf = trace->act_buf;
+
+    if (trace->cnt == 0u) {
+        last_time = trace->last_time;
+    } else if (trace->ring_size != 0u) {
+        // only called from producer side, ring_head is not changed concurrently
+        if (trace->ring_head != 0u) {
+            last_time = trace->time_in_ns[0][trace->pos == 0u ? trace->ring_size - 1u : trace->pos - 1u];
+        }
+    } else if (trace->pos == 0) {
+        last_buf = trace->act_buf == 0 ? 1 : 0;
+        last_time = trace->time_in_ns[last_buf][trace->cnt - 1];
+    } else {
+        last_time = trace->time_in_ns[last_buf][trace->pos - 1];
+    }
+
+    return last_time;
+}
+
+//! \brief Sync to trace when buffer is full.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ *
+ * \return N/A
+ */
+osal_retval_t osal_trace_timedwait(osal_trace_t *trace, osal_timer_t *timeout) {
+    osal_retval_t ret = osal_binary_semaphore_timedwait(&(trace->sync_sem), timeout);
+    return ret;
+}
+
+//! \brief Sync to trace when buffer is full, with a deadline in nanoseconds.
+/*!
+ * \param[in]   trace       Pointer to trace struct.
+ * \param[in]   deadline_ns Absolute timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_wait_until_ns(osal_trace_t *trace, osal_uint64_t deadline_ns) {
+    assert(trace != NULL);
+
+    return osal_binary_semaphore_wait_until_ns(&(trace->sync_sem), deadline_ns);
+}
+
+//! \brief Sync to trace when buffer is full, waiting at most a time in nanoseconds.
+/*!
+ * \param[in]   trace       Pointer to trace struct.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_wait_for_ns(osal_trace_t *trace, osal_uint64_t rel_ns) {
+    assert(trace != NULL);
+
+    return osal_binary_semaphore_wait_for_ns(&(trace->sync_sem), rel_ns);
+}
+
+//! \brief Fetch next complete chunk from a ring mode trace.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[out]  dropped Optional, returns the number of samples dropped by the
+ *                      producer since the last call.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_drain(osal_trace_t *trace, osal_uint64_t *dropped) {
+    assert(trace != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    if ((trace->shm_hdr != NULL) && (trace->shm_name == NULL)) {
+        ret = osal_trace_shm_fetch(trace, dropped);
+    } else if (trace->ring_size == 0u) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        osal_uint64_t tail = trace->ring_tail;
+        osal_uint64_t head = __atomic_load_n(&trace->ring_head, __ATOMIC_ACQUIRE);
+
+        if ((head - tail) < trace->cnt) {
+            ret = OSAL_ERR_NO_DATA;
+        } else {
+            // tail always advances by whole chunks and the ring holds exactly two 
+            // of them, so a chunk never wraps and never straddles a dropped gap.
+            memcpy(trace->time_in_ns[1], &trace->time_in_ns[0][tail % trace->ring_size], 
+                    sizeof(osal_uint64_t) * trace->cnt);
+
+            // hand chunk back to producer, pairs with acquire load in osal_trace_ring_time
+            __atomic_store_n(&trace->ring_tail, tail + trace->cnt, __ATOMIC_RELEASE);
+        }
+
+        if (dropped != NULL) {
+            osal_uint64_t act_dropped = __atomic_load_n(&trace->ring_dropped, __ATOMIC_RELAXED);
+            (*dropped) = act_dropped - trace->ring_dropped_seen;
+            trace->ring_dropped_seen = act_dropped;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Return number of samples dropped in ring mode.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ *
+ * \return total number of samples dropped because the consumer fell behind.
+ */
+osal_uint64_t osal_trace_get_dropped(osal_trace_t *trace) {
+    assert(trace != NULL);
+
+    return __atomic_load_n(&trace->ring_dropped, __ATOMIC_RELAXED);
+}
+
+//! \brief Analyze trace and return average and jitters.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[out]  avg     Return average time interval.
+ * \param[out]  avg_jit Return average jitter (std-dev).
+ * \param[out]  max_jit Return maximum jitter.
+ *
+ * \return N/A
+ */
+void osal_trace_analyze(osal_trace_t *trace, osal_uint64_t *avg, osal_uint64_t *avg_jit, osal_uint64_t *max_jit) {
+    osal_trace_analyze_min_max(trace, avg, avg_jit, max_jit, NULL, NULL);
+}
+
+//! \brief Analyze trace and return average and jitters.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[out]  avg     Return average time interval.
+ * \param[out]  avg_jit Return average jitter (std-dev).
+ * \param[out]  max_jit Return maximum jitter.
+ * \param[out]  min_val Return minimum interval value.
+ * \param[out]  max_val Return maximum interval value.
+ *
+ * \return N/A
+ */
+void osal_trace_analyze_min_max(osal_trace_t *trace, osal_uint64_t *avg, osal_uint64_t *avg_jit, 
+        osal_uint64_t *max_jit, osal_uint64_t *min_val, osal_uint64_t *max_val)
+{
+    assert(trace != NULL);
+    assert(trace->cnt >= 2u);
+    assert(avg != NULL);
+    assert(avg_jit != NULL);
+    assert(max_jit != NULL);
+
+    int act_buffer = trace->act_buf == 1 ? 0 : 1;
+
+    osal_trace_analyze_buffer(trace->time_in_ns[act_buffer], trace->cnt - 1u, 1, trace->cnt, 
+            avg, avg_jit, max_jit, min_val, max_val);
+}
+
+
+//! \brief Analyze trace with relative timestamps and return average and jitters.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[out]  avg     Return average time interval.
+ * \param[out]  avg_jit Return average jitter (std-dev).
+ * \param[out]  max_jit Return maximum jitter.
+ *
+ * \return N/A
+ */
+void osal_trace_analyze_rel(osal_trace_t *trace, osal_uint64_t *avg, osal_uint64_t *avg_jit, osal_uint64_t *max_jit) {
+    osal_trace_analyze_rel_min_max(trace, avg, avg_jit, max_jit, NULL, NULL);
+}
+
+//! \brief Analyze trace with relative timestamps and return average and jitters.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[out]  avg     Return average time interval.
+ * \param[out]  avg_jit Return average jitter (std-dev).
+ * \param[out]  max_jit Return maximum jitter.
+ * \param[out]  min_val Return minimum interval value.
+ * \param[out]  max_val Return maximum interval value.
+ *
+ * \return N/A
+ */
+void osal_trace_analyze_rel_min_max(osal_trace_t *trace, osal_uint64_t *avg, osal_uint64_t *avg_jit, 
+        osal_uint64_t *max_jit, osal_uint64_t *min_val, osal_uint64_t *max_val)
+{
+    assert(trace != NULL);
+    assert(trace->cnt >= 2u);
+    assert(avg != NULL);
+    assert(avg_jit != NULL);
+    assert(max_jit != NULL);
+
+    int act_buffer = trace->act_buf == 1 ? 0 : 1;
+
+    osal_trace_analyze_buffer(trace->time_in_ns[act_buffer], trace->cnt, 0, trace->cnt, 
+            avg, avg_jit, max_jit, min_val, max_val);
+}
+
+//! \brief Get consistent snapshot of streaming statistics.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[out]  stats   Return statistics.
  *
  * \return OK or ERROR_CODE.
  */
-osal_retval_t osal_trace_alloc(osal_trace_t **trace, osal_uint32_t cnt) {
+osal_retval_t osal_trace_get_stats(osal_trace_t *trace, osal_trace_stats_t *stats) {
     assert(trace != NULL);
-    osal_retval_t ret = OSAL_OK;
+    assert(stats != NULL);
 
-    (*trace) = malloc(sizeof(osal_trace_t));
-    memset((*trace), 0, sizeof(osal_trace_t));
+    osal_retval_t ret = OSAL_OK;
 
-    if ((*trace) == NULL) {
-        ret = OSAL_ERR_OUT_OF_MEMORY;
+    if ((trace->attr & OSAL_TRACE_ATTR__STATS) == 0u) {
+        ret = OSAL_ERR_INVALID_PARAM;
     } else {
-        (*trace)->cnt       = cnt;
-        (*trace)->act_buf   = 0;
-        (*trace)->pos       = 0;
+        osal_uint32_t seq_start;
+        osal_uint32_t seq_end;
+        osal_uint32_t reset;
 
-        ret = osal_binary_semaphore_init(&(*trace)->sync_sem, NULL);
-        if (ret != OSAL_OK) {
-            goto error_exit;
-        }
-        
-        (*trace)->time_in_ns[0] = malloc(sizeof(osal_uint64_t) * cnt);
-        (*trace)->time_in_ns[1] = malloc(sizeof(osal_uint64_t) * cnt);
-        (*trace)->tmp           = malloc(sizeof(osal_uint64_t) * cnt);
+        do {
+            seq_start = __atomic_load_n(&trace->stats_seq, __ATOMIC_ACQUIRE);
+            memcpy(stats, &trace->stats, sizeof(osal_trace_stats_t));
+            reset = __atomic_load_n(&trace->stats_reset, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            seq_end = __atomic_load_n(&trace->stats_seq, __ATOMIC_RELAXED);
+        } while (((seq_start & 1u) != 0u) || (seq_start != seq_end));
 
-        if (    ((*trace)->time_in_ns[0] == NULL) ||
-                ((*trace)->time_in_ns[1] == NULL) ||
-                ((*trace)->tmp           == NULL)) {
-            ret = OSAL_ERR_OUT_OF_MEMORY;
-            goto error_exit;
+        if (reset != 0u) {
+            // tracing task has not yet applied the pending reset
+            osal_trace_stats_clear(stats);
         }
-
-        memset((*trace)->time_in_ns[0], 0, sizeof(osal_uint64_t) * cnt);
-        memset((*trace)->time_in_ns[1], 0, sizeof(osal_uint64_t) * cnt);
-        memset((*trace)->tmp, 0, sizeof(osal_uint64_t) * cnt);
     }
 
     return ret;
+}
 
-error_exit:
-    if ((*trace) != NULL) {
-        if ((*trace)->tmp != 0) {
-            free((*trace)->tmp);
-        }
+//! \brief Analyze streaming statistics and return average and jitters.
+/*!
+ * \param[in]   trace   Pointer to trace struct.
+ * \param[out]  avg     Return average.
+ * \param[out]  avg_jit Return average jitter (std-dev).
+ * \param[out]  max_jit Return maximum jitter.
+ * \param[out]  min_val Return minimum value, may be NULL.
+ * \param[out]  max_val Return maximum value, may be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_analyze_stats(osal_trace_t *trace, osal_uint64_t *avg, osal_uint64_t *avg_jit, 
+        osal_uint64_t *max_jit, osal_uint64_t *min_val, osal_uint64_t *max_val)
+{
+    assert(avg != NULL);
+    assert(avg_jit != NULL);
+    assert(max_jit != NULL);
 
-        if ((*trace)->time_in_ns[1] != 0) {
-            free((*trace)->time_in_ns[1]);
-        }
+    osal_trace_stats_t stats;
+    osal_retval_t ret = osal_trace_get_stats(trace, &stats);
 
-        if ((*trace)->time_in_ns[0] != 0) {
-            free((*trace)->time_in_ns[0]);
-        }
+    if ((ret == OSAL_OK) && (stats.cnt == 0u)) {
+        ret = OSAL_ERR_NO_DATA;
+    }
 
-        free((*trace));
+    if (ret == OSAL_OK) {
+        double off;
+
+        (*avg) = (osal_uint64_t)(stats.mean + 0.5);
+        off = stats.mean - (double)(*avg);
+
+        osal_trace_eval_jitter((*avg), stats.m2 + ((double)stats.cnt * off * off), stats.cnt, 
+                stats.min_val, stats.max_val, avg_jit, max_jit);
+
+        if (min_val) { *min_val = stats.min_val; }
+        if (max_val) { *max_val = stats.max_val; }
     }
 
     return ret;
 }
 
-//! \brief Free trace struct.
+//! \brief Reset streaming statistics.
 /*!
- * \param[in]   trace   Pointer to trace struct to free.
+ * \param[in]   trace   Pointer to trace struct.
  *
  * \return N/A
  */
-void osal_trace_free(osal_trace_t *trace) {
+void osal_trace_reset_stats(osal_trace_t *trace) {
     assert(trace != NULL);
 
-    if (trace->tmp != 0) {
-        free(trace->tmp);
+    __atomic_store_n(&trace->stats_reset, 1u, __ATOMIC_RELAXED);
+}
+
+//! \brief Return histogram bucket index of value.
+static inline osal_uint32_t osal_trace_hist_index(const osal_trace_hist_t *hist, osal_uint64_t value) {
+    osal_uint32_t bits = hist->sub_bucket_bits;
+    osal_uint32_t idx;
+
+    if (value < ((osal_uint64_t)1u << bits)) {
+        idx = (osal_uint32_t)value;
+    } else {
+        osal_uint32_t msb = 63u - (osal_uint32_t)__builtin_clzll(value);
+        osal_uint32_t shift = msb - bits + 1u;
+
+        // value >> shift is in [2^(bits-1), 2^bits), one linear range per shift
+        idx = (shift << (bits - 1u)) + (osal_uint32_t)(value >> shift);
+    }
+
+    return idx;
+}
+
+//! \brief Return highest value which falls into histogram bucket.
+static osal_uint64_t osal_trace_hist_bucket_upper(const osal_trace_hist_t *hist, osal_uint32_t idx) {
+    osal_uint32_t bits = hist->sub_bucket_bits;
+    osal_uint32_t half = 1u << (bits - 1u);
+    osal_uint64_t upper;
+
+    if (idx < (1u << bits)) {
+        upper = idx;
+    } else {
+        osal_uint32_t shift = (idx / half) - 1u;
+        osal_uint64_t sub = (idx % half) + half;
+
+        // wraps to UINT64_MAX for the last bucket
+        upper = ((sub + 1u) << shift) - 1u;
+    }
+
+    return upper;
+}
+
+//! \brief Allocate trace histogram.
+/*!
+ * \param[out]  hist                Pointer to hist* where allocated histogram is returned.
+ * \param[in]   sub_bucket_bits     Precision, 0 selects default.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_hist_alloc(osal_trace_hist_t **hist, osal_uint32_t sub_bucket_bits) {
+    assert(hist != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    if (sub_bucket_bits == 0u) {
+        sub_bucket_bits = OSAL_TRACE_HIST_SUB_BUCKET_BITS_DEFAULT;
     }
 
-    if (trace->time_in_ns[1] != 0) {
-        free(trace->time_in_ns[1]);
+    if (    (sub_bucket_bits < OSAL_TRACE_HIST_SUB_BUCKET_BITS_MIN) ||
+            (sub_bucket_bits > OSAL_TRACE_HIST_SUB_BUCKET_BITS_MAX)) {
+        return OSAL_ERR_INVALID_PARAM;
     }
 
-    if (trace->time_in_ns[0] != 0) {
-        free(trace->time_in_ns[0]);
+    (*hist) = malloc(sizeof(osal_trace_hist_t));
+
+    if ((*hist) == NULL) {
+        ret = OSAL_ERR_OUT_OF_MEMORY;
+    } else {
+        (*hist)->sub_bucket_bits = sub_bucket_bits;
+        (*hist)->bucket_cnt      = (66u - sub_bucket_bits) << (sub_bucket_bits - 1u);
+        (*hist)->counts          = malloc(sizeof(osal_uint64_t) * (*hist)->bucket_cnt);
+
+        if ((*hist)->counts == NULL) {
+            free((*hist));
+            (*hist) = NULL;
+            ret = OSAL_ERR_OUT_OF_MEMORY;
+        } else {
+            osal_trace_hist_reset((*hist));
+        }
     }
 
-    free(trace);
+    return ret;
 }
 
-//! \brief Trace time.
+//! \brief Free trace histogram.
 /*!
- * \param[in]   trace   Pointer to trace struct.
+ * \param[in]   hist    Pointer to histogram to free.
  *
- * \return stored trace time in [ns].
+ * \return N/A
  */
-osal_uint64_t osal_trace_point(osal_trace_t *trace) {
-    osal_uint64_t ret_time;
+void osal_trace_hist_free(osal_trace_hist_t *hist) {
+    assert(hist != NULL);
 
-    assert(trace != NULL);
+    if (hist->counts != NULL) {
+        free(hist->counts);
+    }
 
-    ret_time = osal_timer_gettime_nsec();
-    osal_trace_time(trace, ret_time);
+    free(hist);
+}
 
-    return ret_time;
+//! \brief Clear all counters of trace histogram.
+/*!
+ * \param[in]   hist    Pointer to histogram.
+ *
+ * \return N/A
+ */
+void osal_trace_hist_reset(osal_trace_hist_t *hist) {
+    assert(hist != NULL);
+
+    memset(hist->counts, 0, sizeof(osal_uint64_t) * hist->bucket_cnt);
+    __atomic_store_n(&hist->min_val, UINT64_MAX, __ATOMIC_RELAXED);
+    __atomic_store_n(&hist->max_val, 0u, __ATOMIC_RELAXED);
 }
 
-//! \brief Trace time.
+//! \brief Record value in trace histogram.
 /*!
- * \param[in]   trace   Pointer to trace struct.
- * \param[in]   time    Time to store in trace.
+ * \param[in]   hist    Pointer to histogram.
+ * \param[in]   value   Value to record.
  *
  * \return N/A
  */
-void osal_trace_time(osal_trace_t *trace, osal_uint64_t time) {
-    assert(trace != NULL);
+void osal_trace_hist_record(osal_trace_hist_t *hist, osal_uint64_t value) {
+    assert(hist != NULL);
 
-    trace->time_in_ns[trace->act_buf][trace->pos] = time;
+    (void)__atomic_fetch_add(&hist->counts[osal_trace_hist_index(hist, value)], 1u, __ATOMIC_RELAXED);
 
-    trace->pos++;
-    if (trace->pos >= trace->cnt) {
-        trace->act_buf = trace->act_buf == 0 ? 1 : 0;
-        trace->pos = 0;
+    osal_uint64_t act = __atomic_load_n(&hist->min_val, __ATOMIC_RELAXED);
+    while ((value < act) && !__atomic_compare_exchange_n(&hist->min_val, &act, value, 
+                0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
 
-        osal_binary_semaphore_post(&(trace->sync_sem));
-    }
+    act = __atomic_load_n(&hist->max_val, __ATOMIC_RELAXED);
+    while ((value > act) && !__atomic_compare_exchange_n(&hist->max_val, &act, value, 
+                0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
 }
 
-//! \brief Return last time stored in trace.
+//! \brief Get value at percentile.
 /*!
- * \param[in]   trace   Pointer to trace struct.
- * 
- * \return last store trace time in [ns].
+ * \param[in]   hist        Pointer to histogram.
+ * \param[in]   percentile  Percentile in range [0.0, 100.0].
+ *
+ * \return value at percentile.
  */
-osal_uint64_t osal_trace_get_last_time(osal_trace_t *trace) {
-    assert(trace != NULL);
+osal_uint64_t osal_trace_hist_get_percentile(osal_trace_hist_t *hist, double percentile) {
+    assert(hist != NULL);
 
-    osal_uint64_t last_time = 0u;
-    osal_uint32_t last_buf = trace->act_buf;
+    osal_uint64_t total = osal_trace_hist_get_count(hist);
+    osal_uint64_t min_val;
+    osal_uint64_t max_val;
+    osal_uint64_t ret = 0u;
 
-    if (trace->pos == 0) {
-        last_buf = trace->act_buf == 0 ? 1 : 0;
-        last_time = trace->time_in_ns[last_buf][trace->cnt - 1];
+    osal_trace_hist_get_min_max(hist, &min_val, &max_val);
+
+    if (total == 0u) {
+        // empty
+    } else if (percentile <= 0.) {
+        ret = min_val;
+    } else if (percentile >= 100.) {
+        ret = max_val;
     } else {
-        last_time = trace->time_in_ns[last_buf][trace->pos - 1];
+        double exact = (percentile / 100.) * (double)total;
+        osal_uint64_t target = (osal_uint64_t)exact;
+        osal_uint64_t sum = 0u;
+
+        if (((double)target < exact) || (target == 0u)) {
+            target++;
+        }
+
+        ret = max_val;
+
+        for (osal_uint32_t i = 0u; i < hist->bucket_cnt; ++i) {
+            sum += __atomic_load_n(&hist->counts[i], __ATOMIC_RELAXED);
+            if (sum >= target) {
+                osal_uint64_t upper = osal_trace_hist_bucket_upper(hist, i);
+                if (upper < ret) {
+                    ret = upper;
+                }
+                break;
+            }
+        }
     }
 
-    return last_time;
+    return ret;
 }
 
-//! \brief Sync to trace when buffer is full.
+//! \brief Get number of recorded values.
 /*!
- * \param[in]   trace   Pointer to trace struct.
+ * \param[in]   hist    Pointer to histogram.
  *
- * \return N/A
+ * \return number of recorded values.
  */
-osal_retval_t osal_trace_timedwait(osal_trace_t *trace, osal_timer_t *timeout) {
-    osal_retval_t ret = osal_binary_semaphore_timedwait(&(trace->sync_sem), timeout);
-    return ret;
+osal_uint64_t osal_trace_hist_get_count(osal_trace_hist_t *hist) {
+    assert(hist != NULL);
+
+    osal_uint64_t total = 0u;
+
+    for (osal_uint32_t i = 0u; i < hist->bucket_cnt; ++i) {
+        total += __atomic_load_n(&hist->counts[i], __ATOMIC_RELAXED);
+    }
+
+    return total;
 }
 
-//! \brief Analyze trace and return average and jitters.
+//! \brief Get minimum and maximum recorded value.
 /*!
- * \param[in]   trace   Pointer to trace struct.
- * \param[out]  avg     Return average time interval.
- * \param[out]  avg_jit Return average jitter (std-dev).
- * \param[out]  max_jit Return maximum jitter.
+ * \param[in]   hist    Pointer to histogram.
+ * \param[out]  min_val Return minimum value.
+ * \param[out]  max_val Return maximum value.
  *
  * \return N/A
  */
-void osal_trace_analyze(osal_trace_t *trace, osal_uint64_t *avg, osal_uint64_t *avg_jit, osal_uint64_t *max_jit) {
-    osal_trace_analyze_min_max(trace, avg, avg_jit, max_jit, NULL, NULL);
+void osal_trace_hist_get_min_max(osal_trace_hist_t *hist, osal_uint64_t *min_val, osal_uint64_t *max_val) {
+    assert(hist != NULL);
+    assert(min_val != NULL);
+    assert(max_val != NULL);
+
+    (*min_val) = __atomic_load_n(&hist->min_val, __ATOMIC_RELAXED);
+    (*max_val) = __atomic_load_n(&hist->max_val, __ATOMIC_RELAXED);
+
+    if ((*min_val) > (*max_val)) {
+        // nothing recorded yet
+        (*min_val) = 0u;
+        (*max_val) = 0u;
+    }
 }
 
-//! \brief Analyze trace and return average and jitters.
+//! \brief Add all counts of one histogram to another.
+/*!
+ * \param[in]   dst     Pointer to histogram to add to.
+ * \param[in]   src     Pointer to histogram to add.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_hist_merge(osal_trace_hist_t *dst, osal_trace_hist_t *src) {
+    assert(dst != NULL);
+    assert(src != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    if (dst->sub_bucket_bits != src->sub_bucket_bits) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        osal_uint64_t src_min = __atomic_load_n(&src->min_val, __ATOMIC_RELAXED);
+        osal_uint64_t src_max = __atomic_load_n(&src->max_val, __ATOMIC_RELAXED);
+        osal_uint64_t act;
+
+        for (osal_uint32_t i = 0u; i < dst->bucket_cnt; ++i) {
+            osal_uint64_t cnt = __atomic_load_n(&src->counts[i], __ATOMIC_RELAXED);
+            if (cnt != 0u) {
+                (void)__atomic_fetch_add(&dst->counts[i], cnt, __ATOMIC_RELAXED);
+            }
+        }
+
+        act = __atomic_load_n(&dst->min_val, __ATOMIC_RELAXED);
+        while ((src_min < act) && !__atomic_compare_exchange_n(&dst->min_val, &act, src_min, 
+                    0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+
+        act = __atomic_load_n(&dst->max_val, __ATOMIC_RELAXED);
+        while ((src_max > act) && !__atomic_compare_exchange_n(&dst->max_val, &act, src_max, 
+                    0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+    }
+
+    return ret;
+}
+
+//! \brief Attach histogram to trace.
 /*!
  * \param[in]   trace   Pointer to trace struct.
- * \param[out]  avg     Return average time interval.
- * \param[out]  avg_jit Return average jitter (std-dev).
- * \param[out]  max_jit Return maximum jitter.
- * \param[out]  min_val Return minimum interval value.
- * \param[out]  max_val Return maximum interval value.
+ * \param[in]   hist    Pointer to histogram, NULL to detach.
  *
  * \return N/A
  */
-void osal_trace_analyze_min_max(osal_trace_t *trace, osal_uint64_t *avg, osal_uint64_t *avg_jit, 
-        osal_uint64_t *max_jit, osal_uint64_t *min_val, osal_uint64_t *max_val)
-{
+void osal_trace_hist_attach(osal_trace_t *trace, osal_trace_hist_t *hist) {
     assert(trace != NULL);
-    assert(avg != NULL);
-    assert(avg_jit != NULL);
-    assert(max_jit != NULL);
 
-    (*avg)     = 0u;
-    (*avg_jit) = 0u;
-    (*max_jit) = 0u;
+    trace->hist          = hist;
+    trace->has_last_time = 0u;
+}
 
-    int act_buffer = trace->act_buf == 1 ? 0 : 1;
+//! \brief Allocate latency outlier trigger.
+/*!
+ * \param[out]  trig        Pointer to trigger* where allocated trigger is returned.
+ * \param[in]   threshold   Capture a snapshot if an interval (or value) is above.
+ * \param[in]   pre         Number of samples to capture before the triggering one.
+ * \param[in]   post        Number of samples to capture after the triggering one.
+ * \param[in]   slots       Number of snapshots kept until they are read.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_trigger_alloc(osal_trace_trigger_t **trig, osal_uint64_t threshold,
+        osal_uint32_t pre, osal_uint32_t post, osal_uint32_t slots) 
+{
+    assert(trig != NULL);
 
-    for (unsigned i = 0; i < (trace->cnt - 1u); ++i) {
-        trace->tmp[i] = trace->time_in_ns[act_buffer][i + 1u] - trace->time_in_ns[act_buffer][i];
-        (*avg) += trace->tmp[i];
+    osal_retval_t ret = OSAL_OK;
+    osal_uint64_t slot_len = (osal_uint64_t)pre + 1u + post;
 
-        if (i == 0) {
-            if (min_val) { *min_val = trace->tmp[i]; }
-            if (max_val) { *max_val = trace->tmp[i]; }
-        }
+    if ((slots == 0u) || (slot_len > 0xFFFFFFFFu)) {
+        return OSAL_ERR_INVALID_PARAM;
+    }
 
-        if (min_val && (*min_val > trace->tmp[i])) { *min_val = trace->tmp[i]; }
-        if (max_val && (*max_val < trace->tmp[i])) { *max_val = trace->tmp[i]; }
+    (*trig) = calloc(1u, sizeof(osal_trace_trigger_t));
+    if ((*trig) == NULL) {
+        return OSAL_ERR_OUT_OF_MEMORY;
     }
 
-    (*avg) /= (trace->cnt - 1u);
+    (*trig)->threshold  = threshold;
+    (*trig)->pre        = pre;
+    (*trig)->post       = post;
+    (*trig)->slot_cnt   = slots;
+    (*trig)->slot_len   = (osal_uint32_t)slot_len;
 
-    for (unsigned i = 0; i < (trace->cnt - 1u); ++i) {
-        osal_int64_t dev = (osal_int64_t)(*avg) - trace->tmp[i];
-        if (dev < 0) { dev *= -1; }
-        if ((osal_uint64_t)dev > (*max_jit)) { (*max_jit) = dev; }
+    (*trig)->history    = calloc(pre != 0u ? pre : 1u, sizeof(osal_uint64_t));
+    (*trig)->slots      = calloc(slots, sizeof(osal_trace_trigger_slot_t));
+    (*trig)->samples    = calloc((osal_size_t)slots * slot_len, sizeof(osal_uint64_t));
+
+    if (((*trig)->history == NULL) || ((*trig)->slots == NULL) || ((*trig)->samples == NULL)) {
+        ret = OSAL_ERR_OUT_OF_MEMORY;
+    } else {
+        ret = osal_binary_semaphore_init(&(*trig)->sync_sem, NULL);
+    }
 
-        (*avg_jit) += (dev * dev);
+    if (ret != OSAL_OK) {
+        free((*trig)->samples);
+        free((*trig)->slots);
+        free((*trig)->history);
+        free((*trig));
+        (*trig) = NULL;
     }
 
-    (*avg_jit) = sqrt((*avg_jit) / trace->cnt);
+    return ret;
 }
 
+//! \brief Free latency outlier trigger.
+/*!
+ * \param[in]   trig    Pointer to trigger.
+ *
+ * \return N/A
+ */
+void osal_trace_trigger_free(osal_trace_trigger_t *trig) {
+    assert(trig != NULL);
 
-//! \brief Analyze trace with relative timestamps and return average and jitters.
+    (void)osal_binary_semaphore_destroy(&trig->sync_sem);
+
+    free(trig->samples);
+    free(trig->slots);
+    free(trig->history);
+    free(trig);
+}
+
+//! \brief Attach latency outlier trigger to trace.
 /*!
  * \param[in]   trace   Pointer to trace struct.
- * \param[out]  avg     Return average time interval.
- * \param[out]  avg_jit Return average jitter (std-dev).
- * \param[out]  max_jit Return maximum jitter.
+ * \param[in]   trig    Pointer to trigger, NULL to detach.
  *
  * \return N/A
  */
-void osal_trace_analyze_rel(osal_trace_t *trace, osal_uint64_t *avg, osal_uint64_t *avg_jit, osal_uint64_t *max_jit) {
-    osal_trace_analyze_rel_min_max(trace, avg, avg_jit, max_jit, NULL, NULL);
+void osal_trace_trigger_attach(osal_trace_t *trace, osal_trace_trigger_t *trig) {
+    assert(trace != NULL);
+
+    trace->trigger       = trig;
+    trace->has_last_time = 0u;
 }
 
-//! \brief Analyze trace with relative timestamps and return average and jitters.
+//! \brief Change trigger threshold.
 /*!
- * \param[in]   trace   Pointer to trace struct.
- * \param[out]  avg     Return average time interval.
- * \param[out]  avg_jit Return average jitter (std-dev).
- * \param[out]  max_jit Return maximum jitter.
- * \param[out]  min_val Return minimum interval value.
- * \param[out]  max_val Return maximum interval value.
+ * \param[in]   trig        Pointer to trigger.
+ * \param[in]   threshold   New threshold.
  *
  * \return N/A
  */
-void osal_trace_analyze_rel_min_max(osal_trace_t *trace, osal_uint64_t *avg, osal_uint64_t *avg_jit, 
-        osal_uint64_t *max_jit, osal_uint64_t *min_val, osal_uint64_t *max_val)
+void osal_trace_trigger_set_threshold(osal_trace_trigger_t *trig, osal_uint64_t threshold) {
+    assert(trig != NULL);
+
+    __atomic_store_n(&trig->threshold, threshold, __ATOMIC_RELAXED);
+}
+
+//! \brief Wait for a completed snapshot.
+/*!
+ * \param[in]   trig    Pointer to trigger.
+ * \param[in]   timeout Timeout.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_trigger_timedwait(osal_trace_trigger_t *trig, osal_timer_t *timeout) {
+    assert(trig != NULL);
+
+    return osal_binary_semaphore_timedwait(&trig->sync_sem, timeout);
+}
+
+//! \brief Wait for a completed snapshot until a deadline in nanoseconds.
+/*!
+ * \param[in]   trig        Pointer to trigger.
+ * \param[in]   deadline_ns Absolute timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_trigger_wait_until_ns(osal_trace_trigger_t *trig, osal_uint64_t deadline_ns) {
+    assert(trig != NULL);
+
+    return osal_binary_semaphore_wait_until_ns(&trig->sync_sem, deadline_ns);
+}
+
+//! \brief Read oldest unread snapshot.
+/*!
+ * \param[in]   trig    Pointer to trigger.
+ * \param[out]  snap    Returns snapshot information.
+ * \param[out]  buf     Buffer receiving the captured times.
+ * \param[in]   buf_cnt Size of \p buf.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_trace_trigger_read(osal_trace_trigger_t *trig, osal_trace_snapshot_t *snap,
+        osal_uint64_t *buf, osal_uint32_t buf_cnt) 
 {
-    assert(trace != NULL);
-    assert(avg != NULL);
-    assert(avg_jit != NULL);
-    assert(max_jit != NULL);
+    assert(trig != NULL);
+    assert(snap != NULL);
+    assert(buf != NULL);
 
-    (*avg)     = 0u;
-    (*avg_jit) = 0u;
-    (*max_jit) = 0u;
+    osal_retval_t ret = OSAL_ERR_NO_DATA;
+    osal_uint64_t lost = 0u;
 
-    int act_buffer = trace->act_buf == 1 ? 0 : 1;
+    if (buf_cnt < trig->slot_len) {
+        return OSAL_ERR_INVALID_PARAM;
+    }
 
-    for (unsigned i = 0; i < trace->cnt; ++i) {
-        (*avg) += trace->time_in_ns[act_buffer][i];
-        
-        if (i == 0) {
-            if (min_val) { *min_val = trace->time_in_ns[act_buffer][i]; }
-            if (max_val) { *max_val = trace->time_in_ns[act_buffer][i]; }
+    while (ret == OSAL_ERR_NO_DATA) {
+        osal_uint64_t completed = __atomic_load_n(&trig->completed, __ATOMIC_ACQUIRE);
+        osal_uint64_t next = trig->read_cnt + 1u;
+
+        if (next > completed) {
+            break;
         }
 
-        if (min_val && (*min_val > trace->time_in_ns[act_buffer][i])) { *min_val = trace->time_in_ns[act_buffer][i]; }
-        if (max_val && (*max_val < trace->time_in_ns[act_buffer][i])) { *max_val = trace->time_in_ns[act_buffer][i]; }
-    }
+        if ((completed - trig->read_cnt) > trig->slot_cnt) {
+            // oldest unread snapshots were already overwritten
+            lost += completed - trig->slot_cnt - trig->read_cnt;
+            trig->read_cnt = completed - trig->slot_cnt;
+            continue;
+        }
+
+        osal_uint32_t idx = (osal_uint32_t)((next - 1u) % trig->slot_cnt);
+        const osal_trace_trigger_slot_t *slot = &trig->slots[idx];
+        osal_uint64_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+
+        if (seq == next) {
+            snap->value       = slot->value;
+            snap->cnt         = slot->cnt;
+            snap->trigger_pos = slot->trigger_pos;
+
+            if (snap->cnt <= trig->slot_len) {
+                memcpy(buf, &trig->samples[(osal_size_t)idx * trig->slot_len], snap->cnt * sizeof(osal_uint64_t));
+            }
 
-    (*avg) /= trace->cnt;
+            // a new capture may have reused the slot while copying
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if ((__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == next) && (snap->cnt <= trig->slot_len)) {
+                snap->seq = next;
+                ret = OSAL_OK;
+            }
+        }
 
-    for (unsigned i = 0; i < trace->cnt; ++i) {
-        osal_int64_t dev = (osal_int64_t)(*avg) - trace->time_in_ns[act_buffer][i];
-        if (dev < 0) { dev *= -1; }
-        if ((osal_uint64_t)dev > (*max_jit)) { (*max_jit) = dev; }
+        if (ret != OSAL_OK) {
+            lost++;
+        }
 
-        (*avg_jit) += (dev * dev);
+        trig->read_cnt = next;
     }
 
-    (*avg_jit) = sqrt((*avg_jit) / trace->cnt);
+    snap->lost = lost;
+    return ret;
 }
@@ -115,6 +115,32 @@ osal_retval_t osal_binary_semaphore_timedwait(osal_binary_semaphore_t *sem, cons
     return ret;
 }
 
+//! \brief Wait for a binary_semaphore until a deadline in nanoseconds.
+/*!
+ * \param[in]   sem         Pointer to osal binary_semaphore structure. Content is OS dependent.
+ * \param[in]   deadline_ns Absolute timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_binary_semaphore_wait_until_ns(osal_binary_semaphore_t *sem, osal_uint64_t deadline_ns) {
+    osal_timer_t to;
+    to.sec = deadline_ns / NSEC_PER_SEC;
+    to.nsec = deadline_ns % NSEC_PER_SEC;
+
+    return osal_binary_semaphore_timedwait(sem, &to);
+}
+
+//! \brief Wait for a binary_semaphore for a time in nanoseconds.
+/*!
+ * \param[in]   sem         Pointer to osal binary_semaphore structure. Content is OS dependent.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_binary_semaphore_wait_for_ns(osal_binary_semaphore_t *sem, osal_uint64_t rel_ns) {
+    return osal_binary_semaphore_wait_until_ns(sem, osal_timer_gettime_nsec() + rel_ns);
+}
+
 //! \brief Destroys a binary_semaphore.
 /*!
  * \param[in]   sem     Pointer to osal binary_semaphore structure. Content is OS dependent.
@@ -0,0 +1,121 @@
+/**
+ * \file vxworks/mem.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 18 Oct 2026
+ *
+ * \brief OSAL mem vxworks source.
+ *
+ * OSAL mem vxworks source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <libosal/mem.h>
+#include <libosal/osal.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+//! Bookkeeping in front of every allocation, keeps returned memory cache line aligned.
+#define OSAL_MEM_HEADER_SIZE            64u
+
+//! \brief Allocate realtime memory.
+/*!
+ * VxWorks does not page task memory, attributes are ignored.
+ *
+ * \param[out]  ptr     Returns pointer to allocated memory.
+ * \param[in]   size    Size in bytes.
+ * \param[in]   attr    Pointer to memory attributes. Can be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_alloc(osal_void_t **ptr, osal_size_t size, const osal_mem_attr_t *attr) {
+    assert(ptr != NULL);
+    (void)attr;
+
+    osal_retval_t ret = OSAL_OK;
+    osal_uint8_t *base;
+
+    if (size == 0u) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        base = malloc(size + OSAL_MEM_HEADER_SIZE);
+        if (base == NULL) {
+            ret = OSAL_ERR_OUT_OF_MEMORY;
+        } else {
+            memset(base, 0, size + OSAL_MEM_HEADER_SIZE);
+            (*ptr) = base + OSAL_MEM_HEADER_SIZE;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Free realtime memory.
+/*!
+ * \param[in]   ptr     Pointer returned by \ref osal_mem_alloc.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_free(osal_void_t *ptr) {
+    assert(ptr != NULL);
+
+    free((osal_uint8_t *)ptr - OSAL_MEM_HEADER_SIZE);
+
+    return OSAL_OK;
+}
+
+//! \brief Prepare existing memory for realtime use.
+/*!
+ * VxWorks does not page task memory, nothing to do.
+ *
+ * \param[in]   ptr     Start of memory region.
+ * \param[in]   size    Size in bytes.
+ * \param[in]   attr    Pointer to memory attributes. Can be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_prepare(osal_void_t *ptr, osal_size_t size, const osal_mem_attr_t *attr) {
+    assert(ptr != NULL);
+    (void)size;
+    (void)attr;
+
+    return OSAL_OK;
+}
+
+//! \brief Lock all memory of the process.
+/*!
+ * VxWorks does not page task memory, nothing to do.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_lock_all(void) {
+    return OSAL_OK;
+}
+
+//! \brief Unlock all memory of the process.
+/*!
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mem_unlock_all(void) {
+    return OSAL_OK;
+}
@@ -112,6 +112,32 @@ int osal_semaphore_timedwait(osal_semaphore_t *sem, osal_timer_t *to) {
     return ret;
 }
 
+//! \brief Wait for a semaphore until a deadline in nanoseconds.
+/*!
+ * \param[in]   sem         Pointer to osal semaphore structure. Content is OS dependent.
+ * \param[in]   deadline_ns Absolute timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_semaphore_wait_until_ns(osal_semaphore_t *sem, osal_uint64_t deadline_ns) {
+    osal_timer_t to;
+    to.sec = deadline_ns / NSEC_PER_SEC;
+    to.nsec = deadline_ns % NSEC_PER_SEC;
+
+    return osal_semaphore_timedwait(sem, &to);
+}
+
+//! \brief Wait for a semaphore for a time in nanoseconds.
+/*!
+ * \param[in]   sem         Pointer to osal semaphore structure. Content is OS dependent.
+ * \param[in]   rel_ns      Relative timeout in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_semaphore_wait_for_ns(osal_semaphore_t *sem, osal_uint64_t rel_ns) {
+    return osal_semaphore_wait_until_ns(sem, osal_timer_gettime_nsec() + rel_ns);
+}
+
 //! \brief Destroys a semaphore.
 /*!
  * \param[in]   sem     Pointer to osal semaphore structure. Content is OS dependent.
@@ -0,0 +1,106 @@
+/**
+ * \file vxworks/shm.c
+ *
+ * \author agent <agent@local>
+ *
+ * \date 18 Oct 2026
+ *
+ * \brief OSAL shm vxworks source.
+ *
+ * OSAL shm vxworks source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <libosal/shm.h>
+#include <libosal/osal.h>
+
+#include <assert.h>
+
+//! \brief Initialize a shm.
+/*!
+ * \param[in]   shm     Pointer to osal shm structure. Content is OS dependent.
+ * \param[in]   name    Shared memory name.
+ * \param[in]   attr    Pointer to initial shm attributes. Can be NULL.
+ * \param[in]   size    Size for shm creation.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_open(osal_shm_t *shm, const osal_char_t *name,  const osal_shm_attr_t *attr, const osal_size_t size) {
+    assert(shm != NULL);
+    assert(name != NULL);
+    (void)attr;
+    (void)size;
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Map a shm.
+/*!
+ * \param[in]   shm     Pointer to osal shm structure. Content is OS dependent.
+ * \param[in]   attr    Pointer to map attributes.
+ * \param[out]  ptr     Pointer where to returned mapped data pointer.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_map(osal_shm_t *shm, const osal_shm_map_attr_t *attr, osal_void_t **ptr) {
+    assert(shm != NULL);
+    assert(ptr != NULL);
+    (void)attr;
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Closes an open shm.
+/*!
+ * \param[in]   shm     Pointer to osal shm structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_close(osal_shm_t *shm) {
+    assert(shm != NULL);
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Unmap a shm.
+/*!
+ * \param[in]   shm     Pointer to osal shm structure. Content is OS dependent.
+ * \param[in]   ptr     Pointer returned by \ref osal_shm_map.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_unmap(osal_shm_t *shm, osal_void_t *ptr) {
+    assert(shm != NULL);
+    (void)ptr;
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Remove a shm name.
+/*!
+ * \param[in]   name    Shared memory name.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_shm_unlink(const osal_char_t *name) {
+    assert(name != NULL);
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
@@ -69,3 +69,78 @@ int osal_task_create(osal_task_t *hdl, const osal_task_attr_t *attr,
     return OSAL_OK;
 }
 
+//! \brief Set earliest deadline first scheduling for the specified thread.
+/*!
+ * \param[in]   hdl         Pointer to osal task structure. Content is OS dependent.
+ * \param[in]   runtime     Runtime per period in [ns].
+ * \param[in]   deadline    Relative deadline in [ns].
+ * \param[in]   period      Period in [ns].
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_set_deadline(osal_task_t *hdl, osal_uint64_t runtime,
+                                        osal_uint64_t deadline, osal_uint64_t period)
+{
+    (void)hdl;
+    (void)runtime;
+    (void)deadline;
+    (void)period;
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Get the result of applying the scheduling attributes at task creation.
+/*!
+ * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
+ * \param[out]  status  Returns first error applying the attributes.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_get_sched_status(osal_task_t *hdl, osal_retval_t *status) {
+    (void)hdl;
+    (void)status;
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Change the affinity of the specified thread to a CPU set.
+/*!
+ * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
+ * \param[in]   cpuset  CPUs the thread may run on.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_set_cpuset(osal_task_t *hdl, const osal_cpuset_t *cpuset) {
+    (void)hdl;
+    (void)cpuset;
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Get the affinity of the specified thread as CPU set.
+/*!
+ * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
+ * \param[out]  cpuset  CPUs the thread may run on.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_get_cpuset(osal_task_t *hdl, osal_cpuset_t *cpuset) {
+    (void)hdl;
+    (void)cpuset;
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! \brief Get runtime statistics of a created thread.
+/*!
+ * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
+ * \param[out]  stats   Returns the statistics.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_get_stats(osal_task_t *hdl, osal_task_stats_t *stats) {
+    (void)hdl;
+    (void)stats;
+
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
@@ -56,6 +56,26 @@ void osal_sleep(osal_int64_t nsec) {
     }
 }
 
+// Sleep until current time equals nsec value
+osal_retval_t osal_sleep_until_nsec(osal_uint64_t nsec) {
+    osal_uint64_t now = (osal_uint64_t)osal_timer_gettime_nsec();
+
+    // relative sleeps, repeated in case the clock was adjusted meanwhile
+    while (now < nsec) {
+        osal_sleep((osal_int64_t)(nsec - now));
+        now = (osal_uint64_t)osal_timer_gettime_nsec();
+    }
+
+    return OSAL_OK;
+}
+
+// Sleep until timer expired.
+osal_retval_t osal_sleep_until(osal_timer_t *timer) {
+    assert(timer != NULL);
+
+    return osal_sleep_until_nsec(((osal_uint64_t)timer->sec * NSEC_PER_SEC) + (osal_uint64_t)timer->nsec);
+}
+
 //! Sets globally the internal clock source
 void osal_timer_set_clock_source(int clock_id) { global_clock_id = clock_id; }
 
@@ -64,6 +84,21 @@ int osal_timer_get_clock_source(){
     return global_clock_id;
 }
 
+//! Enables the CPU timestamp counter as fast time source. Not supported on VxWorks
+osal_retval_t osal_timer_tsc_enable(osal_uint64_t calibration_time) {
+    (void)calibration_time;
+    return OSAL_ERR_NOT_IMPLEMENTED;
+}
+
+//! Disables the CPU timestamp counter as time source. Not supported on VxWorks
+void osal_timer_tsc_disable(void) {
+}
+
+//! Returns the calibrated timestamp counter frequency. Not supported on VxWorks
+osal_uint64_t osal_timer_tsc_get_frequency(void) {
+    return 0u;
+}
+
 //! gets timer 
 int osal_timer_gettime(osal_timer_t *timer) {
     assert(timer != NULL);
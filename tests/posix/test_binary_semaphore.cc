@@ -1258,6 +1258,88 @@ TEST(BinarySemaphoreFunction, TryCount) {
 }
 } // namespace trywait
 
+namespace clock_attr {
+
+using testutils::elapsed_monotonic_ns;
+using testutils::gettime_ns;
+using testutils::set_deadline_clock;
+
+/* timeouts are interpreted on the clock selected in the attributes, a
+   deadline passed on the wrong clock would expire immediately or after
+   decades. */
+const long CLOCK_TIMEOUT_NS = 10000000;   /* 10 ms */
+const long CLOCK_TIMEOUT_MAX = 1000000000; /* 1 s */
+
+typedef struct {
+  osal_uint32_t attr;
+  clockid_t clock_id;
+} clock_case_t;
+
+TEST(BinarySemaphoreFunction, ClockAttr) {
+  const clock_case_t cases[] = {
+      {OSAL_BINARY_SEMAPHORE_ATTR__CLOCK__REALTIME, CLOCK_REALTIME},
+      {OSAL_BINARY_SEMAPHORE_ATTR__CLOCK__MONOTONIC, CLOCK_MONOTONIC},
+  };
+
+  for (const clock_case_t &c : cases) {
+    osal_binary_semaphore_t sema;
+    osal_binary_semaphore_attr_t attr = c.attr;
+    ASSERT_EQ(osal_binary_semaphore_init(&sema, &attr), OSAL_OK);
+
+    timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    osal_timer_t deadline = set_deadline_clock(c.clock_id, 0, CLOCK_TIMEOUT_NS);
+    EXPECT_EQ(osal_binary_semaphore_timedwait(&sema, &deadline), OSAL_ERR_TIMEOUT);
+    long elapsed = elapsed_monotonic_ns(start);
+    EXPECT_GE(elapsed, CLOCK_TIMEOUT_NS) << "attr " << c.attr;
+    EXPECT_LT(elapsed, CLOCK_TIMEOUT_MAX) << "attr " << c.attr;
+
+    ASSERT_EQ(osal_binary_semaphore_post(&sema), OSAL_OK);
+    deadline = set_deadline_clock(c.clock_id, 0, CLOCK_TIMEOUT_NS);
+    EXPECT_EQ(osal_binary_semaphore_timedwait(&sema, &deadline), OSAL_OK);
+
+    EXPECT_EQ(osal_binary_semaphore_destroy(&sema), OSAL_OK);
+  }
+}
+
+TEST(BinarySemaphoreFunction, NanosecondTimeouts) {
+  const clock_case_t cases[] = {
+      {OSAL_BINARY_SEMAPHORE_ATTR__CLOCK__REALTIME, CLOCK_REALTIME},
+      {OSAL_BINARY_SEMAPHORE_ATTR__CLOCK__MONOTONIC, CLOCK_MONOTONIC},
+  };
+
+  for (const clock_case_t &c : cases) {
+    osal_binary_semaphore_t sema;
+    osal_binary_semaphore_attr_t attr = c.attr;
+    ASSERT_EQ(osal_binary_semaphore_init(&sema, &attr), OSAL_OK);
+
+    timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    EXPECT_EQ(osal_binary_semaphore_wait_until_ns(
+                  &sema, gettime_ns(c.clock_id) + CLOCK_TIMEOUT_NS),
+              OSAL_ERR_TIMEOUT);
+    long elapsed = elapsed_monotonic_ns(start);
+    EXPECT_GE(elapsed, CLOCK_TIMEOUT_NS) << "attr " << c.attr;
+    EXPECT_LT(elapsed, CLOCK_TIMEOUT_MAX) << "attr " << c.attr;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    EXPECT_EQ(osal_binary_semaphore_wait_for_ns(&sema, CLOCK_TIMEOUT_NS),
+              OSAL_ERR_TIMEOUT);
+    elapsed = elapsed_monotonic_ns(start);
+    EXPECT_GE(elapsed, CLOCK_TIMEOUT_NS) << "attr " << c.attr;
+    EXPECT_LT(elapsed, CLOCK_TIMEOUT_MAX) << "attr " << c.attr;
+
+    ASSERT_EQ(osal_binary_semaphore_post(&sema), OSAL_OK);
+    EXPECT_EQ(osal_binary_semaphore_wait_for_ns(&sema, CLOCK_TIMEOUT_NS), OSAL_OK);
+    ASSERT_EQ(osal_binary_semaphore_post(&sema), OSAL_OK);
+    EXPECT_EQ(osal_binary_semaphore_wait_until_ns(&sema, 0), OSAL_OK);
+
+    EXPECT_EQ(osal_binary_semaphore_destroy(&sema), OSAL_OK);
+  }
+}
+
+} // namespace clock_attr
+
 } // namespace test_semaphore
 
 int main(int argc, char **argv) {
@@ -799,6 +799,106 @@ TEST(CondvarFunction, ParallelWait) {
 }
 } // namespace condvar_timedwait
 
+namespace clock_attr {
+
+using testutils::elapsed_monotonic_ns;
+using testutils::gettime_ns;
+using testutils::set_deadline_clock;
+
+/* timeouts are interpreted on the clock selected in the attributes, a
+   deadline passed on the wrong clock would expire immediately or after
+   decades. */
+const long CLOCK_TIMEOUT_NS = 10000000;   /* 10 ms */
+const long CLOCK_TIMEOUT_MAX = 1000000000; /* 1 s */
+
+typedef struct {
+  osal_uint32_t attr;
+  clockid_t clock_id;
+} clock_case_t;
+
+TEST(CondvarFunction, ClockAttr) {
+  const clock_case_t cases[] = {
+      {OSAL_CONDVAR_ATTR__CLOCK__REALTIME, CLOCK_REALTIME},
+      {OSAL_CONDVAR_ATTR__CLOCK__MONOTONIC, CLOCK_MONOTONIC},
+  };
+
+  osal_mutex_t mutex;
+  ASSERT_EQ(osal_mutex_init(&mutex, nullptr), OSAL_OK);
+
+  for (const clock_case_t &c : cases) {
+    osal_condvar_t condvar;
+    osal_condvar_attr_t attr = c.attr;
+    ASSERT_EQ(osal_condvar_init(&condvar, &attr), OSAL_OK);
+
+    ASSERT_EQ(osal_mutex_lock(&mutex), OSAL_OK);
+    timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    osal_timer_t deadline = set_deadline_clock(c.clock_id, 0, CLOCK_TIMEOUT_NS);
+    osal_retval_t orv;
+    do {
+      // spurious wakeups are allowed
+      orv = osal_condvar_timedwait(&condvar, &mutex, &deadline);
+    } while (orv == OSAL_OK);
+    EXPECT_EQ(orv, OSAL_ERR_TIMEOUT);
+    long elapsed = elapsed_monotonic_ns(start);
+    ASSERT_EQ(osal_mutex_unlock(&mutex), OSAL_OK);
+
+    EXPECT_GE(elapsed, CLOCK_TIMEOUT_NS) << "attr " << c.attr;
+    EXPECT_LT(elapsed, CLOCK_TIMEOUT_MAX) << "attr " << c.attr;
+
+    EXPECT_EQ(osal_condvar_destroy(&condvar), OSAL_OK);
+  }
+
+  EXPECT_EQ(osal_mutex_destroy(&mutex), OSAL_OK);
+}
+
+TEST(CondvarFunction, NanosecondTimeouts) {
+  const clock_case_t cases[] = {
+      {OSAL_CONDVAR_ATTR__CLOCK__REALTIME, CLOCK_REALTIME},
+      {OSAL_CONDVAR_ATTR__CLOCK__MONOTONIC, CLOCK_MONOTONIC},
+  };
+
+  osal_mutex_t mutex;
+  ASSERT_EQ(osal_mutex_init(&mutex, nullptr), OSAL_OK);
+
+  for (const clock_case_t &c : cases) {
+    osal_condvar_t condvar;
+    osal_condvar_attr_t attr = c.attr;
+    ASSERT_EQ(osal_condvar_init(&condvar, &attr), OSAL_OK);
+
+    ASSERT_EQ(osal_mutex_lock(&mutex), OSAL_OK);
+    timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    osal_uint64_t deadline = gettime_ns(c.clock_id) + CLOCK_TIMEOUT_NS;
+    osal_retval_t orv;
+    do {
+      orv = osal_condvar_wait_until_ns(&condvar, &mutex, deadline);
+    } while (orv == OSAL_OK);
+    EXPECT_EQ(orv, OSAL_ERR_TIMEOUT);
+    long elapsed = elapsed_monotonic_ns(start);
+    EXPECT_GE(elapsed, CLOCK_TIMEOUT_NS) << "attr " << c.attr;
+    EXPECT_LT(elapsed, CLOCK_TIMEOUT_MAX) << "attr " << c.attr;
+
+    // a spurious wakeup may return early, but never with a timeout
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    orv = osal_condvar_wait_for_ns(&condvar, &mutex, CLOCK_TIMEOUT_NS);
+    elapsed = elapsed_monotonic_ns(start);
+    if (orv == OSAL_ERR_TIMEOUT) {
+      EXPECT_GE(elapsed, CLOCK_TIMEOUT_NS) << "attr " << c.attr;
+    } else {
+      EXPECT_EQ(orv, OSAL_OK);
+    }
+    EXPECT_LT(elapsed, CLOCK_TIMEOUT_MAX) << "attr " << c.attr;
+    ASSERT_EQ(osal_mutex_unlock(&mutex), OSAL_OK);
+
+    EXPECT_EQ(osal_condvar_destroy(&condvar), OSAL_OK);
+  }
+
+  EXPECT_EQ(osal_mutex_destroy(&mutex), OSAL_OK);
+}
+
+} // namespace clock_attr
+
 } // namespace test_condvar
 
 int main(int argc, char **argv) {
@@ -0,0 +1,229 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <vector>
+
+#include "libosal/executor.h"
+#include "libosal/osal.h"
+#include "test_utils.h"
+
+namespace test_executor {
+
+using testutils::wait_nanoseconds;
+
+static void count_job(osal_void_t *arg) { (*(std::atomic<int> *)arg)++; }
+
+TEST(ExecutorFunction, ManyJobs) {
+  osal_executor_attr_t attr = {};
+  attr.workers = 4;
+  osal_executor_t exec;
+  ASSERT_EQ(osal_executor_init(&exec, &attr), OSAL_OK);
+
+  const int cnt = 100000;
+  std::atomic<int> done(0);
+  std::vector<osal_executor_job_t> jobs(cnt);
+  osal_executor_wg_t wg;
+  ASSERT_EQ(osal_executor_wg_init(&wg), OSAL_OK);
+
+  for (int i = 0; i < cnt; ++i) {
+    osal_executor_job_init(&jobs[i], count_job, &done);
+    ASSERT_EQ(osal_executor_submit(&exec, &jobs[i], &wg), OSAL_OK);
+  }
+
+  EXPECT_EQ(osal_executor_wg_wait(&exec, &wg), OSAL_OK);
+  EXPECT_EQ(done, cnt);
+  EXPECT_EQ(osal_executor_wg_destroy(&wg), OSAL_OK);
+
+  // wait groups can be reused
+  ASSERT_EQ(osal_executor_wg_init(&wg), OSAL_OK);
+  osal_executor_job_init(&jobs[0], count_job, &done);
+  ASSERT_EQ(osal_executor_submit(&exec, &jobs[0], &wg), OSAL_OK);
+  EXPECT_EQ(osal_executor_wg_wait(&exec, &wg), OSAL_OK);
+  EXPECT_EQ(done, cnt + 1);
+  EXPECT_EQ(osal_executor_wg_destroy(&wg), OSAL_OK);
+
+  EXPECT_EQ(osal_executor_destroy(&exec), OSAL_OK);
+}
+
+typedef struct {
+  osal_executor_t *exec;
+  int n;
+  long result;
+} fib_t;
+
+// every job forks two jobs and waits for them, only works if waiting
+// workers run other jobs
+static void fib_job(osal_void_t *arg) {
+  fib_t *f = (fib_t *)arg;
+
+  if (f->n < 2) {
+    f->result = f->n;
+    return;
+  }
+
+  fib_t a = {f->exec, f->n - 1, 0};
+  fib_t b = {f->exec, f->n - 2, 0};
+  osal_executor_job_t ja, jb;
+  osal_executor_wg_t wg;
+
+  ASSERT_EQ(osal_executor_wg_init(&wg), OSAL_OK);
+  osal_executor_job_init(&ja, fib_job, &a);
+  osal_executor_job_init(&jb, fib_job, &b);
+  osal_executor_submit(f->exec, &ja, &wg);
+  osal_executor_submit(f->exec, &jb, &wg);
+  osal_executor_wg_wait(f->exec, &wg);
+  osal_executor_wg_destroy(&wg);
+
+  f->result = a.result + b.result;
+}
+
+TEST(ExecutorFunction, NestedWait) {
+  osal_executor_attr_t attr = {};
+  attr.workers = 4;
+  osal_executor_t exec;
+  ASSERT_EQ(osal_executor_init(&exec, &attr), OSAL_OK);
+
+  fib_t f = {&exec, 20, 0};
+  osal_executor_job_t job;
+  osal_executor_wg_t wg;
+  ASSERT_EQ(osal_executor_wg_init(&wg), OSAL_OK);
+  osal_executor_job_init(&job, fib_job, &f);
+  ASSERT_EQ(osal_executor_submit(&exec, &job, &wg), OSAL_OK);
+  EXPECT_EQ(osal_executor_wg_wait(&exec, &wg), OSAL_OK);
+  EXPECT_EQ(f.result, 6765);
+
+  EXPECT_EQ(osal_executor_wg_destroy(&wg), OSAL_OK);
+  EXPECT_EQ(osal_executor_destroy(&exec), OSAL_OK);
+}
+
+typedef struct {
+  osal_executor_t *exec;
+  std::vector<osal_executor_job_t> jobs;
+  osal_executor_wg_t *wg;
+  std::mutex lock;
+  std::set<long> tids;
+  std::atomic<int> done;
+} spawn_t;
+
+static void record_job(osal_void_t *arg) {
+  spawn_t *s = (spawn_t *)arg;
+  wait_nanoseconds(10000);
+
+  std::lock_guard<std::mutex> guard(s->lock);
+  s->tids.insert(syscall(SYS_gettid));
+  s->done++;
+}
+
+// submits all jobs to the deque of one worker
+static void spawn_job(osal_void_t *arg) {
+  spawn_t *s = (spawn_t *)arg;
+
+  for (auto &job : s->jobs) {
+    osal_executor_job_init(&job, record_job, s);
+    osal_executor_submit(s->exec, &job, s->wg);
+  }
+}
+
+static void run_spawn(osal_uint32_t workers, osal_uint32_t deque_size,
+                      size_t cnt, spawn_t *s) {
+  osal_executor_attr_t attr = {};
+  attr.workers = workers;
+  attr.deque_size = deque_size;
+  osal_executor_t exec;
+  ASSERT_EQ(osal_executor_init(&exec, &attr), OSAL_OK);
+
+  osal_executor_wg_t wg;
+  ASSERT_EQ(osal_executor_wg_init(&wg), OSAL_OK);
+  s->exec = &exec;
+  s->wg = &wg;
+  s->jobs.resize(cnt);
+  s->done = 0;
+
+  osal_executor_job_t job;
+  osal_executor_job_init(&job, spawn_job, s);
+  ASSERT_EQ(osal_executor_submit(&exec, &job, &wg), OSAL_OK);
+  EXPECT_EQ(osal_executor_wg_wait(&exec, &wg), OSAL_OK);
+
+  EXPECT_EQ(osal_executor_wg_destroy(&wg), OSAL_OK);
+  EXPECT_EQ(osal_executor_destroy(&exec), OSAL_OK);
+}
+
+TEST(ExecutorFunction, Stealing) {
+  spawn_t s;
+  run_spawn(4, 0, 2000, &s);
+
+  EXPECT_EQ(s.done, 2000);
+  EXPECT_GT(s.tids.size(), 1u) << "no jobs were stolen";
+}
+
+TEST(ExecutorFunction, DequeOverflow) {
+  // jobs not fitting into the deque go to the injection queue
+  spawn_t s;
+  run_spawn(2, 4, 500, &s);
+
+  EXPECT_EQ(s.done, 500);
+}
+
+TEST(ExecutorConfig, WorkerAttributes) {
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+  osal_task_attr_t worker_attr[2] = {};
+  worker_attr[0].affinity = 0x1;
+  worker_attr[1].affinity = cpus > 1 ? 0x2 : 0x1;
+  osal_executor_attr_t attr = {};
+  attr.workers = 2;
+  attr.worker_attr = worker_attr;
+
+  osal_executor_t exec;
+  ASSERT_EQ(osal_executor_init(&exec, &attr), OSAL_OK);
+
+  for (osal_uint32_t i = 0; i < 2; ++i) {
+    osal_task_sched_affinity_t affinity;
+    EXPECT_EQ(osal_task_get_affinity(&exec.workers[i].task, &affinity),
+              OSAL_OK);
+    EXPECT_EQ(affinity, worker_attr[i].affinity);
+
+    char name[16];
+    pthread_getname_np(exec.workers[i].task.tid, name, sizeof(name));
+    EXPECT_EQ(std::string(name), "osal-exec" + std::to_string(i));
+  }
+
+  EXPECT_EQ(osal_executor_destroy(&exec), OSAL_OK);
+}
+
+TEST(ExecutorDetect, WaitGroupBusy) {
+  osal_executor_attr_t attr = {};
+  attr.workers = 1;
+  osal_executor_t exec;
+  ASSERT_EQ(osal_executor_init(&exec, &attr), OSAL_OK);
+
+  osal_executor_wg_t wg;
+  ASSERT_EQ(osal_executor_wg_init(&wg), OSAL_OK);
+
+  spawn_t s;
+  s.done = 0;
+  osal_executor_job_t job;
+  osal_executor_job_init(&job, record_job, &s);
+
+  // lock keeps the job from finishing
+  s.lock.lock();
+  ASSERT_EQ(osal_executor_submit(&exec, &job, &wg), OSAL_OK);
+  EXPECT_EQ(osal_executor_wg_destroy(&wg), OSAL_ERR_BUSY);
+  s.lock.unlock();
+
+  EXPECT_EQ(osal_executor_wg_wait(&exec, &wg), OSAL_OK);
+  EXPECT_EQ(s.done, 1);
+  EXPECT_EQ(osal_executor_wg_destroy(&wg), OSAL_OK);
+  EXPECT_EQ(osal_executor_destroy(&exec), OSAL_OK);
+}
+
+} // namespace test_executor
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,326 @@
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+#include "libosal/fiber.h"
+#include "libosal/osal.h"
+
+namespace test_fiber {
+
+typedef struct {
+  std::string *trace;
+  char name;
+  int rounds;
+} pingpong_t;
+
+static void pingpong(osal_void_t *arg) {
+  pingpong_t *p = (pingpong_t *)arg;
+
+  for (int i = 0; i < p->rounds; ++i) {
+    *p->trace += p->name + std::to_string(i);
+    ASSERT_EQ(osal_fiber_yield(), OSAL_OK);
+  }
+}
+
+TEST(FiberFunction, PingPong) {
+  osal_fiber_sched_t sched;
+  ASSERT_EQ(osal_fiber_sched_init(&sched, nullptr), OSAL_OK);
+
+  std::string trace;
+  pingpong_t a = {&trace, 'a', 3};
+  pingpong_t b = {&trace, 'b', 3};
+  osal_fiber_t fa, fb;
+  ASSERT_EQ(osal_fiber_create(&sched, &fa, pingpong, &a), OSAL_OK);
+  ASSERT_EQ(osal_fiber_create(&sched, &fb, pingpong, &b), OSAL_OK);
+
+  ASSERT_EQ(osal_fiber_sched_run(&sched), OSAL_OK);
+  EXPECT_EQ(trace, "a0b0a1b1a2b2");
+  EXPECT_EQ(fa.state, OSAL_FIBER_STATE_DONE);
+  EXPECT_EQ(osal_fiber_self(), nullptr);
+
+  EXPECT_EQ(osal_fiber_sched_destroy(&sched), OSAL_OK);
+}
+
+typedef struct spawn {
+  osal_fiber_sched_t *sched;
+  osal_fiber_t fiber;
+  struct spawn *child;
+  int *sum;
+} spawn_t;
+
+static void count(osal_void_t *arg) {
+  int *cnt = (int *)arg;
+
+  for (int i = 0; i < 10; ++i) {
+    // keeps a value in a callee-saved register across switches
+    int before = *cnt;
+    osal_fiber_yield();
+    *cnt = before + 1;
+  }
+}
+
+TEST(FiberFunction, Many) {
+  osal_fiber_sched_attr_t attr = {};
+  attr.stack_size = 16 * 1024;
+  attr.max_fibers = 2000;
+  osal_fiber_sched_t sched;
+  ASSERT_EQ(osal_fiber_sched_init(&sched, &attr), OSAL_OK);
+
+  std::vector<osal_fiber_t> fibers(2000);
+  std::vector<int> counts(2000, 0);
+  for (size_t i = 0; i < fibers.size(); ++i) {
+    ASSERT_EQ(osal_fiber_create(&sched, &fibers[i], count, &counts[i]),
+              OSAL_OK);
+  }
+
+  osal_uint64_t start = osal_timer_gettime_nsec();
+  ASSERT_EQ(osal_fiber_sched_run(&sched), OSAL_OK);
+  osal_uint64_t duration = osal_timer_gettime_nsec() - start;
+
+  for (int cnt : counts) {
+    ASSERT_EQ(cnt, 10);
+  }
+
+  EXPECT_EQ(sched.switches, 2000u * 11u);
+  printf("%.1f ns per switch\n", (double)duration / (double)sched.switches);
+
+  EXPECT_EQ(osal_fiber_sched_destroy(&sched), OSAL_OK);
+}
+
+static void spawn(osal_void_t *arg) {
+  spawn_t *s = (spawn_t *)arg;
+
+  (*s->sum)++;
+  if (s->child != nullptr) {
+    ASSERT_EQ(osal_fiber_create(s->sched, &s->child->fiber, spawn, s->child),
+              OSAL_OK);
+  }
+
+  // uses most of the stack
+  volatile char buf[48 * 1024];
+  buf[0] = 1;
+  buf[sizeof(buf) - 1] = 1;
+}
+
+TEST(FiberFunction, CreateFromFiber) {
+  osal_fiber_sched_attr_t attr = {};
+  attr.max_fibers = 4;
+  osal_fiber_sched_t sched;
+  ASSERT_EQ(osal_fiber_sched_init(&sched, &attr), OSAL_OK);
+
+  // each fiber is done before its child starts, so stacks are reused
+  int sum = 0;
+  std::vector<spawn_t> chain(11);
+  for (size_t i = 0; i < chain.size(); ++i) {
+    chain[i] = {&sched, {}, i + 1 < chain.size() ? &chain[i + 1] : nullptr, &sum};
+  }
+
+  ASSERT_EQ(osal_fiber_create(&sched, &chain[0].fiber, spawn, &chain[0]),
+            OSAL_OK);
+  ASSERT_EQ(osal_fiber_sched_run(&sched), OSAL_OK);
+  EXPECT_EQ(sum, 11);
+
+  EXPECT_EQ(osal_fiber_sched_destroy(&sched), OSAL_OK);
+}
+
+typedef struct {
+  osal_uint64_t delay;
+  osal_uint64_t woken;
+  std::vector<osal_uint64_t> *order;
+} sleeper_t;
+
+static void sleeper(osal_void_t *arg) {
+  sleeper_t *s = (sleeper_t *)arg;
+  osal_uint64_t start = osal_timer_gettime_nsec();
+
+  ASSERT_EQ(osal_fiber_sleep(s->delay), OSAL_OK);
+  s->woken = osal_timer_gettime_nsec() - start;
+  s->order->push_back(s->delay);
+}
+
+TEST(FiberFunction, Sleep) {
+  osal_fiber_sched_t sched;
+  ASSERT_EQ(osal_fiber_sched_init(&sched, nullptr), OSAL_OK);
+
+  std::vector<osal_uint64_t> order;
+  sleeper_t s[3] = {{30000000, 0, &order}, {10000000, 0, &order},
+                    {20000000, 0, &order}};
+  osal_fiber_t fibers[3];
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(osal_fiber_create(&sched, &fibers[i], sleeper, &s[i]), OSAL_OK);
+  }
+
+  osal_uint64_t start = osal_timer_gettime_nsec();
+  ASSERT_EQ(osal_fiber_sched_run(&sched), OSAL_OK);
+
+  // all sleep at the same time
+  EXPECT_LT(osal_timer_gettime_nsec() - start, 55000000u);
+  EXPECT_EQ(order, std::vector<osal_uint64_t>({10000000, 20000000, 30000000}));
+  for (auto &x : s) {
+    EXPECT_GE(x.woken, x.delay);
+  }
+
+  EXPECT_EQ(osal_fiber_sched_destroy(&sched), OSAL_OK);
+}
+
+static void timer_sleeper(osal_void_t *arg) {
+  osal_timer_t timer;
+  osal_timer_init(&timer, 5000000);
+  ASSERT_EQ(osal_fiber_sleep_until(&timer), OSAL_OK);
+  EXPECT_EQ(osal_timer_expired(&timer), OSAL_ERR_TIMEOUT);
+  *(bool *)arg = true;
+}
+
+TEST(FiberFunction, SleepUntilTimer) {
+  osal_fiber_sched_t sched;
+  ASSERT_EQ(osal_fiber_sched_init(&sched, nullptr), OSAL_OK);
+
+  bool done = false;
+  osal_fiber_t fiber;
+  ASSERT_EQ(osal_fiber_create(&sched, &fiber, timer_sleeper, &done), OSAL_OK);
+  ASSERT_EQ(osal_fiber_sched_run(&sched), OSAL_OK);
+  EXPECT_TRUE(done);
+
+  EXPECT_EQ(osal_fiber_sched_destroy(&sched), OSAL_OK);
+}
+
+typedef struct {
+  osal_semaphore_t sem;
+  osal_retval_t result;
+  osal_retval_t timeout_result;
+  int spins;
+  bool posted;
+} sem_test_t;
+
+static void sem_waiter(osal_void_t *arg) {
+  sem_test_t *t = (sem_test_t *)arg;
+
+  t->timeout_result = osal_fiber_semaphore_wait_until_ns(
+      &t->sem, osal_timer_gettime_nsec() + 1000000);
+  t->result = osal_fiber_semaphore_wait(&t->sem);
+}
+
+// keeps running while the other fiber waits
+static void sem_spinner(osal_void_t *arg) {
+  sem_test_t *t = (sem_test_t *)arg;
+
+  while (!__atomic_load_n(&t->posted, __ATOMIC_ACQUIRE)) {
+    t->spins++;
+    osal_fiber_sleep(100000);
+  }
+}
+
+static osal_void_t *sem_poster(osal_void_t *arg) {
+  sem_test_t *t = (sem_test_t *)arg;
+
+  osal_sleep(20000000);
+  __atomic_store_n(&t->posted, true, __ATOMIC_RELEASE);
+  osal_semaphore_post(&t->sem);
+  return NULL;
+}
+
+TEST(FiberFunction, Semaphore) {
+  osal_fiber_sched_t sched;
+  ASSERT_EQ(osal_fiber_sched_init(&sched, nullptr), OSAL_OK);
+
+  sem_test_t t = {};
+  ASSERT_EQ(osal_semaphore_init(&t.sem, nullptr, 0), OSAL_OK);
+
+  osal_fiber_t waiter, spinner;
+  ASSERT_EQ(osal_fiber_create(&sched, &waiter, sem_waiter, &t), OSAL_OK);
+  ASSERT_EQ(osal_fiber_create(&sched, &spinner, sem_spinner, &t), OSAL_OK);
+
+  osal_task_t poster;
+  osal_task_attr_t attr = {};
+  ASSERT_EQ(osal_task_create(&poster, &attr, sem_poster, &t), OSAL_OK);
+
+  ASSERT_EQ(osal_fiber_sched_run(&sched), OSAL_OK);
+  EXPECT_EQ(t.timeout_result, OSAL_ERR_TIMEOUT);
+  EXPECT_EQ(t.result, OSAL_OK);
+  EXPECT_GT(t.spins, 10);
+
+  EXPECT_EQ(osal_task_join(&poster, nullptr), OSAL_OK);
+  EXPECT_EQ(osal_semaphore_destroy(&t.sem), OSAL_OK);
+  EXPECT_EQ(osal_fiber_sched_destroy(&sched), OSAL_OK);
+}
+
+static osal_void_t *run_sched(osal_void_t *arg) {
+  osal_fiber_sched_run((osal_fiber_sched_t *)arg);
+  return NULL;
+}
+
+TEST(FiberFunction, SchedulerPerTask) {
+  osal_fiber_sched_t sched[2];
+  std::vector<osal_fiber_t> fibers(200);
+  std::vector<int> counts(200, 0);
+
+  for (int s = 0; s < 2; ++s) {
+    ASSERT_EQ(osal_fiber_sched_init(&sched[s], nullptr), OSAL_OK);
+
+    for (int i = s; i < 200; i += 2) {
+      ASSERT_EQ(osal_fiber_create(&sched[s], &fibers[i], count, &counts[i]),
+                OSAL_OK);
+    }
+  }
+
+  osal_task_t tasks[2];
+  osal_task_attr_t attr = {};
+  for (int s = 0; s < 2; ++s) {
+    ASSERT_EQ(osal_task_create(&tasks[s], &attr, run_sched, &sched[s]),
+              OSAL_OK);
+  }
+
+  for (int s = 0; s < 2; ++s) {
+    EXPECT_EQ(osal_task_join(&tasks[s], nullptr), OSAL_OK);
+    EXPECT_EQ(osal_fiber_sched_destroy(&sched[s]), OSAL_OK);
+  }
+
+  for (int cnt : counts) {
+    EXPECT_EQ(cnt, 10);
+  }
+}
+
+TEST(FiberDetect, PoolExhausted) {
+  osal_fiber_sched_attr_t attr = {};
+  attr.max_fibers = 2;
+  osal_fiber_sched_t sched;
+  ASSERT_EQ(osal_fiber_sched_init(&sched, &attr), OSAL_OK);
+
+  int counts[3] = {};
+  osal_fiber_t fibers[3];
+  ASSERT_EQ(osal_fiber_create(&sched, &fibers[0], count, &counts[0]), OSAL_OK);
+  ASSERT_EQ(osal_fiber_create(&sched, &fibers[1], count, &counts[1]), OSAL_OK);
+  EXPECT_EQ(osal_fiber_create(&sched, &fibers[2], count, &counts[2]),
+            OSAL_ERR_SYSTEM_LIMIT_REACHED);
+  EXPECT_EQ(osal_fiber_sched_destroy(&sched), OSAL_ERR_BUSY);
+
+  ASSERT_EQ(osal_fiber_sched_run(&sched), OSAL_OK);
+
+  // stacks are back in the pool
+  ASSERT_EQ(osal_fiber_create(&sched, &fibers[2], count, &counts[2]), OSAL_OK);
+  ASSERT_EQ(osal_fiber_sched_run(&sched), OSAL_OK);
+  EXPECT_EQ(counts[2], 10);
+
+  EXPECT_EQ(osal_fiber_sched_destroy(&sched), OSAL_OK);
+}
+
+TEST(FiberDetect, NotInFiber) {
+  EXPECT_EQ(osal_fiber_self(), nullptr);
+  EXPECT_EQ(osal_fiber_yield(), OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(osal_fiber_wait(nullptr, nullptr, 1), OSAL_ERR_INVALID_PARAM);
+
+  // wait functions block the thread instead
+  osal_semaphore_t sem;
+  ASSERT_EQ(osal_semaphore_init(&sem, nullptr, 1), OSAL_OK);
+  EXPECT_EQ(osal_fiber_semaphore_wait(&sem), OSAL_OK);
+  EXPECT_EQ(osal_fiber_sleep(1000), OSAL_OK);
+  EXPECT_EQ(osal_semaphore_destroy(&sem), OSAL_OK);
+}
+
+} // namespace test_fiber
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
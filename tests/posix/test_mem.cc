@@ -0,0 +1,137 @@
+#include "gtest/gtest.h"
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <vector>
+
+#include "libosal/mem.h"
+#include "libosal/osal.h"
+
+namespace test_mem {
+
+static long minor_faults() {
+  struct rusage usage;
+  getrusage(RUSAGE_THREAD, &usage);
+  return usage.ru_minflt;
+}
+
+static bool resident(void *ptr, size_t size) {
+  long page_size = sysconf(_SC_PAGESIZE);
+  uintptr_t start = (uintptr_t)ptr & ~(uintptr_t)(page_size - 1);
+  size_t len = ((uintptr_t)ptr + size) - start;
+  std::vector<unsigned char> vec((len + page_size - 1) / page_size);
+
+  if (mincore((void *)start, len, vec.data()) != 0) {
+    return false;
+  }
+
+  for (unsigned char v : vec) {
+    if ((v & 1u) == 0u) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(MemFunction, AllocFree) {
+  const osal_mem_attr_t attrs[] = {
+      0u,
+      OSAL_MEM_ATTR__PREFAULT,
+      OSAL_MEM_ATTR__LOCK | OSAL_MEM_ATTR__PREFAULT,
+      OSAL_MEM_ATTR__LOCK | OSAL_MEM_ATTR__PREFAULT | OSAL_MEM_ATTR__HUGEPAGE,
+  };
+  const size_t size = 4 * 1024 * 1024 + 123;
+
+  osal_void_t *ptr = nullptr;
+  EXPECT_EQ(osal_mem_alloc(&ptr, 0, nullptr), OSAL_ERR_INVALID_PARAM);
+
+  for (osal_mem_attr_t attr : attrs) {
+    osal_retval_t orv = osal_mem_alloc(&ptr, size, &attr);
+    if ((orv == OSAL_ERR_PERMISSION_DENIED) || (orv == OSAL_ERR_OUT_OF_MEMORY)) {
+      printf("cannot lock %zu bytes, skipping attr 0x%x\n", size, attr);
+      continue;
+    }
+    ASSERT_EQ(orv, OSAL_OK) << "attr 0x" << std::hex << attr;
+    EXPECT_EQ((uintptr_t)ptr % 64u, 0u);
+
+    if ((attr & OSAL_MEM_ATTR__PREFAULT) != 0u) {
+      EXPECT_TRUE(resident(ptr, size)) << "attr 0x" << std::hex << attr;
+
+      // first touch does not fault any more
+      long faults = minor_faults();
+      memset(ptr, 0xA5, size);
+      EXPECT_LT(minor_faults() - faults, 4) << "attr 0x" << std::hex << attr;
+    } else {
+      EXPECT_EQ(((unsigned char *)ptr)[0], 0u);
+      EXPECT_EQ(((unsigned char *)ptr)[size - 1], 0u);
+      memset(ptr, 0xA5, size);
+    }
+
+    EXPECT_EQ(osal_mem_free(ptr), OSAL_OK);
+  }
+}
+
+static unsigned char prepare_buf[1024 * 1024 + 17];
+
+TEST(MemFunction, Prepare) {
+  osal_mem_attr_t attr = OSAL_MEM_ATTR__PREFAULT;
+  unsigned char *ptr = &prepare_buf[17];
+  const size_t size = sizeof(prepare_buf) - 17;
+
+  ASSERT_EQ(osal_mem_prepare(ptr, size, &attr), OSAL_OK);
+  EXPECT_TRUE(resident(ptr, size));
+
+  attr = OSAL_MEM_ATTR__LOCK;
+  osal_retval_t orv = osal_mem_prepare(ptr, size, &attr);
+  if ((orv == OSAL_ERR_PERMISSION_DENIED) || (orv == OSAL_ERR_OUT_OF_MEMORY)) {
+    GTEST_SKIP() << "not allowed to lock memory";
+  }
+  EXPECT_EQ(orv, OSAL_OK);
+  munlock(ptr, size);
+
+  EXPECT_EQ(osal_mem_prepare(ptr, size, nullptr), OSAL_OK);
+}
+
+static long locked_kb() {
+  long kb = -1;
+  char line[256];
+  FILE *fp = fopen("/proc/self/status", "r");
+
+  while ((fp != nullptr) && (fgets(line, sizeof(line), fp) != nullptr)) {
+    if (sscanf(line, "VmLck: %ld kB", &kb) == 1) {
+      break;
+    }
+  }
+  if (fp != nullptr) {
+    fclose(fp);
+  }
+  return kb;
+}
+
+TEST(MemFunction, LockAll) {
+  osal_retval_t orv = osal_mem_lock_all();
+  if ((orv == OSAL_ERR_PERMISSION_DENIED) || (orv == OSAL_ERR_OUT_OF_MEMORY)) {
+    GTEST_SKIP() << "not allowed to lock memory";
+  }
+  ASSERT_EQ(orv, OSAL_OK);
+  EXPECT_GT(locked_kb(), 0);
+
+  // future allocations are locked as well and resident without touching
+  std::vector<char> *buf = new std::vector<char>();
+  buf->reserve(4 * 1024 * 1024);
+  EXPECT_TRUE(resident(buf->data(), buf->capacity()));
+  delete buf;
+
+  EXPECT_EQ(osal_mem_unlock_all(), OSAL_OK);
+  EXPECT_EQ(locked_kb(), 0);
+}
+
+} // namespace test_mem
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
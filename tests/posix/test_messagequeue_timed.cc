@@ -8,6 +8,10 @@
 
 namespace test_messagequeue {
 
+using testutils::elapsed_monotonic_ns;
+using testutils::gettime_ns;
+using testutils::set_deadline_clock;
+
 /* These tests are essentially a replica of the functional ones in
    test_messagequeue.cc, but with the difference that the timed send
    and receive functions are used.
@@ -295,4 +299,127 @@ TEST(MessageQueueFunction, TimeoutsDelayedRecv) {
       << "send_waitcount too small";
 }
 
+/* timeouts are interpreted on the clock selected in the open flags,
+   although mq_timedsend/mq_timedreceive only take CLOCK_REALTIME. */
+TEST(MessageQueueFunction, ClockAttr) {
+  const long timeout_ns = 10000000;   /* 10 ms */
+  const long timeout_max = 1000000000; /* 1 s */
+  const struct {
+    osal_uint32_t oflags;
+    clockid_t clock_id;
+  } cases[] = {
+      {OSAL_MQ_ATTR__CLOCK__REALTIME, CLOCK_REALTIME},
+      {OSAL_MQ_ATTR__CLOCK__MONOTONIC, CLOCK_MONOTONIC},
+  };
+
+  for (const auto &c : cases) {
+    osal_mq_t queue;
+    osal_mq_attr_t attr = {};
+    attr.oflags =
+        OSAL_MQ_ATTR__OFLAG__RDWR | OSAL_MQ_ATTR__OFLAG__CREAT | c.oflags;
+    attr.max_messages = 1;
+    attr.max_message_size = sizeof(message_t);
+    attr.mode = S_IRUSR | S_IWUSR;
+    mq_unlink("/test_clock");
+    ASSERT_EQ(osal_mq_open(&queue, "/test_clock", &attr), OSAL_OK);
+
+    message_t msg = {};
+    osal_uint32_t prio = 0;
+
+    // empty queue, receive times out
+    timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    osal_timer_t deadline = set_deadline_clock(c.clock_id, 0, timeout_ns);
+    EXPECT_EQ(osal_mq_timedreceive(&queue, (char *)&msg, sizeof(msg), &prio,
+                                   &deadline),
+              OSAL_ERR_TIMEOUT);
+    long elapsed = elapsed_monotonic_ns(start);
+    EXPECT_GE(elapsed, timeout_ns) << "oflags " << c.oflags;
+    EXPECT_LT(elapsed, timeout_max) << "oflags " << c.oflags;
+
+    // full queue, send times out
+    deadline = set_deadline_clock(c.clock_id, 0, timeout_ns);
+    EXPECT_EQ(osal_mq_timedsend(&queue, (char *)&msg, sizeof(msg), prio,
+                                &deadline),
+              OSAL_OK);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    deadline = set_deadline_clock(c.clock_id, 0, timeout_ns);
+    EXPECT_EQ(osal_mq_timedsend(&queue, (char *)&msg, sizeof(msg), prio,
+                                &deadline),
+              OSAL_ERR_TIMEOUT);
+    elapsed = elapsed_monotonic_ns(start);
+    EXPECT_GE(elapsed, timeout_ns) << "oflags " << c.oflags;
+    EXPECT_LT(elapsed, timeout_max) << "oflags " << c.oflags;
+
+    EXPECT_EQ(osal_mq_close(&queue), OSAL_OK);
+    mq_unlink("/test_clock");
+  }
+}
+
+TEST(MessageQueueFunction, NanosecondTimeouts) {
+  const long timeout_ns = 10000000;   /* 10 ms */
+  const long timeout_max = 1000000000; /* 1 s */
+
+  osal_mq_t queue;
+  osal_mq_attr_t attr = {};
+  attr.oflags = OSAL_MQ_ATTR__OFLAG__RDWR | OSAL_MQ_ATTR__OFLAG__CREAT |
+                OSAL_MQ_ATTR__CLOCK__MONOTONIC;
+  attr.max_messages = 1;
+  attr.max_message_size = sizeof(message_t);
+  attr.mode = S_IRUSR | S_IWUSR;
+  mq_unlink("/test_clock_ns");
+  ASSERT_EQ(osal_mq_open(&queue, "/test_clock_ns", &attr), OSAL_OK);
+
+  message_t msg = {};
+  osal_uint32_t prio = 0;
+
+  timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  EXPECT_EQ(osal_mq_receive_until_ns(&queue, (char *)&msg, sizeof(msg), &prio,
+                                     gettime_ns(CLOCK_MONOTONIC) + timeout_ns),
+            OSAL_ERR_TIMEOUT);
+  long elapsed = elapsed_monotonic_ns(start);
+  EXPECT_GE(elapsed, timeout_ns);
+  EXPECT_LT(elapsed, timeout_max);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  EXPECT_EQ(osal_mq_receive_for_ns(&queue, (char *)&msg, sizeof(msg), &prio,
+                                   timeout_ns),
+            OSAL_ERR_TIMEOUT);
+  elapsed = elapsed_monotonic_ns(start);
+  EXPECT_GE(elapsed, timeout_ns);
+  EXPECT_LT(elapsed, timeout_max);
+
+  msg.payload = 42;
+  EXPECT_EQ(osal_mq_send_for_ns(&queue, (char *)&msg, sizeof(msg), prio,
+                                timeout_ns),
+            OSAL_OK);
+
+  // queue full
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  EXPECT_EQ(osal_mq_send_until_ns(&queue, (char *)&msg, sizeof(msg), prio,
+                                  gettime_ns(CLOCK_MONOTONIC) + timeout_ns),
+            OSAL_ERR_TIMEOUT);
+  elapsed = elapsed_monotonic_ns(start);
+  EXPECT_GE(elapsed, timeout_ns);
+  EXPECT_LT(elapsed, timeout_max);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  EXPECT_EQ(osal_mq_send_for_ns(&queue, (char *)&msg, sizeof(msg), prio,
+                                timeout_ns),
+            OSAL_ERR_TIMEOUT);
+  elapsed = elapsed_monotonic_ns(start);
+  EXPECT_GE(elapsed, timeout_ns);
+  EXPECT_LT(elapsed, timeout_max);
+
+  msg.payload = 0;
+  EXPECT_EQ(osal_mq_receive_until_ns(&queue, (char *)&msg, sizeof(msg), &prio,
+                                     gettime_ns(CLOCK_MONOTONIC) + timeout_ns),
+            OSAL_OK);
+  EXPECT_EQ(msg.payload, 42u);
+
+  EXPECT_EQ(osal_mq_close(&queue), OSAL_OK);
+  mq_unlink("/test_clock_ns");
+}
+
 } // namespace test_messagequeue
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+
+#include "libosal/osal.h"
+#include "libosal/periodic.h"
+
+namespace test_periodic {
+
+static const osal_uint64_t period = 10000000;
+
+TEST(PeriodicFunction, Grid) {
+  osal_periodic_t per;
+  osal_periodic_stats_t stats;
+  const osal_uint64_t start = osal_timer_gettime_nsec() + 5000000;
+
+  EXPECT_EQ(osal_periodic_init(&per, nullptr, 0, 0, 0), OSAL_ERR_INVALID_PARAM);
+  osal_periodic_attr_t attr = 0xF;
+  EXPECT_EQ(osal_periodic_init(&per, &attr, period, 0, 0), OSAL_ERR_INVALID_PARAM);
+
+  // catch up, so a late wakeup of the test machine does not leave the grid
+  attr = OSAL_PERIODIC_ATTR__OVERRUN__CATCH_UP;
+  ASSERT_EQ(osal_periodic_init(&per, &attr, period, 1000000, start), OSAL_OK);
+
+  // releases lie exactly on the grid, no drift
+  osal_uint64_t missed = 0;
+  for (int i = 0; i < 20; ++i) {
+    osal_retval_t orv = osal_periodic_wait_next_period(&per);
+    ASSERT_TRUE((orv == OSAL_OK) || (orv == OSAL_ERR_TIMEOUT));
+    missed += orv == OSAL_ERR_TIMEOUT ? 1 : 0;
+    EXPECT_EQ(per.release, start + 1000000 + i * period);
+    EXPECT_GE(osal_timer_gettime_nsec(), per.release);
+  }
+
+  osal_periodic_get_stats(&per, &stats);
+  EXPECT_EQ(stats.releases, 20u);
+  EXPECT_EQ(stats.cycles, 19u);
+  EXPECT_EQ(stats.missed, missed);
+  EXPECT_EQ(stats.skipped, 0u);
+  EXPECT_LE(stats.exec_min, stats.exec_max);
+  EXPECT_LE(stats.lat_min, stats.lat_max);
+  EXPECT_GE(stats.lat_sum, stats.lat_max);
+
+  osal_periodic_reset_stats(&per);
+  EXPECT_NE(osal_periodic_wait_next_period(&per), OSAL_ERR_OPERATION_FAILED);
+  osal_periodic_get_stats(&per, &stats);
+  EXPECT_EQ(stats.releases, 1u);
+  EXPECT_EQ(stats.cycles, 1u);
+  EXPECT_EQ(stats.lat_min, stats.lat_max);
+}
+
+TEST(PeriodicFunction, OverrunSkip) {
+  osal_periodic_t per;
+  osal_periodic_stats_t stats;
+
+  ASSERT_EQ(osal_periodic_init(&per, nullptr, period, 0, 0), OSAL_OK);
+  ASSERT_EQ(osal_periodic_wait_next_period(&per), OSAL_OK);
+  const osal_uint64_t first = per.release;
+
+  // job takes 2.5 periods, releases 1 and 2 are skipped
+  osal_busy_wait_until_nsec(first + (5 * period) / 2);
+  EXPECT_EQ(osal_periodic_wait_next_period(&per), OSAL_ERR_TIMEOUT);
+  EXPECT_EQ(per.release, first + 3 * period);
+  EXPECT_GE(osal_timer_gettime_nsec(), first + 3 * period);
+
+  EXPECT_EQ(osal_periodic_wait_next_period(&per), OSAL_OK);
+  EXPECT_EQ(per.release, first + 4 * period);
+
+  osal_periodic_get_stats(&per, &stats);
+  EXPECT_EQ(stats.missed, 1u);
+  EXPECT_EQ(stats.skipped, 2u);
+  EXPECT_GE(stats.exec_max, (5 * period) / 2);
+}
+
+TEST(PeriodicFunction, OverrunCatchUp) {
+  osal_periodic_t per;
+  osal_periodic_stats_t stats;
+  osal_periodic_attr_t attr = OSAL_PERIODIC_ATTR__OVERRUN__CATCH_UP;
+
+  ASSERT_EQ(osal_periodic_init(&per, &attr, period, 0, 0), OSAL_OK);
+  ASSERT_EQ(osal_periodic_wait_next_period(&per), OSAL_OK);
+  const osal_uint64_t first = per.release;
+
+  // missed releases run back to back without sleeping
+  osal_busy_wait_until_nsec(first + (5 * period) / 2);
+  EXPECT_EQ(osal_periodic_wait_next_period(&per), OSAL_ERR_TIMEOUT);
+  EXPECT_EQ(per.release, first + period);
+  EXPECT_EQ(osal_periodic_wait_next_period(&per), OSAL_ERR_TIMEOUT);
+  EXPECT_EQ(per.release, first + 2 * period);
+  EXPECT_LT(osal_timer_gettime_nsec(), first + 3 * period);
+
+  EXPECT_EQ(osal_periodic_wait_next_period(&per), OSAL_OK);
+  EXPECT_EQ(per.release, first + 3 * period);
+
+  osal_periodic_get_stats(&per, &stats);
+  EXPECT_EQ(stats.missed, 2u);
+  EXPECT_EQ(stats.skipped, 0u);
+}
+
+} // namespace test_periodic
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
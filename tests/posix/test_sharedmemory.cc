@@ -746,6 +746,39 @@ TEST(SharedmemoryFunction, TestMMAPWorks) {
   unlink(PATH_SHM_NAME7);
 }
 
+TEST(SharedmemoryFunction, TestUnmapUnlink) {
+
+  const char *SHM_NAME8 = "/shm_test8";
+
+  osal_retval_t orv;
+  osal_shm_t shm;
+  long *p_mem;
+
+  osal_shm_attr_t attr =
+      (OSAL_SHM_ATTR__FLAG__RDWR | OSAL_SHM_ATTR__FLAG__CREAT |
+       ((S_IRUSR | S_IWUSR) << OSAL_SHM_ATTR__MODE__SHIFT));
+
+  orv = osal_shm_open(&shm, SHM_NAME8, &attr, sizeof(long));
+  ASSERT_EQ(orv, 0) << "could not open shared memory";
+
+  osal_shm_map_attr_t map_attr =
+      (OSAL_SHM_MAP_ATTR__PROT_READ | OSAL_SHM_MAP_ATTR__PROT_WRITE |
+       OSAL_SHM_MAP_ATTR__SHARED);
+  orv = osal_shm_map(&shm, &map_attr, (osal_void_t **)&p_mem);
+  ASSERT_EQ(orv, 0) << "could not map shared memory";
+  *p_mem = 42;
+
+  EXPECT_EQ(osal_shm_unmap(&shm, p_mem), OSAL_OK);
+  EXPECT_EQ(osal_shm_close(&shm), OSAL_OK);
+
+  EXPECT_EQ(osal_shm_unlink(SHM_NAME8), OSAL_OK);
+  EXPECT_EQ(osal_shm_unlink(SHM_NAME8), OSAL_ERR_NOT_FOUND);
+
+  osal_shm_attr_t open_attr = OSAL_SHM_ATTR__FLAG__RDWR;
+  EXPECT_EQ(osal_shm_open(&shm, SHM_NAME8, &open_attr, sizeof(long)),
+            OSAL_ERR_NOT_FOUND);
+}
+
 TEST(SharedmemoryDetect, TestPermDenied) {
 
   const char *SHM_NAME7 = "shm_test7";
@@ -0,0 +1,313 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+#include "libosal/osal.h"
+#include "libosal/span.h"
+#include "test_utils.h"
+
+namespace test_span {
+
+using testutils::wait_nanoseconds;
+
+static std::string export_to_string() {
+  char path[] = "/tmp/test_span_XXXXXX";
+  int fd = mkstemp(path);
+  EXPECT_GE(fd, 0);
+  close(fd);
+
+  EXPECT_EQ(osal_span_export_chrome(path), OSAL_OK);
+
+  std::ifstream in(path);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  unlink(path);
+  return ss.str();
+}
+
+static int count(const std::string &str, const std::string &pattern) {
+  int cnt = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos;
+       pos = str.find(pattern, pos + 1)) {
+    ++cnt;
+  }
+  return cnt;
+}
+
+TEST(SpanFunction, Nesting) {
+  // no buffer yet, spans are ignored
+  osal_span_begin("ignored");
+  osal_span_end();
+
+  ASSERT_EQ(osal_span_thread_init(64, "main"), OSAL_OK);
+  EXPECT_EQ(osal_span_thread_init(64, "main"), OSAL_ERR_BUSY);
+  EXPECT_EQ(osal_span_thread_init(0, "main"), OSAL_ERR_INVALID_PARAM);
+
+  osal_span_begin("cycle");
+  osal_span_begin("read \"inputs\"");
+  wait_nanoseconds(1000);
+  osal_span_end();
+  osal_span_begin("compute");
+  wait_nanoseconds(1000);
+  osal_span_end();
+  osal_span_end();
+  EXPECT_EQ(osal_span_get_dropped(), 0u);
+
+  std::string json = export_to_string();
+  EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+  EXPECT_EQ(count(json, "\"ph\":\"X\""), 3);
+  EXPECT_EQ(count(json, "\"name\":\"ignored\""), 0);
+  EXPECT_NE(json.find("\"args\":{\"name\":\"main\"}"), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"read \\\"inputs\\\"\""), std::string::npos);
+
+  // inner spans complete first
+  EXPECT_LT(json.find("\"name\":\"compute\""), json.find("\"name\":\"cycle\""));
+
+  // unbalanced end and too deep nesting are dropped
+  osal_span_end();
+  for (unsigned i = 0; i < OSAL_SPAN_MAX_DEPTH + 2; ++i) {
+    osal_span_begin("deep");
+  }
+  for (unsigned i = 0; i < OSAL_SPAN_MAX_DEPTH + 2; ++i) {
+    osal_span_end();
+  }
+  EXPECT_EQ(osal_span_get_dropped(), 3u);
+  EXPECT_EQ(count(export_to_string(), "\"name\":\"deep\""),
+            (int)OSAL_SPAN_MAX_DEPTH);
+
+  osal_span_cleanup();
+  osal_span_begin("ignored");
+  osal_span_end();
+  EXPECT_EQ(count(export_to_string(), "\"ph\":\"X\""), 0);
+  EXPECT_EQ(osal_span_thread_init(8, nullptr), OSAL_OK);
+  osal_span_cleanup();
+
+  EXPECT_EQ(osal_span_export_chrome(nullptr), OSAL_ERR_INVALID_PARAM);
+  EXPECT_NE(osal_span_export_chrome("/nonexistent/dir/spans.json"), OSAL_OK);
+}
+
+typedef struct {
+  osal_uint32_t cycles;
+  std::atomic<int> ready;
+} span_thread_args_t;
+
+static void *span_thread(void *arg) {
+  span_thread_args_t *args = (span_thread_args_t *)arg;
+
+  EXPECT_EQ(osal_span_thread_init(16, nullptr), OSAL_OK);
+  args->ready++;
+
+  for (osal_uint32_t i = 0; i < args->cycles; ++i) {
+    osal_span_begin("cycle");
+    osal_span_begin("read");
+    osal_span_end();
+    osal_span_begin("compute");
+    osal_span_end();
+    osal_span_end();
+  }
+
+  return nullptr;
+}
+
+TEST(SpanFunction, MultiThreaded) {
+  const int num_threads = 4;
+  span_thread_args_t args;
+  osal_task_t tasks[num_threads];
+
+  args.cycles = 100000;
+  args.ready = 0;
+
+  for (int i = 0; i < num_threads; ++i) {
+    ASSERT_EQ(osal_task_create(&tasks[i], nullptr, span_thread, &args),
+              OSAL_OK);
+  }
+
+  // export while threads are recording and wrapping their buffers
+  while (args.ready < num_threads) {
+    wait_nanoseconds(100000);
+  }
+  for (int i = 0; i < 10; ++i) {
+    std::string json = export_to_string();
+    EXPECT_LE(count(json, "\"ph\":\"X\""), num_threads * 16);
+    EXPECT_EQ(count(json, "\"name\":\"thread_name\""), num_threads);
+  }
+
+  for (int i = 0; i < num_threads; ++i) {
+    osal_task_join(&tasks[i], nullptr);
+  }
+
+  // buffers outlive their threads and keep the newest spans
+  std::string json = export_to_string();
+  EXPECT_EQ(count(json, "\"ph\":\"X\""), num_threads * 16);
+  EXPECT_EQ(count(json, "\"name\":\"cycle\""), num_threads * 6);
+
+  osal_span_cleanup();
+}
+
+TEST(SpanFunction, BufferOverflow) {
+  // span names need static lifetime
+  static char names[20][8];
+  for (int i = 0; i < 20; ++i) {
+    snprintf(names[i], sizeof(names[i]), "s%d", i);
+  }
+
+  // rounded up to 8 spans
+  ASSERT_EQ(osal_span_thread_init(5, "main"), OSAL_OK);
+
+  for (int i = 0; i < 20; ++i) {
+    osal_span_begin(names[i]);
+    osal_span_end();
+  }
+
+  // overwritten spans are not dropped, only the newest 8 are exported
+  EXPECT_EQ(osal_span_get_dropped(), 0u);
+  std::string json = export_to_string();
+  EXPECT_EQ(count(json, "\"ph\":\"X\""), 8);
+  for (int i = 0; i < 20; ++i) {
+    std::string name = std::string("\"name\":\"") + names[i] + "\"";
+    EXPECT_EQ(count(json, name), i < 12 ? 0 : 1) << names[i];
+  }
+
+  // unbalanced ends are counted, recorded spans stay untouched
+  for (int i = 0; i < 5; ++i) {
+    osal_span_end();
+  }
+  EXPECT_EQ(osal_span_get_dropped(), 5u);
+  EXPECT_EQ(count(export_to_string(), "\"ph\":\"X\""), 8);
+
+  osal_span_cleanup();
+}
+
+typedef struct {
+  int index;
+  int num_threads;
+  std::atomic<int> *ready;
+} span_export_args_t;
+
+static void *span_export_thread(void *arg) {
+  span_export_args_t *args = (span_export_args_t *)arg;
+  std::string name = "worker" + std::to_string(args->index);
+
+  EXPECT_EQ(osal_span_thread_init(32, name.c_str()), OSAL_OK);
+  for (int i = 0; i <= args->index; ++i) {
+    osal_span_begin("work");
+    osal_span_end();
+  }
+
+  (*args->ready)++;
+  while (*args->ready < args->num_threads) {
+    wait_nanoseconds(100000);
+  }
+
+  // all threads export at the same time
+  for (int i = 0; i < 10; ++i) {
+    std::string json = export_to_string();
+    EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+    EXPECT_EQ(count(json, "\"name\":\"thread_name\""), args->num_threads);
+    EXPECT_EQ(count(json, "\"name\":\"work\""),
+              args->num_threads * (args->num_threads + 1) / 2);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"" + name + "\"}"),
+              std::string::npos);
+  }
+
+  return nullptr;
+}
+
+TEST(SpanFunction, MultiThreadedExport) {
+  const int num_threads = 4;
+  std::atomic<int> ready(0);
+  span_export_args_t args[num_threads];
+  osal_task_t tasks[num_threads];
+
+  for (int i = 0; i < num_threads; ++i) {
+    args[i] = {i, num_threads, &ready};
+    ASSERT_EQ(osal_task_create(&tasks[i], nullptr, span_export_thread, &args[i]),
+              OSAL_OK);
+  }
+
+  for (int i = 0; i < num_threads; ++i) {
+    osal_task_join(&tasks[i], nullptr);
+  }
+
+  osal_span_cleanup();
+}
+
+typedef struct {
+  std::atomic<int> phase;
+  osal_uint64_t dropped;
+  osal_retval_t reinit;
+} span_reset_args_t;
+
+static void span_wait_phase(std::atomic<int> *phase, int value) {
+  while (*phase < value) {
+    wait_nanoseconds(100000);
+  }
+}
+
+static void *span_reset_thread(void *arg) {
+  span_reset_args_t *args = (span_reset_args_t *)arg;
+
+  EXPECT_EQ(osal_span_thread_init(8, "worker"), OSAL_OK);
+  osal_span_begin("before");
+  osal_span_end();
+  // dropped count of the old buffer, gone after cleanup
+  osal_span_end();
+  args->phase = 1;
+
+  // main thread frees all buffers meanwhile
+  span_wait_phase(&args->phase, 2);
+
+  osal_span_begin("after");
+  osal_span_end();
+  args->dropped = osal_span_get_dropped();
+  args->reinit = osal_span_thread_init(8, "worker");
+  osal_span_begin("again");
+  osal_span_end();
+  args->phase = 3;
+
+  return nullptr;
+}
+
+TEST(SpanFunction, CleanupInvalidatesSpans) {
+  span_reset_args_t args;
+  osal_task_t task;
+
+  args.phase = 0;
+  args.dropped = 1;
+  args.reinit = OSAL_ERR_OPERATION_FAILED;
+
+  ASSERT_EQ(osal_task_create(&task, nullptr, span_reset_thread, &args),
+            OSAL_OK);
+  span_wait_phase(&args.phase, 1);
+  EXPECT_EQ(count(export_to_string(), "\"name\":\"before\""), 1);
+
+  osal_span_cleanup();
+  std::string json = export_to_string();
+  EXPECT_EQ(count(json, "\"ph\":\"X\""), 0);
+  EXPECT_EQ(count(json, "\"name\":\"thread_name\""), 0);
+
+  // the still running thread lost its buffer and may create a new one
+  args.phase = 2;
+  span_wait_phase(&args.phase, 3);
+  EXPECT_EQ(args.dropped, 0u);
+  EXPECT_EQ(args.reinit, OSAL_OK);
+
+  json = export_to_string();
+  EXPECT_EQ(count(json, "\"name\":\"before\""), 0);
+  EXPECT_EQ(count(json, "\"name\":\"after\""), 0);
+  EXPECT_EQ(count(json, "\"name\":\"again\""), 1);
+
+  osal_task_join(&task, nullptr);
+  osal_span_cleanup();
+}
+
+} // namespace test_span
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
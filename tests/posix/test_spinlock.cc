@@ -1,8 +1,12 @@
 #include "gtest/gtest.h"
 #include <pthread.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <vector>
 
 #include "libosal/osal.h"
+#include "libosal/shm.h"
 #include "libosal/spinlock.h"
 #include "test_utils.h"
 
@@ -191,6 +195,179 @@ TEST(SpinlockMultithreading, RandomizedPlusWait) {
       << "multi-threaded counter test failed";
 }
 
+static const osal_spinlock_attr_t algorithms[] = {
+    OSAL_SPINLOCK_ATTR__ALGORITHM__DEFAULT,
+    OSAL_SPINLOCK_ATTR__ALGORITHM__TICKET, OSAL_SPINLOCK_ATTR__ALGORITHM__TTAS};
+
+static unsigned long run_counter_threads(osal_spinlock_t *spinlock,
+                                         ulong n_threads, uint loopcount) {
+  std::vector<pthread_t> thread_ids(n_threads);
+  std::vector<thread_param_t> thread_params(n_threads);
+  unsigned long counter = 0;
+
+  for (ulong i = 0; i < n_threads; i++) {
+    thread_params[i].thread_id = i;
+    thread_params[i].p_count_spinlock = spinlock;
+    thread_params[i].p_counter = &counter;
+    thread_params[i].loopcount = loopcount;
+    thread_params[i].max_wait_time_nsec = 0;
+    pthread_create(&thread_ids[i], nullptr, test_random, &thread_params[i]);
+  }
+
+  for (ulong i = 0; i < n_threads; i++) {
+    pthread_join(thread_ids[i], nullptr);
+  }
+
+  return counter;
+}
+
+TEST(SpinlockFunction, Algorithms) {
+  // the algorithm must not make every spinlock big
+  EXPECT_LE(sizeof(osal_spinlock_t), 16u);
+
+  for (osal_spinlock_attr_t attr : algorithms) {
+    osal_spinlock_t count_spinlock;
+    ASSERT_EQ(osal_spinlock_init(&count_spinlock, &attr), OSAL_OK);
+
+    EXPECT_EQ(run_counter_threads(&count_spinlock, 8, 20000), 8u * 20000u)
+        << "algorithm " << std::hex << attr;
+
+    EXPECT_EQ(osal_spinlock_destroy(&count_spinlock), OSAL_OK);
+  }
+}
+
+typedef struct {
+  osal_spinlock_mcs_t *lock;
+  unsigned long *counter;
+  uint loopcount;
+} mcs_param_t;
+
+static void *mcs_counter(void *arg) {
+  mcs_param_t *params = (mcs_param_t *)arg;
+
+  for (uint i = 0; i < params->loopcount; i++) {
+    osal_spinlock_mcs_lock(params->lock);
+    *(params->counter) = *(params->counter) + 1;
+    osal_spinlock_mcs_unlock(params->lock);
+  }
+
+  return nullptr;
+}
+
+static unsigned long run_mcs_counter_threads(osal_spinlock_mcs_t *spinlock,
+                                             ulong n_threads, uint loopcount) {
+  std::vector<pthread_t> thread_ids(n_threads);
+  unsigned long counter = 0;
+  mcs_param_t params = {spinlock, &counter, loopcount};
+
+  for (ulong i = 0; i < n_threads; i++) {
+    pthread_create(&thread_ids[i], nullptr, mcs_counter, &params);
+  }
+
+  for (ulong i = 0; i < n_threads; i++) {
+    pthread_join(thread_ids[i], nullptr);
+  }
+
+  return counter;
+}
+
+TEST(SpinlockFunction, Mcs) {
+  osal_spinlock_mcs_t count_spinlock;
+  ASSERT_EQ(osal_spinlock_mcs_init(&count_spinlock), OSAL_OK);
+
+  EXPECT_EQ(run_mcs_counter_threads(&count_spinlock, 8, 20000), 8u * 20000u);
+
+  EXPECT_EQ(osal_spinlock_mcs_destroy(&count_spinlock), OSAL_OK);
+}
+
+TEST(SpinlockFunction, McsMoreWaitersThanNodes) {
+  osal_spinlock_mcs_t count_spinlock;
+  ASSERT_EQ(osal_spinlock_mcs_init(&count_spinlock), OSAL_OK);
+
+  const ulong n_threads = OSAL_SPINLOCK_MCS_NODES + 16;
+  EXPECT_EQ(run_mcs_counter_threads(&count_spinlock, n_threads, 200),
+            n_threads * 200u);
+
+  EXPECT_EQ(osal_spinlock_mcs_destroy(&count_spinlock), OSAL_OK);
+}
+
+typedef struct {
+  osal_spinlock_t lock;
+  osal_spinlock_mcs_t mcs;
+  unsigned long counter;
+} shared_counter_t;
+
+// MCS lock is run after the algorithms of osal_spinlock_t
+static const int mcs_run = sizeof(algorithms) / sizeof(algorithms[0]);
+
+TEST(SpinlockFunction, ProcessShared) {
+  const char *name = "/osal_test_spinlock";
+  const int n_processes = 4;
+  const int loopcount = 20000;
+
+  for (int run = 0; run <= mcs_run; ++run) {
+    osal_shm_t shm;
+    osal_shm_attr_t shm_attr =
+        (OSAL_SHM_ATTR__FLAG__RDWR | OSAL_SHM_ATTR__FLAG__CREAT |
+         (S_IRWXU << OSAL_SHM_ATTR__MODE__SHIFT));
+    ASSERT_EQ(osal_shm_open(&shm, name, &shm_attr, sizeof(shared_counter_t)),
+              OSAL_OK);
+
+    shared_counter_t *shared;
+    osal_shm_map_attr_t map_attr =
+        (OSAL_SHM_MAP_ATTR__PROT_READ | OSAL_SHM_MAP_ATTR__PROT_WRITE |
+         OSAL_SHM_MAP_ATTR__SHARED);
+    ASSERT_EQ(osal_shm_map(&shm, &map_attr, (osal_void_t **)&shared), OSAL_OK);
+
+    if (run == mcs_run) {
+      ASSERT_EQ(osal_spinlock_mcs_init(&shared->mcs), OSAL_OK);
+    } else {
+      osal_spinlock_attr_t attr =
+          algorithms[run] | OSAL_SPINLOCK_ATTR__PROCESS_SHARED;
+      ASSERT_EQ(osal_spinlock_init(&shared->lock, &attr), OSAL_OK);
+    }
+    shared->counter = 0;
+
+    std::vector<pid_t> pids;
+    for (int p = 0; p < n_processes; ++p) {
+      pid_t pid = fork();
+      if (pid == 0) {
+        for (int i = 0; i < loopcount; ++i) {
+          if (run == mcs_run) {
+            osal_spinlock_mcs_lock(&shared->mcs);
+            shared->counter++;
+            osal_spinlock_mcs_unlock(&shared->mcs);
+          } else {
+            osal_spinlock_lock(&shared->lock);
+            shared->counter++;
+            osal_spinlock_unlock(&shared->lock);
+          }
+        }
+        _exit(0);
+      }
+      pids.push_back(pid);
+    }
+
+    for (pid_t pid : pids) {
+      int status = -1;
+      waitpid(pid, &status, 0);
+      EXPECT_EQ(status, 0);
+    }
+
+    EXPECT_EQ(shared->counter, (unsigned long)(n_processes * loopcount))
+        << "run " << run;
+
+    if (run == mcs_run) {
+      EXPECT_EQ(osal_spinlock_mcs_destroy(&shared->mcs), OSAL_OK);
+    } else {
+      EXPECT_EQ(osal_spinlock_destroy(&shared->lock), OSAL_OK);
+    }
+    EXPECT_EQ(osal_shm_unmap(&shm, shared), OSAL_OK);
+    EXPECT_EQ(osal_shm_close(&shm), OSAL_OK);
+    EXPECT_EQ(osal_shm_unlink(name), OSAL_OK);
+  }
+}
+
 } // namespace test_spinlock
 
 int main(int argc, char **argv) {
@@ -0,0 +1,176 @@
+#include "gtest/gtest.h"
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+#include "libosal/osal.h"
+#include "libosal/task_registry.h"
+
+namespace test_task_registry {
+
+typedef struct {
+  osal_semaphore_t release;
+} blocker_t;
+
+static void *blocker(void *arg) {
+  osal_semaphore_wait(&((blocker_t *)arg)->release);
+  return nullptr;
+}
+
+// returns index of the entry of task, -1 if not registered
+static int find(const osal_task_registry_t *reg, const osal_task_t *task,
+                osal_task_registry_entry_t *entry) {
+  for (osal_uint32_t i = 0; i < reg->entries; ++i) {
+    if ((osal_task_registry_read(reg, i, entry) == OSAL_OK) &&
+        (entry->ktid == task->ktid)) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+TEST(TaskRegistryFunction, PublishAndAttach) {
+  blocker_t b;
+  ASSERT_EQ(osal_semaphore_init(&b.release, nullptr, 0), OSAL_OK);
+
+  // tasks created before publishing are kept
+  osal_task_attr_t attr = {};
+  strcpy(attr.task_name, "reg-before");
+  attr.policy = OSAL_SCHED_POLICY_OTHER;
+  attr.affinity = 0x1;
+  osal_task_t before;
+  ASSERT_EQ(osal_task_create(&before, &attr, blocker, &b), OSAL_OK);
+
+  const osal_task_registry_t *reg;
+  EXPECT_EQ(osal_task_registry_unpublish(), OSAL_OK);
+  EXPECT_EQ(osal_task_registry_attach(getpid(), &reg), OSAL_ERR_NOT_FOUND);
+  ASSERT_EQ(osal_task_registry_publish(), OSAL_OK);
+  EXPECT_EQ(osal_task_registry_publish(), OSAL_OK);
+  ASSERT_EQ(osal_task_registry_attach(getpid(), &reg), OSAL_OK);
+  EXPECT_EQ(reg->pid, getpid());
+  EXPECT_EQ(reg->entries, OSAL_TASK_REGISTRY_ENTRIES);
+
+  // tasks pinned with a cpuset record the set
+  strcpy(attr.task_name, "reg-after");
+  attr.affinity = 0;
+  osal_cpuset_zero(&attr.cpuset);
+  osal_cpuset_set(&attr.cpuset, 0);
+  osal_task_t after;
+  ASSERT_EQ(osal_task_create(&after, &attr, blocker, &b), OSAL_OK);
+
+  osal_task_registry_entry_t entry;
+  ASSERT_GE(find(reg, &before, &entry), 0);
+  EXPECT_STREQ(entry.name, "reg-before");
+  EXPECT_EQ(entry.policy, OSAL_SCHED_POLICY_OTHER);
+  EXPECT_EQ(osal_cpuset_to_mask(&entry.cpuset), 0x1u);
+  EXPECT_EQ(osal_cpuset_count(&entry.cpuset), 1u);
+  EXPECT_EQ(entry.sched_status, OSAL_OK);
+  EXPECT_GT(entry.created, 0u);
+  ASSERT_GE(find(reg, &after, &entry), 0);
+  EXPECT_STREQ(entry.name, "reg-after");
+  EXPECT_TRUE(osal_cpuset_isset(&entry.cpuset, 0));
+  EXPECT_EQ(osal_cpuset_count(&entry.cpuset), 1u);
+
+  // joined tasks are removed
+  osal_semaphore_post(&b.release);
+  osal_semaphore_post(&b.release);
+  ASSERT_EQ(osal_task_join(&before, nullptr), OSAL_OK);
+  ASSERT_EQ(osal_task_join(&after, nullptr), OSAL_OK);
+  EXPECT_LT(find(reg, &before, &entry), 0);
+  EXPECT_LT(find(reg, &after, &entry), 0);
+
+  EXPECT_EQ(osal_task_registry_detach(reg), OSAL_OK);
+  EXPECT_EQ(osal_task_registry_unpublish(), OSAL_OK);
+  EXPECT_EQ(osal_task_registry_attach(getpid(), &reg), OSAL_ERR_NOT_FOUND);
+  EXPECT_EQ(osal_semaphore_destroy(&b.release), OSAL_OK);
+}
+
+static void *finish(void *arg) {
+  *(osal_int32_t *)arg = (osal_int32_t)syscall(SYS_gettid);
+  return nullptr;
+}
+
+TEST(TaskRegistryFunction, RemovedOnExit) {
+  ASSERT_EQ(osal_task_registry_publish(), OSAL_OK);
+  const osal_task_registry_t *reg;
+  ASSERT_EQ(osal_task_registry_attach(getpid(), &reg), OSAL_OK);
+
+  // the entry goes away when the task ends, not when it is joined
+  osal_int32_t ktid = 0;
+  osal_task_t task;
+  ASSERT_EQ(osal_task_create(&task, nullptr, finish, &ktid), OSAL_OK);
+
+  osal_task_registry_entry_t entry;
+  osal_task_t exited = task;
+  int idx = 0;
+  for (int i = 0; (i < 1000) && (idx >= 0); ++i) {
+    usleep(1000);
+    idx = find(reg, &exited, &entry);
+  }
+  EXPECT_EQ(ktid, (osal_int32_t)task.ktid);
+  EXPECT_LT(idx, 0);
+
+  ASSERT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+  EXPECT_EQ(osal_task_registry_detach(reg), OSAL_OK);
+  EXPECT_EQ(osal_task_registry_unpublish(), OSAL_OK);
+}
+
+TEST(TaskRegistryFunction, MainThread) {
+  osal_task_t self;
+  ASSERT_EQ(osal_task_get_hdl(&self), OSAL_OK);
+  ASSERT_EQ(osal_task_registry_add(&self, nullptr), OSAL_OK);
+  ASSERT_EQ(osal_task_registry_publish(), OSAL_OK);
+
+  const osal_task_registry_t *reg;
+  osal_task_registry_entry_t entry;
+  ASSERT_EQ(osal_task_registry_attach(getpid(), &reg), OSAL_OK);
+  ASSERT_GE(find(reg, &self, &entry), 0);
+  EXPECT_STREQ(entry.name, "");
+  EXPECT_EQ(entry.policy, 0u);
+
+  EXPECT_EQ(osal_task_registry_remove(&self), OSAL_OK);
+  EXPECT_EQ(osal_task_registry_remove(&self), OSAL_ERR_NOT_FOUND);
+  EXPECT_LT(find(reg, &self, &entry), 0);
+
+  EXPECT_EQ(osal_task_registry_detach(reg), OSAL_OK);
+  EXPECT_EQ(osal_task_registry_unpublish(), OSAL_OK);
+}
+
+TEST(TaskRegistryReject, Full) {
+  ASSERT_EQ(osal_task_registry_publish(), OSAL_OK);
+  const osal_task_registry_t *reg;
+  ASSERT_EQ(osal_task_registry_attach(getpid(), &reg), OSAL_OK);
+  osal_uint32_t dropped = reg->dropped;
+
+  // fake handles, only the kernel thread id is used
+  std::vector<osal_task_t> tasks(OSAL_TASK_REGISTRY_ENTRIES + 1);
+  osal_uint32_t added = 0;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    memset(&tasks[i], 0, sizeof(tasks[i]));
+    tasks[i].ktid = 0x7ffff000 + (pid_t)i;
+    if (osal_task_registry_add(&tasks[i], nullptr) == OSAL_OK) {
+      added++;
+    } else {
+      EXPECT_EQ(osal_task_registry_add(&tasks[i], nullptr),
+                OSAL_ERR_SYSTEM_LIMIT_REACHED);
+    }
+  }
+  EXPECT_EQ(added, OSAL_TASK_REGISTRY_ENTRIES);
+  EXPECT_GT(reg->dropped, dropped);
+
+  for (osal_uint32_t i = 0; i < added; ++i) {
+    EXPECT_EQ(osal_task_registry_remove(&tasks[i]), OSAL_OK);
+  }
+
+  EXPECT_EQ(osal_task_registry_detach(reg), OSAL_OK);
+  EXPECT_EQ(osal_task_registry_unpublish(), OSAL_OK);
+}
+
+} // namespace test_task_registry
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -1,5 +1,8 @@
 #include "gtest/gtest.h"
+#include <atomic>
 #include <pthread.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
 #include <vector>
 
 #include "libosal/osal.h"
@@ -414,7 +417,8 @@ TEST(TasksMultithreadingConfig, TaskAttributes) {
   osal_task_t hdl;
 
   orv = osal_task_get_hdl(&hdl);
-  EXPECT_EQ(orv, OSAL_ERR_NOT_IMPLEMENTED) << "error in osal_task_get_hdl";
+  EXPECT_EQ(orv, OSAL_OK) << "error in osal_task_get_hdl";
+  EXPECT_TRUE(pthread_equal(hdl.tid, pthread_self()));
 
   osal_task_sched_affinity_t affinity;
   orv = osal_task_get_affinity(&thread_id, &affinity);
@@ -446,7 +450,8 @@ TEST(TasksMultithreadingConfig, TaskAttributes) {
 
   osal_task_state_t state;
   orv = osal_task_get_state(&thread_id, &state);
-  ASSERT_EQ(orv, OSAL_ERR_NOT_IMPLEMENTED) << "osal_task_get_state() failed";
+  ASSERT_EQ(orv, OSAL_OK) << "osal_task_get_state() failed";
+  EXPECT_EQ(state, OSAL_STATE_THREAD_BLOCKED) << "thread waits for condvar";
 
   orv = osal_condvar_signal(&thread_params.condvar);
   ASSERT_EQ(orv, OSAL_OK) << "osal_condvar_signal() failed";
@@ -535,6 +540,523 @@ TEST(TasksMultithreadingFunction, SuspendResume) {
 
 } // namespace test_getattrs
 
+namespace test_sched {
+
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+
+typedef struct {
+  osal_semaphore_t *release;
+  int policy;
+  int priority;
+  cpu_set_t cpus;
+} sched_probe_t;
+
+void *sched_probe(void *arg) {
+  sched_probe_t *probe = (sched_probe_t *)arg;
+  struct sched_param param;
+  probe->policy = sched_getscheduler(0);
+  probe->priority = sched_getparam(0, &param) == 0 ? param.sched_priority : -1;
+  sched_getaffinity(0, sizeof(probe->cpus), &probe->cpus);
+  if (probe->release != nullptr) {
+    osal_semaphore_wait(probe->release);
+  }
+  return nullptr;
+}
+
+static osal_retval_t run_probe(osal_task_attr_t *attr, int *policy) {
+  sched_probe_t probe = {nullptr, -1, -1, {}};
+  osal_task_t task;
+  osal_retval_t status = OSAL_ERR_OPERATION_FAILED;
+
+  EXPECT_EQ(osal_task_create(&task, attr, sched_probe, &probe), OSAL_OK);
+  EXPECT_EQ(osal_task_get_sched_status(&task, &status), OSAL_OK);
+  EXPECT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+
+  *policy = probe.policy;
+  return status;
+}
+
+TEST(TasksMultithreadingConfig, SchedBatchIdle) {
+  const struct {
+    osal_task_sched_policy_t policy;
+    int expected;
+  } cases[] = {{OSAL_SCHED_POLICY_BATCH, SCHED_BATCH},
+               {OSAL_SCHED_POLICY_IDLE, SCHED_IDLE}};
+
+  for (const auto &c : cases) {
+    osal_task_attr_t attr = {};
+    attr.policy = c.policy;
+
+    int policy;
+    EXPECT_EQ(run_probe(&attr, &policy), OSAL_OK) << "policy " << c.policy;
+    EXPECT_EQ(policy, c.expected) << "policy " << c.policy;
+  }
+}
+
+TEST(TasksMultithreadingConfig, SchedDeadline) {
+  osal_task_attr_t attr = {};
+  attr.policy = OSAL_SCHED_POLICY_DEADLINE;
+  attr.runtime = 1000000;
+  attr.deadline = 10000000;
+  attr.period = 10000000;
+
+  int policy;
+  osal_retval_t status = run_probe(&attr, &policy);
+  if ((status == OSAL_ERR_PERMISSION_DENIED) ||
+      (status == OSAL_ERR_NOT_IMPLEMENTED)) {
+    GTEST_SKIP() << "SCHED_DEADLINE not available";
+  }
+  EXPECT_EQ(status, OSAL_OK);
+  EXPECT_EQ(policy, SCHED_DEADLINE);
+
+  // runtime larger than deadline is rejected, the task runs nevertheless
+  attr.runtime = 20000000;
+  EXPECT_EQ(run_probe(&attr, &policy), OSAL_ERR_INVALID_PARAM);
+  EXPECT_NE(policy, SCHED_DEADLINE);
+
+  // deadline without runtime is rejected before it reaches the kernel
+  attr.runtime = 0;
+  EXPECT_EQ(run_probe(&attr, &policy), OSAL_ERR_INVALID_PARAM);
+  EXPECT_NE(policy, SCHED_DEADLINE);
+}
+
+TEST(TasksMultithreadingConfig, SchedDeadlineAdmission) {
+  // every task reserves a full CPU, admission control has to refuse one of
+  // them at the latest when the number of CPUs is exceeded
+  const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  osal_semaphore_t release;
+  ASSERT_EQ(osal_semaphore_init(&release, nullptr, 0), OSAL_OK);
+
+  osal_task_attr_t attr = {};
+  attr.policy = OSAL_SCHED_POLICY_DEADLINE;
+  attr.runtime = 10000000;
+  attr.deadline = 10000000;
+  attr.period = 10000000;
+
+  std::vector<osal_task_t> tasks(cpus + 1);
+  std::vector<sched_probe_t> probes(cpus + 1, sched_probe_t{&release, -1, -1, {}});
+  osal_retval_t last = OSAL_OK;
+  long created = 0;
+
+  while ((created < (cpus + 1)) && (last == OSAL_OK)) {
+    ASSERT_EQ(osal_task_create(&tasks[created], &attr, sched_probe,
+                               &probes[created]),
+              OSAL_OK);
+    EXPECT_EQ(osal_task_get_sched_status(&tasks[created], &last), OSAL_OK);
+    created++;
+  }
+
+  for (long i = 0; i < created; ++i) {
+    osal_semaphore_post(&release);
+  }
+  for (long i = 0; i < created; ++i) {
+    EXPECT_EQ(osal_task_join(&tasks[i], nullptr), OSAL_OK);
+  }
+  osal_semaphore_destroy(&release);
+
+  if ((last == OSAL_ERR_PERMISSION_DENIED) ||
+      (last == OSAL_ERR_NOT_IMPLEMENTED)) {
+    GTEST_SKIP() << "SCHED_DEADLINE not available";
+  } else if (last == OSAL_OK) {
+    GTEST_SKIP() << "deadline bandwidth not limited";
+  }
+  EXPECT_EQ(last, OSAL_ERR_ADMISSION_DENIED);
+  EXPECT_NE(probes[created - 1].policy, SCHED_DEADLINE);
+}
+
+TEST(TasksMultithreadingConfig, AttributesBeforeStart) {
+  osal_task_attr_t attr = {};
+  attr.policy = OSAL_SCHED_POLICY_FIFO;
+  attr.priority = 10;
+  attr.affinity = 0x1;
+
+  sched_probe_t probe = {nullptr, -1, -1, {}};
+  osal_task_t task;
+  osal_retval_t status;
+  ASSERT_EQ(osal_task_create(&task, &attr, sched_probe, &probe), OSAL_OK);
+  EXPECT_EQ(osal_task_get_sched_status(&task, &status), OSAL_OK);
+  ASSERT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+
+  // affinity never needs privileges
+  EXPECT_EQ(CPU_COUNT(&probe.cpus), 1);
+  EXPECT_TRUE(CPU_ISSET(0, &probe.cpus));
+
+  if (status == OSAL_ERR_PERMISSION_DENIED) {
+    GTEST_SKIP() << "no realtime privileges";
+  }
+  EXPECT_EQ(status, OSAL_OK);
+  EXPECT_EQ(probe.policy, SCHED_FIFO);
+  EXPECT_EQ(probe.priority, 10);
+}
+
+static void *noop_task(void *) { return nullptr; }
+
+TEST(TasksMultithreadingFunction, CreateLatency) {
+  // creating a task must not wait for a polling interval
+  const int cnt = 64;
+  std::vector<osal_task_t> tasks(cnt);
+
+  osal_uint64_t start = osal_timer_gettime_nsec();
+  for (int i = 0; i < cnt; ++i) {
+    ASSERT_EQ(osal_task_create(&tasks[i], nullptr, noop_task, nullptr),
+              OSAL_OK);
+  }
+  osal_uint64_t dur = osal_timer_gettime_nsec() - start;
+
+  for (int i = 0; i < cnt; ++i) {
+    EXPECT_EQ(osal_task_join(&tasks[i], nullptr), OSAL_OK);
+  }
+
+  EXPECT_LT(dur, cnt * 1000000u) << "average " << dur / cnt << " ns per task";
+  if (verbose) {
+    printf("created %d tasks in %lu ns/task\n", cnt,
+           (unsigned long)(dur / cnt));
+  }
+}
+
+TEST(TasksCpuset, Operations) {
+  osal_cpuset_t set;
+  osal_cpuset_zero(&set);
+  EXPECT_EQ(osal_cpuset_count(&set), 0u);
+  EXPECT_EQ(osal_cpuset_next(&set, -1), -1);
+
+  const osal_uint32_t cpus[] = {0, 31, 32, 63, 64, 127, 500, 1023};
+  for (auto cpu : cpus) {
+    osal_cpuset_set(&set, cpu);
+  }
+  // out of range is ignored
+  osal_cpuset_set(&set, OSAL_CPUSET_SIZE);
+  EXPECT_FALSE(osal_cpuset_isset(&set, OSAL_CPUSET_SIZE));
+
+  EXPECT_EQ(osal_cpuset_count(&set), sizeof(cpus) / sizeof(cpus[0]));
+  size_t i = 0;
+  for (osal_int32_t cpu = osal_cpuset_next(&set, -1); cpu >= 0;
+       cpu = osal_cpuset_next(&set, cpu)) {
+    ASSERT_LT(i, sizeof(cpus) / sizeof(cpus[0]));
+    EXPECT_EQ((osal_uint32_t)cpu, cpus[i++]);
+  }
+  EXPECT_EQ(i, sizeof(cpus) / sizeof(cpus[0]));
+
+  osal_cpuset_clear(&set, 64);
+  EXPECT_FALSE(osal_cpuset_isset(&set, 64));
+  EXPECT_TRUE(osal_cpuset_isset(&set, 63));
+  EXPECT_EQ(osal_cpuset_next(&set, 63), 127);
+
+  // 32 bit shim only keeps CPUs 0 to 31
+  EXPECT_EQ(osal_cpuset_to_mask(&set), 0x80000001u);
+  osal_cpuset_from_mask(&set, 0x80000001u);
+  EXPECT_EQ(osal_cpuset_count(&set), 2u);
+  EXPECT_TRUE(osal_cpuset_isset(&set, 31));
+}
+
+TEST(TasksCpuset, TaskAffinity) {
+  osal_cpuset_t online, set;
+  ASSERT_EQ(osal_task_get_cpuset(nullptr, &online), OSAL_OK);
+  ASSERT_GT(osal_cpuset_count(&online), 0u);
+  const osal_uint32_t last = (osal_uint32_t)[&] {
+    osal_int32_t cpu = -1, next;
+    while ((next = osal_cpuset_next(&online, cpu)) >= 0) {
+      cpu = next;
+    }
+    return cpu;
+  }();
+
+  // pin a task to the highest available CPU with the attributes
+  osal_task_attr_t attr = {};
+  osal_cpuset_zero(&attr.cpuset);
+  osal_cpuset_set(&attr.cpuset, last);
+
+  sched_probe_t probe = {nullptr, -1, -1, {}};
+  osal_task_t task;
+  osal_retval_t status;
+  ASSERT_EQ(osal_task_create(&task, &attr, sched_probe, &probe), OSAL_OK);
+  EXPECT_EQ(osal_task_get_sched_status(&task, &status), OSAL_OK);
+  EXPECT_EQ(status, OSAL_OK);
+  ASSERT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+  EXPECT_EQ(CPU_COUNT(&probe.cpus), 1);
+  EXPECT_TRUE(CPU_ISSET(last, &probe.cpus));
+
+  // set and get on the calling thread
+  osal_cpuset_zero(&set);
+  osal_cpuset_set(&set, last);
+  ASSERT_EQ(osal_task_set_cpuset(nullptr, &set), OSAL_OK);
+  osal_cpuset_zero(&set);
+  ASSERT_EQ(osal_task_get_cpuset(nullptr, &set), OSAL_OK);
+  EXPECT_EQ(osal_cpuset_count(&set), 1u);
+  EXPECT_TRUE(osal_cpuset_isset(&set, last));
+
+  osal_task_sched_affinity_t mask;
+  ASSERT_EQ(osal_task_get_affinity(nullptr, &mask), OSAL_OK);
+  EXPECT_EQ(mask, last < 32 ? (1u << last) : 0u);
+
+  // no available CPU in the set
+  osal_cpuset_zero(&set);
+  osal_cpuset_set(&set, OSAL_CPUSET_SIZE - 1);
+  if (!osal_cpuset_isset(&online, OSAL_CPUSET_SIZE - 1)) {
+    EXPECT_EQ(osal_task_set_cpuset(nullptr, &set), OSAL_ERR_INVALID_PARAM);
+  }
+  osal_cpuset_zero(&set);
+  EXPECT_EQ(osal_task_set_cpuset(nullptr, &set), OSAL_ERR_INVALID_PARAM);
+
+  EXPECT_EQ(osal_task_set_cpuset(nullptr, &online), OSAL_OK);
+}
+
+TEST(TasksCpuset, TaskAttrRoundTrip) {
+  osal_semaphore_t release;
+  ASSERT_EQ(osal_semaphore_init(&release, nullptr, 0), OSAL_OK);
+
+  sched_probe_t probe = {&release, -1, -1, {}};
+  osal_task_t task;
+  ASSERT_EQ(osal_task_create(&task, nullptr, sched_probe, &probe), OSAL_OK);
+
+  osal_cpuset_t set;
+  osal_task_attr_t attr = {};
+  ASSERT_EQ(osal_task_get_task_attr(&task, &attr), OSAL_OK);
+  ASSERT_EQ(osal_task_get_cpuset(&task, &set), OSAL_OK);
+  EXPECT_EQ(attr.affinity, 0u);
+  EXPECT_EQ(memcmp(&attr.cpuset, &set, sizeof(set)), 0);
+
+  // CPU 40 is faked if this machine has fewer CPUs, the kernel ignores it
+  const osal_uint32_t first = (osal_uint32_t)osal_cpuset_next(&set, -1);
+  osal_cpuset_zero(&attr.cpuset);
+  osal_cpuset_set(&attr.cpuset, first);
+  osal_cpuset_set(&attr.cpuset, 40);
+  ASSERT_EQ(osal_task_set_task_attr(&task, &attr), OSAL_OK);
+
+  osal_task_attr_t again = {};
+  ASSERT_EQ(osal_task_get_task_attr(&task, &again), OSAL_OK);
+  EXPECT_EQ(again.affinity, 0u);
+  EXPECT_TRUE(osal_cpuset_isset(&again.cpuset, first));
+
+  // a mask filled from the same set must not drop CPU 40
+  again.affinity = osal_cpuset_to_mask(&attr.cpuset);
+  again.cpuset = attr.cpuset;
+  ASSERT_EQ(osal_task_set_task_attr(&task, &again), OSAL_OK);
+  ASSERT_EQ(osal_task_get_task_attr(&task, &again), OSAL_OK);
+  EXPECT_TRUE(osal_cpuset_isset(&again.cpuset, first));
+
+  const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (cpus > 40) {
+    EXPECT_TRUE(osal_cpuset_isset(&again.cpuset, 40));
+  }
+
+  osal_semaphore_post(&release);
+  ASSERT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+  osal_semaphore_destroy(&release);
+}
+
+} // namespace test_sched
+
+namespace test_stack {
+
+typedef struct {
+  size_t stack_size;
+  size_t guard_size;
+  unsigned long timer_slack;
+  long faults;
+} stack_probe_t;
+
+static long minor_faults() {
+  struct rusage usage;
+  getrusage(RUSAGE_THREAD, &usage);
+  return usage.ru_minflt;
+}
+
+static void __attribute__((noinline)) touch_stack(size_t size) {
+  char buf[size];
+  volatile char *page = buf;
+  for (size_t i = 0; i < size; i += 4096) {
+    page[i] = 1;
+  }
+}
+
+static void *stack_probe(void *arg) {
+  stack_probe_t *probe = (stack_probe_t *)arg;
+  pthread_attr_t pattr;
+
+  if (pthread_getattr_np(pthread_self(), &pattr) == 0) {
+    pthread_attr_getstacksize(&pattr, &probe->stack_size);
+    pthread_attr_getguardsize(&pattr, &probe->guard_size);
+    pthread_attr_destroy(&pattr);
+  }
+  probe->timer_slack = (unsigned long)prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+
+  long faults = minor_faults();
+  touch_stack(96 * 1024);
+  probe->faults = minor_faults() - faults;
+  return nullptr;
+}
+
+TEST(TasksMultithreadingConfig, StackAttributes) {
+  osal_task_attr_t attr = {};
+  attr.stack_size = 512 * 1024;
+  attr.guard_size = 64 * 1024;
+  attr.stack_prefault = 128 * 1024;
+  attr.timer_slack = 1;
+
+  stack_probe_t probe = {};
+  osal_task_t task;
+  osal_retval_t status;
+  ASSERT_EQ(osal_task_create(&task, &attr, stack_probe, &probe), OSAL_OK);
+  EXPECT_EQ(osal_task_get_sched_status(&task, &status), OSAL_OK);
+  ASSERT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+
+  EXPECT_EQ(status, OSAL_OK);
+  EXPECT_EQ(probe.stack_size, attr.stack_size);
+  EXPECT_EQ(probe.guard_size, attr.guard_size);
+  EXPECT_EQ(probe.timer_slack, 1u);
+  // prefaulted stack pages do not fault again in the handler
+  EXPECT_LT(probe.faults, 4);
+}
+
+TEST(TasksMultithreadingConfig, StackPrefaultClamped) {
+  // more than the stack, with default and explicit stack size
+  osal_task_attr_t attr = {};
+  attr.stack_prefault = 1024 * 1024 * 1024;
+
+  for (size_t stack_size : {(size_t)0, (size_t)256 * 1024}) {
+    attr.stack_size = stack_size;
+
+    stack_probe_t probe = {};
+    osal_task_t task;
+    ASSERT_EQ(osal_task_create(&task, &attr, stack_probe, &probe), OSAL_OK);
+    ASSERT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+
+    EXPECT_LT(probe.faults, 4);
+  }
+}
+
+static void *stack_noop(void *) { return nullptr; }
+
+TEST(TasksMultithreadingConfig, StackPrefaultSmallStack) {
+  // on the smallest stack, and less than one prefault frame
+  osal_task_attr_t attr = {};
+  attr.stack_size = PTHREAD_STACK_MIN;
+
+  for (size_t prefault : {(size_t)1024 * 1024 * 1024, (size_t)100}) {
+    attr.stack_prefault = prefault;
+
+    osal_task_t task;
+    ASSERT_EQ(osal_task_create(&task, &attr, stack_noop, nullptr), OSAL_OK);
+    ASSERT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+  }
+}
+
+TEST(TasksMultithreadingDetect, StackTooSmall) {
+  osal_task_attr_t attr = {};
+  attr.stack_size = 1;
+
+  osal_task_t task;
+  EXPECT_EQ(osal_task_create(&task, &attr, stack_probe, nullptr),
+            OSAL_ERR_INVALID_PARAM);
+}
+
+} // namespace test_stack
+
+namespace test_stats {
+
+using testutils::wait_nanoseconds;
+
+typedef struct {
+  std::atomic<int> phase;
+  int sleeps;
+} stats_probe_t;
+
+static void *stats_probe(void *arg) {
+  stats_probe_t *probe = (stats_probe_t *)arg;
+
+  // sleep to get voluntary switches, then burn CPU until told to stop
+  for (int i = 0; i < probe->sleeps; ++i) {
+    wait_nanoseconds(100000);
+  }
+  probe->phase = 1;
+  while (probe->phase == 1) {
+  }
+  return nullptr;
+}
+
+TEST(TasksMultithreadingFunction, TaskStats) {
+  stats_probe_t probe;
+  probe.phase = 0;
+  probe.sleeps = 20;
+
+  osal_task_t task;
+  ASSERT_EQ(osal_task_create(&task, nullptr, stats_probe, &probe), OSAL_OK);
+  while (probe.phase == 0) {
+    wait_nanoseconds(1000000);
+  }
+
+  osal_task_stats_t first, second;
+  ASSERT_EQ(osal_task_get_stats(&task, &first), OSAL_OK);
+  wait_nanoseconds(20000000);
+  ASSERT_EQ(osal_task_get_stats(&task, &second), OSAL_OK);
+
+  osal_task_state_t state;
+  EXPECT_EQ(osal_task_get_state(&task, &state), OSAL_OK);
+  EXPECT_EQ(state, OSAL_STATE_THREAD_ACTIVE);
+
+  probe.phase = 2;
+  ASSERT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+
+  EXPECT_GE(first.voluntary_switches, (osal_uint64_t)probe.sleeps);
+  EXPECT_GT(second.cpu_time, first.cpu_time);
+  EXPECT_GE(second.involuntary_switches, first.involuntary_switches);
+  EXPECT_GE(second.minor_faults, first.minor_faults);
+  EXPECT_GE(second.cpu, 0);
+
+  // the thread is gone after join
+  EXPECT_EQ(osal_task_get_state(&task, &state), OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(state, OSAL_STATE_THREAD_UNKNOWN_ID);
+  EXPECT_EQ(osal_task_get_stats(&task, &first), OSAL_ERR_INVALID_PARAM);
+}
+
+TEST(TasksMultithreadingFunction, OwnStats) {
+  osal_task_t self;
+  ASSERT_EQ(osal_task_get_hdl(&self), OSAL_OK);
+
+  osal_task_stats_t first, second;
+  ASSERT_EQ(osal_task_get_stats(&self, &first), OSAL_OK);
+  wait_nanoseconds(1000000);
+  ASSERT_EQ(osal_task_get_stats(&self, &second), OSAL_OK);
+
+  EXPECT_GT(second.voluntary_switches, first.voluntary_switches);
+  EXPECT_GE(second.cpu_time, first.cpu_time);
+  EXPECT_EQ(second.cpu, sched_getcpu());
+
+  osal_task_state_t state;
+  EXPECT_EQ(osal_task_get_state(&self, &state), OSAL_OK);
+  EXPECT_EQ(state, OSAL_STATE_THREAD_ACTIVE);
+
+  // sampling must be cheap enough for a supervisor
+  osal_task_t other;
+  stats_probe_t probe;
+  probe.phase = 0;
+  probe.sleeps = 0;
+  ASSERT_EQ(osal_task_create(&other, nullptr, stats_probe, &probe), OSAL_OK);
+  while (probe.phase == 0) {
+    wait_nanoseconds(1000000);
+  }
+
+  const int cnt = 1000;
+  osal_uint64_t start = osal_timer_gettime_nsec();
+  for (int i = 0; i < cnt; ++i) {
+    EXPECT_EQ(osal_task_get_stats(&other, &first), OSAL_OK);
+  }
+  osal_uint64_t dur = osal_timer_gettime_nsec() - start;
+
+  probe.phase = 2;
+  ASSERT_EQ(osal_task_join(&other, nullptr), OSAL_OK);
+
+  EXPECT_LT(dur / cnt, 1000000u);
+  if (verbose) {
+    printf("osal_task_get_stats takes %lu ns\n", (unsigned long)(dur / cnt));
+  }
+}
+
+} // namespace test_stats
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
 
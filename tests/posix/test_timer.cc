@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <errno.h>
 #include <pthread.h>
 #include <stdlib.h>
@@ -469,6 +470,110 @@ TEST(TimerFunction, BusyWait) {
   EXPECT_GE(stop, now + delta) << "osal_busy_wait incorrect delta";
 }
 
+TEST(TimerFunction, TscClock) {
+  osal_retval_t orv = osal_timer_tsc_enable(20000000u);
+  if ((orv == OSAL_ERR_UNAVAILABLE) || (orv == OSAL_ERR_NOT_IMPLEMENTED)) {
+    EXPECT_EQ(osal_timer_tsc_get_frequency(), 0u);
+    GTEST_SKIP() << "no invariant timestamp counter";
+  }
+  ASSERT_EQ(orv, OSAL_OK) << "osal_timer_tsc_enable failed";
+  EXPECT_GT(osal_timer_tsc_get_frequency(), 0u);
+
+  struct timespec ts;
+  clock_gettime(osal_timer_get_clock_source(), &ts);
+  const osal_uint64_t ref = ts.tv_sec * 1000000000ull + ts.tv_nsec;
+  const osal_uint64_t start = osal_timer_gettime_nsec();
+  EXPECT_LT(start > ref ? start - ref : ref - start, 1000000u)
+      << "timestamp counter not based on clock source";
+
+  // timestamps are monotonic
+  osal_uint64_t last = start;
+  for (int i = 0; i < 100000; ++i) {
+    osal_uint64_t now = osal_timer_gettime_nsec();
+    ASSERT_GE(now, last);
+    last = now;
+  }
+
+  // rate matches clock source
+  clock_gettime(osal_timer_get_clock_source(), &ts);
+  const osal_uint64_t ref0 = ts.tv_sec * 1000000000ull + ts.tv_nsec;
+  const osal_uint64_t tsc0 = osal_timer_gettime_nsec();
+  osal_sleep(50000000u);
+  clock_gettime(osal_timer_get_clock_source(), &ts);
+  const osal_uint64_t ref1 = ts.tv_sec * 1000000000ull + ts.tv_nsec;
+  const osal_uint64_t tsc1 = osal_timer_gettime_nsec();
+  const osal_int64_t drift = (osal_int64_t)(tsc1 - tsc0) - (osal_int64_t)(ref1 - ref0);
+  EXPECT_LT(llabs(drift), 100000) << "timestamp counter rate off by " << drift << " ns";
+
+  // rebased on clock source change
+  osal_timer_set_clock_source(LIBOSAL_CLOCK_MONOTONIC);
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  const osal_uint64_t mono = ts.tv_sec * 1000000000ull + ts.tv_nsec;
+  const osal_uint64_t tsc_mono = osal_timer_gettime_nsec();
+  EXPECT_LT(tsc_mono > mono ? tsc_mono - mono : mono - tsc_mono, 1000000u);
+  osal_timer_set_clock_source(LIBOSAL_CLOCK_REALTIME);
+
+  osal_timer_tsc_disable();
+  EXPECT_EQ(osal_timer_tsc_get_frequency(), 0u);
+}
+
+TEST(TimerFunction, SleepUntilPrecise) {
+  const int cycles = 1000;
+  const osal_uint64_t period = 1000000u;
+  osal_timer_precise_stats_t stats;
+  std::vector<osal_uint64_t> late;
+
+  osal_timer_precise_reset(0);
+  osal_timer_precise_get_stats(&stats);
+  EXPECT_EQ(stats.slack, (osal_uint64_t)OSAL_TIMER_PRECISE_SLACK_DEFAULT);
+  EXPECT_EQ(stats.cnt, 0u);
+
+  // never returns before the deadline, deadlines in the past return at once
+  osal_uint64_t next = osal_timer_gettime_nsec() + period;
+  for (int i = 0; i < cycles; ++i) {
+    EXPECT_EQ(osal_sleep_until_precise(next), OSAL_OK);
+    osal_uint64_t now = osal_timer_gettime_nsec();
+    ASSERT_GE(now, next);
+    late.push_back(now - next);
+    next += period;
+  }
+  EXPECT_EQ(osal_sleep_until_precise(osal_timer_gettime_nsec() - period), OSAL_OK);
+
+  // slack adapted to the wakeup latency of this machine
+  osal_timer_precise_get_stats(&stats);
+  EXPECT_EQ(stats.cnt, (osal_uint64_t)cycles + 1u);
+  EXPECT_LE(stats.late, (osal_uint64_t)cycles);
+  EXPECT_GE(stats.slack, (osal_uint64_t)OSAL_TIMER_PRECISE_SLACK_MIN);
+  EXPECT_LE(stats.slack, (osal_uint64_t)OSAL_TIMER_PRECISE_SLACK_MAX);
+
+  std::sort(late.begin(), late.end());
+  if (verbose) {
+    printf("median wakeup %lu nsec late, slack %lu nsec\n",
+           (ulong)late[cycles / 2], (ulong)stats.slack);
+  }
+  if (check_latency) {
+    EXPECT_LT(late[cycles / 2], 10000u)
+        << "median wakeup " << late[cycles / 2] << " ns late";
+  }
+
+  osal_timer_precise_reset(1);
+  osal_timer_precise_get_stats(&stats);
+  EXPECT_EQ(stats.slack, (osal_uint64_t)OSAL_TIMER_PRECISE_SLACK_MIN);
+  EXPECT_EQ(stats.late, 0u);
+
+  // with the minimum slack the sleep overshoots sooner or later, that is
+  // counted and the slack grows
+  for (int i = 0; (i < 100) && (stats.late == 0u); ++i) {
+    osal_timer_precise_reset(1);
+    next = osal_timer_gettime_nsec() + period;
+    EXPECT_EQ(osal_sleep_until_precise(next), OSAL_OK);
+    ASSERT_GE(osal_timer_gettime_nsec(), next);
+    osal_timer_precise_get_stats(&stats);
+  }
+  EXPECT_EQ(stats.late, 1u);
+  EXPECT_GT(stats.slack, (osal_uint64_t)OSAL_TIMER_PRECISE_SLACK_MIN);
+}
+
 } // namespace test_timer
 
 int main(int argc, char **argv) {
@@ -0,0 +1,204 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "libosal/osal.h"
+#include "libosal/timer_service.h"
+#include "test_utils.h"
+
+namespace test_timer_service {
+
+using testutils::wait_nanoseconds;
+
+typedef struct {
+  osal_timer_service_timer_t tmr;
+  osal_uint64_t armed_at;
+  osal_uint64_t timeout;
+  std::atomic<osal_uint64_t> fired_at;
+  std::atomic<int> cnt;
+} test_timer_t;
+
+static void test_timer_cb(osal_void_t *arg) {
+  test_timer_t *t = (test_timer_t *)arg;
+  t->fired_at = osal_timer_gettime_nsec();
+  t->cnt++;
+}
+
+static void arm(osal_timer_service_t *svc, test_timer_t *t,
+                osal_uint64_t timeout) {
+  osal_timer_service_timer_init(&t->tmr, test_timer_cb, t);
+  t->timeout = timeout;
+  t->fired_at = 0;
+  t->cnt = 0;
+  t->armed_at = osal_timer_gettime_nsec();
+  ASSERT_EQ(osal_timer_service_arm(svc, &t->tmr, timeout, 0), OSAL_OK);
+}
+
+TEST(TimerServiceFunction, OneShot) {
+  // 1 us ticks, so that timers in the second and third wheel level expire
+  // within the test
+  osal_timer_service_attr_t attr = {};
+  attr.tick = 1000;
+  osal_timer_service_t svc;
+  ASSERT_EQ(osal_timer_service_init(&svc, &attr), OSAL_OK);
+
+  const osal_uint64_t timeouts[] = {0,      1000,    100000,  255000, 256000,
+                                    300000, 5000000, 65536000, 70000000};
+  const size_t cnt = sizeof(timeouts) / sizeof(timeouts[0]);
+  std::vector<test_timer_t> timers(cnt);
+
+  for (size_t i = 0; i < cnt; ++i) {
+    arm(&svc, &timers[i], timeouts[i]);
+  }
+
+  // cancelled timers do not fire
+  test_timer_t cancelled;
+  arm(&svc, &cancelled, 10000000);
+  EXPECT_EQ(osal_timer_service_cancel(&svc, &cancelled.tmr), OSAL_OK);
+  EXPECT_EQ(osal_timer_service_cancel(&svc, &cancelled.tmr),
+            OSAL_ERR_NOT_FOUND);
+
+  wait_nanoseconds(200000000);
+
+  for (size_t i = 0; i < cnt; ++i) {
+    EXPECT_EQ(timers[i].cnt, 1) << "timeout " << timeouts[i];
+    EXPECT_GE(timers[i].fired_at, timers[i].armed_at + timeouts[i])
+        << "timeout " << timeouts[i] << " expired early";
+    EXPECT_EQ(osal_timer_service_cancel(&svc, &timers[i].tmr),
+              OSAL_ERR_NOT_FOUND);
+  }
+  EXPECT_EQ(cancelled.cnt, 0);
+
+  EXPECT_EQ(osal_timer_service_destroy(&svc), OSAL_OK);
+}
+
+typedef struct {
+  osal_timer_service_t *svc;
+  osal_timer_service_timer_t tmr;
+  std::atomic<int> cnt;
+  int stop_after;
+} periodic_t;
+
+static void periodic_cb(osal_void_t *arg) {
+  periodic_t *p = (periodic_t *)arg;
+  if (++p->cnt == p->stop_after) {
+    // cancel from own callback stops the periodic timer
+    EXPECT_EQ(osal_timer_service_cancel(p->svc, &p->tmr), OSAL_ERR_NOT_FOUND);
+  }
+}
+
+TEST(TimerServiceFunction, Periodic) {
+  osal_timer_service_t svc;
+  ASSERT_EQ(osal_timer_service_init(&svc, nullptr), OSAL_OK);
+
+  periodic_t p;
+  p.svc = &svc;
+  p.cnt = 0;
+  p.stop_after = 10;
+  osal_timer_service_timer_init(&p.tmr, periodic_cb, &p);
+
+  osal_uint64_t start = osal_timer_gettime_nsec();
+  ASSERT_EQ(osal_timer_service_arm(&svc, &p.tmr, 2000000, 2000000), OSAL_OK);
+  while (p.cnt < p.stop_after) {
+    wait_nanoseconds(1000000);
+    ASSERT_LT(osal_timer_gettime_nsec() - start, 5000000000u);
+  }
+  EXPECT_GE(osal_timer_gettime_nsec() - start, 20000000u);
+
+  wait_nanoseconds(20000000);
+  EXPECT_EQ(p.cnt, p.stop_after);
+
+  // re-arming an armed timer moves it
+  p.stop_after = 0;
+  p.cnt = 0;
+  ASSERT_EQ(osal_timer_service_arm(&svc, &p.tmr, 1000000000, 0), OSAL_OK);
+  ASSERT_EQ(osal_timer_service_arm(&svc, &p.tmr, 1000000, 0), OSAL_OK);
+  wait_nanoseconds(20000000);
+  EXPECT_EQ(p.cnt, 1);
+
+  EXPECT_EQ(osal_timer_service_destroy(&svc), OSAL_OK);
+}
+
+typedef struct {
+  osal_timer_service_timer_t tmr;
+  std::atomic<int> *freed;
+} owned_t;
+
+static void free_self_cb(osal_void_t *arg) {
+  owned_t *o = (owned_t *)arg;
+  std::atomic<int> *freed = o->freed;
+
+  // scribble over the timer like a reusing allocator would
+  memset(o, 0xFF, sizeof(*o));
+  delete o;
+  (*freed)++;
+}
+
+TEST(TimerServiceFunction, OneShotFreedInCallback) {
+  osal_timer_service_attr_t attr = {};
+  attr.tick = 100000;
+  osal_timer_service_t svc;
+  ASSERT_EQ(osal_timer_service_init(&svc, &attr), OSAL_OK);
+
+  const int cnt = 100;
+  std::atomic<int> freed(0);
+  for (int i = 0; i < cnt; ++i) {
+    owned_t *o = new owned_t;
+    o->freed = &freed;
+    osal_timer_service_timer_init(&o->tmr, free_self_cb, o);
+    ASSERT_EQ(osal_timer_service_arm(&svc, &o->tmr, (i % 10) * 100000, 0),
+              OSAL_OK);
+  }
+
+  osal_uint64_t start = osal_timer_gettime_nsec();
+  while (freed < cnt) {
+    wait_nanoseconds(1000000);
+    ASSERT_LT(osal_timer_gettime_nsec() - start, 5000000000u);
+  }
+
+  EXPECT_EQ(osal_timer_service_destroy(&svc), OSAL_OK);
+}
+
+TEST(TimerServiceFunction, ManyTimers) {
+  const size_t cnt = 100000;
+  osal_timer_service_attr_t attr = {};
+  attr.tick = 100000;
+  osal_timer_service_t svc;
+  ASSERT_EQ(osal_timer_service_init(&svc, &attr), OSAL_OK);
+
+  std::vector<test_timer_t> timers(cnt);
+  osal_uint64_t start = osal_timer_gettime_nsec();
+  for (size_t i = 0; i < cnt; ++i) {
+    // every other timer far beyond the test, they are cancelled again
+    arm(&svc, &timers[i], (i & 1) ? (i % 100) * 1000000 : 3600000000000);
+  }
+  osal_uint64_t arm_time = osal_timer_gettime_nsec() - start;
+
+  for (size_t i = 0; i < cnt; i += 2) {
+    EXPECT_EQ(osal_timer_service_cancel(&svc, &timers[i].tmr), OSAL_OK);
+  }
+
+  wait_nanoseconds(300000000);
+
+  int fired = 0;
+  for (size_t i = 0; i < cnt; ++i) {
+    fired += timers[i].cnt;
+    if (timers[i].cnt != 0) {
+      EXPECT_GE(timers[i].fired_at, timers[i].armed_at + timers[i].timeout);
+    }
+  }
+  EXPECT_EQ(fired, (int)cnt / 2);
+  printf("armed %zu timers in %lu ns/timer\n", cnt,
+         (unsigned long)(arm_time / cnt));
+
+  EXPECT_EQ(osal_timer_service_destroy(&svc), OSAL_OK);
+}
+
+} // namespace test_timer_service
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,257 @@
+#include "gtest/gtest.h"
+#include <fstream>
+#include <ftw.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "libosal/osal.h"
+#include "libosal/topology.h"
+
+namespace test_topology {
+
+// fake sysfs with two packages, each with two cores with two SMT threads
+// sharing one L3 and one NUMA node, cpus 1-3 and 6-7 isolated
+class FakeSysfs : public ::testing::Test {
+protected:
+  std::string root;
+
+  void write(const std::string &path, const std::string &content) {
+    std::string full = root + "/" + path;
+
+    for (size_t pos = full.find('/', root.size() + 1);
+         pos != std::string::npos; pos = full.find('/', pos + 1)) {
+      mkdir(full.substr(0, pos).c_str(), 0755);
+    }
+
+    std::ofstream(full) << content << "\n";
+  }
+
+  void cache(int cpu, int idx, int level, const std::string &type,
+             const std::string &size, const std::string &cpus) {
+    std::string dir = "devices/system/cpu/cpu" + std::to_string(cpu) +
+                      "/cache/index" + std::to_string(idx) + "/";
+    write(dir + "level", std::to_string(level));
+    write(dir + "type", type);
+    write(dir + "size", size);
+    write(dir + "shared_cpu_list", cpus);
+  }
+
+  void SetUp() override {
+    char tmpl[] = "/tmp/osal-sysfs.XXXXXX";
+    ASSERT_NE(mkdtemp(tmpl), nullptr);
+    root = tmpl;
+
+    write("devices/system/cpu/possible", "0-7");
+    write("devices/system/cpu/online", "0-7");
+    write("devices/system/cpu/isolated", "1-3,6-7");
+    write("devices/system/cpu/nohz_full", "3,7");
+
+    for (int cpu = 0; cpu < 8; ++cpu) {
+      int core = cpu % 4;
+      int pkg = core / 2;
+      std::string dir =
+          "devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+      std::string siblings =
+          std::to_string(core) + "," + std::to_string(core + 4);
+      std::string shared = pkg == 0 ? "0-1,4-5" : "2-3,6-7";
+
+      write(dir + "core_id", std::to_string(core % 2));
+      write(dir + "physical_package_id", std::to_string(pkg));
+      write(dir + "thread_siblings_list", siblings);
+
+      cache(cpu, 0, 1, "Data", "32K", siblings);
+      cache(cpu, 1, 1, "Instruction", "32K", siblings);
+      cache(cpu, 2, 2, "Unified", "1024K", siblings);
+      cache(cpu, 3, 3, "Unified", "16M", shared);
+    }
+
+    write("devices/system/node/possible", "0-1");
+    write("devices/system/node/node0/cpulist", "0-1,4-5");
+    write("devices/system/node/node1/cpulist", "2-3,6-7");
+  }
+
+  static int remove_entry(const char *path, const struct stat *, int,
+                          struct FTW *) {
+    return remove(path);
+  }
+
+  void TearDown() override {
+    nftw(root.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+  }
+};
+
+static osal_cpuset_t cpus(const char *list) {
+  osal_cpuset_t set;
+  EXPECT_EQ(osal_topology_parse_cpulist(list, &set), OSAL_OK) << list;
+  return set;
+}
+
+static bool same(const osal_cpuset_t &set, const char *list) {
+  osal_cpuset_t expected = cpus(list);
+  return memcmp(&set, &expected, sizeof(osal_cpuset_t)) == 0;
+}
+
+#define EXPECT_SET_EQ(set, list) EXPECT_TRUE(same(set, list)) << list
+
+TEST(TopologyFunction, ParseCpulist) {
+  osal_cpuset_t set;
+
+  ASSERT_EQ(osal_topology_parse_cpulist("0-3,8,10-11\n", &set), OSAL_OK);
+  EXPECT_EQ(osal_cpuset_count(&set), 7u);
+  EXPECT_TRUE(osal_cpuset_isset(&set, 3));
+  EXPECT_FALSE(osal_cpuset_isset(&set, 4));
+  EXPECT_TRUE(osal_cpuset_isset(&set, 11));
+
+  ASSERT_EQ(osal_topology_parse_cpulist("1023", &set), OSAL_OK);
+  EXPECT_TRUE(osal_cpuset_isset(&set, 1023));
+
+  // empty files, e.g. no isolated cpus
+  ASSERT_EQ(osal_topology_parse_cpulist("\n", &set), OSAL_OK);
+  EXPECT_EQ(osal_cpuset_count(&set), 0u);
+}
+
+TEST(TopologyDetect, ParseCpulistInvalid) {
+  osal_cpuset_t set;
+
+  for (const char *list : {"3-1", "1,", "1-", "-1", "1;2", "(null)", "1024"}) {
+    EXPECT_EQ(osal_topology_parse_cpulist(list, &set), OSAL_ERR_INVALID_PARAM)
+        << list;
+    EXPECT_EQ(osal_cpuset_count(&set), 0u);
+  }
+}
+
+TEST_F(FakeSysfs, Parse) {
+  osal_topology_t topo;
+  ASSERT_EQ(osal_topology_init(&topo, root.c_str()), OSAL_OK);
+
+  EXPECT_EQ(topo.cpu_cnt, 8u);
+  EXPECT_SET_EQ(topo.online, "0-7");
+  EXPECT_SET_EQ(topo.isolated, "1-3,6-7");
+  EXPECT_SET_EQ(topo.nohz_full, "3,7");
+
+  EXPECT_EQ(topo.cpus[6].core_id, 0);
+  EXPECT_EQ(topo.cpus[6].package_id, 1);
+  EXPECT_EQ(topo.cpus[6].node, 1);
+
+  // 4 cores with L1d, L1i and L2, 2 packages with L3
+  EXPECT_EQ(topo.cache_cnt, 14u);
+  EXPECT_EQ(topo.node_cnt, 2u);
+
+  osal_cpuset_t set;
+  ASSERT_EQ(osal_topology_get_siblings(&topo, 1, &set), OSAL_OK);
+  EXPECT_SET_EQ(set, "1,5");
+  ASSERT_EQ(osal_topology_get_cache_cpus(&topo, 2, 3, &set), OSAL_OK);
+  EXPECT_SET_EQ(set, "2-3,6-7");
+  ASSERT_EQ(osal_topology_get_cache_cpus(&topo, 2, 1, &set), OSAL_OK);
+  EXPECT_SET_EQ(set, "2,6");
+  ASSERT_EQ(osal_topology_get_node_cpus(&topo, 4, &set), OSAL_OK);
+  EXPECT_SET_EQ(set, "0-1,4-5");
+
+  bool found = false;
+  for (osal_uint32_t i = 0; i < topo.cache_cnt; ++i) {
+    if (topo.caches[i].level == 3) {
+      EXPECT_EQ(topo.caches[i].type, OSAL_TOPOLOGY_CACHE_UNIFIED);
+      EXPECT_EQ(topo.caches[i].size, 16u << 20);
+      found = true;
+    }
+  }
+  EXPECT_TRUE(found);
+
+  EXPECT_EQ(osal_topology_get_cache_cpus(&topo, 2, 4, &set), OSAL_ERR_NOT_FOUND);
+  EXPECT_EQ(osal_topology_get_siblings(&topo, 8, &set), OSAL_ERR_NOT_FOUND);
+  EXPECT_EQ(osal_topology_destroy(&topo), OSAL_OK);
+}
+
+TEST_F(FakeSysfs, OfflineCpu) {
+  write("devices/system/cpu/online", "0-5");
+  write("devices/system/cpu/nohz_full", "(null)");
+
+  osal_topology_t topo;
+  ASSERT_EQ(osal_topology_init(&topo, root.c_str()), OSAL_OK);
+
+  EXPECT_EQ(topo.cpu_cnt, 8u);
+  EXPECT_EQ(topo.cpus[6].online, OSAL_FALSE);
+  EXPECT_EQ(osal_cpuset_count(&topo.nohz_full), 0u);
+
+  osal_cpuset_t set;
+  EXPECT_EQ(osal_topology_get_siblings(&topo, 6, &set), OSAL_ERR_NOT_FOUND);
+
+  // cpu 6 and 7 are isolated but offline
+  osal_uint32_t cpu;
+  osal_cpuset_t busy = cpus("1-5");
+  ASSERT_EQ(osal_topology_place(&topo, 0, &topo.isolated, &busy, &cpu),
+            OSAL_ERR_NOT_FOUND);
+  EXPECT_EQ(osal_topology_destroy(&topo), OSAL_OK);
+}
+
+TEST_F(FakeSysfs, Place) {
+  osal_topology_t topo;
+  ASSERT_EQ(osal_topology_init(&topo, root.c_str()), OSAL_OK);
+  osal_uint32_t cpu = 0;
+  const osal_uint32_t rt =
+      OSAL_TOPOLOGY_PLACE__ISOLATED | OSAL_TOPOLOGY_PLACE__IDLE_SMT;
+
+  // cpu 1 is isolated but its sibling 5 is not
+  ASSERT_EQ(osal_topology_place(&topo, OSAL_TOPOLOGY_PLACE__ISOLATED, nullptr,
+                                nullptr, &cpu), OSAL_OK);
+  EXPECT_EQ(cpu, 1u);
+  ASSERT_EQ(osal_topology_place(&topo, rt, nullptr, nullptr, &cpu), OSAL_OK);
+  EXPECT_EQ(cpu, 2u);
+
+  // a noisy task on 6 rules out its sibling 2
+  osal_cpuset_t busy = cpus("6");
+  ASSERT_EQ(osal_topology_place(&topo, rt, nullptr, &busy, &cpu), OSAL_OK);
+  EXPECT_EQ(cpu, 3u);
+
+  osal_cpuset_set(&busy, 3);
+  EXPECT_EQ(osal_topology_place(&topo, rt, nullptr, &busy, &cpu),
+            OSAL_ERR_NOT_FOUND);
+  ASSERT_EQ(osal_topology_place(&topo, OSAL_TOPOLOGY_PLACE__NOHZ_FULL, nullptr,
+                                &busy, &cpu), OSAL_OK);
+  EXPECT_EQ(cpu, 7u);
+
+  // sharing an L3 with cpu 0
+  osal_cpuset_t l3;
+  ASSERT_EQ(osal_topology_get_cache_cpus(&topo, 0, 3, &l3), OSAL_OK);
+  EXPECT_EQ(osal_topology_place(&topo, rt, &l3, nullptr, &cpu),
+            OSAL_ERR_NOT_FOUND);
+  busy = cpus("0-1");
+  ASSERT_EQ(osal_topology_place(&topo, 0, &l3, &busy, &cpu), OSAL_OK);
+  EXPECT_EQ(cpu, 4u);
+
+  EXPECT_EQ(osal_topology_destroy(&topo), OSAL_OK);
+}
+
+TEST_F(FakeSysfs, Missing) {
+  osal_topology_t topo;
+  std::string missing = root + "/missing";
+
+  EXPECT_EQ(osal_topology_init(&topo, missing.c_str()), OSAL_ERR_NOT_FOUND);
+}
+
+TEST(TopologyFunction, System) {
+  osal_topology_t topo;
+  ASSERT_EQ(osal_topology_init(&topo, nullptr), OSAL_OK);
+
+  EXPECT_EQ(osal_cpuset_count(&topo.online),
+            (osal_uint32_t)sysconf(_SC_NPROCESSORS_ONLN));
+
+  osal_uint32_t cpu;
+  ASSERT_EQ(osal_topology_place(&topo, 0, nullptr, nullptr, &cpu), OSAL_OK);
+
+  osal_cpuset_t set;
+  ASSERT_EQ(osal_topology_get_siblings(&topo, cpu, &set), OSAL_OK);
+  EXPECT_TRUE(osal_cpuset_isset(&set, cpu));
+
+  EXPECT_EQ(osal_topology_destroy(&topo), OSAL_OK);
+}
+
+} // namespace test_topology
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
+#include <atomic>
 #include <pthread.h>
+#include <sys/resource.h>
 #include <vector>
 
 #include "libosal/osal.h"
@@ -47,6 +49,704 @@ TEST(TraceFunction, SingleThreaded) {
   osal_trace_free(tracep);
 }
 
+TEST(TraceFunction, RingSingleThreaded) {
+  const osal_uint32_t chunk = 100;
+  osal_trace_attr_t attr = OSAL_TRACE_ATTR__MODE__RING;
+  osal_trace_t *tracep;
+  osal_uint64_t dropped;
+
+  ASSERT_EQ(osal_trace_alloc_attr(&tracep, &attr, chunk), OSAL_OK);
+
+  EXPECT_EQ(osal_trace_drain(tracep, &dropped), OSAL_ERR_NO_DATA);
+  EXPECT_EQ(dropped, 0u);
+
+  // fill ring (two chunks) plus 10 samples which have to be dropped
+  for (osal_uint64_t i = 0; i < (3 * chunk + 10); ++i) {
+    osal_trace_time(tracep, i * 1000u);
+  }
+
+  EXPECT_EQ(osal_trace_get_dropped(tracep), chunk + 10u);
+  EXPECT_EQ(osal_trace_get_last_time(tracep), (2 * chunk - 1) * 1000u);
+
+  ASSERT_EQ(osal_trace_drain(tracep, &dropped), OSAL_OK);
+  EXPECT_EQ(dropped, chunk + 10u);
+
+  osal_uint64_t avg, avg_jit, max_jit, min_val, max_val;
+  osal_trace_analyze_min_max(tracep, &avg, &avg_jit, &max_jit, &min_val,
+                             &max_val);
+  EXPECT_EQ(avg, 1000u);
+  EXPECT_EQ(max_jit, 0u);
+  EXPECT_EQ(min_val, 1000u);
+  EXPECT_EQ(max_val, 1000u);
+
+  ASSERT_EQ(osal_trace_drain(tracep, &dropped), OSAL_OK);
+  EXPECT_EQ(dropped, 0u);
+  EXPECT_EQ(osal_trace_drain(tracep, &dropped), OSAL_ERR_NO_DATA);
+
+  // producer continues on freed ring space
+  for (osal_uint64_t i = 0; i < chunk; ++i) {
+    osal_trace_time(tracep, i * 10u);
+  }
+  ASSERT_EQ(osal_trace_drain(tracep, nullptr), OSAL_OK);
+  osal_trace_analyze_min_max(tracep, &avg, &avg_jit, &max_jit, &min_val,
+                             &max_val);
+  EXPECT_EQ(avg, 10u);
+
+  osal_trace_attr_t plain = OSAL_TRACE_ATTR__MODE__DOUBLE_BUFFER;
+  osal_trace_t *plainp;
+  ASSERT_EQ(osal_trace_alloc_attr(&plainp, &plain, chunk), OSAL_OK);
+  EXPECT_EQ(osal_trace_drain(plainp, nullptr), OSAL_ERR_INVALID_PARAM);
+  osal_trace_free(plainp);
+
+  osal_trace_free(tracep);
+}
+
+typedef struct {
+  osal_trace_t *tracep;
+  osal_uint64_t samples;
+  std::atomic<bool> done;
+} ring_producer_args_t;
+
+static void *ring_producer(void *arg) {
+  ring_producer_args_t *args = (ring_producer_args_t *)arg;
+
+  for (osal_uint64_t i = 1; i <= args->samples; ++i) {
+    osal_trace_time(args->tracep, i);
+  }
+
+  args->done = true;
+  return nullptr;
+}
+
+TEST(TraceFunction, RingProducerConsumer) {
+  const osal_uint32_t chunk = 64;
+  const osal_uint64_t samples = 1000 * chunk;
+  osal_trace_attr_t attr = OSAL_TRACE_ATTR__MODE__RING;
+  ring_producer_args_t args;
+  osal_task_t producer;
+
+  ASSERT_EQ(osal_trace_alloc_attr(&args.tracep, &attr, chunk), OSAL_OK);
+  args.samples = samples;
+  args.done = false;
+
+  ASSERT_EQ(osal_task_create(&producer, nullptr, ring_producer, &args),
+            OSAL_OK);
+
+  osal_uint64_t received = 0;
+  osal_uint64_t dropped_total = 0;
+
+  while (true) {
+    bool producer_done = args.done;
+    osal_uint64_t dropped = 0;
+    osal_retval_t orv = osal_trace_drain(args.tracep, &dropped);
+    dropped_total += dropped;
+
+    if (orv == OSAL_ERR_NO_DATA) {
+      if (producer_done) {
+        break;
+      }
+
+      (void)osal_trace_wait_for_ns(args.tracep, 1000000);
+      continue;
+    }
+
+    ASSERT_EQ(orv, OSAL_OK);
+
+    // every drained chunk must be internally consistent
+    osal_uint64_t avg, avg_jit, max_jit;
+    osal_trace_analyze(args.tracep, &avg, &avg_jit, &max_jit);
+    EXPECT_EQ(avg, 1u);
+    EXPECT_EQ(max_jit, 0u);
+
+    received += chunk;
+  }
+
+  ASSERT_EQ(osal_task_join(&producer, nullptr), OSAL_OK);
+  // only an incomplete last chunk may remain in the ring
+  EXPECT_LE(received + dropped_total, samples);
+  EXPECT_LT(samples - (received + dropped_total), chunk);
+  EXPECT_EQ(dropped_total, osal_trace_get_dropped(args.tracep));
+
+  osal_trace_free(args.tracep);
+}
+
+TEST(TraceFunction, HistPercentile) {
+  osal_trace_hist_t *histp;
+
+  EXPECT_EQ(osal_trace_hist_alloc(&histp, 1), OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(osal_trace_hist_alloc(&histp, 17), OSAL_ERR_INVALID_PARAM);
+  ASSERT_EQ(osal_trace_hist_alloc(&histp, 0), OSAL_OK);
+
+  EXPECT_EQ(osal_trace_hist_get_count(histp), 0u);
+  EXPECT_EQ(osal_trace_hist_get_percentile(histp, 50.), 0u);
+
+  // small values are counted exactly
+  for (osal_uint64_t v = 0; v < 100; v++) {
+    osal_trace_hist_record(histp, v);
+  }
+  EXPECT_EQ(osal_trace_hist_get_percentile(histp, 50.), 49u);
+  EXPECT_EQ(osal_trace_hist_get_percentile(histp, 99.), 98u);
+  EXPECT_EQ(osal_trace_hist_get_percentile(histp, 0.), 0u);
+  EXPECT_EQ(osal_trace_hist_get_percentile(histp, 100.), 99u);
+
+  osal_trace_hist_reset(histp);
+  EXPECT_EQ(osal_trace_hist_get_count(histp), 0u);
+
+  // large values within relative error of default precision
+  const osal_uint64_t n = 1000000;
+  for (osal_uint64_t v = 1; v <= n; v++) {
+    osal_trace_hist_record(histp, v * 1000u);
+  }
+
+  const double pcts[] = {50., 90., 99., 99.9, 99.99};
+  for (double p : pcts) {
+    double exact = p / 100. * n * 1000.;
+    double got = osal_trace_hist_get_percentile(histp, p);
+    EXPECT_GE(got, exact) << "p" << p;
+    EXPECT_LE(got, exact * (1. + 1. / 64.)) << "p" << p;
+  }
+
+  osal_uint64_t min_val, max_val;
+  osal_trace_hist_get_min_max(histp, &min_val, &max_val);
+  EXPECT_EQ(min_val, 1000u);
+  EXPECT_EQ(max_val, n * 1000u);
+  EXPECT_EQ(osal_trace_hist_get_percentile(histp, 100.), n * 1000u);
+
+  // whole range must be representable
+  osal_trace_hist_record(histp, UINT64_MAX);
+  EXPECT_EQ(osal_trace_hist_get_percentile(histp, 100.), UINT64_MAX);
+
+  osal_trace_hist_free(histp);
+}
+
+TEST(TraceFunction, HistMergeAttach) {
+  osal_trace_hist_t *hist_a, *hist_b, *hist_c;
+  osal_trace_t *trace_a, *trace_b;
+  osal_trace_attr_t attr = OSAL_TRACE_ATTR__REL;
+
+  ASSERT_EQ(osal_trace_hist_alloc(&hist_a, 0), OSAL_OK);
+  ASSERT_EQ(osal_trace_hist_alloc(&hist_b, 0), OSAL_OK);
+  ASSERT_EQ(osal_trace_hist_alloc(&hist_c, 10), OSAL_OK);
+  ASSERT_EQ(osal_trace_alloc(&trace_a, 16), OSAL_OK);
+  ASSERT_EQ(osal_trace_alloc_attr(&trace_b, &attr, 16), OSAL_OK);
+
+  osal_trace_hist_attach(trace_a, hist_a);
+  osal_trace_hist_attach(trace_b, hist_b);
+
+  // trace_a records intervals of 10, one outlier of 110
+  osal_uint64_t t = 1000;
+  for (int i = 0; i < 100; i++) {
+    t += (i == 50) ? 110 : 10;
+    osal_trace_time(trace_a, t);
+  }
+  EXPECT_EQ(osal_trace_hist_get_count(hist_a), 99u);
+  EXPECT_EQ(osal_trace_hist_get_percentile(hist_a, 50.), 10u);
+  EXPECT_EQ(osal_trace_hist_get_percentile(hist_a, 100.), 110u);
+
+  // trace_b records values directly
+  for (int i = 0; i < 100; i++) {
+    osal_trace_time(trace_b, 20);
+  }
+  EXPECT_EQ(osal_trace_hist_get_count(hist_b), 100u);
+  EXPECT_EQ(osal_trace_hist_get_percentile(hist_b, 50.), 20u);
+
+  EXPECT_EQ(osal_trace_hist_merge(hist_a, hist_c), OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(osal_trace_hist_merge(hist_a, hist_b), OSAL_OK);
+  EXPECT_EQ(osal_trace_hist_get_count(hist_a), 199u);
+  EXPECT_EQ(osal_trace_hist_get_percentile(hist_a, 25.), 10u);
+  EXPECT_EQ(osal_trace_hist_get_percentile(hist_a, 75.), 20u);
+  EXPECT_EQ(osal_trace_hist_get_percentile(hist_a, 100.), 110u);
+
+  osal_trace_hist_attach(trace_a, NULL);
+  osal_trace_time(trace_a, t + 10);
+  EXPECT_EQ(osal_trace_hist_get_count(hist_a), 199u);
+
+  osal_trace_free(trace_b);
+  osal_trace_free(trace_a);
+  osal_trace_hist_free(hist_c);
+  osal_trace_hist_free(hist_b);
+  osal_trace_hist_free(hist_a);
+}
+
+TEST(TraceFunction, StatsMatchesAnalyze) {
+  const osal_uint32_t count = 1000;
+  osal_trace_attr_t attr = OSAL_TRACE_ATTR__STATS;
+  osal_trace_attr_t plain = 0;
+  osal_trace_t *tracep;
+  osal_trace_stats_t stats;
+
+  EXPECT_EQ(osal_trace_alloc_attr(&tracep, &plain, 0), OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(osal_trace_alloc_attr(&tracep, &attr, 1), OSAL_ERR_INVALID_PARAM);
+
+  ASSERT_EQ(osal_trace_alloc_attr(&tracep, &attr, count), OSAL_OK);
+
+  osal_uint64_t avg, avg_jit, max_jit, min_val, max_val;
+  EXPECT_EQ(osal_trace_analyze_stats(tracep, &avg, &avg_jit, &max_jit, NULL,
+                                     NULL),
+            OSAL_ERR_NO_DATA);
+
+  // one buffer of intervals around 1 ms with deterministic jitter
+  osal_uint64_t t = 1000000000;
+  for (osal_uint32_t i = 0; i < count; i++) {
+    t += 1000000 + ((i * 7919u) % 2001u) - 1000u;
+    osal_trace_time(tracep, t);
+  }
+
+  osal_uint64_t b_avg, b_avg_jit, b_max_jit, b_min_val, b_max_val;
+  osal_trace_analyze_min_max(tracep, &b_avg, &b_avg_jit, &b_max_jit,
+                             &b_min_val, &b_max_val);
+
+  ASSERT_EQ(osal_trace_analyze_stats(tracep, &avg, &avg_jit, &max_jit,
+                                     &min_val, &max_val),
+            OSAL_OK);
+  EXPECT_NEAR(avg, b_avg, 1);
+  EXPECT_NEAR(avg_jit, b_avg_jit, 1);
+  EXPECT_NEAR(max_jit, b_max_jit, 1);
+  EXPECT_EQ(min_val, b_min_val);
+  EXPECT_EQ(max_val, b_max_val);
+
+  ASSERT_EQ(osal_trace_get_stats(tracep, &stats), OSAL_OK);
+  EXPECT_EQ(stats.cnt, count - 1u);
+
+  osal_trace_reset_stats(tracep);
+  ASSERT_EQ(osal_trace_get_stats(tracep, &stats), OSAL_OK);
+  EXPECT_EQ(stats.cnt, 0u);
+
+  osal_trace_time(tracep, t + 500);
+  ASSERT_EQ(osal_trace_analyze_stats(tracep, &avg, &avg_jit, &max_jit,
+                                     &min_val, &max_val),
+            OSAL_OK);
+  EXPECT_EQ(avg, 500u);
+  EXPECT_EQ(avg_jit, 0u);
+  EXPECT_EQ(max_jit, 0u);
+
+  osal_trace_free(tracep);
+
+  // no stats without attribute
+  ASSERT_EQ(osal_trace_alloc(&tracep, 16), OSAL_OK);
+  EXPECT_EQ(osal_trace_get_stats(tracep, &stats), OSAL_ERR_INVALID_PARAM);
+  osal_trace_free(tracep);
+}
+
+TEST(TraceFunction, StatsConcurrentRead) {
+  const osal_uint64_t samples = 2000000;
+  osal_trace_attr_t attr = OSAL_TRACE_ATTR__STATS | OSAL_TRACE_ATTR__REL;
+  ring_producer_args_t args;
+  osal_task_t producer;
+  osal_trace_stats_t stats;
+
+  // stats only, no sample buffers at all
+  ASSERT_EQ(osal_trace_alloc_attr(&args.tracep, &attr, 0), OSAL_OK);
+  args.samples = samples;
+  args.done = false;
+
+  ASSERT_EQ(osal_task_create(&producer, nullptr, ring_producer, &args),
+            OSAL_OK);
+
+  // producer records 1, 2, 3, ... so every consistent snapshot satisfies
+  // max == cnt and mean == (cnt + 1) / 2
+  osal_uint64_t reads = 0;
+  do {
+    ASSERT_EQ(osal_trace_get_stats(args.tracep, &stats), OSAL_OK);
+    if (stats.cnt != 0u) {
+      ASSERT_EQ(stats.min_val, 1u);
+      ASSERT_EQ(stats.max_val, stats.cnt);
+      ASSERT_NEAR(stats.mean, (stats.cnt + 1) / 2., 1e-6 * stats.cnt);
+    }
+    reads++;
+  } while (!args.done);
+
+  ASSERT_EQ(osal_task_join(&producer, nullptr), OSAL_OK);
+
+  ASSERT_EQ(osal_trace_get_stats(args.tracep, &stats), OSAL_OK);
+  EXPECT_EQ(stats.cnt, samples);
+  EXPECT_EQ(osal_trace_get_last_time(args.tracep), samples);
+  printf("concurrent stats reads: %lu\n", reads);
+
+  osal_trace_free(args.tracep);
+}
+
+TEST(TraceFunction, KernelsAgree) {
+  const osal_uint32_t count = 1003;  // not a multiple of any vector width
+  const osal_trace_kernel_t kernels[] = {
+      OSAL_TRACE_KERNEL__SSE42, OSAL_TRACE_KERNEL__AVX2,
+      OSAL_TRACE_KERNEL__NEON};
+  osal_trace_t *tracep;
+  osal_trace_t *widep;
+
+  EXPECT_EQ(osal_trace_set_kernel(OSAL_TRACE_KERNEL__NEON + 1),
+            OSAL_ERR_INVALID_PARAM);
+
+  ASSERT_EQ(osal_trace_alloc(&tracep, count), OSAL_OK);
+  ASSERT_EQ(osal_trace_alloc(&widep, count), OSAL_OK);
+
+  osal_uint64_t t = 1000000000;
+  for (osal_uint32_t i = 0; i < count; i++) {
+    t += 1000000 + ((i * 7919u) % 2001u) - 1000u;
+    osal_trace_time(tracep, t);
+    // values far beyond what vector int64->double conversion handles
+    osal_trace_time(widep, (i % 2u) ? (1ull << 62) + i : i);
+  }
+
+  osal_uint64_t ref[2][5];
+  ASSERT_EQ(osal_trace_set_kernel(OSAL_TRACE_KERNEL__SCALAR), OSAL_OK);
+  EXPECT_EQ(osal_trace_get_kernel(), OSAL_TRACE_KERNEL__SCALAR);
+  osal_trace_analyze_min_max(tracep, &ref[0][0], &ref[0][1], &ref[0][2],
+                             &ref[0][3], &ref[0][4]);
+  osal_trace_analyze_rel_min_max(widep, &ref[1][0], &ref[1][1], &ref[1][2],
+                                 &ref[1][3], &ref[1][4]);
+
+  for (osal_trace_kernel_t kernel : kernels) {
+    if (osal_trace_set_kernel(kernel) != OSAL_OK) {
+      printf("trace kernel %u not supported\n", kernel);
+      continue;
+    }
+
+    osal_uint64_t res[2][5];
+    osal_trace_analyze_min_max(tracep, &res[0][0], &res[0][1], &res[0][2],
+                               &res[0][3], &res[0][4]);
+    osal_trace_analyze_rel_min_max(widep, &res[1][0], &res[1][1], &res[1][2],
+                                   &res[1][3], &res[1][4]);
+
+    for (int b = 0; b < 2; b++) {
+      EXPECT_EQ(res[b][0], ref[b][0]) << "kernel " << kernel;
+      EXPECT_NEAR(res[b][1], ref[b][1], 1 + ref[b][1] / 1000000)
+          << "kernel " << kernel;
+      EXPECT_EQ(res[b][2], ref[b][2]) << "kernel " << kernel;
+      EXPECT_EQ(res[b][3], ref[b][3]) << "kernel " << kernel;
+      EXPECT_EQ(res[b][4], ref[b][4]) << "kernel " << kernel;
+    }
+  }
+
+  EXPECT_EQ(osal_trace_set_kernel(OSAL_TRACE_KERNEL__AUTO), OSAL_OK);
+  EXPECT_NE(osal_trace_get_kernel(), OSAL_TRACE_KERNEL__AUTO);
+
+  osal_trace_free(widep);
+  osal_trace_free(tracep);
+}
+
+TEST(TraceFunction, ShmExport) {
+  const osal_uint32_t count = 100;
+  const char *name = "/osal_test_trace_shm";
+  osal_trace_attr_t ring = OSAL_TRACE_ATTR__MODE__RING;
+  osal_trace_t *writer;
+  osal_trace_t *reader;
+  osal_uint64_t dropped;
+
+  EXPECT_EQ(osal_trace_alloc_shm(&writer, name, &ring, count),
+            OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(osal_trace_attach_shm(&reader, name), OSAL_ERR_NOT_FOUND);
+
+  ASSERT_EQ(osal_trace_alloc_shm(&writer, name, NULL, count), OSAL_OK);
+  ASSERT_EQ(osal_trace_attach_shm(&reader, name), OSAL_OK);
+
+  EXPECT_EQ(osal_trace_drain(reader, &dropped), OSAL_ERR_NO_DATA);
+  // the exporting side has no reader semantics
+  EXPECT_EQ(osal_trace_drain(writer, &dropped), OSAL_ERR_INVALID_PARAM);
+
+  osal_uint64_t t = 1000;
+  for (osal_uint32_t i = 0; i < count; i++) {
+    osal_trace_time(writer, t += 10);
+  }
+
+  osal_uint64_t avg, avg_jit, max_jit;
+  ASSERT_EQ(osal_trace_drain(reader, &dropped), OSAL_OK);
+  EXPECT_EQ(dropped, 0u);
+  osal_trace_analyze(reader, &avg, &avg_jit, &max_jit);
+  EXPECT_EQ(avg, 10u);
+  EXPECT_EQ(osal_trace_drain(reader, &dropped), OSAL_ERR_NO_DATA);
+
+  // reader too slow, only the newest buffer is fetched
+  for (osal_uint32_t i = 0; i < 3 * count; i++) {
+    osal_trace_time(writer, t += (i < 2 * count) ? 10 : 20);
+  }
+  ASSERT_EQ(osal_trace_drain(reader, &dropped), OSAL_OK);
+  EXPECT_EQ(dropped, 2u * count);
+  osal_trace_analyze(reader, &avg, &avg_jit, &max_jit);
+  EXPECT_EQ(avg, 20u);
+  EXPECT_EQ(max_jit, 0u);
+
+  // a late reader gets the newest complete buffer immediately
+  osal_trace_t *late;
+  ASSERT_EQ(osal_trace_attach_shm(&late, name), OSAL_OK);
+  ASSERT_EQ(osal_trace_drain(late, &dropped), OSAL_OK);
+  osal_trace_analyze(late, &avg, &avg_jit, &max_jit);
+  EXPECT_EQ(avg, 20u);
+  osal_trace_free(late);
+
+  // segment is unlinked with the exporting trace
+  osal_trace_free(writer);
+  EXPECT_EQ(osal_trace_attach_shm(&late, name), OSAL_ERR_NOT_FOUND);
+  osal_trace_free(reader);
+}
+
+TEST(TraceFunction, ShmConcurrentRead) {
+  const osal_uint32_t count = 256;
+  const char *name = "/osal_test_trace_shm_conc";
+  ring_producer_args_t args;
+  osal_task_t producer;
+  osal_trace_t *reader;
+
+  ASSERT_EQ(osal_trace_alloc_shm(&args.tracep, name, NULL, count), OSAL_OK);
+  ASSERT_EQ(osal_trace_attach_shm(&reader, name), OSAL_OK);
+  args.samples = 20000 * count;
+  args.done = false;
+
+  ASSERT_EQ(osal_task_create(&producer, nullptr, ring_producer, &args),
+            OSAL_OK);
+
+  // producer writes 1, 2, 3, ... so every untorn buffer has no jitter
+  osal_uint64_t fetched = 0, dropped_total = 0;
+  while (!args.done) {
+    osal_uint64_t dropped;
+    if (osal_trace_drain(reader, &dropped) != OSAL_OK) {
+      continue;
+    }
+
+    osal_uint64_t avg, avg_jit, max_jit;
+    osal_trace_analyze(reader, &avg, &avg_jit, &max_jit);
+    ASSERT_EQ(avg, 1u);
+    ASSERT_EQ(max_jit, 0u);
+    fetched++;
+    dropped_total += dropped;
+  }
+
+  ASSERT_EQ(osal_task_join(&producer, nullptr), OSAL_OK);
+  EXPECT_GT(fetched, 0u);
+  printf("fetched %lu buffers, skipped %lu samples\n", fetched, dropped_total);
+
+  osal_trace_free(reader);
+  osal_trace_free(args.tracep);
+}
+
+TEST(TraceFunction, TriggerSnapshot) {
+  const osal_uint32_t pre = 4, post = 3, len = pre + 1 + post;
+  osal_trace_t *tracep;
+  osal_trace_trigger_t *trig;
+  osal_trace_snapshot_t snap;
+  osal_uint64_t buf[len];
+
+  ASSERT_EQ(osal_trace_trigger_alloc(&trig, 1500, pre, post, 2), OSAL_OK);
+  ASSERT_EQ(osal_trace_alloc(&tracep, 16), OSAL_OK);
+  osal_trace_trigger_attach(tracep, trig);
+
+  EXPECT_EQ(osal_trace_trigger_read(trig, &snap, buf, len - 1),
+            OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(osal_trace_trigger_read(trig, &snap, buf, len), OSAL_ERR_NO_DATA);
+
+  // 1 us cycle, overrun of 2 us at t = 10000, pre window only partially filled
+  // for an early overrun at t = 3000
+  osal_uint64_t t = 0;
+  auto cycle = [&](osal_uint64_t interval) {
+    t += interval;
+    osal_trace_time(tracep, t);
+  };
+
+  cycle(1000);
+  cycle(2000);
+  for (int i = 0; i < 2; ++i) {
+    cycle(1000);
+  }
+  EXPECT_EQ(osal_trace_trigger_read(trig, &snap, buf, len), OSAL_ERR_NO_DATA)
+      << "snapshot completed before post window";
+  cycle(1000);
+
+  osal_timer_t to;
+  osal_timer_init(&to, 1000000);
+  EXPECT_EQ(osal_trace_trigger_timedwait(trig, &to), OSAL_OK);
+
+  ASSERT_EQ(osal_trace_trigger_read(trig, &snap, buf, len), OSAL_OK);
+  EXPECT_EQ(snap.seq, 1u);
+  EXPECT_EQ(snap.value, 2000u);
+  EXPECT_EQ(snap.lost, 0u);
+  EXPECT_EQ(snap.trigger_pos, 1u);
+  EXPECT_EQ(snap.cnt, 5u);
+  const osal_uint64_t expected1[] = {1000, 3000, 4000, 5000, 6000};
+  for (osal_uint32_t i = 0; i < snap.cnt; ++i) {
+    EXPECT_EQ(buf[i], expected1[i]) << "at " << i;
+  }
+
+  // overruns inside a running capture belong to it
+  for (int i = 0; i < 10; ++i) {
+    cycle(1000);
+  }
+  cycle(3000);
+  cycle(2500);
+  cycle(1000);
+  cycle(1000);
+  ASSERT_EQ(osal_trace_trigger_read(trig, &snap, buf, len), OSAL_OK);
+  EXPECT_EQ(snap.seq, 2u);
+  EXPECT_EQ(snap.value, 3000u);
+  EXPECT_EQ(snap.cnt, len);
+  EXPECT_EQ(snap.trigger_pos, pre);
+  EXPECT_EQ(buf[pre] - buf[pre - 1], 3000u);
+  EXPECT_EQ(buf[pre + 1] - buf[pre], 2500u);
+  EXPECT_EQ(osal_trace_trigger_read(trig, &snap, buf, len), OSAL_ERR_NO_DATA);
+
+  // more snapshots than slots, the oldest unread ones are lost
+  for (int k = 0; k < 5; ++k) {
+    cycle(5000);
+    for (osal_uint32_t i = 0; i < post; ++i) {
+      cycle(1000);
+    }
+  }
+  ASSERT_EQ(osal_trace_trigger_read(trig, &snap, buf, len), OSAL_OK);
+  EXPECT_EQ(snap.seq, 6u);
+  EXPECT_EQ(snap.lost, 3u);
+  ASSERT_EQ(osal_trace_trigger_read(trig, &snap, buf, len), OSAL_OK);
+  EXPECT_EQ(snap.seq, 7u);
+  EXPECT_EQ(snap.lost, 0u);
+
+  // disarmed
+  osal_trace_trigger_set_threshold(trig, UINT64_MAX);
+  cycle(100000);
+  for (osal_uint32_t i = 0; i < post; ++i) {
+    cycle(1000);
+  }
+  EXPECT_EQ(osal_trace_trigger_read(trig, &snap, buf, len), OSAL_ERR_NO_DATA);
+
+  osal_trace_trigger_attach(tracep, nullptr);
+  osal_trace_trigger_free(trig);
+  osal_trace_free(tracep);
+}
+
+typedef struct {
+  osal_trace_t *tracep;
+  osal_uint64_t cycles;
+  std::atomic<bool> done;
+} trigger_producer_args_t;
+
+static void *trigger_producer(void *arg) {
+  trigger_producer_args_t *args = (trigger_producer_args_t *)arg;
+  osal_uint64_t t = 0;
+
+  // every 16th interval is an overrun of 2 us
+  for (osal_uint64_t i = 1; i <= args->cycles; ++i) {
+    t += (i % 16) == 0 ? 2000 : 1000;
+    osal_trace_time(args->tracep, t);
+  }
+
+  args->done = true;
+  return nullptr;
+}
+
+TEST(TraceFunction, TriggerConcurrentRead) {
+  const osal_uint32_t pre = 8, post = 4, len = pre + 1 + post;
+  trigger_producer_args_t args;
+  osal_trace_trigger_t *trig;
+  osal_task_t producer;
+
+  ASSERT_EQ(osal_trace_alloc(&args.tracep, 64), OSAL_OK);
+  ASSERT_EQ(osal_trace_trigger_alloc(&trig, 1500, pre, post, 4), OSAL_OK);
+  osal_trace_trigger_attach(args.tracep, trig);
+  // last overrun is followed by a complete post window
+  args.cycles = 2000000 + 8;
+  args.done = false;
+
+  ASSERT_EQ(osal_task_create(&producer, nullptr, trigger_producer, &args),
+            OSAL_OK);
+
+  osal_uint64_t read = 0, lost = 0, last_seq = 0;
+  osal_uint64_t buf[len];
+
+  while (true) {
+    bool producer_done = args.done;
+    osal_trace_snapshot_t snap;
+    osal_retval_t orv = osal_trace_trigger_read(trig, &snap, buf, len);
+
+    if (orv == OSAL_ERR_NO_DATA) {
+      lost += snap.lost;
+      if (producer_done) {
+        break;
+      }
+      continue;
+    }
+
+    ASSERT_EQ(orv, OSAL_OK);
+    lost += snap.lost;
+    read++;
+    EXPECT_GT(snap.seq, last_seq);
+    last_seq = snap.seq;
+
+    // every copied snapshot has to be untorn
+    ASSERT_EQ(snap.cnt, len);
+    EXPECT_EQ(snap.value, 2000u);
+    for (osal_uint32_t i = 1; i < snap.cnt; ++i) {
+      EXPECT_EQ(buf[i] - buf[i - 1], i == snap.trigger_pos ? 2000u : 1000u)
+          << "torn snapshot " << snap.seq << " at " << i;
+    }
+  }
+
+  osal_task_join(&producer, nullptr);
+  EXPECT_EQ(read + lost, args.cycles / 16);
+  printf("read %lu snapshots, lost %lu\n", (unsigned long)read,
+         (unsigned long)lost);
+
+  osal_trace_trigger_free(trig);
+  osal_trace_free(args.tracep);
+}
+
+OSAL_TRACE_DEFINE_STATIC(static_trace, OSAL_TRACE_ATTR__MODE__DOUBLE_BUFFER, 100);
+OSAL_TRACE_DEFINE_STATIC(static_ring, OSAL_TRACE_ATTR__MODE__RING, 16);
+
+TEST(TraceFunction, InitCallerStorage) {
+  osal_uint64_t avg, avg_jit, max_jit;
+
+  ASSERT_EQ(OSAL_TRACE_INIT_STATIC(static_trace), OSAL_OK);
+  for (osal_uint64_t i = 1; i <= 100; ++i) {
+    osal_trace_time(&static_trace, i * 1000);
+  }
+  EXPECT_EQ(static_trace.time_in_ns[0], &static_trace_storage[0]);
+  osal_trace_analyze(&static_trace, &avg, &avg_jit, &max_jit);
+  EXPECT_EQ(avg, 1000u);
+  osal_trace_destroy(&static_trace);
+
+  ASSERT_EQ(OSAL_TRACE_INIT_STATIC(static_ring), OSAL_OK);
+  EXPECT_EQ(static_ring.ring_size, 32u);
+  for (osal_uint64_t i = 1; i <= 16; ++i) {
+    osal_trace_time(&static_ring, i);
+  }
+  EXPECT_EQ(osal_trace_drain(&static_ring, nullptr), OSAL_OK);
+  osal_trace_destroy(&static_ring);
+
+  // caller struct with allocated and with too small storage
+  osal_trace_t trace;
+  osal_uint64_t storage[10];
+  osal_trace_attr_t attr = OSAL_TRACE_ATTR__MODE__RING;
+  EXPECT_EQ(osal_trace_init(&trace, &attr, 4, storage, 10), OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(osal_trace_init(&trace, &attr, 3, storage, 10), OSAL_OK);
+  osal_trace_destroy(&trace);
+  EXPECT_EQ(osal_trace_init(&trace, nullptr, 1000, nullptr, 0), OSAL_OK);
+  osal_trace_destroy(&trace);
+}
+
+TEST(TraceFunction, LockedStorage) {
+  const osal_uint32_t cnt = 256 * 1024;
+  osal_trace_attr_t attr = OSAL_TRACE_ATTR__MEM_LOCK | OSAL_TRACE_ATTR__MEM_HUGEPAGE;
+  osal_trace_t *tracep;
+
+  osal_retval_t orv = osal_trace_alloc_attr(&tracep, &attr, cnt);
+  if ((orv == OSAL_ERR_PERMISSION_DENIED) || (orv == OSAL_ERR_OUT_OF_MEMORY)) {
+    GTEST_SKIP() << "not allowed to lock memory";
+  }
+  ASSERT_EQ(orv, OSAL_OK);
+
+  // first pass through both buffers does not page-fault
+  struct rusage usage;
+  getrusage(RUSAGE_THREAD, &usage);
+  long faults = usage.ru_minflt;
+  for (osal_uint64_t i = 1; i <= 2 * cnt; ++i) {
+    osal_trace_time(tracep, i);
+  }
+  getrusage(RUSAGE_THREAD, &usage);
+  EXPECT_LT(usage.ru_minflt - faults, 4);
+
+  osal_uint64_t avg, avg_jit, max_jit;
+  osal_trace_analyze(tracep, &avg, &avg_jit, &max_jit);
+  EXPECT_EQ(avg, 1u);
+  osal_trace_free(tracep);
+}
+
 } // namespace test_trace
 
 int main(int argc, char **argv) {
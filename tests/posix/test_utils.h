@@ -38,24 +38,44 @@ inline size_t hash_u32(uint32_t const val) {
   return new_hash;
 }
 
-inline osal_timer_t set_deadline(int sec, long nsec)
+inline osal_timer_t set_deadline_clock(clockid_t clock_id, int sec, long nsec)
 /* takes a second and a nanosecond value,
    and generates a deadline value that
-   many seconds / nanoseconds from now.
+   many seconds / nanoseconds from now,
+   measured on the given clock.
 */
 {
   timespec now;
-  clock_gettime(CLOCK_REALTIME, &now);
+  clock_gettime(clock_id, &now);
   osal_timer_t deadline;
   deadline.sec = now.tv_sec + sec;
   deadline.nsec = now.tv_nsec + nsec;
-  while (deadline.nsec > 1000000000) {
+  while (deadline.nsec >= 1000000000) {
     deadline.nsec -= 1000000000;
     deadline.sec += 1;
   }
   return deadline;
 }
 
+inline osal_timer_t set_deadline(int sec, long nsec) {
+  return set_deadline_clock(CLOCK_REALTIME, sec, nsec);
+}
+
+/* returns the time of a clock in nanoseconds */
+inline uint64_t gettime_ns(clockid_t clock_id) {
+  timespec now;
+  clock_gettime(clock_id, &now);
+  return (uint64_t)now.tv_sec * 1000000000ul + (uint64_t)now.tv_nsec;
+}
+
+/* returns nanoseconds elapsed on the monotonic clock since start */
+inline long elapsed_monotonic_ns(timespec const &start) {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start.tv_sec) * 1000000000l +
+         (now.tv_nsec - start.tv_nsec);
+}
+
 using std::vector;
 
 /* a bit ridiculous, but this is only